@@ -0,0 +1,15 @@
+# - Optionally compile for the instruction set of the build machine
+# This enables wider vector paths (such as AVX2) selected in hyper/simd.h.
+
+option(HYPER_NATIVE_ARCH "Compile for the instruction set of the build machine" OFF)
+
+if(HYPER_NATIVE_ARCH)
+    if(CMAKE_COMPILER_IS_GNUCXX OR CMAKE_COMPILER_IS_GNUC
+            OR CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -march=native")
+    elseif(CMAKE_BUILD_TOOL MATCHES "(msdev|devenv|nmake)")
+        set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} /arch:AVX2")
+    else()
+        message(STATUS "Unknown compiler, cannot set native architecture flags")
+    endif()
+endif()
@@ -0,0 +1,62 @@
+/// @file Barrier.h
+/// Reusable meeting point for a fixed group of threads.
+
+#ifndef HYPER_BARRIER_H
+#define HYPER_BARRIER_H
+
+#include "integer.h"
+
+namespace hyper {
+    /// @brief Point that a group of threads waits at until all of them have arrived.
+    /// @details Once the last thread arrives, every thread is released and the barrier resets for the next phase,
+    ///   which makes it a good fit for keeping worker threads in step from one frame to the next.
+    ///
+    ///   The barrier is sense-reversing: rather than resetting a flag, the last thread to arrive
+    ///   moves the barrier on to the next phase, and waiting threads watch for the phase to change.
+    ///   A thread that races ahead into the next phase can't confuse threads still leaving the previous one.
+    ///
+    ///   Waiting threads spin for a while before sleeping, since in a frame loop the rest of the group
+    ///   usually arrives within microseconds, well under the cost of sleeping and being woken.
+    ///   The last thread only makes a system call if another thread has gone to sleep.
+    class Barrier {
+    public:
+        /// @brief Default number of times to check the phase before sleeping.
+        static constexpr uint32 defaultSpinCount = 4096;
+
+        /// @brief General constructor.
+        /// @param threads Number of threads in the group. Must be at least one.
+        /// @param spinCount Number of times a waiting thread checks for the next phase before sleeping.
+        explicit Barrier(uint32 threads, uint32 spinCount = defaultSpinCount) noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        Barrier(const Barrier &other) = delete;
+
+        /// @brief Retrieves the number of threads in the group.
+        /// @return Number of threads that must arrive to complete a phase.
+        uint32 threads() const noexcept;
+
+        /// @brief Retrieves the current phase.
+        /// @return Number of phases that have completed.
+        uint32 phase() const noexcept;
+
+        /// @brief Arrives at the barrier and waits for the rest of the group.
+        /// @details Writes made by any thread before arriving are visible to every thread once they are released.
+        /// @return True for exactly one thread in each phase, the last to arrive.
+        ///   This can be used to pick a thread to do serial work between phases.
+        bool arriveAndWait() noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        Barrier &operator=(const Barrier &other) = delete;
+
+    private:
+        uint32 _threads;
+        uint32 _spinCount;
+        uint32 _remaining;
+        uint32 _phase;
+        uint32 _sleepers;
+    };
+}
+
+#endif // HYPER_BARRIER_H
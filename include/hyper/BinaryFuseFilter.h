@@ -0,0 +1,93 @@
+/// @file BinaryFuseFilter.h
+/// Compact probabilistic membership for a fixed set of keys.
+
+#ifndef HYPER_BINARY_FUSE_FILTER_H
+#define HYPER_BINARY_FUSE_FILTER_H
+
+#include <cstddef>   // For size_t.
+#include "byte.h"
+#include "hash.h"
+#include "integer.h"
+
+namespace hyper {
+    /// @brief Static xor filter using the 3-wise binary fuse construction.
+    /// @details Answers whether a key might be in a set that is fixed when the filter is built.
+    ///   There are no false negatives, and about one in 256 absent keys are reported as present.
+    ///   Each key costs about 9 bits, which is smaller and more accurate than a Bloom filter,
+    ///   but keys cannot be added after the filter is built.
+    ///   A query reads three bytes from three nearby segments of the fingerprint array.
+    ///   Keys are 64-bit integers; hash other keys with @ref hash(const byte *, size_t, uint64) first.
+    /// @see BloomFilter for a filter that supports inserting keys.
+    class BinaryFuseFilter {
+    public:
+        /// @brief Default constructor.
+        /// @details Creates an empty filter that contains nothing.
+        BinaryFuseFilter() noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        BinaryFuseFilter(const BinaryFuseFilter &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Frees the filter's storage.
+        ~BinaryFuseFilter() noexcept;
+
+        /// @brief Builds the filter from a set of keys.
+        /// @details Replaces any keys the filter was previously built with.
+        ///   Duplicate keys are allowed.
+        /// @param keys Keys to put in the filter.
+        /// @param count Number of keys in @p keys.
+        /// @return True if the filter was built.
+        /// @return False if construction failed, which is vanishingly unlikely.
+        ///   The filter is left empty in this case.
+        bool build(const uint64 *keys, size_t count) noexcept;
+
+        /// @brief Checks if a key might be in the filter.
+        /// @param key Key to look for.
+        /// @return False if the key is definitely not in the set.
+        /// @return True if the key is probably in the set.
+        bool contains(uint64 key) const noexcept;
+
+        /// @brief Checks if a key might be in the filter.
+        /// @param key Bytes of the key.
+        /// @param size Number of bytes in @p key.
+        /// @return False if the key is definitely not in the set.
+        /// @return True if the key is probably in the set.
+        bool contains(const byte *key, size_t size) const noexcept {
+            return contains(hash(key, size));
+        }
+
+        /// @brief Checks if many keys might be in the filter.
+        /// @details Fingerprints are prefetched ahead of the queries that use them,
+        ///   so that the cache misses overlap instead of being paid one at a time.
+        /// @param keys Keys to look for.
+        /// @param count Number of keys to check.
+        /// @param[out] results Set to the result of @ref contains() for each key.
+        void contains(const uint64 *keys, size_t count, bool *results) const noexcept;
+
+        /// @brief Retrieves the amount of memory used to store the filter.
+        /// @return Size of the filter's fingerprints in bytes.
+        size_t sizeInBytes() const noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        BinaryFuseFilter &operator=(const BinaryFuseFilter &other) = delete;
+
+    private:
+        uint64 _seed;
+        uint32 _segmentLength;
+        uint32 _segmentLengthMask;
+        uint32 _segmentCount;
+        uint32 _segmentCountLength;
+        uint32 _arrayLength;
+        uint8 *_fingerprints;
+
+        /// @brief Sizes the fingerprint array for a number of keys.
+        void allocate(size_t count) noexcept;
+
+        /// @brief Computes the position of a key's fingerprint in one of the three segments.
+        uint32 position(uint32 index, uint64 hash) const noexcept;
+    };
+}
+
+#endif // HYPER_BINARY_FUSE_FILTER_H
@@ -0,0 +1,99 @@
+/// @file BloomFilter.h
+/// Probabilistic set membership with one cache miss per query.
+
+#ifndef HYPER_BLOOM_FILTER_H
+#define HYPER_BLOOM_FILTER_H
+
+#include <cstddef>   // For size_t.
+#include "byte.h"
+#include "hash.h"
+#include "integer.h"
+
+namespace hyper {
+    /// @brief Cache-line blocked Bloom filter.
+    /// @details Answers whether a key might have been inserted.
+    ///   There are no false negatives, but there are false positives:
+    ///   with the default 10 bits per key, about one in a hundred absent keys are reported as present.
+    ///   Each key maps to a single 64-byte block and sets one bit in each of the block's eight words,
+    ///   so a query touches exactly one cache line and has no data-dependent branches.
+    ///   Keys are inserted and queried by their 64-bit hash.
+    ///   The byte overloads hash the key with @ref hash(const byte *, size_t, uint64) first.
+    /// @see BinaryFuseFilter for a smaller and more accurate filter of a fixed set of keys.
+    class BloomFilter {
+    public:
+        /// @brief General constructor.
+        /// @details Creates an empty filter sized for an expected number of keys.
+        /// @param keyCount Number of keys expected to be inserted.
+        ///   Inserting more keys than this increases the false-positive rate.
+        /// @param bitsPerKey Number of bits of storage to use for each expected key.
+        ///   Every additional bit per key roughly halves the false-positive rate.
+        explicit BloomFilter(size_t keyCount, size_t bitsPerKey = 10) noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        BloomFilter(const BloomFilter &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Frees the filter's storage.
+        ~BloomFilter() noexcept;
+
+        /// @brief Adds a key to the filter.
+        /// @param hash 64-bit hash of the key.
+        void insertHash(uint64 hash) noexcept;
+
+        /// @brief Adds a key to the filter.
+        /// @param key Bytes of the key.
+        /// @param size Number of bytes in @p key.
+        void insert(const byte *key, size_t size) noexcept {
+            insertHash(hash(key, size));
+        }
+
+        /// @brief Checks if a key might be in the filter.
+        /// @param hash 64-bit hash of the key.
+        /// @return False if the key was definitely not inserted.
+        /// @return True if the key was probably inserted.
+        bool containsHash(uint64 hash) const noexcept;
+
+        /// @brief Checks if a key might be in the filter.
+        /// @param key Bytes of the key.
+        /// @param size Number of bytes in @p key.
+        /// @return False if the key was definitely not inserted.
+        /// @return True if the key was probably inserted.
+        bool contains(const byte *key, size_t size) const noexcept {
+            return containsHash(hash(key, size));
+        }
+
+        /// @brief Checks if many keys might be in the filter.
+        /// @details Blocks are prefetched ahead of the queries that use them,
+        ///   so that the cache misses overlap instead of being paid one at a time.
+        /// @param hashes 64-bit hashes of the keys.
+        /// @param count Number of hashes to check.
+        /// @param[out] results Set to the result of @ref containsHash() for each hash.
+        void containsHashes(const uint64 *hashes, size_t count, bool *results) const noexcept;
+
+        /// @brief Removes all keys from the filter.
+        void clear() noexcept;
+
+        /// @brief Retrieves the amount of memory used to store the filter.
+        /// @return Size of the filter's storage in bytes.
+        size_t sizeInBytes() const noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        BloomFilter &operator=(const BloomFilter &other) = delete;
+
+    private:
+        /// @brief Group of bits that fits in a single cache line.
+        struct alignas(64) Block {
+            uint64 words[8];
+        };
+
+        Block *_blocks;
+        size_t _blockCount;
+
+        /// @brief Computes the bits a hash sets in each word of its block.
+        static void computeMask(uint64 hash, uint64 (&mask)[8]) noexcept;
+    };
+}
+
+#endif // HYPER_BLOOM_FILTER_H
@@ -0,0 +1,401 @@
+/// @file Cache.h
+/// Thread-safe, size-bounded cache of shared values.
+
+#ifndef HYPER_CACHE_H
+#define HYPER_CACHE_H
+
+#include <cstddef>   // For size_t.
+#include "assert.h"
+#include "hash.h"
+#include "integer.h"
+#include "ScopedLock.h"
+#include "SharedPointer.h"
+#include "SpinLock.h"
+#include "utility.h"
+
+namespace hyper {
+    /// @brief Concurrent cache that keeps the most useful values within a cost budget.
+    /// @details Values are stored and returned as shared pointers,
+    ///   so a value that is evicted while a reader is using it stays alive until the reader lets it go.
+    ///   Each value has a cost, such as its size in bytes, and the cache evicts values to keep the total
+    ///   of those costs within its capacity.
+    ///
+    ///   The cache is split into shards by key, each with its own lock and an equal share of the capacity,
+    ///   so threads working on different keys rarely contend. Locks are only held for the table lookup;
+    ///   evicted values are released after the lock is dropped.
+    ///
+    ///   Eviction uses S3-FIFO: new keys go into a small FIFO queue that takes about a tenth of the capacity.
+    ///   Keys that are read again before they reach the end of it move to the main FIFO queue,
+    ///   and the rest are evicted and remembered as ghosts. A ghost that is inserted again goes straight to
+    ///   the main queue. Keys at the end of the main queue that have been read recently get another pass.
+    ///   This keeps one-off lookups from flushing out the working set, and a hit only bumps a small counter
+    ///   instead of reordering a list.
+    /// @tparam T Type of value to cache.
+    template<typename T>
+    class Cache {
+    public:
+        /// @brief General constructor.
+        /// @details Creates an empty cache.
+        /// @param capacity Maximum total cost of the values in the cache.
+        /// @param shardCount Number of independently locked shards. Rounded up to a power of two.
+        ///   More shards reduce contention, but each shard only gets a fraction of the capacity.
+        explicit Cache(size_t capacity, size_t shardCount = 16) noexcept
+                : _shards(nullptr), _shardBits(0), _capacity(capacity) {
+            while((size_t(1) << _shardBits) < shardCount)
+                _shardBits++;
+            const size_t count = size_t(1) << _shardBits;
+            _shards = new Shard[count];
+            for(size_t i = 0; i < count; i++)
+                _shards[i].capacity = capacity / count;
+        }
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        Cache(const Cache &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Releases the cache's references to its values.
+        ~Cache() noexcept {
+            clear();
+            delete[] _shards;
+        }
+
+        /// @brief Looks up a value.
+        /// @details A hit marks the key as recently used.
+        /// @param key Key of the value to find.
+        /// @param[out] value Set to the cached value on a hit. Left unchanged on a miss.
+        /// @return True if the key is in the cache.
+        /// @return False if the key is not in the cache.
+        bool find(uint64 key, SharedPointer<T> &value) noexcept {
+            const auto keyHash = hash(key);
+            auto &shard = shardFor(keyHash);
+            // The caller's old reference is dropped after unlocking, in case it was the last one.
+            SharedPointer<T> previous(move(value));
+            bool hit;
+            {
+                ScopedLock<SpinLock> guard(shard.lock);
+                auto entry = shard.find(key, keyHash);
+                hit = entry != nullptr;
+                if(hit) {
+                    if(entry->frequency < maxFrequency)
+                        entry->frequency++;
+                    value = entry->value;
+                }
+            }
+            if(!hit)
+                value = move(previous);
+            return hit;
+        }
+
+        /// @brief Adds a value to the cache, replacing any value already stored under the key.
+        /// @details Other values are evicted as needed to make room.
+        /// @param key Key to store the value under.
+        /// @param value Value to store.
+        /// @param cost Cost of the value, in the same units as the capacity.
+        /// @return True if the value was stored.
+        /// @return False if the value costs more than a shard can hold, so it was not stored.
+        ///   Any value previously stored under the key is removed.
+        bool insert(uint64 key, const SharedPointer<T> &value, size_t cost = 1) noexcept {
+            const auto keyHash = hash(key);
+            auto &shard = shardFor(keyHash);
+            auto entry = new Entry(key, keyHash, value, cost);
+            Entry *evicted = nullptr;
+            bool stored;
+            {
+                ScopedLock<SpinLock> guard(shard.lock);
+                auto existing = shard.find(key, keyHash);
+                if(existing != nullptr) {
+                    shard.remove(existing);
+                    evicted = existing;
+                }
+                stored = cost <= shard.capacity;
+                if(stored) {
+                    shard.add(entry);
+                    shard.evict(evicted);
+                }
+            }
+            if(!stored)
+                delete entry;
+            release(evicted);
+            return stored;
+        }
+
+        /// @brief Removes a value from the cache.
+        /// @param key Key of the value to remove.
+        /// @return True if the value was removed.
+        /// @return False if the key was not in the cache.
+        bool erase(uint64 key) noexcept {
+            const auto keyHash = hash(key);
+            auto &shard = shardFor(keyHash);
+            Entry *entry;
+            {
+                ScopedLock<SpinLock> guard(shard.lock);
+                entry = shard.find(key, keyHash);
+                if(entry != nullptr)
+                    shard.remove(entry);
+            }
+            const bool found = entry != nullptr;
+            delete entry;
+            return found;
+        }
+
+        /// @brief Removes every value from the cache.
+        void clear() noexcept {
+            for(size_t i = 0, count = size_t(1) << _shardBits; i < count; i++) {
+                Entry *evicted = nullptr;
+                {
+                    ScopedLock<SpinLock> guard(_shards[i].lock);
+                    _shards[i].detachAll(evicted);
+                }
+                release(evicted);
+            }
+        }
+
+        /// @brief Counts the values in the cache.
+        /// @details Other threads may change the cache while the shards are counted,
+        ///   so the result is only a snapshot.
+        /// @return Number of values in the cache.
+        size_t size() const noexcept {
+            size_t total = 0;
+            for(size_t i = 0, count = size_t(1) << _shardBits; i < count; i++) {
+                ScopedLock<SpinLock> guard(_shards[i].lock);
+                total += _shards[i].count;
+            }
+            return total;
+        }
+
+        /// @brief Adds up the cost of the values in the cache.
+        /// @details Other threads may change the cache while the shards are counted,
+        ///   so the result is only a snapshot.
+        /// @return Total cost of the values in the cache.
+        size_t cost() const noexcept {
+            size_t total = 0;
+            for(size_t i = 0, count = size_t(1) << _shardBits; i < count; i++) {
+                ScopedLock<SpinLock> guard(_shards[i].lock);
+                total += _shards[i].small.cost + _shards[i].main.cost;
+            }
+            return total;
+        }
+
+        /// @brief Retrieves the capacity of the cache.
+        /// @return Maximum total cost of the values in the cache.
+        size_t capacity() const noexcept {
+            return _capacity;
+        }
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        Cache &operator=(const Cache &other) = delete;
+
+    private:
+        /// @brief Largest recent-use count an entry can build up.
+        static constexpr uint8 maxFrequency = 3;
+
+        /// @brief Cached value and its links in the shard's table and queue.
+        struct Entry {
+            uint64 key;
+            uint64 keyHash;
+            SharedPointer<T> value;
+            size_t cost;
+            Entry *chain;
+            Entry *previous;
+            Entry *next;
+            uint8 frequency;
+            bool inMain;
+
+            Entry(uint64 key, uint64 keyHash, const SharedPointer<T> &value, size_t cost) noexcept
+                    : key(key), keyHash(keyHash), value(value), cost(cost),
+                      chain(nullptr), previous(nullptr), next(nullptr), frequency(0), inMain(false) {
+                // ...
+            }
+        };
+
+        /// @brief Doubly-linked FIFO queue of entries.
+        struct Queue {
+            Entry *head = nullptr;
+            Entry *tail = nullptr;
+            size_t cost = 0;
+
+            void push(Entry *entry) noexcept {
+                entry->previous = tail;
+                entry->next = nullptr;
+                if(tail != nullptr)
+                    tail->next = entry;
+                else
+                    head = entry;
+                tail = entry;
+                cost += entry->cost;
+            }
+
+            void unlink(Entry *entry) noexcept {
+                if(entry->previous != nullptr)
+                    entry->previous->next = entry->next;
+                else
+                    head = entry->next;
+                if(entry->next != nullptr)
+                    entry->next->previous = entry->previous;
+                else
+                    tail = entry->previous;
+                cost -= entry->cost;
+            }
+        };
+
+        /// @brief Independently locked part of the cache.
+        /// @details Aligned to a cache line so that locking one shard doesn't slow down its neighbors.
+        struct alignas(64) Shard {
+            mutable SpinLock lock;
+            Entry **buckets = nullptr;
+            uint64 *ghosts = nullptr;
+            size_t bucketMask = 0;
+            size_t count = 0;
+            size_t capacity = 0;
+            Queue small;
+            Queue main;
+
+            Shard() noexcept = default;
+
+            Shard(const Shard &other) = delete;
+
+            ~Shard() noexcept {
+                delete[] buckets;
+                delete[] ghosts;
+            }
+
+            Shard &operator=(const Shard &other) = delete;
+
+            Entry *find(uint64 key, uint64 keyHash) const noexcept {
+                if(buckets == nullptr)
+                    return nullptr;
+                auto entry = buckets[keyHash & bucketMask];
+                while(entry != nullptr && entry->key != key)
+                    entry = entry->chain;
+                return entry;
+            }
+
+            void add(Entry *entry) noexcept {
+                if(count >= bucketMask)
+                    grow();
+                auto &bucket = buckets[entry->keyHash & bucketMask];
+                entry->chain = bucket;
+                bucket = entry;
+                count++;
+
+                // Ghosts are remembered in a direct-mapped table, so a collision just forgets the older one.
+                // The low bit is set so that an empty slot never matches.
+                // S3-FIFO remembers about as many ghosts as the main queue holds entries. Costs aren't counted
+                // in entries, so the table shares the bucket count instead, which grows with the entries held.
+                auto &ghost = ghosts[entry->keyHash & bucketMask];
+                if(ghost == (entry->keyHash | 1)) {
+                    ghost = 0;
+                    entry->inMain = true;
+                    main.push(entry);
+                } else {
+                    small.push(entry);
+                }
+            }
+
+            void remove(Entry *entry) noexcept {
+                auto link = &buckets[entry->keyHash & bucketMask];
+                while(*link != entry)
+                    link = &(*link)->chain;
+                *link = entry->chain;
+                entry->chain = nullptr;
+                count--;
+                (entry->inMain ? main : small).unlink(entry);
+            }
+
+            void evict(Entry *&evicted) noexcept {
+                while(small.cost + main.cost > capacity) {
+                    Entry *entry;
+                    if(small.cost > capacity / 10 || main.head == nullptr) {
+                        // Keys read while in the small queue have been seen twice, so they graduate.
+                        entry = small.head;
+                        if(entry->frequency > 0) {
+                            small.unlink(entry);
+                            entry->frequency = 0;
+                            entry->inMain = true;
+                            main.push(entry);
+                            continue;
+                        }
+                        ghosts[entry->keyHash & bucketMask] = entry->keyHash | 1;
+                    } else {
+                        entry = main.head;
+                        if(entry->frequency > 0) {
+                            main.unlink(entry);
+                            entry->frequency--;
+                            main.push(entry);
+                            continue;
+                        }
+                    }
+                    remove(entry);
+                    entry->chain = evicted;
+                    evicted = entry;
+                }
+            }
+
+            void detachAll(Entry *&evicted) noexcept {
+                Queue *queues[] = {&small, &main};
+                for(auto queue : queues) {
+                    for(auto entry = queue->head; entry != nullptr;) {
+                        auto next = entry->next;
+                        entry->chain = evicted;
+                        evicted = entry;
+                        entry = next;
+                    }
+                    *queue = Queue();
+                }
+                for(size_t i = 0; buckets != nullptr && i <= bucketMask; i++)
+                    buckets[i] = nullptr;
+                count = 0;
+            }
+
+            void grow() noexcept {
+                const size_t size = buckets == nullptr ? 16 : (bucketMask + 1) * 2;
+                auto resized = new Entry *[size]();
+                for(size_t i = 0; buckets != nullptr && i <= bucketMask; i++) {
+                    for(auto entry = buckets[i]; entry != nullptr;) {
+                        auto next = entry->chain;
+                        auto &bucket = resized[entry->keyHash & (size - 1)];
+                        entry->chain = bucket;
+                        bucket = entry;
+                        entry = next;
+                    }
+                }
+                // Keep the ghost history, so a shard that is still growing doesn't readmit keys it just evicted
+                // into the small queue. Stored ghosts have their low bit set, so it is taken from the old slot.
+                auto ghosted = new uint64[size]();
+                for(size_t i = 0; ghosts != nullptr && i <= bucketMask; i++) {
+                    const uint64 ghost = ghosts[i];
+                    if(ghost != 0)
+                        ghosted[((ghost & ~uint64(1)) | (i & 1)) & (size - 1)] = ghost;
+                }
+                delete[] buckets;
+                delete[] ghosts;
+                buckets = resized;
+                ghosts = ghosted;
+                bucketMask = size - 1;
+            }
+        };
+
+        Shard *_shards;
+        uint32 _shardBits;
+        size_t _capacity;
+
+        /// @brief Picks the shard for a key from the top bits of its hash.
+        /// @details Buckets within the shard use the bottom bits, so the two choices are independent.
+        Shard &shardFor(uint64 keyHash) const noexcept {
+            return _shards[_shardBits == 0 ? 0 : keyHash >> (64 - _shardBits)];
+        }
+
+        /// @brief Frees a chain of entries that have been removed from their shard.
+        static void release(Entry *entry) noexcept {
+            while(entry != nullptr) {
+                auto next = entry->chain;
+                delete entry;
+                entry = next;
+            }
+        }
+    };
+}
+
+#endif // HYPER_CACHE_H
@@ -0,0 +1,448 @@
+/// @file ConcurrentHashMap.h
+/// Hash map that many threads can read and update at once.
+
+#ifndef HYPER_CONCURRENT_HASH_MAP_H
+#define HYPER_CONCURRENT_HASH_MAP_H
+
+#include <cstddef>   // For size_t.
+#include <cstdint>   // For uintptr_t.
+#include "hash.h"
+#include "HazardPointer.h"
+#include "Pair.h"
+#include "SpinLock.h"
+
+namespace hyper {
+    /// @brief Concurrent open-addressing hash map, built for lookup tables that are read far more than written.
+    /// @details Every slot of the table holds a pointer to an immutable entry,
+    ///   which stores the key and value together as a @ref Pair along with the key's hash.
+    ///   Reads never take a lock or write to shared memory: they probe the table linearly,
+    ///   publishing each entry they look at in a hazard pointer so it can't be freed under them.
+    ///   Writers claim empty slots and replace or remove entries with a single compare-and-swap,
+    ///   and replaced entries are handed to a @ref HazardDomain to be freed once no reader holds them.
+    ///   Removed keys leave a tombstone, which is only cleared out when the table is rebuilt.
+    ///
+    ///   When the table is half full, a larger one is created and entries are moved over incrementally:
+    ///   each write moves a chunk of slots, along with the slots on its own key's probe sequence.
+    ///   Moving an entry freezes its slot first, so readers keep finding it in the old table
+    ///   until it is in the new one, and are then redirected. Readers are never blocked by a resize.
+    ///   A writer only waits if another writer is in the middle of moving an entry on its probe sequence.
+    ///   Once every slot has moved, the new table takes over and the old one is retired.
+    /// @tparam K Type of key. Must be copyable and comparable with @c operator==.
+    /// @tparam V Type of value. Must be copyable. Lookups return a copy.
+    /// @tparam Hash Function object that hashes keys.
+    template<typename K, typename V, typename Hash = Hasher<K>>
+    class ConcurrentHashMap {
+    public:
+        /// @brief General constructor.
+        /// @details Creates an empty map.
+        /// @param capacity Number of entries to make room for before the table first grows.
+        explicit ConcurrentHashMap(size_t capacity = 16) noexcept
+                : _domain(), _table(new Table(roundCapacity(capacity * 2))), _size(0), _hash() {
+            // ...
+        }
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        ConcurrentHashMap(const ConcurrentHashMap &other) = delete;
+
+        /// @brief Destructor.
+        /// @details No other thread may still be using the map.
+        ~ConcurrentHashMap() noexcept {
+            auto table = _table;
+            while(table != nullptr) {
+                // Entries still in a table that was being moved from aren't in the next one yet.
+                for(size_t i = 0; i < table->capacity; i++)
+                    if(isEntry(table->slots[i]))
+                        delete table->slots[i];
+                const auto next = table->next;
+                delete table;
+                table = next;
+            }
+        }
+
+        /// @brief Looks up the value for a key.
+        /// @param key Key to look up.
+        /// @param value Set to a copy of the value if the key is found.
+        /// @return True if the key is in the map.
+        bool find(const K &key, V &value) const noexcept {
+            HazardPointer tableHazard(_domain);
+            HazardPointer entryHazard(_domain);
+            const auto keyHash = _hash(key);
+            auto table = tableHazard.protect(_table);
+            while(true) {
+                Entry *entry = nullptr;
+                const auto probe = lookup(*table, keyHash, key, entryHazard, entry);
+                if(probe == Probe::Found) {
+                    value = entry->pair.second;
+                    return true;
+                }
+                if(probe == Probe::Missing)
+                    return false;
+                table = advance(tableHazard, table);
+            }
+        }
+
+        /// @brief Checks whether a key is in the map.
+        /// @param key Key to look for.
+        /// @return True if the key is in the map.
+        bool contains(const K &key) const noexcept {
+            HazardPointer tableHazard(_domain);
+            HazardPointer entryHazard(_domain);
+            const auto keyHash = _hash(key);
+            auto table = tableHazard.protect(_table);
+            while(true) {
+                Entry *entry = nullptr;
+                const auto probe = lookup(*table, keyHash, key, entryHazard, entry);
+                if(probe != Probe::Moved)
+                    return probe == Probe::Found;
+                table = advance(tableHazard, table);
+            }
+        }
+
+        /// @brief Adds a key to the map, or replaces its value if it is already there.
+        /// @param key Key to add.
+        /// @param value Value to store for the key.
+        /// @return True if the key was added, false if an existing value was replaced.
+        bool insert(const K &key, const V &value) noexcept {
+            const auto keyHash = _hash(key);
+            auto entry = new Entry{keyHash, Pair<K, V>(key, value)};
+            return write(keyHash, key, entry);
+        }
+
+        /// @brief Removes a key from the map.
+        /// @param key Key to remove.
+        /// @return True if the key was removed, false if it wasn't in the map.
+        bool erase(const K &key) noexcept {
+            return write(_hash(key), key, nullptr);
+        }
+
+        /// @brief Retrieves the number of keys in the map.
+        /// @return Number of keys, which may already be out of date.
+        size_t size() const noexcept {
+            return __atomic_load_n(&_size, __ATOMIC_RELAXED);
+        }
+
+        /// @brief Retrieves the number of slots in the current table.
+        /// @details The table grows once half of its slots are used.
+        /// @return Number of slots.
+        size_t capacity() const noexcept {
+            HazardPointer tableHazard(_domain);
+            return tableHazard.protect(_table)->capacity;
+        }
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        ConcurrentHashMap &operator=(const ConcurrentHashMap &other) = delete;
+
+    private:
+        struct Entry {
+            uint64 hash;
+            Pair<K, V> pair;
+        };
+
+        struct Table {
+            size_t capacity;
+            // Slots that have ever held an entry, including tombstones. Bounds the probe length.
+            size_t used;
+            // Next chunk of slots to move, and number of slots moved so far.
+            size_t moveCursor;
+            size_t moved;
+            Table *next;
+            Entry **slots;
+
+            explicit Table(size_t capacity) noexcept
+                    : capacity(capacity), used(0), moveCursor(0), moved(0), next(nullptr), slots(new Entry *[capacity]) {
+                for(size_t i = 0; i < capacity; i++)
+                    slots[i] = nullptr;
+            }
+
+            Table(const Table &other) = delete;
+
+            ~Table() noexcept {
+                delete[] slots;
+            }
+
+            Table &operator=(const Table &other) = delete;
+        };
+
+        // Entries are shared between tables while they are moved, so retiring a table leaves them alone.
+        struct TableDeleter {
+            void operator()(Table *&table) noexcept {
+                delete table;
+                table = nullptr;
+            }
+        };
+
+        enum class Probe {
+            Found,
+            Missing,
+            Moved
+        };
+
+        // Slot values other than entries. Entries are at least 8-byte aligned, so these can't collide with them,
+        // and the low bit of an entry pointer is free to mark it as frozen while it is moved.
+        static constexpr uintptr_t tombstoneValue = 2;
+        static constexpr uintptr_t movedValue = 4;
+        static constexpr uintptr_t movedEmptyValue = 6;
+        static constexpr uintptr_t frozenBit = 1;
+        static constexpr uintptr_t firstEntryValue = 8;
+
+        static constexpr size_t minimumCapacity = 16;
+
+        // Slots each writer moves from the old table while a resize is in progress.
+        static constexpr size_t moveChunk = 64;
+
+        mutable HazardDomain _domain;
+        Table *_table;
+        size_t _size;
+        Hash _hash;
+
+        static Entry *slotValue(uintptr_t value) noexcept {
+            return reinterpret_cast<Entry *>(value);
+        }
+
+        static uintptr_t bits(const Entry *slot) noexcept {
+            return reinterpret_cast<uintptr_t>(slot);
+        }
+
+        static bool isEntry(const Entry *slot) noexcept {
+            return bits(slot) >= firstEntryValue && (bits(slot) & frozenBit) == 0;
+        }
+
+        static bool isFrozen(const Entry *slot) noexcept {
+            return bits(slot) >= firstEntryValue && (bits(slot) & frozenBit) != 0;
+        }
+
+        static bool isMoved(const Entry *slot) noexcept {
+            return bits(slot) == movedValue || bits(slot) == movedEmptyValue;
+        }
+
+        static Entry *unfreeze(Entry *slot) noexcept {
+            return slotValue(bits(slot) & ~frozenBit);
+        }
+
+        static size_t roundCapacity(size_t capacity) noexcept {
+            size_t rounded = minimumCapacity;
+            while(rounded < capacity)
+                rounded *= 2;
+            return rounded;
+        }
+
+        static bool matches(const Entry *entry, uint64 keyHash, const K &key) noexcept {
+            return entry->hash == keyHash && entry->pair.first == key;
+        }
+
+        // Loads a slot, and if it holds an entry, protects the entry from being freed.
+        static Entry *protectSlot(Entry *const &slot, HazardPointer &hazard) noexcept {
+            while(true) {
+                const auto value = __atomic_load_n(&slot, __ATOMIC_ACQUIRE);
+                if(bits(value) < firstEntryValue)
+                    return value;
+                hazard.reset(unfreeze(value));
+                if(__atomic_load_n(&slot, __ATOMIC_ACQUIRE) == value)
+                    return value;
+            }
+        }
+
+        // Searches one table. Frozen entries are still current, since nothing can replace them until they have moved.
+        // Slots move in no particular order, so a moved slot only sends the search to the next table
+        // once the rest of the key's run has been checked: the key's own slot may not have moved yet.
+        Probe lookup(const Table &table, uint64 keyHash, const K &key, HazardPointer &hazard, Entry *&entry) const noexcept {
+            const auto mask = table.capacity - 1;
+            bool moved = false;
+            for(auto index = keyHash & mask; ; index = (index + 1) & mask) {
+                const auto slot = protectSlot(table.slots[index], hazard);
+                if(slot == nullptr)
+                    return moved ? Probe::Moved : Probe::Missing;
+                if(bits(slot) == movedEmptyValue)
+                    return Probe::Moved;
+                if(bits(slot) == movedValue) {
+                    moved = true;
+                    continue;
+                }
+                if(bits(slot) == tombstoneValue)
+                    continue;
+                if(matches(unfreeze(slot), keyHash, key)) {
+                    entry = unfreeze(slot);
+                    return Probe::Found;
+                }
+            }
+        }
+
+        // Moves protection on from a table whose slots have moved to the next one.
+        // The next table can only be retired after it has taken over from this one,
+        // so it is safe to use if this table is still current once the hazard is published.
+        Table *advance(HazardPointer &hazard, Table *table) const noexcept {
+            const auto next = __atomic_load_n(&table->next, __ATOMIC_ACQUIRE);
+            hazard.reset(next);
+            if(__atomic_load_n(&_table, __ATOMIC_ACQUIRE) == table)
+                return next;
+            return hazard.protect(_table);
+        }
+
+        // Claims a slot in a table for the first time. Fails if the table is too full.
+        static bool reserve(Table &table) noexcept {
+            if(__atomic_add_fetch(&table.used, 1, __ATOMIC_RELAXED) <= table.capacity / 2)
+                return true;
+            __atomic_sub_fetch(&table.used, 1, __ATOMIC_RELAXED);
+            return false;
+        }
+
+        // Puts a frozen entry into the next table. Only the thread that froze it does this,
+        // and no writer touches its key in the next table until it has moved, so it can't already be there.
+        static void copy(Table &next, Entry *entry) noexcept {
+            __atomic_add_fetch(&next.used, 1, __ATOMIC_RELAXED);
+            const auto mask = next.capacity - 1;
+            for(auto index = entry->hash & mask; ; index = (index + 1) & mask) {
+                Entry *expected = nullptr;
+                if(__atomic_compare_exchange_n(&next.slots[index], &expected, entry, false,
+                                               __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+                    return;
+            }
+        }
+
+        // Moves one slot to the next table, waiting if another thread is moving it.
+        // Returns the moved marker, which tells whether the slot was empty.
+        static uintptr_t moveSlot(Table &table, Table &next, size_t index) noexcept {
+            auto &slot = table.slots[index];
+            auto value = __atomic_load_n(&slot, __ATOMIC_ACQUIRE);
+            while(true) {
+                if(isMoved(value))
+                    return bits(value);
+                if(isFrozen(value)) {
+                    cpuRelax();
+                    value = __atomic_load_n(&slot, __ATOMIC_ACQUIRE);
+                    continue;
+                }
+                Entry *replacement;
+                if(value == nullptr)
+                    replacement = slotValue(movedEmptyValue);
+                else if(bits(value) == tombstoneValue)
+                    replacement = slotValue(movedValue);
+                else
+                    replacement = slotValue(bits(value) | frozenBit);
+                if(!__atomic_compare_exchange_n(&slot, &value, replacement, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+                    continue;
+                if(!isFrozen(replacement))
+                    return bits(replacement);
+                copy(next, value);
+                __atomic_store_n(&slot, slotValue(movedValue), __ATOMIC_RELEASE);
+                return movedValue;
+            }
+        }
+
+        // Moves the slots a key could be in, from its home slot to the first slot that was empty.
+        static void moveRun(Table &table, Table &next, uint64 keyHash) noexcept {
+            const auto mask = table.capacity - 1;
+            for(auto index = keyHash & mask; ; index = (index + 1) & mask)
+                if(moveSlot(table, next, index) == movedEmptyValue)
+                    return;
+        }
+
+        // Moves chunks of slots to the next table, and hands over to it once every slot has moved.
+        // With all set, keeps going until there is nothing left to claim and then waits for the handover.
+        void moveChunks(Table *table, Table &next, bool all) noexcept {
+            do {
+                const auto start = __atomic_fetch_add(&table->moveCursor, moveChunk, __ATOMIC_RELAXED);
+                if(start >= table->capacity)
+                    break;
+                const auto end = start + moveChunk < table->capacity ? start + moveChunk : table->capacity;
+                for(auto index = start; index < end; index++)
+                    moveSlot(*table, next, index);
+                if(__atomic_add_fetch(&table->moved, end - start, __ATOMIC_ACQ_REL) == table->capacity) {
+                    auto expected = table;
+                    if(__atomic_compare_exchange_n(&_table, &expected, &next, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+                        _domain.retire<Table, TableDeleter>(table);
+                }
+            } while(all);
+            if(all)
+                while(__atomic_load_n(&_table, __ATOMIC_ACQUIRE) == table)
+                    cpuRelax();
+        }
+
+        // Creates the next table for the current one. The table that is still being moved from has to finish first.
+        void grow(Table *table, HazardPointer &spare) noexcept {
+            const auto current = spare.protect(_table);
+            if(current != table) {
+                // Either the table has already been replaced or it is the next table of the current one.
+                if(__atomic_load_n(&current->next, __ATOMIC_ACQUIRE) == table)
+                    moveChunks(current, *table, true);
+                spare.clear();
+                return;
+            }
+            spare.clear();
+            // Rebuild at the same size if the table is mostly tombstones.
+            const auto live = __atomic_load_n(&_size, __ATOMIC_RELAXED);
+            const auto capacity = live * 4 > table->capacity ? table->capacity * 2 : table->capacity;
+            const auto next = new Table(capacity);
+            Table *expected = nullptr;
+            if(!__atomic_compare_exchange_n(&table->next, &expected, next, false, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE))
+                delete next;
+        }
+
+        // Replaces, adds or (with a null entry) removes a key.
+        bool write(uint64 keyHash, const K &key, Entry *entry) noexcept {
+            HazardPointer tableHazard(_domain);
+            HazardPointer nextHazard(_domain);
+            HazardPointer entryHazard(_domain);
+            auto table = tableHazard.protect(_table);
+            while(true) {
+                const auto next = __atomic_load_n(&table->next, __ATOMIC_ACQUIRE);
+                if(next != nullptr) {
+                    // A resize is in progress. Once this key's slots have moved, it is only written to the next table.
+                    nextHazard.reset(next);
+                    if(__atomic_load_n(&_table, __ATOMIC_ACQUIRE) != table) {
+                        table = tableHazard.protect(_table);
+                        continue;
+                    }
+                    moveRun(*table, *next, keyHash);
+                    moveChunks(table, *next, false);
+                    tableHazard.reset(next);
+                    table = next;
+                    continue;
+                }
+
+                bool retry = false;
+                const auto mask = table->capacity - 1;
+                for(auto index = keyHash & mask; !retry; ) {
+                    auto &slot = table->slots[index];
+                    const auto value = protectSlot(slot, entryHazard);
+                    if(isMoved(value) || isFrozen(value)) {
+                        retry = true;
+                    } else if(value == nullptr) {
+                        if(entry == nullptr)
+                            return false;
+                        if(!reserve(*table)) {
+                            grow(table, nextHazard);
+                            retry = true;
+                            continue;
+                        }
+                        auto expected = value;
+                        if(__atomic_compare_exchange_n(&slot, &expected, entry, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+                            __atomic_add_fetch(&_size, 1, __ATOMIC_RELAXED);
+                            return true;
+                        }
+                        // Lost the slot to another writer. Look at it again, since it may now hold this key.
+                        __atomic_sub_fetch(&table->used, 1, __ATOMIC_RELAXED);
+                    } else if(bits(value) == tombstoneValue || !matches(value, keyHash, key)) {
+                        index = (index + 1) & mask;
+                    } else {
+                        const auto replacement = entry != nullptr ? entry : slotValue(tombstoneValue);
+                        auto expected = value;
+                        if(__atomic_compare_exchange_n(&slot, &expected, replacement, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+                            entryHazard.clear();
+                            _domain.retire(value);
+                            if(entry == nullptr)
+                                __atomic_sub_fetch(&_size, 1, __ATOMIC_RELAXED);
+                            return entry == nullptr;
+                        }
+                    }
+                }
+                // Slots were frozen, moved or the table filled up, so there is a next table to move on to.
+                table = tableHazard.protect(_table);
+            }
+        }
+    };
+}
+
+#endif // HYPER_CONCURRENT_HASH_MAP_H
@@ -0,0 +1,121 @@
+/// @file CountMinSketch.h
+/// Frequency estimation in a small, fixed amount of memory.
+
+#ifndef HYPER_COUNT_MIN_SKETCH_H
+#define HYPER_COUNT_MIN_SKETCH_H
+
+#include <cstddef>   // For size_t.
+#include "byte.h"
+#include "hash.h"
+#include "integer.h"
+
+namespace hyper {
+    /// @brief Estimates how many times each key appears in a stream.
+    /// @details The sketch is a grid of counters with @c depth rows of @c width counters.
+    ///   Each key increments one counter in every row, and its estimate is the smallest of those counters.
+    ///   Estimates never undercount; with probability @c 1-e^-depth they overcount by at most
+    ///   @c e/width times the total of all counts.
+    ///   Updates are conservative: only the counters that would otherwise become the new minimum are raised,
+    ///   which greatly reduces overcounting. Counters saturate instead of wrapping around.
+    ///
+    ///   Sketches are not thread-safe. To count across threads, give each thread its own sketch
+    ///   and @ref merge() them.
+    class CountMinSketch {
+    public:
+        /// @brief General constructor.
+        /// @details Creates an empty sketch.
+        /// @param width Number of counters in each row. Must be greater than zero.
+        /// @param depth Number of rows. Must be greater than zero.
+        CountMinSketch(size_t width, size_t depth) noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        CountMinSketch(const CountMinSketch &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Frees the sketch's counters.
+        ~CountMinSketch() noexcept;
+
+        /// @brief Counts occurrences of a key.
+        /// @param keyHash 64-bit hash of the key.
+        /// @param count Number of occurrences to add.
+        void addHash(uint64 keyHash, uint32 count = 1) noexcept;
+
+        /// @brief Counts occurrences of a key.
+        /// @param key Bytes of the key.
+        /// @param size Number of bytes in @p key.
+        /// @param count Number of occurrences to add.
+        void add(const byte *key, size_t size, uint32 count = 1) noexcept {
+            addHash(hash(key, size), count);
+        }
+
+        /// @brief Estimates the number of occurrences of a key.
+        /// @param keyHash 64-bit hash of the key.
+        /// @return Approximate number of occurrences. This is never less than the true count.
+        uint32 estimateHash(uint64 keyHash) const noexcept;
+
+        /// @brief Estimates the number of occurrences of a key.
+        /// @param key Bytes of the key.
+        /// @param size Number of bytes in @p key.
+        /// @return Approximate number of occurrences. This is never less than the true count.
+        uint32 estimate(const byte *key, size_t size) const noexcept {
+            return estimateHash(hash(key, size));
+        }
+
+        /// @brief Retrieves the total of all counts added to the sketch.
+        /// @return Sum of every @p count passed to @ref addHash().
+        uint64 totalCount() const noexcept;
+
+        /// @brief Adds all of the counts from another sketch to this one.
+        /// @details Counters are added element-wise. The result is the same as a sketch that saw both streams
+        ///   without conservative update, so estimates after a merge may be slightly higher.
+        /// @param other Sketch to merge from. It must have the same width and depth.
+        /// @return True if the sketches were merged.
+        /// @return False if the dimensions are different. The sketch is left unchanged.
+        bool merge(const CountMinSketch &other) noexcept;
+
+        /// @brief Resets all counts to zero.
+        void clear() noexcept;
+
+        /// @brief Retrieves the number of counters in each row.
+        /// @return Width of the sketch.
+        size_t width() const noexcept;
+
+        /// @brief Retrieves the number of rows.
+        /// @return Depth of the sketch.
+        size_t depth() const noexcept;
+
+        /// @brief Calculates the number of bytes needed to serialize the sketch.
+        /// @return Size of the serialized sketch in bytes.
+        size_t serializedSize() const noexcept;
+
+        /// @brief Serializes the sketch so it can be stored or sent elsewhere.
+        /// @param[out] output Destination for the serialized sketch.
+        ///   This must have room for @ref serializedSize() bytes.
+        /// @return Number of bytes written to @p output.
+        size_t serialize(byte *output) const noexcept;
+
+        /// @brief Replaces the sketch with one that was serialized.
+        /// @details The data is validated, so it is safe to use with data received from elsewhere.
+        /// @param input Serialized sketch produced by @ref serialize().
+        /// @param size Number of bytes in @p input.
+        /// @return True if the sketch was replaced.
+        /// @return False if the data is not a valid sketch. The sketch is left unchanged.
+        bool deserialize(const byte *input, size_t size) noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        CountMinSketch &operator=(const CountMinSketch &other) = delete;
+
+    private:
+        uint32 *_counters;
+        size_t _width;
+        size_t _depth;
+        uint64 _total;
+
+        /// @brief Computes the column of a key in a row.
+        size_t column(uint64 keyHash, uint64 step, size_t row) const noexcept;
+    };
+}
+
+#endif // HYPER_COUNT_MIN_SKETCH_H
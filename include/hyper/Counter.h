@@ -8,7 +8,10 @@
 
 namespace hyper {
     /// @brief Non-negative value that can be incremented and decremented.
-    /// @todo Make thread-safe.
+    /// @details All operations are atomic, so a counter can be shared between threads.
+    ///   Increments are relaxed, and decrements synchronize with each other,
+    ///   which is what reference counting needs: the thread that drops the last reference
+    ///   sees every write made by threads that held one.
     class Counter {
     public:
         /// @brief Default constructor.
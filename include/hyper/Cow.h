@@ -0,0 +1,139 @@
+/// @file Cow.h
+/// Value wrapper that shares copies until one is written to.
+
+#ifndef HYPER_COW_H
+#define HYPER_COW_H
+
+#include <cstddef>   // For size_t.
+#include "assert.h"
+#include "SharedPointer.h"
+#include "utility.h"
+
+namespace hyper {
+    /// @brief Copy-on-write value.
+    /// @details Copying a @c Cow shares the value instead of copying it, which costs one reference count increment.
+    ///   The value is only cloned when @ref write() is called while other copies still share it,
+    ///   so copies that are only read never pay for a clone.
+    ///   This suits configuration objects and large tables that are handed around defensively but rarely changed.
+    ///
+    ///   Different copies can be used from different threads, since they only share the value
+    ///   through a thread-safe reference count. A single @c Cow must not be written by one thread
+    ///   while another reads or copies it.
+    /// @tparam T Type of value held. Must be copy constructible.
+    template<typename T>
+    class Cow {
+    public:
+        /// @brief Default constructor.
+        /// @details Holds a default-constructed value.
+        Cow() noexcept
+                : _shared(new T()) {
+            // ...
+        }
+
+        /// @brief General constructor.
+        /// @param value Value to copy.
+        explicit Cow(const T &value) noexcept
+                : _shared(new T(value)) {
+            // ...
+        }
+
+        /// @brief General constructor.
+        /// @param value Value to move in.
+        explicit Cow(T &&value) noexcept
+                : _shared(new T(move(value))) {
+            // ...
+        }
+
+        /// @brief Copy constructor.
+        /// @details Shares the value of another instance without copying it.
+        /// @param other Instance to share with.
+        Cow(const Cow &other) noexcept
+                : _shared(other._shared) {
+            // ...
+        }
+
+        /// @brief Move constructor.
+        /// @details The moved-from instance may only be assigned to or destroyed.
+        /// @param other Instance to take the value from.
+        Cow(Cow &&other) noexcept
+                : _shared(move(other._shared)) {
+            // ...
+        }
+
+        /// @brief Reads the value.
+        /// @return Value, which may be shared with other copies.
+        const T &read() const noexcept {
+            ASSERTF(_shared.useCount() != 0, "Attempt to read a moved-from Cow");
+            return *_shared;
+        }
+
+        /// @brief Gets write access to the value.
+        /// @details Clones the value first if another copy shares it,
+        ///   so the change is only seen through this instance.
+        ///   The reference stays valid until this instance is copied, assigned or destroyed;
+        ///   writing through it after copying this instance would change the copy too.
+        /// @return Value that isn't shared with any other copy.
+        T &write() noexcept {
+            ASSERTF(_shared.useCount() != 0, "Attempt to write a moved-from Cow");
+            if(_shared.useCount() != 1)
+                _shared = SharedPointer<T>(new T(*_shared));
+            return *_shared;
+        }
+
+        /// @brief Checks whether the value is shared with other copies.
+        /// @return True if the next @ref write() will clone the value.
+        bool isShared() const noexcept {
+            return _shared.useCount() > 1;
+        }
+
+        /// @brief Retrieves the number of copies sharing the value.
+        /// @return Number of copies, including this one.
+        size_t useCount() const noexcept {
+            return _shared.useCount();
+        }
+
+        /// @brief Indirect access operator.
+        /// @details Same as @ref read().
+        /// @return Value, which may be shared with other copies.
+        const T &operator*() const noexcept {
+            return read();
+        }
+
+        /// @brief Member access operator.
+        /// @details Gives read-only access; use @ref write() to change the value.
+        /// @return Pointer to the value, which may be shared with other copies.
+        const T *operator->() const noexcept {
+            return &read();
+        }
+
+        /// @brief Assignment operator.
+        /// @details Shares the value of another instance, releasing this one's.
+        /// @param other Instance to share with.
+        /// @return This instance.
+        Cow &operator=(const Cow &other) noexcept {
+            if(this != &other)
+                _shared = other._shared;
+            return *this;
+        }
+
+        /// @brief Move assignment operator.
+        /// @details The moved-from instance may only be assigned to or destroyed.
+        /// @param other Instance to take the value from.
+        /// @return This instance.
+        Cow &operator=(Cow &&other) noexcept {
+            _shared = move(other._shared);
+            return *this;
+        }
+
+    private:
+        SharedPointer<T> _shared;
+    };
+
+    /// @brief Copy-on-write values are trivially relocatable, since they only hold a shared pointer.
+    /// @tparam T Type of value held.
+    template<typename T>
+    struct IsTriviallyRelocatable<Cow<T>> : BoolConstant<true> {
+    };
+}
+
+#endif // HYPER_COW_H
@@ -0,0 +1,89 @@
+/// @file CpuTopology.h
+/// Layout of the machine's processors.
+
+#ifndef HYPER_CPU_TOPOLOGY_H
+#define HYPER_CPU_TOPOLOGY_H
+
+#include <cstddef>   // For size_t.
+#include "integer.h"
+
+namespace hyper {
+    /// @brief Where a logical CPU sits in the machine.
+    /// @details Groups are numbered densely from zero, in order of their lowest-numbered logical CPU.
+    struct LogicalCpu {
+        /// @brief Index the operating system uses for the logical CPU.
+        uint32 id;
+
+        /// @brief Physical core the logical CPU runs on.
+        /// @details Logical CPUs on the same core are SMT siblings (hyper-threads) and share its execution units.
+        uint32 core;
+
+        /// @brief Group of logical CPUs that share a last-level (L3) cache.
+        uint32 cache;
+
+        /// @brief Processor package (socket) the logical CPU is in.
+        uint32 package;
+    };
+
+    /// @brief Describes the logical CPUs, physical cores, shared caches and packages of the machine.
+    /// @details The layout is read from @c /sys/devices/system/cpu when the object is created.
+    ///   If it can't be read, each online logical CPU is treated as its own core
+    ///   in a single cache domain and package.
+    ///
+    ///   This is used to place threads: one per physical core avoids SMT siblings competing for a core,
+    ///   and keeping threads that share data in one cache domain keeps that data in a shared cache.
+    class CpuTopology {
+    public:
+        /// @brief Default constructor.
+        /// @details Reads the topology of the current machine.
+        CpuTopology() noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        CpuTopology(const CpuTopology &other) = delete;
+
+        /// @brief Destructor.
+        ~CpuTopology() noexcept;
+
+        /// @brief Retrieves the number of online logical CPUs.
+        /// @return Number of logical CPUs.
+        size_t logicalCount() const noexcept;
+
+        /// @brief Retrieves a logical CPU.
+        /// @param index Index of the logical CPU, from zero to one less than @ref logicalCount().
+        ///   This is not necessarily the operating system's identifier for it.
+        /// @return Description of the logical CPU.
+        const LogicalCpu &logical(size_t index) const noexcept;
+
+        /// @brief Retrieves the number of physical cores.
+        /// @return Number of cores.
+        size_t coreCount() const noexcept;
+
+        /// @brief Retrieves the number of last-level cache domains.
+        /// @return Number of groups of logical CPUs that share a last-level cache.
+        size_t cacheCount() const noexcept;
+
+        /// @brief Retrieves the number of processor packages.
+        /// @return Number of packages.
+        size_t packageCount() const noexcept;
+
+        /// @brief Picks one logical CPU to represent a physical core.
+        /// @param core Index of the core, from zero to one less than @ref coreCount().
+        /// @return Operating system identifier of the lowest-numbered logical CPU on the core.
+        uint32 primaryCpu(size_t core) const noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        CpuTopology &operator=(const CpuTopology &other) = delete;
+
+    private:
+        LogicalCpu *_cpus;
+        size_t _count;
+        size_t _coreCount;
+        size_t _cacheCount;
+        size_t _packageCount;
+        uint32 *_primaries;
+    };
+}
+
+#endif // HYPER_CPU_TOPOLOGY_H
@@ -0,0 +1,160 @@
+/// @file Csv.h
+/// Fast reader for comma- and tab-separated values.
+
+#ifndef HYPER_CSV_H
+#define HYPER_CSV_H
+
+#include <cstddef>   // For size_t.
+#include "byte.h"
+#include "float.h"
+#include "integer.h"
+#include "parse.h"
+#include "WorkerPool.h"
+
+namespace hyper {
+    /// @brief View of one field of a record, pointing into the reader's input.
+    /// @details Quoted fields are given without their surrounding quotes,
+    ///   but a quote inside one is still written as two quotes. Use @ref unescape() to copy them out as one.
+    struct CsvField {
+        /// @brief First byte of the field.
+        const char *data;
+
+        /// @brief Number of bytes in the field.
+        size_t size;
+
+        /// @brief Whether the field was quoted.
+        bool quoted;
+
+        /// @brief Compares against a null-terminated string.
+        /// @details The field is compared as it is in the input, so doubled quotes are not collapsed.
+        /// @param text String to compare with.
+        /// @return True if both strings have the same bytes.
+        bool operator==(const char *text) const noexcept {
+            // Stop at the end of the string first, since the field may contain a null byte at the same position.
+            for(size_t i = 0; i < size; i++) {
+                if(text[i] == '\0' || text[i] != data[i])
+                    return false;
+            }
+            return text[size] == '\0';
+        }
+
+        /// @brief Copies the field, collapsing each pair of quotes in a quoted field into one quote.
+        /// @param[out] output Destination for the bytes, with room for at least @ref size bytes.
+        /// @return Number of bytes written.
+        size_t unescape(char *output) const noexcept;
+
+        /// @brief Converts the field to a signed integer, without allocating.
+        /// @param[out] value Set to the number. Not changed if the conversion fails.
+        /// @return True if the field is an integer that fits.
+        bool toInt64(int64 &value) const noexcept {
+            return parseInt64(data, size, value);
+        }
+
+        /// @brief Converts the field to an unsigned integer, without allocating.
+        /// @param[out] value Set to the number. Not changed if the conversion fails.
+        /// @return True if the field is a non-negative integer that fits.
+        bool toUInt64(uint64 &value) const noexcept {
+            return parseUInt64(data, size, value);
+        }
+
+        /// @brief Converts the field to a double, without allocating.
+        /// @param[out] value Set to the number. Not changed if the conversion fails.
+        /// @return True if the field is a number that fits.
+        bool toDouble(float64 &value) const noexcept {
+            return parseFloat64(data, size, value);
+        }
+    };
+
+    /// @brief Streaming reader that splits delimited text into records and fields.
+    /// @details Follows RFC 4180: fields are separated by a delimiter and records by newlines,
+    ///   with an optional carriage return before each newline. A field starting with a quote may contain
+    ///   delimiters, newlines and doubled quotes. Empty lines are skipped.
+    ///   Malformed quoting isn't rejected: a quote that is never closed runs to the end of the input.
+    ///
+    ///   The input is scanned in 64-byte blocks with the instruction set selected in simd.h,
+    ///   building bit masks of quotes, delimiters and newlines. A prefix XOR of the quote mask gives the
+    ///   bytes inside quotes, so finding the next separator is a count of trailing zeros rather than
+    ///   a loop over bytes. Fields point into the input, which must stay alive while they are used,
+    ///   and the input is never copied, so it can come straight from a mapped file.
+    ///
+    ///   Large inputs can be read in parallel by splitting them with @ref split()
+    ///   and giving each worker its own reader over one chunk.
+    class CsvReader {
+    public:
+        /// @brief General constructor.
+        /// @param data Text to read. Must stay alive while the reader and its fields are used.
+        /// @param size Number of bytes in @p data.
+        /// @param delimiter Byte between fields, such as a comma or a tab. Must not be a quote or a newline.
+        CsvReader(const byte *data, size_t size, char delimiter = ',') noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        CsvReader(const CsvReader &other) = delete;
+
+        /// @brief Destructor.
+        ~CsvReader() noexcept;
+
+        /// @brief Reads the next record.
+        /// @details Fields of the previous record are no longer valid afterward.
+        /// @return True if a record was read, false at the end of the input.
+        bool next() noexcept;
+
+        /// @brief Retrieves the number of fields in the current record.
+        /// @return Number of fields.
+        size_t fieldCount() const noexcept {
+            return _fieldCount;
+        }
+
+        /// @brief Accesses a field of the current record.
+        /// @param index Position of the field, counting from zero. Must be less than @ref fieldCount().
+        /// @return The field.
+        const CsvField &field(size_t index) const noexcept {
+            return _fields[index];
+        }
+
+        /// @brief Splits text into chunks that start at record boundaries, so they can be read in parallel.
+        /// @details Each worker first counts the quotes in an equal slice of the text.
+        ///   An exclusive prefix XOR of the counts' parities tells each slice whether it starts inside quotes,
+        ///   so each worker can then find the first newline outside quotes in its slice.
+        ///   Chunk @c i runs from @c boundaries[i] to @c boundaries[i + 1], and can be read by its own reader:
+        ///   @code
+        ///   pool.run(Function<void(size_t)>([&](size_t worker) {
+        ///       CsvReader reader(data + boundaries[worker], boundaries[worker + 1] - boundaries[worker]);
+        ///       while(reader.next())
+        ///           process(reader);
+        ///   }));
+        ///   @endcode
+        ///   A chunk is empty when a record spans its whole slice.
+        ///   A pool whose workers all failed to start has none to split with,
+        ///   so the text is left as a single chunk for the caller to read itself.
+        /// @param pool Workers to count and search with. The text is split into one chunk per worker.
+        /// @param data Text to split.
+        /// @param size Number of bytes in @p data.
+        /// @param[out] boundaries Destination for the chunk boundaries, with room for @c pool.size() + 1 offsets,
+        ///   or two if the pool has no workers.
+        ///   The first is zero and the last is @p size.
+        static void split(WorkerPool &pool, const byte *data, size_t size, size_t *boundaries) noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        CsvReader &operator=(const CsvReader &other) = delete;
+
+    private:
+        void load() noexcept;
+        void addField(size_t start, size_t end, bool lineEnd) noexcept;
+
+        const byte *_data;
+        size_t _size;
+        char _delimiter;
+        size_t _block;
+        size_t _next;
+        uint64 _separators;
+        uint64 _quoteCarry;
+        size_t _fieldStart;
+        CsvField *_fields;
+        size_t _fieldCount;
+        size_t _fieldCapacity;
+    };
+}
+
+#endif // HYPER_CSV_H
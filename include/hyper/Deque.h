@@ -0,0 +1,332 @@
+/// @file Deque.h
+/// Double-ended queue stored in fixed-size blocks.
+
+#ifndef HYPER_DEQUE_H
+#define HYPER_DEQUE_H
+
+#include <cstddef>   // For size_t.
+#include <new>       // For placement new.
+#include "assert.h"
+#include "utility.h"
+
+namespace hyper {
+    /// @brief Sequence that grows and shrinks at both ends without moving its elements.
+    /// @details Elements are stored in blocks of a fixed, power-of-two number of elements,
+    ///   and a ring of block pointers keeps the blocks in order.
+    ///   Pushing or popping at either end is O(1) and never moves an existing element,
+    ///   so pointers to elements stay valid until those elements are removed.
+    ///   Indexing is O(1): a shift and a mask find the block and the position within it.
+    ///
+    ///   One emptied block is kept spare, so a deque used as a queue
+    ///   doesn't allocate every time it crosses a block boundary.
+    /// @tparam T Type of element stored.
+    template<typename T>
+    class Deque {
+    public:
+        /// @brief Number of elements in each block.
+        /// @details Blocks are about 512 bytes, with at least 16 elements each.
+        static constexpr size_t blockSize = []() {
+            size_t size = 16;
+            while(size * 2 * sizeof(T) <= 512)
+                size *= 2;
+            return size;
+        }();
+
+        /// @brief Iterator over the elements from front to back.
+        /// @tparam Element Type of element referenced, const for read-only iteration.
+        /// @tparam Owner Type of deque iterated over, const for read-only iteration.
+        template<typename Element, typename Owner>
+        class Iterator {
+        public:
+            /// @brief General constructor.
+            /// @param deque Deque to iterate over.
+            /// @param index Index of the element to start at.
+            Iterator(Owner *deque, size_t index) noexcept
+                    : _deque(deque), _index(index) {
+                // ...
+            }
+
+            /// @brief Accesses the current element.
+            /// @return Current element.
+            Element &operator*() const noexcept {
+                return (*_deque)[_index];
+            }
+
+            /// @brief Accesses the current element.
+            /// @return Pointer to the current element.
+            Element *operator->() const noexcept {
+                return &(*_deque)[_index];
+            }
+
+            /// @brief Moves to the next element.
+            /// @return This iterator.
+            Iterator &operator++() noexcept {
+                _index++;
+                return *this;
+            }
+
+            /// @brief Compares two iterators.
+            /// @param other Iterator to compare against.
+            /// @return True if the iterators are at different positions.
+            bool operator!=(const Iterator &other) const noexcept {
+                return _index != other._index;
+            }
+
+        private:
+            Owner *_deque;
+            size_t _index;
+        };
+
+        /// @brief Default constructor.
+        /// @details Creates an empty deque without allocating.
+        Deque() noexcept
+                : _blocks(nullptr), _ringCapacity(0), _firstBlock(0), _blockCount(0),
+                  _offset(0), _size(0), _spare(nullptr) {
+            // ...
+        }
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        Deque(const Deque &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Destroys the remaining elements.
+        ~Deque() noexcept {
+            clear();
+            ::operator delete(_spare);
+            delete[] _blocks;
+        }
+
+        /// @brief Adds an element to the back.
+        /// @param element Element to copy into the deque.
+        /// @return Added element.
+        T &pushBack(const T &element) noexcept {
+            T copy(element);
+            return pushBack(move(copy));
+        }
+
+        /// @brief Adds an element to the back.
+        /// @param element Element to move into the deque.
+        /// @return Added element.
+        T &pushBack(T &&element) noexcept {
+            if(_offset + _size == _blockCount * blockSize)
+                addBlock(false);
+            auto slot = &block(_offset + _size)[(_offset + _size) & (blockSize - 1)];
+            new(slot) T(move(element));
+            _size++;
+            return *slot;
+        }
+
+        /// @brief Adds an element to the front.
+        /// @param element Element to copy into the deque.
+        /// @return Added element.
+        T &pushFront(const T &element) noexcept {
+            T copy(element);
+            return pushFront(move(copy));
+        }
+
+        /// @brief Adds an element to the front.
+        /// @param element Element to move into the deque.
+        /// @return Added element.
+        T &pushFront(T &&element) noexcept {
+            if(_offset == 0) {
+                addBlock(true);
+                _offset = blockSize;
+            }
+            _offset--;
+            auto slot = &block(_offset)[_offset];
+            new(slot) T(move(element));
+            _size++;
+            return *slot;
+        }
+
+        /// @brief Removes the element at the back.
+        /// @details The deque is asserted to not be empty.
+        /// @return Removed element.
+        T popBack() noexcept {
+            ASSERTF(_size > 0, "Attempt to pop from an empty deque");
+            auto &last = (*this)[_size - 1];
+            T result(move(last));
+            last.~T();
+            _size--;
+            // Release the last block once nothing is left in it.
+            if(_offset + _size <= (_blockCount - 1) * blockSize)
+                removeBlock(false);
+            return result;
+        }
+
+        /// @brief Removes the element at the front.
+        /// @details The deque is asserted to not be empty.
+        /// @return Removed element.
+        T popFront() noexcept {
+            ASSERTF(_size > 0, "Attempt to pop from an empty deque");
+            auto &first = (*this)[0];
+            T result(move(first));
+            first.~T();
+            _size--;
+            if(++_offset == blockSize) {
+                removeBlock(true);
+                _offset = 0;
+            }
+            return result;
+        }
+
+        /// @brief Retrieves the element at the front.
+        /// @details The deque is asserted to not be empty.
+        /// @return First element.
+        T &front() noexcept {
+            ASSERTF(_size > 0, "Attempt to access the front of an empty deque");
+            return (*this)[0];
+        }
+
+        /// @copydoc front()
+        const T &front() const noexcept {
+            ASSERTF(_size > 0, "Attempt to access the front of an empty deque");
+            return (*this)[0];
+        }
+
+        /// @brief Retrieves the element at the back.
+        /// @details The deque is asserted to not be empty.
+        /// @return Last element.
+        T &back() noexcept {
+            ASSERTF(_size > 0, "Attempt to access the back of an empty deque");
+            return (*this)[_size - 1];
+        }
+
+        /// @copydoc back()
+        const T &back() const noexcept {
+            ASSERTF(_size > 0, "Attempt to access the back of an empty deque");
+            return (*this)[_size - 1];
+        }
+
+        /// @brief Retrieves the number of elements.
+        /// @return Number of elements in the deque.
+        size_t size() const noexcept {
+            return _size;
+        }
+
+        /// @brief Checks whether the deque has no elements.
+        /// @return True if the deque is empty.
+        bool isEmpty() const noexcept {
+            return _size == 0;
+        }
+
+        /// @brief Removes every element.
+        /// @details Blocks are released, except for one kept spare.
+        void clear() noexcept {
+            if constexpr(IsTriviallyDestructible<T>::value)
+                _size = 0;
+            for(; _size > 0; _size--)
+                (*this)[_size - 1].~T();
+            while(_blockCount > 0)
+                removeBlock(false);
+            _offset = 0;
+        }
+
+        /// @brief Retrieves the first iterator.
+        /// @return Iterator at the front.
+        Iterator<T, Deque> begin() noexcept {
+            return Iterator<T, Deque>(this, 0);
+        }
+
+        /// @brief Retrieves the end iterator.
+        /// @return Iterator past the back.
+        Iterator<T, Deque> end() noexcept {
+            return Iterator<T, Deque>(this, _size);
+        }
+
+        /// @copydoc begin()
+        Iterator<const T, const Deque> begin() const noexcept {
+            return Iterator<const T, const Deque>(this, 0);
+        }
+
+        /// @copydoc end()
+        Iterator<const T, const Deque> end() const noexcept {
+            return Iterator<const T, const Deque>(this, _size);
+        }
+
+        /// @brief Retrieves an element by index.
+        /// @param index Index of the element, counting from the front.
+        /// @return Element at the index.
+        T &operator[](size_t index) noexcept {
+            ASSERTF(index < _size, "Deque index %zu out of range", index);
+            const auto position = _offset + index;
+            return block(position)[position & (blockSize - 1)];
+        }
+
+        /// @copydoc operator[]()
+        const T &operator[](size_t index) const noexcept {
+            ASSERTF(index < _size, "Deque index %zu out of range", index);
+            const auto position = _offset + index;
+            return block(position)[position & (blockSize - 1)];
+        }
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        Deque &operator=(const Deque &other) = delete;
+
+    private:
+        static constexpr size_t blockShift = []() {
+            size_t shift = 0;
+            while((size_t(1) << shift) < blockSize)
+                shift++;
+            return shift;
+        }();
+
+        // Ring of block pointers. Block i of the deque is at (_firstBlock + i) modulo the ring's capacity.
+        T **_blocks;
+        size_t _ringCapacity;
+        size_t _firstBlock;
+        size_t _blockCount;
+        // Position of the front element within the first block.
+        size_t _offset;
+        size_t _size;
+        T *_spare;
+
+        T *block(size_t position) const noexcept {
+            return _blocks[(_firstBlock + (position >> blockShift)) & (_ringCapacity - 1)];
+        }
+
+        void addBlock(bool atFront) noexcept {
+            if(_blockCount == _ringCapacity) {
+                // Unroll the ring into a larger one. Only block pointers move, never elements.
+                const auto capacity = _ringCapacity == 0 ? 8 : _ringCapacity * 2;
+                const auto blocks = new T *[capacity];
+                for(size_t i = 0; i < _blockCount; i++)
+                    blocks[i] = _blocks[(_firstBlock + i) & (_ringCapacity - 1)];
+                delete[] _blocks;
+                _blocks = blocks;
+                _ringCapacity = capacity;
+                _firstBlock = 0;
+            }
+            T *block = _spare;
+            _spare = nullptr;
+            if(block == nullptr)
+                block = static_cast<T *>(::operator new(blockSize * sizeof(T)));
+            if(atFront) {
+                _firstBlock = (_firstBlock + _ringCapacity - 1) & (_ringCapacity - 1);
+                _blocks[_firstBlock] = block;
+            } else {
+                _blocks[(_firstBlock + _blockCount) & (_ringCapacity - 1)] = block;
+            }
+            _blockCount++;
+        }
+
+        void removeBlock(bool atFront) noexcept {
+            T *block;
+            if(atFront) {
+                block = _blocks[_firstBlock];
+                _firstBlock = (_firstBlock + 1) & (_ringCapacity - 1);
+            } else {
+                block = _blocks[(_firstBlock + _blockCount - 1) & (_ringCapacity - 1)];
+            }
+            _blockCount--;
+            if(_spare == nullptr)
+                _spare = block;
+            else
+                ::operator delete(block);
+        }
+    };
+}
+
+#endif // HYPER_DEQUE_H
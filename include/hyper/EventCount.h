@@ -0,0 +1,73 @@
+/// @file EventCount.h
+/// Lets threads sleep until a lock-free data structure changes.
+
+#ifndef HYPER_EVENT_COUNT_H
+#define HYPER_EVENT_COUNT_H
+
+#include "integer.h"
+
+namespace hyper {
+    /// @brief Condition variable for lock-free data structures.
+    /// @details A lock-free queue has no mutex to pair with a condition variable,
+    ///   so a consumer that finds it empty has nowhere to sleep. An event count fills that gap
+    ///   without putting a lock on the fast path:
+    ///   @code
+    ///   while(!queue.tryPop(item)) {
+    ///       const auto key = events.prepareWait();
+    ///       if(queue.tryPop(item)) {
+    ///           events.cancelWait();
+    ///           break;
+    ///       }
+    ///       events.wait(key);
+    ///   }
+    ///   @endcode
+    ///   and the producer calls @ref notify() after each push.
+    ///   A notification that comes between @ref prepareWait() and @ref wait() is not lost.
+    ///   Notifying is a fence and a load when no thread is waiting.
+    class EventCount {
+    public:
+        /// @brief Token from @ref prepareWait() for @ref wait().
+        using Key = uint32;
+
+        /// @brief Default constructor.
+        EventCount() noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        EventCount(const EventCount &other) = delete;
+
+        /// @brief Announces that the current thread is about to wait.
+        /// @details After calling this, the thread must check its condition again,
+        ///   then call either @ref wait() or @ref cancelWait().
+        /// @return Key to pass to @ref wait().
+        Key prepareWait() noexcept;
+
+        /// @brief Withdraws from waiting after @ref prepareWait(), because the condition was met.
+        void cancelWait() noexcept;
+
+        /// @brief Sleeps until a notification arrives after @ref prepareWait().
+        /// @details Returns immediately if one has already arrived.
+        /// @param key Value returned by @ref prepareWait().
+        void wait(Key key) noexcept;
+
+        /// @brief Wakes one waiting thread.
+        /// @details Call this after making the change that waiting threads are looking for.
+        void notify() noexcept;
+
+        /// @brief Wakes every waiting thread.
+        /// @details Call this after making the change that waiting threads are looking for.
+        void notifyAll() noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        EventCount &operator=(const EventCount &other) = delete;
+
+    private:
+        uint32 _epoch;
+        uint32 _waiters;
+
+        bool advance() noexcept;
+    };
+}
+
+#endif // HYPER_EVENT_COUNT_H
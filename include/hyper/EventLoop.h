@@ -0,0 +1,165 @@
+/// @file EventLoop.h
+/// Single-threaded scheduler for coroutine tasks.
+
+#ifndef HYPER_EVENT_LOOP_H
+#define HYPER_EVENT_LOOP_H
+
+#include <coroutine>   // Compiler support for coroutines is declared in the std namespace.
+#include <cstddef>     // For size_t.
+#include "integer.h"
+#include "Result.h"
+#include "Task.h"
+
+namespace hyper {
+    /// @brief Runs coroutine tasks on the current thread.
+    /// @details Tasks are started with @ref spawn() and suspend by awaiting the loop's awaitables:
+    ///   @ref yield() to let other tasks run, @ref sleep() to wait for a duration,
+    ///   and @ref readable() or @ref writable() to wait for a file descriptor.
+    ///   @ref run() resumes tasks as they become ready until none are left.
+    ///
+    ///   Timers are kept in a heap ordered by deadline, and file descriptors are waited on with @c poll(),
+    ///   which also sleeps until the next timer is due.
+    ///   The loop is not thread-safe; each thread that runs tasks needs its own loop.
+    class EventLoop {
+    public:
+        /// @brief Awaitable that resumes the awaiting coroutine later.
+        class ScheduleAwaiter {
+        public:
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) const noexcept;
+
+            void await_resume() const noexcept {
+                // ...
+            }
+
+        private:
+            friend class EventLoop;
+
+            EventLoop *_loop;
+            uint64 _deadline;
+
+            ScheduleAwaiter(EventLoop *loop, uint64 deadline) noexcept;
+        };
+
+        /// @brief Awaitable that resumes the awaiting coroutine when a file descriptor is ready.
+        class IoAwaiter {
+        public:
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) noexcept;
+
+            Result<void> await_resume() const noexcept;
+
+        private:
+            friend class EventLoop;
+
+            EventLoop *_loop;
+            int _fd;
+            short _events;
+            short _returnedEvents;
+
+            IoAwaiter(EventLoop *loop, int fd, short events) noexcept;
+        };
+
+        /// @brief Default constructor.
+        /// @details Creates a loop with no tasks.
+        EventLoop() noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        EventLoop(const EventLoop &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Spawned tasks that haven't finished are destroyed without being resumed again,
+        ///   along with any tasks they are awaiting.
+        ~EventLoop() noexcept;
+
+        /// @brief Starts a task.
+        /// @details The task is scheduled to run by @ref run() and frees itself when it finishes.
+        /// @param task Task to start. It must hold a coroutine, so it can't be default constructed or moved from.
+        void spawn(Task<void> &&task) noexcept;
+
+        /// @brief Schedules a suspended coroutine to be resumed by @ref run().
+        /// @param handle Coroutine to resume.
+        void schedule(std::coroutine_handle<> handle) noexcept;
+
+        /// @brief Lets other ready tasks run before continuing.
+        /// @return Awaitable that resumes the awaiting coroutine on the next pass of the loop.
+        ScheduleAwaiter yield() noexcept;
+
+        /// @brief Waits for a duration.
+        /// @param nanoseconds Minimum time to wait, in nanoseconds.
+        /// @return Awaitable that resumes the awaiting coroutine once the time has passed.
+        ScheduleAwaiter sleep(uint64 nanoseconds) noexcept;
+
+        /// @brief Waits until a file descriptor has data to read.
+        /// @param fd File descriptor to wait on.
+        /// @return Awaitable that resumes the awaiting coroutine once the descriptor is readable,
+        ///   giving an error if the descriptor is invalid or failed.
+        IoAwaiter readable(int fd) noexcept;
+
+        /// @brief Waits until a file descriptor can be written to.
+        /// @param fd File descriptor to wait on.
+        /// @return Awaitable that resumes the awaiting coroutine once the descriptor is writable,
+        ///   giving an error if the descriptor is invalid or failed.
+        IoAwaiter writable(int fd) noexcept;
+
+        /// @brief Runs tasks until none are left.
+        /// @details Returns once no task is ready, sleeping or waiting on a file descriptor.
+        void run() noexcept;
+
+        /// @brief Runs the tasks that are ready now.
+        /// @details Due timers and ready file descriptors are checked first.
+        /// @param wait Whether to wait for a timer or file descriptor if no task is ready.
+        /// @return True if there are still tasks in the loop.
+        /// @return False if every task has finished.
+        bool runOnce(bool wait = false) noexcept;
+
+        /// @brief Reads the monotonic clock used for timers.
+        /// @return Current time in nanoseconds from an arbitrary starting point.
+        static uint64 now() noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        EventLoop &operator=(const EventLoop &other) = delete;
+
+    private:
+        struct Timer {
+            uint64 deadline = 0;
+            uint64 sequence = 0;
+            std::coroutine_handle<> handle = nullptr;
+        };
+
+        struct Waiter {
+            IoAwaiter *awaiter = nullptr;
+            std::coroutine_handle<> handle = nullptr;
+        };
+
+        std::coroutine_handle<> *_ready;
+        size_t _readyHead;
+        size_t _readyCount;
+        size_t _readyCapacity;
+        Timer *_timers;
+        size_t _timerCount;
+        size_t _timerCapacity;
+        uint64 _timerSequence;
+        Waiter *_waiters;
+        size_t _waiterCount;
+        size_t _waiterCapacity;
+        void *_pollBuffer;
+        detail::TaskPromiseBase *_spawned;
+
+        void addTimer(uint64 deadline, std::coroutine_handle<> handle) noexcept;
+
+        void addWaiter(IoAwaiter *awaiter, std::coroutine_handle<> handle) noexcept;
+
+        void pollWaiters(int timeout) noexcept;
+    };
+}
+
+#endif // HYPER_EVENT_LOOP_H
@@ -67,7 +67,10 @@ namespace hyper {
     public:
         /// @brief Default constructor.
         /// @details Creates a function that references null.
-        Function() = default;
+        Function()
+                : _callable() {
+            // ...
+        }
 
         /// @brief Copy constructor.
         /// @param other Existing function to copy from.
@@ -79,7 +82,7 @@ namespace hyper {
         /// @brief Move constructor.
         /// @param other Existing function to take ownership of.
         Function(Function &&other) noexcept
-                : _callable(other._callable) {
+                : _callable(move(other._callable)) {
             // ...
         }
 
@@ -104,7 +107,7 @@ namespace hyper {
         /// @param other Existing function to take ownership of.
         /// @return Reference to this instance after it has been updated.
         Function &operator=(Function &&other) noexcept {
-            _callable = other._callable;
+            _callable = move(other._callable);
             return *this;
         }
 
@@ -157,6 +160,14 @@ namespace hyper {
             return (bool)_callable;
         }
     };
+
+    /// @brief Functions are trivially relocatable.
+    /// @details A function only holds a shared pointer to its callable, which is itself trivially relocatable.
+    /// @tparam ReturnValue Type of the return value of the function.
+    /// @tparam Args Types for the arguments the function expects when called.
+    template<typename ReturnValue, typename... Args>
+    struct IsTriviallyRelocatable<Function<ReturnValue(Args...)>> : BoolConstant<true> {
+    };
 }
 
 #endif // HYPER_FUNCTION_H
\ No newline at end of file
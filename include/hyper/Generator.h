@@ -0,0 +1,178 @@
+/// @file Generator.h
+/// Coroutines that produce a sequence of values on demand.
+
+#ifndef HYPER_GENERATOR_H
+#define HYPER_GENERATOR_H
+
+#include <coroutine>   // Compiler support for coroutines is declared in the std namespace.
+#include "assert.h"
+#include "Task.h"      // For the pooled frame allocator.
+#include "utility.h"
+
+namespace hyper {
+    /// @brief Coroutine that produces a sequence of values on demand.
+    /// @details A generator is a coroutine function that returns @c Generator<T> and produces values
+    ///   with @c co_yield. Each call to @ref next() runs the coroutine until it yields the next value,
+    ///   so values are only computed as they are consumed, and the sequence may be endless.
+    ///   Generators can also be used in range-based for loops.
+    ///
+    ///   Yielded values are not copied; @ref value() refers to the yielded object,
+    ///   which stays valid until the generator is resumed.
+    ///   Coroutine frames are allocated from a per-thread pool.
+    /// @tparam T Type of value produced.
+    template<typename T>
+    class Generator {
+    public:
+        /// @brief Promise type used by the compiler to build the coroutine.
+        struct promise_type : detail::PooledPromise {
+            const T *current = nullptr;
+
+            Generator get_return_object() noexcept {
+                return Generator(Handle::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() const noexcept {
+                return {};
+            }
+
+            std::suspend_always final_suspend() const noexcept {
+                return {};
+            }
+
+            std::suspend_always yield_value(const T &value) noexcept {
+                current = &value;
+                return {};
+            }
+
+            void return_void() const noexcept {
+                // ...
+            }
+        };
+
+        /// @brief Marks the end of the sequence in range-based for loops.
+        struct Sentinel {
+            // ...
+        };
+
+        /// @brief Walks the values of a generator in range-based for loops.
+        class Iterator {
+        public:
+            /// @brief General constructor.
+            /// @param generator Generator to walk.
+            explicit Iterator(Generator *generator) noexcept
+                    : _generator(generator) {
+                // ...
+            }
+
+            /// @brief Indirect access operator.
+            /// @return Current value.
+            const T &operator*() const noexcept {
+                return _generator->value();
+            }
+
+            /// @brief Pre-increment operator.
+            /// @details Moves on to the next value.
+            /// @return Updated iterator.
+            Iterator &operator++() noexcept {
+                _generator->next();
+                return *this;
+            }
+
+            /// @brief Checks if the iterator has reached the end of the sequence.
+            /// @return True if there are no more values.
+            bool operator==(Sentinel) const noexcept {
+                return _generator->isDone();
+            }
+
+        private:
+            Generator *_generator;
+        };
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        Generator(const Generator &other) = delete;
+
+        /// @brief Move constructor.
+        /// @details Takes ownership of an existing generator.
+        /// @param other Existing generator to take ownership of.
+        Generator(Generator &&other) noexcept
+                : _handle(other._handle) {
+            other._handle = nullptr;
+        }
+
+        /// @brief Destructor.
+        /// @details Destroys the coroutine, even if it hasn't finished.
+        ~Generator() noexcept {
+            if(_handle)
+                _handle.destroy();
+        }
+
+        /// @brief Runs the coroutine until it produces its next value.
+        /// @return True if a value was produced.
+        /// @return False if the coroutine has finished.
+        bool next() noexcept {
+            if(!_handle || _handle.done())
+                return false;
+            _handle.resume();
+            return !_handle.done();
+        }
+
+        /// @brief Retrieves the most recently produced value.
+        /// @details @ref next() must have returned true.
+        /// @return Value produced by the coroutine.
+        const T &value() const noexcept {
+            ASSERTF(_handle && !_handle.done() && _handle.promise().current != nullptr,
+                    "Generator has no current value");
+            return *_handle.promise().current;
+        }
+
+        /// @brief Checks whether the coroutine has finished.
+        /// @return True if there are no more values.
+        bool isDone() const noexcept {
+            return !_handle || _handle.done();
+        }
+
+        /// @brief Starts a range-based for loop.
+        /// @details Produces the first value.
+        /// @return Iterator at the first value.
+        Iterator begin() noexcept {
+            next();
+            return Iterator(this);
+        }
+
+        /// @brief Ends a range-based for loop.
+        /// @return Sentinel marking the end of the sequence.
+        Sentinel end() const noexcept {
+            return {};
+        }
+
+        /// @brief Move assignment operator.
+        /// @param other Existing generator to take ownership of.
+        /// @return Reference to this instance after it has been updated.
+        Generator &operator=(Generator &&other) noexcept {
+            if(this != &other) {
+                if(_handle)
+                    _handle.destroy();
+                _handle = other._handle;
+                other._handle = nullptr;
+            }
+            return *this;
+        }
+
+        /// @brief Assignment operator.
+        /// @details Copy assignment is deleted.
+        Generator &operator=(const Generator &other) = delete;
+
+    private:
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Handle _handle;
+
+        explicit Generator(Handle handle) noexcept
+                : _handle(handle) {
+            // ...
+        }
+    };
+}
+
+#endif // HYPER_GENERATOR_H
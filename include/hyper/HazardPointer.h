@@ -0,0 +1,177 @@
+/// @file HazardPointer.h
+/// Safe memory reclamation for lock-free data structures.
+
+#ifndef HYPER_HAZARD_POINTER_H
+#define HYPER_HAZARD_POINTER_H
+
+#include <cstddef>   // For size_t.
+#include "DefaultDeleter.h"
+#include "ThreadLocal.h"
+
+namespace hyper {
+    namespace detail {
+        /// @brief Whether the process can force a memory barrier on every other thread.
+        /// @details When it can, readers publishing a hazard only need to stop the compiler reordering,
+        ///   and the domain pays for a full barrier on every thread when it scans.
+        ///   Otherwise readers issue a full barrier themselves.
+        extern bool hazardAsymmetricFence;
+
+        /// @brief Orders a hazard store before the reads that follow it.
+        inline void hazardLightFence() noexcept {
+            if(hazardAsymmetricFence) [[likely]]
+                __atomic_signal_fence(__ATOMIC_SEQ_CST);
+            else
+                __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        }
+
+        /// @brief Hazard slots and retired objects belonging to one thread.
+        struct HazardRecord;
+    }
+
+    /// @brief Tracks which objects threads are reading and frees retired objects once none are.
+    /// @details A lock-free structure can't free a node the moment it unlinks it,
+    ///   because another thread may have loaded a pointer to it just before.
+    ///   With hazard pointers, each reader publishes the pointer it is about to use in a @ref HazardPointer,
+    ///   and a writer hands unlinked nodes to @ref retire() instead of deleting them.
+    ///   Once enough nodes have been retired, the domain scans every published hazard
+    ///   and frees the retired nodes that no thread is protecting.
+    ///
+    ///   Unlike epoch-based reclamation, a slow or stalled reader only holds back the few nodes it protects,
+    ///   so the memory waiting to be freed stays bounded: at most the scan threshold per thread,
+    ///   plus one node per hazard slot.
+    ///
+    ///   Protecting a pointer costs a plain store and a compiler barrier on Linux,
+    ///   where the scan uses @c membarrier() to force the matching barrier on the readers.
+    ///   Scans sort the hazards once, so checking each retired node is a binary search.
+    class HazardDomain {
+    public:
+        /// @brief Number of hazard pointers each thread can hold at once.
+        static constexpr size_t slotsPerThread = 4;
+
+        /// @brief Default constructor.
+        HazardDomain() noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        HazardDomain(const HazardDomain &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Frees every retired object. No thread may still be using the domain.
+        ~HazardDomain() noexcept;
+
+        /// @brief Hands over an object to be freed once no thread is protecting it.
+        /// @details The object must already be unreachable from the data structure,
+        ///   so no thread can newly protect it.
+        /// @param object Object to free.
+        /// @tparam T Type of object.
+        /// @tparam Deleter Strategy used to free the object.
+        template<typename T, typename Deleter = DefaultDeleter<T>>
+        void retire(T *object) noexcept {
+            retire(object, [](void *pointer) noexcept {
+                auto instance = static_cast<T *>(pointer);
+                Deleter deleter;
+                deleter(instance);
+            });
+        }
+
+        /// @brief Frees every retired object that no thread is protecting.
+        /// @details This happens automatically as objects are retired,
+        ///   but can be called to release memory sooner.
+        /// @return Number of objects freed.
+        size_t reclaim() noexcept;
+
+        /// @brief Retrieves the number of objects waiting to be freed.
+        /// @details Only counts objects retired by threads currently using the domain, and may be out of date.
+        /// @return Number of retired objects not yet freed.
+        size_t retiredCount() const noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        HazardDomain &operator=(const HazardDomain &other) = delete;
+
+    private:
+        friend class HazardPointer;
+
+        struct Binding {
+            HazardDomain *domain;
+            detail::HazardRecord *record;
+
+            ~Binding() noexcept;
+        };
+
+        detail::HazardRecord *_records;
+        ThreadLocal<Binding> *_bindings;
+
+        detail::HazardRecord *threadRecord() noexcept;
+
+        void retire(void *object, void (*reclaim)(void *) noexcept) noexcept;
+
+        size_t scan(detail::HazardRecord &record) noexcept;
+    };
+
+    /// @brief Hazard slot that keeps one object from being freed while the current thread reads it.
+    /// @details Create one on the stack around each read:
+    ///   @code
+    ///   HazardPointer hazard(domain);
+    ///   auto node = hazard.protect(list.head);
+    ///   // node can't be freed until hazard is cleared or destroyed.
+    ///   @endcode
+    ///   A thread can hold up to @ref HazardDomain::slotsPerThread of these at once.
+    class HazardPointer {
+    public:
+        /// @brief General constructor.
+        /// @details Takes a free hazard slot from the current thread.
+        /// @param domain Domain that objects read through this are retired to.
+        explicit HazardPointer(HazardDomain &domain) noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        HazardPointer(const HazardPointer &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Clears the hazard and gives the slot back.
+        ~HazardPointer() noexcept;
+
+        /// @brief Loads a shared pointer and protects the object it points to.
+        /// @details The pointer is loaded again after publishing it, and the loop repeats until the two agree,
+        ///   so the object can't have been retired in between.
+        /// @param source Shared location to load the pointer from.
+        /// @return Protected pointer, which may be null.
+        /// @tparam T Type of object.
+        template<typename T>
+        T *protect(T *const &source) noexcept {
+            auto pointer = __atomic_load_n(&source, __ATOMIC_RELAXED);
+            while(true) {
+                __atomic_store_n(_slot, static_cast<void *>(pointer), __ATOMIC_RELAXED);
+                detail::hazardLightFence();
+                const auto current = __atomic_load_n(&source, __ATOMIC_ACQUIRE);
+                if(current == pointer)
+                    return pointer;
+                pointer = current;
+            }
+        }
+
+        /// @brief Protects a pointer that is already known to be safe.
+        /// @details Use this to hand protection over from another hazard pointer.
+        /// @param pointer Pointer to protect.
+        void reset(const void *pointer) noexcept {
+            __atomic_store_n(_slot, const_cast<void *>(pointer), __ATOMIC_RELAXED);
+            detail::hazardLightFence();
+        }
+
+        /// @brief Stops protecting the current object.
+        void clear() noexcept {
+            __atomic_store_n(_slot, nullptr, __ATOMIC_RELEASE);
+        }
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        HazardPointer &operator=(const HazardPointer &other) = delete;
+
+    private:
+        detail::HazardRecord *_record;
+        void **_slot;
+    };
+}
+
+#endif // HYPER_HAZARD_POINTER_H
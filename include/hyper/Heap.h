@@ -0,0 +1,169 @@
+/// @file Heap.h
+/// Priority queue stored in a contiguous array.
+
+#ifndef HYPER_HEAP_H
+#define HYPER_HEAP_H
+
+#include <cstddef>   // For size_t.
+#include <new>       // For placement new.
+#include "assert.h"
+#include "utility.h"
+
+namespace hyper {
+    namespace detail {
+        /// @brief Compares values with @c operator<.
+        /// @tparam T Type of value to compare.
+        template<typename T>
+        struct DefaultLess {
+            constexpr bool operator()(const T &first, const T &second) const {
+                return first < second;
+            }
+        };
+
+        /// @brief Number of children each node has in the array-based heaps.
+        /// @details Four children per node halves the depth of a binary heap.
+        ///   The extra comparisons per level are against neighboring elements,
+        ///   which usually share a cache line, so sifting touches fewer lines overall.
+        constexpr size_t heapArity = 4;
+    }
+
+    /// @brief Priority queue that gives the smallest element first.
+    /// @details Elements are kept in an implicit 4-ary heap in one contiguous array.
+    ///   Pushing and popping are O(log n), and finding the smallest element is O(1).
+    /// @tparam T Type of element stored.
+    /// @tparam Less Type of callable that takes two elements and returns true if the first is smaller.
+    template<typename T, typename Less = detail::DefaultLess<T>>
+    class Heap {
+    public:
+        /// @brief Default constructor.
+        /// @details Creates an empty heap.
+        /// @param less Comparison used to order elements.
+        explicit Heap(Less less = Less()) noexcept
+                : _elements(nullptr), _size(0), _capacity(0), _less(less) {
+            // ...
+        }
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        Heap(const Heap &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Destroys the remaining elements.
+        ~Heap() noexcept {
+            clear();
+            ::operator delete(_elements);
+        }
+
+        /// @brief Adds an element.
+        /// @param element Element to copy into the heap.
+        void push(const T &element) noexcept {
+            T copy(element);
+            push(move(copy));
+        }
+
+        /// @brief Adds an element.
+        /// @param element Element to move into the heap.
+        void push(T &&element) noexcept {
+            if(_size == _capacity)
+                reserve(_capacity == 0 ? 16 : _capacity * 2);
+            new(&_elements[_size]) T(move(element));
+            size_t index = _size++;
+            if(index == 0)
+                return;
+            // Sift the new element up, moving larger parents down into the hole.
+            T value(move(_elements[index]));
+            while(index > 0) {
+                const size_t parent = (index - 1) / detail::heapArity;
+                if(!_less(value, _elements[parent]))
+                    break;
+                _elements[index] = move(_elements[parent]);
+                index = parent;
+            }
+            _elements[index] = move(value);
+        }
+
+        /// @brief Retrieves the smallest element.
+        /// @details The heap is asserted to not be empty.
+        /// @return Smallest element.
+        const T &top() const noexcept {
+            ASSERTF(_size > 0, "Attempt to access the top of an empty heap");
+            return _elements[0];
+        }
+
+        /// @brief Removes the smallest element.
+        /// @details The heap is asserted to not be empty.
+        /// @return Smallest element, which is no longer in the heap.
+        T pop() noexcept {
+            ASSERTF(_size > 0, "Attempt to pop from an empty heap");
+            T result(move(_elements[0]));
+            _size--;
+            if(_size > 0) {
+                // Sift the last element down from the root, moving smaller children up into the hole.
+                T last(move(_elements[_size]));
+                size_t index = 0;
+                while(true) {
+                    const size_t first = index * detail::heapArity + 1;
+                    if(first >= _size)
+                        break;
+                    const size_t end = first + detail::heapArity < _size ? first + detail::heapArity : _size;
+                    size_t smallest = first;
+                    for(size_t child = first + 1; child < end; child++)
+                        if(_less(_elements[child], _elements[smallest]))
+                            smallest = child;
+                    if(!_less(_elements[smallest], last))
+                        break;
+                    _elements[index] = move(_elements[smallest]);
+                    index = smallest;
+                }
+                _elements[index] = move(last);
+            }
+            _elements[_size].~T();
+            return result;
+        }
+
+        /// @brief Retrieves the number of elements.
+        /// @return Number of elements in the heap.
+        size_t size() const noexcept {
+            return _size;
+        }
+
+        /// @brief Checks whether the heap has no elements.
+        /// @return True if the heap is empty.
+        bool isEmpty() const noexcept {
+            return _size == 0;
+        }
+
+        /// @brief Removes every element.
+        /// @details The memory for the elements is kept for reuse.
+        void clear() noexcept {
+            if constexpr(!IsTriviallyDestructible<T>::value)
+                for(size_t i = 0; i < _size; i++)
+                    _elements[i].~T();
+            _size = 0;
+        }
+
+        /// @brief Makes room for a number of elements without further allocation.
+        /// @param capacity Number of elements to make room for.
+        void reserve(size_t capacity) noexcept {
+            if(capacity <= _capacity)
+                return;
+            auto elements = static_cast<T *>(::operator new(capacity * sizeof(T)));
+            relocate(elements, _elements, _size);
+            ::operator delete(_elements);
+            _elements = elements;
+            _capacity = capacity;
+        }
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        Heap &operator=(const Heap &other) = delete;
+
+    private:
+        T *_elements;
+        size_t _size;
+        size_t _capacity;
+        Less _less;
+    };
+}
+
+#endif // HYPER_HEAP_H
@@ -0,0 +1,132 @@
+/// @file HyperLogLog.h
+/// Cardinality estimation in a small, fixed amount of memory.
+
+#ifndef HYPER_HYPER_LOG_LOG_H
+#define HYPER_HYPER_LOG_LOG_H
+
+#include <cstddef>   // For size_t.
+#include "byte.h"
+#include "hash.h"
+#include "integer.h"
+
+namespace hyper {
+    /// @brief Estimates the number of distinct keys in a stream.
+    /// @details HyperLogLog++ sketch with @c 2^precision registers.
+    ///   The relative error is about @c 1.04/sqrt(2^precision), which is 0.8% at the default precision of 14,
+    ///   using 16 KiB of memory in the dense representation.
+    ///   Small cardinalities use a sparse representation that stores only the registers that have been set,
+    ///   at a higher internal precision, so they are counted almost exactly and use far less memory.
+    ///   The sketch switches to the dense representation when that becomes smaller.
+    ///   Dense estimates use Ertl's improved estimator, which needs no empirical bias correction tables.
+    ///
+    ///   Sketches are not thread-safe. To count across threads, give each thread its own sketch
+    ///   and @ref merge() them; the merged estimate is the same as if one sketch had seen every key.
+    class HyperLogLog {
+    public:
+        /// @brief Smallest supported precision.
+        static constexpr uint8 minPrecision = 4;
+
+        /// @brief Largest supported precision.
+        static constexpr uint8 maxPrecision = 18;
+
+        /// @brief General constructor.
+        /// @details Creates an empty sketch.
+        /// @param precision Number of hash bits used to pick a register, from 4 to 18.
+        ///   Each additional bit doubles the dense memory and reduces the error by a factor of @c sqrt(2).
+        explicit HyperLogLog(uint8 precision = 14) noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        HyperLogLog(const HyperLogLog &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Frees the sketch's storage.
+        ~HyperLogLog() noexcept;
+
+        /// @brief Adds a key to the sketch.
+        /// @param keyHash 64-bit hash of the key.
+        void insertHash(uint64 keyHash) noexcept;
+
+        /// @brief Adds a key to the sketch.
+        /// @param key Bytes of the key.
+        /// @param size Number of bytes in @p key.
+        void insert(const byte *key, size_t size) noexcept {
+            insertHash(hash(key, size));
+        }
+
+        /// @brief Estimates the number of distinct keys added to the sketch.
+        /// @return Approximate number of distinct keys.
+        uint64 estimate() const noexcept;
+
+        /// @brief Adds all of the keys from another sketch to this one.
+        /// @details Dense registers are combined with vector instructions.
+        /// @param other Sketch to merge from. It must have the same precision.
+        /// @return True if the sketches were merged.
+        /// @return False if the precisions are different. The sketch is left unchanged.
+        bool merge(const HyperLogLog &other) noexcept;
+
+        /// @brief Removes all keys from the sketch.
+        /// @details The sketch returns to the sparse representation.
+        void clear() noexcept;
+
+        /// @brief Retrieves the precision of the sketch.
+        /// @return Number of hash bits used to pick a register.
+        uint8 precision() const noexcept;
+
+        /// @brief Checks which representation the sketch is using.
+        /// @return True if the sketch is using the sparse representation.
+        /// @return False if the sketch is using the dense representation.
+        bool isSparse() const noexcept;
+
+        /// @brief Calculates the number of bytes needed to serialize the sketch.
+        /// @return Size of the serialized sketch in bytes.
+        size_t serializedSize() const noexcept;
+
+        /// @brief Serializes the sketch so it can be stored or sent elsewhere.
+        /// @param[out] output Destination for the serialized sketch.
+        ///   This must have room for @ref serializedSize() bytes.
+        /// @return Number of bytes written to @p output.
+        size_t serialize(byte *output) const noexcept;
+
+        /// @brief Replaces the sketch with one that was serialized.
+        /// @details The data is validated, so it is safe to use with data received from elsewhere.
+        /// @param input Serialized sketch produced by @ref serialize().
+        /// @param size Number of bytes in @p input.
+        /// @return True if the sketch was replaced.
+        /// @return False if the data is not a valid sketch. The sketch is left unchanged.
+        bool deserialize(const byte *input, size_t size) noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        HyperLogLog &operator=(const HyperLogLog &other) = delete;
+
+    private:
+        /// @brief Number of sparse entries buffered before they are sorted into the sparse list.
+        static constexpr size_t pendingCapacity = 256;
+
+        uint8 _precision;
+        uint8 *_registers;
+        mutable uint32 *_sparse;
+        mutable size_t _sparseCount;
+        mutable size_t _sparseCapacity;
+        mutable uint32 *_pending;
+        mutable size_t _pendingCount;
+
+        /// @brief Sorts pending entries into the sparse list.
+        void flush() const noexcept;
+
+        /// @brief Merges sorted sparse entries into the sparse list.
+        void mergeSparse(const uint32 *entries, size_t count) const noexcept;
+
+        /// @brief Switches to the dense representation.
+        void convertToDense() noexcept;
+
+        /// @brief Applies sparse entries to the dense registers.
+        void applySparse(const uint32 *entries, size_t count) noexcept;
+
+        /// @brief Releases sparse storage.
+        void releaseSparse() noexcept;
+    };
+}
+
+#endif // HYPER_HYPER_LOG_LOG_H
@@ -0,0 +1,253 @@
+/// @file IndexedHeap.h
+/// Priority queue of numbered items whose priorities can change.
+
+#ifndef HYPER_INDEXED_HEAP_H
+#define HYPER_INDEXED_HEAP_H
+
+#include <cstddef>   // For size_t.
+#include <new>       // For placement new.
+#include "assert.h"
+#include "Heap.h"
+#include "integer.h"
+#include "utility.h"
+
+namespace hyper {
+    /// @brief Priority queue of items identified by index, supporting decrease-key.
+    /// @details Items are numbered from zero up to the capacity given at construction, such as node indices
+    ///   in a graph. The queue tracks where each item sits in its 4-ary heap,
+    ///   so an item's priority can be looked up, lowered, raised or removed in place,
+    ///   which is what Dijkstra's algorithm and A* need to relax edges.
+    ///
+    ///   The heap holds each item's priority next to its index, so sifting doesn't have to look anything up.
+    ///   All memory is allocated up front; nothing is allocated while the queue is in use.
+    /// @tparam Priority Type of priority. The item with the smallest priority comes first.
+    /// @tparam Less Type of callable that takes two priorities and returns true if the first is smaller.
+    template<typename Priority, typename Less = detail::DefaultLess<Priority>>
+    class IndexedHeap {
+    public:
+        /// @brief General constructor.
+        /// @details Creates an empty queue.
+        /// @param capacity Number of distinct items. Items are numbered from zero to one less than this.
+        /// @param less Comparison used to order priorities.
+        explicit IndexedHeap(size_t capacity, Less less = Less()) noexcept
+                : _entries(static_cast<Entry *>(::operator new(capacity * sizeof(Entry)))),
+                  _positions(new uint32[capacity]), _size(0), _capacity(capacity), _less(less) {
+            ASSERTF(capacity <= absent, "Indexed heap capacity %zu is too large", capacity);
+            for(size_t i = 0; i < capacity; i++)
+                _positions[i] = absent;
+        }
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        IndexedHeap(const IndexedHeap &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Destroys the remaining priorities.
+        ~IndexedHeap() noexcept {
+            clear();
+            ::operator delete(_entries);
+            delete[] _positions;
+        }
+
+        /// @brief Adds an item.
+        /// @details The item is asserted to not already be in the queue.
+        /// @param item Index of the item.
+        /// @param priority Priority of the item.
+        void push(size_t item, const Priority &priority) noexcept {
+            ASSERTF(item < _capacity, "Item %zu out of range", item);
+            ASSERTF(_positions[item] == absent, "Item %zu is already in the heap", item);
+            new(&_entries[_size]) Entry{priority, static_cast<uint32>(item)};
+            _positions[item] = static_cast<uint32>(_size);
+            siftUp(_size++);
+        }
+
+        /// @brief Adds an item, or lowers its priority if it is already in the queue.
+        /// @details This is the relax step of shortest-path searches.
+        /// @param item Index of the item.
+        /// @param priority New priority of the item.
+        /// @return True if the item was added or its priority lowered.
+        /// @return False if the item was already in the queue with a priority no larger than @p priority.
+        bool pushOrDecrease(size_t item, const Priority &priority) noexcept {
+            ASSERTF(item < _capacity, "Item %zu out of range", item);
+            if(_positions[item] == absent) {
+                push(item, priority);
+                return true;
+            }
+            auto &entry = _entries[_positions[item]];
+            if(!_less(priority, entry.priority))
+                return false;
+            entry.priority = priority;
+            siftUp(_positions[item]);
+            return true;
+        }
+
+        /// @brief Changes the priority of an item in the queue.
+        /// @details The priority can be raised or lowered. The item is asserted to be in the queue.
+        /// @param item Index of the item.
+        /// @param priority New priority of the item.
+        void update(size_t item, const Priority &priority) noexcept {
+            ASSERTF(contains(item), "Item %zu is not in the heap", item);
+            const size_t position = _positions[item];
+            auto &entry = _entries[position];
+            const bool lower = _less(priority, entry.priority);
+            entry.priority = priority;
+            if(lower)
+                siftUp(position);
+            else
+                siftDown(position);
+        }
+
+        /// @brief Removes an item from the queue.
+        /// @param item Index of the item.
+        /// @return True if the item was removed.
+        /// @return False if the item wasn't in the queue.
+        bool erase(size_t item) noexcept {
+            if(!contains(item))
+                return false;
+            removeAt(_positions[item]);
+            return true;
+        }
+
+        /// @brief Checks whether an item is in the queue.
+        /// @param item Index of the item.
+        /// @return True if the item is waiting in the queue.
+        bool contains(size_t item) const noexcept {
+            return item < _capacity && _positions[item] != absent;
+        }
+
+        /// @brief Retrieves the priority of an item.
+        /// @details The item is asserted to be in the queue.
+        /// @param item Index of the item.
+        /// @return Priority of the item.
+        const Priority &priority(size_t item) const noexcept {
+            ASSERTF(contains(item), "Item %zu is not in the heap", item);
+            return _entries[_positions[item]].priority;
+        }
+
+        /// @brief Retrieves the item with the smallest priority.
+        /// @details The queue is asserted to not be empty.
+        /// @return Index of the item.
+        size_t top() const noexcept {
+            ASSERTF(_size > 0, "Attempt to access the top of an empty heap");
+            return _entries[0].item;
+        }
+
+        /// @brief Retrieves the smallest priority.
+        /// @details The queue is asserted to not be empty.
+        /// @return Priority of the item at the top of the queue.
+        const Priority &topPriority() const noexcept {
+            ASSERTF(_size > 0, "Attempt to access the top of an empty heap");
+            return _entries[0].priority;
+        }
+
+        /// @brief Removes the item with the smallest priority.
+        /// @details The queue is asserted to not be empty.
+        /// @return Index of the removed item.
+        size_t pop() noexcept {
+            ASSERTF(_size > 0, "Attempt to pop from an empty heap");
+            const size_t item = _entries[0].item;
+            removeAt(0);
+            return item;
+        }
+
+        /// @brief Retrieves the number of items in the queue.
+        /// @return Number of items.
+        size_t size() const noexcept {
+            return _size;
+        }
+
+        /// @brief Checks whether the queue has no items.
+        /// @return True if the queue is empty.
+        bool isEmpty() const noexcept {
+            return _size == 0;
+        }
+
+        /// @brief Retrieves the number of distinct items.
+        /// @return Capacity given at construction.
+        size_t capacity() const noexcept {
+            return _capacity;
+        }
+
+        /// @brief Removes every item.
+        /// @details Takes time proportional to the number of items in the queue, not the capacity.
+        void clear() noexcept {
+            for(size_t i = 0; i < _size; i++) {
+                _positions[_entries[i].item] = absent;
+                _entries[i].~Entry();
+            }
+            _size = 0;
+        }
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        IndexedHeap &operator=(const IndexedHeap &other) = delete;
+
+    private:
+        static constexpr uint32 absent = 0xFFFFFFFF;
+
+        struct Entry {
+            Priority priority;
+            uint32 item;
+        };
+
+        Entry *_entries;
+        uint32 *_positions;
+        size_t _size;
+        size_t _capacity;
+        Less _less;
+
+        void place(Entry &&entry, size_t position) noexcept {
+            _positions[entry.item] = static_cast<uint32>(position);
+            _entries[position] = move(entry);
+        }
+
+        void siftUp(size_t position) noexcept {
+            Entry entry(move(_entries[position]));
+            while(position > 0) {
+                const size_t parent = (position - 1) / detail::heapArity;
+                if(!_less(entry.priority, _entries[parent].priority))
+                    break;
+                place(move(_entries[parent]), position);
+                position = parent;
+            }
+            place(move(entry), position);
+        }
+
+        void siftDown(size_t position) noexcept {
+            Entry entry(move(_entries[position]));
+            while(true) {
+                const size_t first = position * detail::heapArity + 1;
+                if(first >= _size)
+                    break;
+                const size_t end = first + detail::heapArity < _size ? first + detail::heapArity : _size;
+                size_t smallest = first;
+                for(size_t child = first + 1; child < end; child++)
+                    if(_less(_entries[child].priority, _entries[smallest].priority))
+                        smallest = child;
+                if(!_less(_entries[smallest].priority, entry.priority))
+                    break;
+                place(move(_entries[smallest]), position);
+                position = smallest;
+            }
+            place(move(entry), position);
+        }
+
+        void removeAt(size_t position) noexcept {
+            _positions[_entries[position].item] = absent;
+            _size--;
+            if(position < _size) {
+                // Fill the hole with the last entry, which may need to move either way.
+                const bool lower = _less(_entries[_size].priority, _entries[position].priority);
+                _entries[position] = move(_entries[_size]);
+                _positions[_entries[position].item] = static_cast<uint32>(position);
+                if(lower)
+                    siftUp(position);
+                else
+                    siftDown(position);
+            }
+            _entries[_size].~Entry();
+        }
+    };
+}
+
+#endif // HYPER_INDEXED_HEAP_H
@@ -0,0 +1,254 @@
+/// @file Json.h
+/// Fast JSON parser with lazy, zero-copy access to values.
+
+#ifndef HYPER_JSON_H
+#define HYPER_JSON_H
+
+#include <cstddef>   // For size_t.
+#include "byte.h"
+#include "float.h"
+#include "integer.h"
+#include "JsonError.h"
+#include "Result.h"
+
+namespace hyper {
+    /// @brief Types of JSON values.
+    enum class JsonType : uint8 {
+        /// @brief The @c null literal.
+        Null,
+        /// @brief The @c true or @c false literal.
+        Boolean,
+        /// @brief A number.
+        Number,
+        /// @brief A string.
+        String,
+        /// @brief An ordered list of values.
+        Array,
+        /// @brief A list of members, each with a string key and a value.
+        Object
+    };
+
+    /// @brief View of a JSON string's bytes, with escape sequences already decoded.
+    /// @details The bytes are not null-terminated.
+    struct JsonString {
+        /// @brief First byte of the string.
+        const char *data;
+
+        /// @brief Number of bytes in the string.
+        size_t size;
+
+        /// @brief Compares against a null-terminated string.
+        /// @param text String to compare with.
+        /// @return True if both strings have the same bytes.
+        bool operator==(const char *text) const noexcept {
+            for(size_t i = 0; i < size; i++) {
+                if(text[i] != data[i])
+                    return false;
+            }
+            return text[size] == '\0';
+        }
+    };
+
+    class JsonDocument;
+
+    namespace detail {
+        /// @brief Entry of a parsed document's tape, which lists its values in the order they appear.
+        /// @details Arrays and objects are followed by their contents, with each object key
+        ///   as a string entry just before its value.
+        struct JsonTapeEntry {
+            /// @brief @ref JsonType in the low byte, along with the flags below.
+            uint32 kind;
+
+            /// @brief Number of elements or members in a container, bytes in a string or a number's text,
+            ///   or 1 for @c true.
+            uint32 length;
+
+            /// @brief Index of the entry after a container's contents,
+            ///   or the offset of a string or a number's text.
+            uint64 payload;
+
+            /// @brief Set on strings whose decoded bytes are in the document rather than the input.
+            static constexpr uint32 decoded = 0x100;
+
+            /// @brief Set on numbers with no fraction or exponent.
+            static constexpr uint32 integer = 0x200;
+
+            /// @brief Retrieves the type of the value.
+            /// @return Type stored in the low byte of @ref kind.
+            JsonType type() const noexcept {
+                return static_cast<JsonType>(kind & 0xFF);
+            }
+        };
+    }
+
+    /// @brief Lightweight handle to a value in a parsed @ref JsonDocument.
+    /// @details Values are read lazily: numbers are checked during parsing but only converted
+    ///   when read, and strings without escape sequences point straight into the input.
+    ///   Containers know where their contents end, so skipping over a member or element
+    ///   never walks what's inside it.
+    ///   A value stays valid until its document is parsed again or destroyed,
+    ///   and strings also need the input to stay alive.
+    class JsonValue {
+    public:
+        /// @brief General constructor.
+        /// @param document Document holding the value.
+        /// @param index Position of the value on the document's tape.
+        JsonValue(const JsonDocument *document, size_t index) noexcept
+                : _document(document), _index(index) {
+            // ...
+        }
+
+        /// @brief Retrieves the type of the value.
+        /// @return Type of the value.
+        JsonType type() const noexcept {
+            return entry().type();
+        }
+
+        /// @brief Checks whether the value is @c null.
+        /// @return True if the value is @c null.
+        bool isNull() const noexcept {
+            return type() == JsonType::Null;
+        }
+
+        /// @brief Reads a boolean.
+        /// @return The value, or an error if it isn't @c true or @c false.
+        Result<bool> getBool() const noexcept;
+
+        /// @brief Reads a signed integer.
+        /// @return The value, or an error if it isn't an integer or doesn't fit.
+        Result<int64> getInt64() const noexcept;
+
+        /// @brief Reads an unsigned integer.
+        /// @return The value, or an error if it isn't a non-negative integer or doesn't fit.
+        Result<uint64> getUInt64() const noexcept;
+
+        /// @brief Reads a number as a double.
+        /// @details Integers are accepted too. The result is correctly rounded.
+        /// @return The value, or an error if it isn't a number or is too large for a double.
+        Result<float64> getDouble() const noexcept;
+
+        /// @brief Reads a string.
+        /// @return View of the decoded string, or an error if the value isn't a string.
+        Result<JsonString> getString() const noexcept;
+
+        /// @brief Retrieves the number of elements in an array or members in an object.
+        /// @return Size of the container, or zero for other values.
+        size_t size() const noexcept {
+            const auto type = this->type();
+            return type == JsonType::Array || type == JsonType::Object ? entry().length : 0;
+        }
+
+        /// @brief Finds a member of an object.
+        /// @details Members are searched in order, so this is linear in the size of the object.
+        ///   If the key appears more than once, the first member with it is found.
+        /// @param key Key of the member, as a null-terminated string.
+        /// @return Value of the member, or an error if this isn't an object or the key isn't in it.
+        Result<JsonValue> field(const char *key) const noexcept;
+
+        /// @brief Finds an element of an array.
+        /// @details Elements before it are skipped over, so this is linear in @p index.
+        /// @param index Position of the element, counting from zero.
+        /// @return Element, or an error if this isn't an array or is too short.
+        Result<JsonValue> element(size_t index) const noexcept;
+
+        /// @brief Calls a function with each element of an array, in order.
+        /// @details Does nothing if this isn't an array.
+        /// @param visit Function to call with each element.
+        /// @tparam Visit Type of function to call.
+        template<typename Visit>
+        void forEachElement(Visit visit) const noexcept {
+            if(type() != JsonType::Array)
+                return;
+            const size_t end = entry().payload;
+            for(size_t i = _index + 1; i < end; i = next(i))
+                visit(JsonValue(_document, i));
+        }
+
+        /// @brief Calls a function with the key and value of each member of an object, in order.
+        /// @details Does nothing if this isn't an object.
+        /// @param visit Function to call with each key and value.
+        /// @tparam Visit Type of function to call.
+        template<typename Visit>
+        void forEachField(Visit visit) const noexcept {
+            if(type() != JsonType::Object)
+                return;
+            const size_t end = entry().payload;
+            for(size_t i = _index + 1; i < end; i = next(i + 1))
+                visit(JsonValue(_document, i).string(), JsonValue(_document, i + 1));
+        }
+
+    private:
+        const detail::JsonTapeEntry &entry() const noexcept;
+        size_t next(size_t index) const noexcept;
+        JsonString string() const noexcept;
+
+        const JsonDocument *_document;
+        size_t _index;
+    };
+
+    /// @brief Parsed JSON document.
+    /// @details Parsing runs in two stages, in the style of simdjson.
+    ///   The first uses vector instructions to classify 64 bytes at a time, tracking escapes and
+    ///   which bytes are inside strings with bit tricks, and records where every structural
+    ///   character and scalar value starts. The second walks that index, checks the grammar,
+    ///   and writes each value to a flat tape that @ref JsonValue reads from.
+    ///
+    ///   The input is not copied, so it can come straight from a mapped file, and must stay alive
+    ///   while the document's strings are used. It doesn't need to be null-terminated or padded.
+    ///   A document keeps its buffers between parses, so reusing one for many inputs avoids allocating.
+    class JsonDocument {
+    public:
+        /// @brief Maximum depth of nested arrays and objects.
+        static constexpr size_t maxDepth = 1024;
+
+        /// @brief Default constructor.
+        /// @details Creates an empty document without allocating.
+        JsonDocument() noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        JsonDocument(const JsonDocument &other) = delete;
+
+        /// @brief Destructor.
+        ~JsonDocument() noexcept;
+
+        /// @brief Parses JSON text, replacing the document's contents.
+        /// @details Values read from an earlier parse are no longer valid afterward.
+        /// @param data UTF-8 text to parse. Must stay alive while strings from the document are read.
+        /// @param size Number of bytes in @p data. Must be less than 4 GB.
+        /// @return Nothing, or a @ref JsonError describing the first problem found.
+        Result<void> parse(const byte *data, size_t size) noexcept;
+
+        /// @brief Accesses the top-level value.
+        /// @details The document must have been parsed successfully.
+        /// @return Top-level value.
+        JsonValue root() const noexcept {
+            return JsonValue(this, 0);
+        }
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        JsonDocument &operator=(const JsonDocument &other) = delete;
+
+    private:
+        friend class JsonValue;
+
+        size_t index() noexcept;
+        Result<void> build(size_t count) noexcept;
+        Result<void> parseString(size_t position, detail::JsonTapeEntry &entry) noexcept;
+        Result<void> parseNumber(size_t position, detail::JsonTapeEntry &entry) noexcept;
+
+        const byte *_input;
+        size_t _size;
+        uint32 *_indices;
+        size_t _indexCapacity;
+        detail::JsonTapeEntry *_tape;
+        size_t _tapeCapacity;
+        size_t _tapeSize;
+        char *_strings;
+        size_t _stringCapacity;
+        size_t _stringSize;
+    };
+}
+
+#endif // HYPER_JSON_H
@@ -0,0 +1,91 @@
+/// @file JsonError.h
+/// Error reported while parsing or reading JSON.
+
+#ifndef HYPER_JSON_ERROR_H
+#define HYPER_JSON_ERROR_H
+
+#include <cstddef>   // For size_t.
+#include "Error.h"
+
+namespace hyper {
+    /// @brief Reasons JSON can fail to parse or be read.
+    enum class JsonErrorCode {
+        /// @brief The input has no value in it.
+        Empty,
+        /// @brief The input is too large to index.
+        TooLarge,
+        /// @brief Containers are nested deeper than the parser allows.
+        DepthExceeded,
+        /// @brief A byte can't start a value.
+        UnexpectedCharacter,
+        /// @brief A string has no closing quote.
+        UnclosedString,
+        /// @brief A string has an unknown escape sequence or a bad @c \\u escape.
+        InvalidEscape,
+        /// @brief A string has a raw control character, which must be escaped.
+        ControlCharacter,
+        /// @brief A string isn't valid UTF-8.
+        InvalidUtf8,
+        /// @brief A number doesn't follow the JSON grammar.
+        InvalidNumber,
+        /// @brief A word that looked like @c true, @c false or @c null isn't one.
+        InvalidLiteral,
+        /// @brief The input ends in the middle of a value.
+        UnexpectedEnd,
+        /// @brief An object member doesn't start with a string key.
+        ExpectedKey,
+        /// @brief An object key isn't followed by a colon.
+        ExpectedColon,
+        /// @brief A value in a container isn't followed by a comma or the end of the container.
+        ExpectedCommaOrEnd,
+        /// @brief There is more after the top-level value.
+        TrailingContent,
+        /// @brief A value was read as a type it doesn't have.
+        IncorrectType,
+        /// @brief A number doesn't fit in the type it was read as.
+        NumberOutOfRange,
+        /// @brief An object has no member with the requested key.
+        MissingField,
+        /// @brief An array has no element at the requested index.
+        IndexOutOfRange
+    };
+
+    /// @brief Error reported while parsing or reading JSON.
+    /// @details Records what went wrong and the byte offset in the input where it was found.
+    class JsonError : public Error {
+    public:
+        /// @brief General constructor.
+        /// @param code What went wrong.
+        /// @param offset Position in the input, in bytes, where the problem was found.
+        JsonError(JsonErrorCode code, size_t offset) noexcept;
+
+        /// @brief General constructor.
+        /// @details Used for problems that aren't tied to a position in the input,
+        ///   such as reading a parsed value as the wrong type.
+        /// @param code What went wrong.
+        explicit JsonError(JsonErrorCode code) noexcept;
+
+        /// @brief Destructor.
+        ~JsonError() noexcept override;
+
+        /// @brief Error message.
+        /// @details Describes the problem and where it was found.
+        /// @return String containing the error message.
+        const char *message() const noexcept override;
+
+        /// @brief Retrieves what went wrong.
+        /// @return Reason for the error.
+        JsonErrorCode code() const noexcept;
+
+        /// @brief Retrieves where the problem was found.
+        /// @return Position in the input, in bytes, or the largest @c size_t if the error has no position.
+        size_t offset() const noexcept;
+
+    private:
+        JsonErrorCode _code;
+        size_t _offset;
+        char _message[96];
+    };
+}
+
+#endif // HYPER_JSON_ERROR_H
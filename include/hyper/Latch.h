@@ -0,0 +1,51 @@
+/// @file Latch.h
+/// Single-use countdown that threads can wait on.
+
+#ifndef HYPER_LATCH_H
+#define HYPER_LATCH_H
+
+#include "integer.h"
+
+namespace hyper {
+    /// @brief Counter that threads can wait to reach zero.
+    /// @details The latch starts at a count, and each piece of work counts it down when it finishes.
+    ///   Once it reaches zero it stays there and every waiting thread is released.
+    ///   This is the usual way to wait for a batch of jobs to complete.
+    ///
+    ///   Counting down only makes a system call when the count reaches zero and a thread is asleep.
+    class Latch {
+    public:
+        /// @brief General constructor.
+        /// @param count Number of times @ref countDown() must be called to release waiting threads.
+        explicit Latch(uint32 count) noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        Latch(const Latch &other) = delete;
+
+        /// @brief Decreases the count, releasing waiting threads if it reaches zero.
+        /// @details Writes made before counting down are visible to threads released by the latch.
+        /// @param count Amount to decrease the count by. It must not go below zero.
+        void countDown(uint32 count = 1) noexcept;
+
+        /// @brief Checks whether the count has reached zero, without waiting.
+        /// @return True if the count is zero.
+        bool isReady() const noexcept;
+
+        /// @brief Sleeps until the count reaches zero.
+        void wait() const noexcept;
+
+        /// @brief Decreases the count by one and sleeps until it reaches zero.
+        void arriveAndWait() noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        Latch &operator=(const Latch &other) = delete;
+
+    private:
+        uint32 _count;
+        mutable uint32 _waiters;
+    };
+}
+
+#endif // HYPER_LATCH_H
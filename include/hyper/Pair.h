@@ -8,6 +8,8 @@
 
 namespace hyper {
     /// @brief Simple container for holding two values.
+    /// @details Copying and moving are member-wise, so a pair of trivially copyable values is itself
+    ///   trivially copyable and containers can copy it with @c memcpy.
     /// @tparam T1 Type of the first value.
     /// @tparam T2 Type of the second value.
     template<typename T1, typename T2>
@@ -46,18 +48,12 @@ namespace hyper {
         /// @brief Copy constructor.
         /// @details Copies the values from an existing pair into a new pair.
         /// @param other Other pair to copy values from.
-        constexpr Pair(Pair const &other) noexcept
-                : first(other.first), second(other.second) {
-            // ...
-        }
+        constexpr Pair(Pair const &other) noexcept = default;
 
         /// @brief Move constructor.
         /// @details Moves the values from a temporary pair into a new pair.
         /// @param other Other pair to move values from.
-        constexpr Pair(Pair &&other) noexcept
-                : first(move(other.first)), second(move(other.second)) {
-            // ...
-        }
+        constexpr Pair(Pair &&other) noexcept = default;
 
         /// @brief Swaps values with another pair of the same type.
         /// @param other Other pair to swap values with.
@@ -114,20 +110,13 @@ namespace hyper {
         /// @details Copies values from another pair into this instance.
         /// @param other Other pair to copy values from.
         /// @return Reference to updated this instance.
-        constexpr inline Pair &operator=(Pair const &other) noexcept {
-            first  = other.first;
-            second = other.second;
-            return *this;
-        }
+        constexpr inline Pair &operator=(Pair const &other) noexcept = default;
 
         /// @brief Move assignment operator.
         /// @details Moves values from another pair into this instance.
         /// @param other Other pair to move values from.
         /// @return Reference to updated this instance.
-        constexpr inline Pair &operator=(Pair &&other) noexcept {
-            swap(other);
-            return *this;
-        }
+        constexpr inline Pair &operator=(Pair &&other) noexcept = default;
     };
 
     /// @brief Creates a new pair.
@@ -150,6 +139,14 @@ namespace hyper {
     template<typename T1, typename T2>
     inline void swap(Pair<T1, T2> &first, Pair<T1, T2> &second) noexcept {
         first.swap(second);
+    }
+
+    /// @brief A pair is trivially relocatable when both of its values are.
+    /// @tparam T1 Type of the first value.
+    /// @tparam T2 Type of the second value.
+    template<typename T1, typename T2>
+    struct IsTriviallyRelocatable<Pair<T1, T2>>
+            : BoolConstant<IsTriviallyRelocatable<T1>::value && IsTriviallyRelocatable<T2>::value> {
     };
 }
 
@@ -0,0 +1,448 @@
+/// @file PersistentHashMap.h
+/// Hash map whose copies share structure, so snapshots are cheap.
+
+#ifndef HYPER_PERSISTENT_HASH_MAP_H
+#define HYPER_PERSISTENT_HASH_MAP_H
+
+#include <cstddef>   // For size_t.
+#include <new>       // For placement new.
+#include "assert.h"
+#include "hash.h"
+#include "integer.h"
+#include "Pair.h"
+#include "utility.h"
+
+namespace hyper {
+    /// @brief Persistent hash map, stored as a hash array mapped trie.
+    /// @details Each level of the trie uses five bits of the key's hash to pick one of 32 slots.
+    ///   Slots are stored compressed: every node has one bitmap of slots holding an entry inline
+    ///   and another of slots holding a child node, and keeps only the occupied slots,
+    ///   packed in order and found by counting the set bits below the slot's bit.
+    ///   Keys whose full hashes are equal end up together in a collision node at the bottom.
+    ///   Subtrees are kept canonical: a child node always holds at least two entries,
+    ///   so a map looks the same however it was built.
+    ///
+    ///   Nodes are reference counted and shared, so copying a map is O(1) and gives an independent snapshot.
+    ///   An update copies the nodes on the path to its key that are shared with another map, and leaves the rest shared.
+    ///   A node that this map holds the only reference to is changed in place instead, as long as every node above it
+    ///   is too. That makes a run of updates with no snapshot in between behave like a transient batch:
+    ///   after the first update has copied the shared path, later ones don't copy anything
+    ///   except nodes that have to change size.
+    ///
+    ///   Reference counts are atomic, so maps that share nodes can be used and updated from different threads.
+    ///   A single map must not be updated by one thread while another uses it.
+    /// @tparam K Type of key. Must be copyable and comparable with @c operator==.
+    /// @tparam V Type of value. Must be copyable.
+    /// @tparam Hash Function object that hashes keys.
+    template<typename K, typename V, typename Hash = Hasher<K>>
+    class PersistentHashMap {
+    public:
+        /// @brief Key and value stored together.
+        typedef Pair<K, V> Entry;
+
+        /// @brief Default constructor.
+        /// @details Creates an empty map without allocating.
+        PersistentHashMap() noexcept
+                : _root(nullptr), _size(0), _hash() {
+            // ...
+        }
+
+        /// @brief Copy constructor.
+        /// @details Takes a snapshot of another map, sharing all of its nodes.
+        /// @param other Map to copy.
+        PersistentHashMap(const PersistentHashMap &other) noexcept
+                : _root(other._root), _size(other._size), _hash(other._hash) {
+            if(_root != nullptr)
+                retain(_root);
+        }
+
+        /// @brief Move constructor.
+        /// @details Leaves the other map empty.
+        /// @param other Map to take the contents of.
+        PersistentHashMap(PersistentHashMap &&other) noexcept
+                : _root(other._root), _size(other._size), _hash(other._hash) {
+            other._root = nullptr;
+            other._size = 0;
+        }
+
+        /// @brief Destructor.
+        /// @details Frees the nodes that aren't shared with another map.
+        ~PersistentHashMap() noexcept {
+            if(_root != nullptr)
+                release(_root);
+        }
+
+        /// @brief Looks up the value for a key.
+        /// @param key Key to look up.
+        /// @return Value for the key, or null if the key isn't in the map.
+        ///   The value stays valid until this map is updated or destroyed.
+        const V *find(const K &key) const noexcept {
+            const auto entry = findEntry(_hash(key), key);
+            return entry == nullptr ? nullptr : &entry->second;
+        }
+
+        /// @brief Checks whether a key is in the map.
+        /// @param key Key to look for.
+        /// @return True if the key is in the map.
+        bool contains(const K &key) const noexcept {
+            return findEntry(_hash(key), key) != nullptr;
+        }
+
+        /// @brief Adds a key to the map, or replaces its value if it is already there.
+        /// @details Copies of the map made earlier are not affected.
+        /// @param key Key to add.
+        /// @param value Value to store for the key.
+        /// @return True if the key was added, false if an existing value was replaced.
+        bool insert(const K &key, const V &value) noexcept {
+            const auto keyHash = _hash(key);
+            if(_root == nullptr) {
+                _root = allocate(bitFor(keyHash, 0), 0, 1);
+                new(_root->entries()) Entry(key, value);
+                _size = 1;
+                return true;
+            }
+            bool added = false;
+            _root = insert(_root, 0, keyHash, Entry(key, value), added);
+            if(added)
+                _size++;
+            return added;
+        }
+
+        /// @brief Removes a key from the map.
+        /// @details Copies of the map made earlier are not affected.
+        /// @param key Key to remove.
+        /// @return True if the key was removed, false if it wasn't in the map.
+        bool erase(const K &key) noexcept {
+            const auto keyHash = _hash(key);
+            // Checking first means a missing key never copies a shared path.
+            if(findEntry(keyHash, key) == nullptr)
+                return false;
+            _root = erase(_root, 0, keyHash, key);
+            _size--;
+            return true;
+        }
+
+        /// @brief Removes every entry.
+        void clear() noexcept {
+            if(_root != nullptr)
+                release(_root);
+            _root = nullptr;
+            _size = 0;
+        }
+
+        /// @brief Retrieves the number of entries.
+        /// @return Number of keys in the map.
+        size_t size() const noexcept {
+            return _size;
+        }
+
+        /// @brief Checks whether the map has no entries.
+        /// @return True if the map is empty.
+        bool isEmpty() const noexcept {
+            return _size == 0;
+        }
+
+        /// @brief Calls a function with each entry, in no particular order.
+        /// @param visit Function to call with each key and its value.
+        /// @tparam Visit Type of function to call.
+        template<typename Visit>
+        void forEach(Visit visit) const noexcept {
+            if(_root != nullptr)
+                visitNode(_root, visit);
+        }
+
+        /// @brief Assignment operator.
+        /// @details Takes a snapshot of another map, releasing this map's nodes.
+        /// @param other Map to copy.
+        /// @return This map.
+        PersistentHashMap &operator=(const PersistentHashMap &other) noexcept {
+            // Retaining first keeps self-assignment from freeing the nodes.
+            if(other._root != nullptr)
+                retain(other._root);
+            if(_root != nullptr)
+                release(_root);
+            _root = other._root;
+            _size = other._size;
+            _hash = other._hash;
+            return *this;
+        }
+
+        /// @brief Move assignment operator.
+        /// @details Leaves the other map empty.
+        /// @param other Map to take the contents of.
+        /// @return This map.
+        PersistentHashMap &operator=(PersistentHashMap &&other) noexcept {
+            if(this != &other) {
+                if(_root != nullptr)
+                    release(_root);
+                _root = other._root;
+                _size = other._size;
+                _hash = other._hash;
+                other._root = nullptr;
+                other._size = 0;
+            }
+            return *this;
+        }
+
+    private:
+        static constexpr size_t bitsPerLevel = 5;
+        static constexpr size_t hashBits = 64;
+
+        // Entries are stored right after the header, and child pointers right after the entries.
+        struct Node {
+            uint32 refs;
+            // Slots holding an entry and slots holding a child. Both are zero in collision nodes.
+            uint32 entryMap;
+            uint32 childMap;
+            uint32 entryCount;
+
+            static constexpr size_t entriesOffset() noexcept {
+                return (sizeof(Node) + alignof(Entry) - 1) & ~(alignof(Entry) - 1);
+            }
+
+            static constexpr size_t childrenOffset(size_t entryCount) noexcept {
+                return (entriesOffset() + entryCount * sizeof(Entry) + alignof(Node *) - 1) & ~(alignof(Node *) - 1);
+            }
+
+            Entry *entries() noexcept {
+                return reinterpret_cast<Entry *>(reinterpret_cast<char *>(this) + entriesOffset());
+            }
+
+            Node **children() noexcept {
+                return reinterpret_cast<Node **>(reinterpret_cast<char *>(this) + childrenOffset(entryCount));
+            }
+
+            size_t childCount() const noexcept {
+                return static_cast<size_t>(__builtin_popcount(childMap));
+            }
+        };
+
+        static_assert(alignof(Entry) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Over-aligned entries aren't supported");
+
+        Node *_root;
+        size_t _size;
+        Hash _hash;
+
+        static uint32 bitFor(uint64 keyHash, size_t shift) noexcept {
+            return uint32(1) << ((keyHash >> shift) & 31);
+        }
+
+        static size_t indexOf(uint32 map, uint32 bit) noexcept {
+            return static_cast<size_t>(__builtin_popcount(map & (bit - 1)));
+        }
+
+        // Creates a node with a reference count of one. Its entries and children are left for the caller to fill in.
+        static Node *allocate(uint32 entryMap, uint32 childMap, uint32 entryCount) noexcept {
+            const auto bytes = Node::childrenOffset(entryCount)
+                               + static_cast<size_t>(__builtin_popcount(childMap)) * sizeof(Node *);
+            return new(::operator new(bytes)) Node{1, entryMap, childMap, entryCount};
+        }
+
+        static void retain(Node *node) noexcept {
+            __atomic_fetch_add(&node->refs, 1, __ATOMIC_RELAXED);
+        }
+
+        static void release(Node *node) noexcept {
+            if(__atomic_sub_fetch(&node->refs, 1, __ATOMIC_ACQ_REL) != 0)
+                return;
+            if constexpr(!IsTriviallyDestructible<Entry>::value)
+                for(size_t i = 0; i < node->entryCount; i++)
+                    node->entries()[i].~Entry();
+            for(size_t i = 0; i < node->childCount(); i++)
+                release(node->children()[i]);
+            ::operator delete(node);
+        }
+
+        // Returns a node that only this map references, copying the node if it is shared.
+        // The caller's reference to the original is handed over either way.
+        static Node *own(Node *node) noexcept {
+            if(__atomic_load_n(&node->refs, __ATOMIC_ACQUIRE) == 1)
+                return node;
+            auto copy = allocate(node->entryMap, node->childMap, node->entryCount);
+            for(size_t i = 0; i < node->entryCount; i++)
+                new(&copy->entries()[i]) Entry(node->entries()[i]);
+            for(size_t i = 0; i < node->childCount(); i++) {
+                copy->children()[i] = node->children()[i];
+                retain(copy->children()[i]);
+            }
+            release(node);
+            return copy;
+        }
+
+        // The functions below reshape a node this map owns, moving its contents into a node of the new size.
+
+        static Node *insertEntry(Node *node, uint32 bit, size_t index, Entry &&entry) noexcept {
+            auto resized = allocate(node->entryMap | bit, node->childMap, node->entryCount + 1);
+            relocate(resized->entries(), node->entries(), index);
+            new(&resized->entries()[index]) Entry(move(entry));
+            relocate(resized->entries() + index + 1, node->entries() + index, node->entryCount - index);
+            relocate(resized->children(), node->children(), node->childCount());
+            ::operator delete(node);
+            return resized;
+        }
+
+        static Node *removeEntry(Node *node, uint32 bit, size_t index) noexcept {
+            auto resized = allocate(node->entryMap & ~bit, node->childMap, node->entryCount - 1);
+            node->entries()[index].~Entry();
+            relocate(resized->entries(), node->entries(), index);
+            relocate(resized->entries() + index, node->entries() + index + 1, node->entryCount - index - 1);
+            relocate(resized->children(), node->children(), node->childCount());
+            ::operator delete(node);
+            return resized;
+        }
+
+        // Swaps an entry, which the caller has already moved from, for a child holding it and the entry colliding with it.
+        static Node *entryToChild(Node *node, uint32 bit, Node *child) noexcept {
+            const auto entryIndex = indexOf(node->entryMap, bit);
+            const auto childIndex = indexOf(node->childMap, bit);
+            auto resized = allocate(node->entryMap & ~bit, node->childMap | bit, node->entryCount - 1);
+            node->entries()[entryIndex].~Entry();
+            relocate(resized->entries(), node->entries(), entryIndex);
+            relocate(resized->entries() + entryIndex, node->entries() + entryIndex + 1,
+                     node->entryCount - entryIndex - 1);
+            relocate(resized->children(), node->children(), childIndex);
+            resized->children()[childIndex] = child;
+            relocate(resized->children() + childIndex + 1, node->children() + childIndex,
+                     node->childCount() - childIndex);
+            ::operator delete(node);
+            return resized;
+        }
+
+        // Swaps a child, which the caller has already freed, for the one entry it held.
+        static Node *childToEntry(Node *node, uint32 bit, Entry &&entry) noexcept {
+            const auto entryIndex = indexOf(node->entryMap, bit);
+            const auto childIndex = indexOf(node->childMap, bit);
+            auto resized = allocate(node->entryMap | bit, node->childMap & ~bit, node->entryCount + 1);
+            relocate(resized->entries(), node->entries(), entryIndex);
+            new(&resized->entries()[entryIndex]) Entry(move(entry));
+            relocate(resized->entries() + entryIndex + 1, node->entries() + entryIndex,
+                     node->entryCount - entryIndex);
+            relocate(resized->children(), node->children(), childIndex);
+            relocate(resized->children() + childIndex, node->children() + childIndex + 1,
+                     node->childCount() - childIndex - 1);
+            ::operator delete(node);
+            return resized;
+        }
+
+        // Builds the smallest subtree holding two entries whose hashes match up to the shift.
+        static Node *merge(size_t shift, Entry &&first, uint64 firstHash, Entry &&second, uint64 secondHash) noexcept {
+            if(shift >= hashBits) {
+                auto node = allocate(0, 0, 2);
+                new(&node->entries()[0]) Entry(move(first));
+                new(&node->entries()[1]) Entry(move(second));
+                return node;
+            }
+            const auto firstBit = bitFor(firstHash, shift);
+            const auto secondBit = bitFor(secondHash, shift);
+            if(firstBit == secondBit) {
+                auto node = allocate(0, firstBit, 0);
+                node->children()[0] = merge(shift + bitsPerLevel, move(first), firstHash, move(second), secondHash);
+                return node;
+            }
+            auto node = allocate(firstBit | secondBit, 0, 2);
+            const size_t firstIndex = firstBit < secondBit ? 0 : 1;
+            new(&node->entries()[firstIndex]) Entry(move(first));
+            new(&node->entries()[1 - firstIndex]) Entry(move(second));
+            return node;
+        }
+
+        Entry *findEntry(uint64 keyHash, const K &key) const noexcept {
+            auto node = _root;
+            for(size_t shift = 0; node != nullptr; shift += bitsPerLevel) {
+                if(shift >= hashBits) {
+                    for(size_t i = 0; i < node->entryCount; i++)
+                        if(node->entries()[i].first == key)
+                            return &node->entries()[i];
+                    return nullptr;
+                }
+                const auto bit = bitFor(keyHash, shift);
+                if(node->entryMap & bit) {
+                    auto &entry = node->entries()[indexOf(node->entryMap, bit)];
+                    return entry.first == key ? &entry : nullptr;
+                }
+                if(!(node->childMap & bit))
+                    return nullptr;
+                node = node->children()[indexOf(node->childMap, bit)];
+            }
+            return nullptr;
+        }
+
+        // Takes over the caller's reference to the node and returns a reference to the updated one.
+        Node *insert(Node *node, size_t shift, uint64 keyHash, Entry &&entry, bool &added) const noexcept {
+            node = own(node);
+            if(shift >= hashBits) {
+                for(size_t i = 0; i < node->entryCount; i++) {
+                    if(node->entries()[i].first == entry.first) {
+                        node->entries()[i].second = move(entry.second);
+                        return node;
+                    }
+                }
+                added = true;
+                return insertEntry(node, 0, node->entryCount, move(entry));
+            }
+            const auto bit = bitFor(keyHash, shift);
+            if(node->entryMap & bit) {
+                auto &existing = node->entries()[indexOf(node->entryMap, bit)];
+                if(existing.first == entry.first) {
+                    existing.second = move(entry.second);
+                    return node;
+                }
+                added = true;
+                const auto existingHash = _hash(existing.first);
+                const auto child = merge(shift + bitsPerLevel, move(existing), existingHash, move(entry), keyHash);
+                return entryToChild(node, bit, child);
+            }
+            if(node->childMap & bit) {
+                auto &child = node->children()[indexOf(node->childMap, bit)];
+                child = insert(child, shift + bitsPerLevel, keyHash, move(entry), added);
+                return node;
+            }
+            added = true;
+            return insertEntry(node, bit, indexOf(node->entryMap, bit), move(entry));
+        }
+
+        // Takes over the caller's reference to the node and returns a reference to the updated one,
+        // or null if the node is left empty. The key must be in the subtree.
+        static Node *erase(Node *node, size_t shift, uint64 keyHash, const K &key) noexcept {
+            node = own(node);
+            if(shift >= hashBits) {
+                size_t index = 0;
+                while(!(node->entries()[index].first == key))
+                    index++;
+                return removeEntry(node, 0, index);
+            }
+            const auto bit = bitFor(keyHash, shift);
+            if(node->entryMap & bit) {
+                if(node->entryCount == 1 && node->childMap == 0) {
+                    node->entries()[0].~Entry();
+                    ::operator delete(node);
+                    return nullptr;
+                }
+                return removeEntry(node, bit, indexOf(node->entryMap, bit));
+            }
+            ASSERTF(node->childMap & bit, "Key to erase is missing from persistent hash map");
+            auto &slot = node->children()[indexOf(node->childMap, bit)];
+            const auto child = erase(slot, shift + bitsPerLevel, keyHash, key);
+            // Children hold at least two entries, so one can't be left empty, but it can be left with a single entry.
+            // Pulling that entry up keeps the trie canonical.
+            if(child->entryCount == 1 && child->childMap == 0) {
+                Entry entry(move(child->entries()[0]));
+                child->entries()[0].~Entry();
+                ::operator delete(child);
+                return childToEntry(node, bit, move(entry));
+            }
+            slot = child;
+            return node;
+        }
+
+        template<typename Visit>
+        static void visitNode(Node *node, Visit &visit) noexcept {
+            for(size_t i = 0; i < node->entryCount; i++)
+                visit(static_cast<const K &>(node->entries()[i].first), static_cast<const V &>(node->entries()[i].second));
+            for(size_t i = 0; i < node->childCount(); i++)
+                visitNode(node->children()[i], visit);
+        }
+    };
+}
+
+#endif // HYPER_PERSISTENT_HASH_MAP_H
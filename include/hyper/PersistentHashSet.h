@@ -0,0 +1,87 @@
+/// @file PersistentHashSet.h
+/// Hash set whose copies share structure, so snapshots are cheap.
+
+#ifndef HYPER_PERSISTENT_HASH_SET_H
+#define HYPER_PERSISTENT_HASH_SET_H
+
+#include <cstddef>   // For size_t.
+#include "PersistentHashMap.h"
+
+namespace hyper {
+    namespace detail {
+        /// @brief Placeholder value for sets built on maps.
+        struct NoValue {
+        };
+    }
+
+    /// @brief Persistent hash set, stored as a hash array mapped trie.
+    /// @details Copying a set is O(1) and gives an independent snapshot.
+    ///   See @ref PersistentHashMap for how nodes are shared and updated.
+    /// @tparam K Type of key. Must be copyable and comparable with @c operator==.
+    /// @tparam Hash Function object that hashes keys.
+    template<typename K, typename Hash = Hasher<K>>
+    class PersistentHashSet {
+    public:
+        /// @brief Default constructor.
+        /// @details Creates an empty set without allocating.
+        PersistentHashSet() noexcept
+                : _map() {
+            // ...
+        }
+
+        /// @brief Checks whether a key is in the set.
+        /// @param key Key to look for.
+        /// @return True if the key is in the set.
+        bool contains(const K &key) const noexcept {
+            return _map.contains(key);
+        }
+
+        /// @brief Adds a key to the set.
+        /// @details Copies of the set made earlier are not affected.
+        /// @param key Key to add.
+        /// @return True if the key was added, false if it was already in the set.
+        bool insert(const K &key) noexcept {
+            return _map.insert(key, detail::NoValue());
+        }
+
+        /// @brief Removes a key from the set.
+        /// @details Copies of the set made earlier are not affected.
+        /// @param key Key to remove.
+        /// @return True if the key was removed, false if it wasn't in the set.
+        bool erase(const K &key) noexcept {
+            return _map.erase(key);
+        }
+
+        /// @brief Removes every key.
+        void clear() noexcept {
+            _map.clear();
+        }
+
+        /// @brief Retrieves the number of keys.
+        /// @return Number of keys in the set.
+        size_t size() const noexcept {
+            return _map.size();
+        }
+
+        /// @brief Checks whether the set has no keys.
+        /// @return True if the set is empty.
+        bool isEmpty() const noexcept {
+            return _map.isEmpty();
+        }
+
+        /// @brief Calls a function with each key, in no particular order.
+        /// @param visit Function to call with each key.
+        /// @tparam Visit Type of function to call.
+        template<typename Visit>
+        void forEach(Visit visit) const noexcept {
+            _map.forEach([&visit](const K &key, const detail::NoValue &) {
+                visit(key);
+            });
+        }
+
+    private:
+        PersistentHashMap<K, detail::NoValue, Hash> _map;
+    };
+}
+
+#endif // HYPER_PERSISTENT_HASH_SET_H
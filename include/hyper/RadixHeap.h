@@ -0,0 +1,201 @@
+/// @file RadixHeap.h
+/// Priority queue for integer keys that never go backwards.
+
+#ifndef HYPER_RADIX_HEAP_H
+#define HYPER_RADIX_HEAP_H
+
+#include <cstddef>   // For size_t.
+#include <new>       // For placement new.
+#include "assert.h"
+#include "integer.h"
+#include "utility.h"
+
+namespace hyper {
+    /// @brief Priority queue for monotone integer keys.
+    /// @details Keys must never be smaller than the last key taken from the top,
+    ///   which holds for Dijkstra's algorithm with non-negative edge weights
+    ///   and for event queues that only schedule into the future.
+    ///   In exchange, pushing is O(1) and popping is amortized O(log C) for key range C,
+    ///   without comparing elements against each other.
+    ///
+    ///   Elements are bucketed by the highest bit where their key differs from the last key taken from the top.
+    ///   When the top is needed and the lowest bucket is empty, the next non-empty bucket is split by its minimum,
+    ///   and every element in it moves to a strictly lower bucket, so each element moves at most 64 times.
+    /// @tparam T Type of value stored with each key.
+    template<typename T>
+    class RadixHeap {
+    public:
+        /// @brief Default constructor.
+        /// @details Creates an empty heap.
+        RadixHeap() noexcept
+                : _buckets(), _size(0), _last(0) {
+            // ...
+        }
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        RadixHeap(const RadixHeap &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Destroys the remaining values.
+        ~RadixHeap() noexcept {
+            clear();
+            for(auto &bucket : _buckets)
+                ::operator delete(bucket.entries);
+        }
+
+        /// @brief Adds a value.
+        /// @details The key is asserted to be no smaller than the last key taken from the top.
+        /// @param key Priority of the value. Smaller keys come first.
+        /// @param value Value to store.
+        void push(uint64 key, const T &value) noexcept {
+            T copy(value);
+            push(key, move(copy));
+        }
+
+        /// @brief Adds a value.
+        /// @details The key is asserted to be no smaller than the last key taken from the top.
+        /// @param key Priority of the value. Smaller keys come first.
+        /// @param value Value to move into the heap.
+        void push(uint64 key, T &&value) noexcept {
+            ASSERTF(key >= _last, "Radix heap keys must not decrease");
+            _buckets[bucketFor(key)].push(key, move(value));
+            _size++;
+        }
+
+        /// @brief Retrieves the smallest key.
+        /// @details The heap is asserted to not be empty.
+        /// @return Key at the top of the heap.
+        uint64 topKey() const noexcept {
+            ASSERTF(_size > 0, "Attempt to access the top of an empty heap");
+            refill();
+            return _last;
+        }
+
+        /// @brief Retrieves a value with the smallest key.
+        /// @details The heap is asserted to not be empty. Values with equal keys come out in any order.
+        /// @return Value at the top of the heap.
+        T &top() noexcept {
+            ASSERTF(_size > 0, "Attempt to access the top of an empty heap");
+            refill();
+            const auto &bucket = _buckets[0];
+            return bucket.entries[bucket.count - 1].value;
+        }
+
+        /// @copydoc top()
+        const T &top() const noexcept {
+            ASSERTF(_size > 0, "Attempt to access the top of an empty heap");
+            refill();
+            const auto &bucket = _buckets[0];
+            return bucket.entries[bucket.count - 1].value;
+        }
+
+        /// @brief Removes a value with the smallest key.
+        /// @details The heap is asserted to not be empty.
+        /// @return Removed value.
+        T pop() noexcept {
+            ASSERTF(_size > 0, "Attempt to pop from an empty heap");
+            refill();
+            auto &bucket = _buckets[0];
+            auto &entry = bucket.entries[--bucket.count];
+            T value(move(entry.value));
+            entry.~Entry();
+            _size--;
+            return value;
+        }
+
+        /// @brief Retrieves the number of values.
+        /// @return Number of values in the heap.
+        size_t size() const noexcept {
+            return _size;
+        }
+
+        /// @brief Checks whether the heap has no values.
+        /// @return True if the heap is empty.
+        bool isEmpty() const noexcept {
+            return _size == 0;
+        }
+
+        /// @brief Removes every value.
+        /// @details Memory is kept for reuse. Keys may start from zero again.
+        void clear() noexcept {
+            for(auto &bucket : _buckets) {
+                if constexpr(!IsTriviallyDestructible<Entry>::value)
+                    for(size_t i = 0; i < bucket.count; i++)
+                        bucket.entries[i].~Entry();
+                bucket.count = 0;
+            }
+            _size = 0;
+            _last = 0;
+        }
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        RadixHeap &operator=(const RadixHeap &other) = delete;
+
+    private:
+        struct Entry {
+            uint64 key;
+            T value;
+        };
+
+        struct Bucket {
+            Entry *entries = nullptr;
+            size_t count = 0;
+            size_t capacity = 0;
+
+            void push(uint64 key, T &&value) noexcept {
+                if(count == capacity) {
+                    capacity = capacity == 0 ? 16 : capacity * 2;
+                    auto resized = static_cast<Entry *>(::operator new(capacity * sizeof(Entry)));
+                    if constexpr(IsTriviallyRelocatable<T>::value) {
+                        if(count > 0)
+                            __builtin_memcpy(static_cast<void *>(resized), entries, count * sizeof(Entry));
+                    } else {
+                        for(size_t i = 0; i < count; i++) {
+                            new(&resized[i]) Entry{entries[i].key, move(entries[i].value)};
+                            entries[i].~Entry();
+                        }
+                    }
+                    ::operator delete(entries);
+                    entries = resized;
+                }
+                new(&entries[count++]) Entry{key, move(value)};
+            }
+        };
+
+        // Bucket 0 holds keys equal to the last key taken from the top,
+        // and bucket i holds keys whose highest bit that differs from it is bit i - 1.
+        // Buckets are split lazily when the top is read.
+        mutable Bucket _buckets[65];
+        size_t _size;
+        mutable uint64 _last;
+
+        size_t bucketFor(uint64 key) const noexcept {
+            return key == _last ? 0 : 64 - static_cast<size_t>(__builtin_clzll(key ^ _last));
+        }
+
+        void refill() const noexcept {
+            if(_buckets[0].count > 0)
+                return;
+            size_t index = 1;
+            while(_buckets[index].count == 0)
+                index++;
+            auto &bucket = _buckets[index];
+            uint64 minimum = bucket.entries[0].key;
+            for(size_t i = 1; i < bucket.count; i++)
+                if(bucket.entries[i].key < minimum)
+                    minimum = bucket.entries[i].key;
+            // Every key in the bucket differs from the new minimum in a lower bit, so they all move down.
+            _last = minimum;
+            for(size_t i = 0; i < bucket.count; i++) {
+                auto &entry = bucket.entries[i];
+                _buckets[bucketFor(entry.key)].push(entry.key, move(entry.value));
+                entry.~Entry();
+            }
+            bucket.count = 0;
+        }
+    };
+}
+
+#endif // HYPER_RADIX_HEAP_H
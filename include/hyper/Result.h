@@ -0,0 +1,225 @@
+/// @file Result.h
+/// Value or error returned by an operation that can fail.
+
+#ifndef HYPER_RESULT_H
+#define HYPER_RESULT_H
+
+#include <new>   // For placement new.
+#include "assert.h"
+#include "Error.h"
+#include "SharedPointer.h"
+#include "utility.h"
+
+namespace hyper {
+    /// @brief Outcome of an operation that can fail.
+    /// @details Holds either the value produced by the operation or the error that stopped it.
+    ///   This is used instead of throwing exceptions.
+    ///   Results convert implicitly from both a value and an error,
+    ///   so a function can simply return either one.
+    /// @tparam T Type of value produced on success.
+    template<typename T>
+    class Result {
+    public:
+        /// @brief General constructor.
+        /// @details Creates a successful result.
+        /// @param value Value produced by the operation.
+        Result(const T &value) noexcept
+                : _ok(true) {
+            new(&_value) T(value);
+        }
+
+        /// @brief General constructor.
+        /// @details Creates a successful result.
+        /// @param value Value produced by the operation.
+        Result(T &&value) noexcept
+                : _ok(true) {
+            new(&_value) T(move(value));
+        }
+
+        /// @brief General constructor.
+        /// @details Creates a failed result.
+        /// @param error Error that stopped the operation. Must not be null.
+        Result(const SharedPointer<Error> &error) noexcept
+                : _ok(false) {
+            ASSERTF((bool)error, "A failed result needs an error");
+            new(&_error) SharedPointer<Error>(error);
+        }
+
+        /// @brief Copy constructor.
+        /// @param other Existing result to copy.
+        Result(const Result &other) noexcept
+                : _ok(other._ok) {
+            if(_ok)
+                new(&_value) T(other._value);
+            else
+                new(&_error) SharedPointer<Error>(other._error);
+        }
+
+        /// @brief Move constructor.
+        /// @param other Existing result to take the contents of.
+        Result(Result &&other) noexcept
+                : _ok(other._ok) {
+            if(_ok)
+                new(&_value) T(move(other._value));
+            else
+                new(&_error) SharedPointer<Error>(move(other._error));
+        }
+
+        /// @brief Destructor.
+        /// @details Destroys the value or error.
+        ~Result() noexcept {
+            destroy();
+        }
+
+        /// @brief Checks whether the operation succeeded.
+        /// @return True if the result holds a value.
+        /// @return False if the result holds an error.
+        bool isOk() const noexcept {
+            return _ok;
+        }
+
+        /// @brief Explicit bool cast.
+        /// @details Checks whether the operation succeeded.
+        /// @return True if the result holds a value.
+        /// @return False if the result holds an error.
+        explicit operator bool() const noexcept {
+            return _ok;
+        }
+
+        /// @brief Retrieves the value produced by the operation.
+        /// @details The result is asserted to be successful.
+        /// @return Value held by the result.
+        T &value() noexcept {
+            ASSERTF(_ok, "Attempt to get the value of a failed result");
+            return _value;
+        }
+
+        /// @copydoc value()
+        const T &value() const noexcept {
+            ASSERTF(_ok, "Attempt to get the value of a failed result");
+            return _value;
+        }
+
+        /// @brief Retrieves the error that stopped the operation.
+        /// @details The result is asserted to have failed.
+        /// @return Error held by the result.
+        const SharedPointer<Error> &error() const noexcept {
+            ASSERTF(!_ok, "Attempt to get the error of a successful result");
+            return _error;
+        }
+
+        /// @brief Copy assignment operator.
+        /// @param other Existing result to copy.
+        /// @return Reference to this instance after it has been updated.
+        Result &operator=(const Result &other) noexcept {
+            if(this != &other) {
+                destroy();
+                new(this) Result(other);
+            }
+            return *this;
+        }
+
+        /// @brief Move assignment operator.
+        /// @param other Existing result to take the contents of.
+        /// @return Reference to this instance after it has been updated.
+        Result &operator=(Result &&other) noexcept {
+            if(this != &other) {
+                destroy();
+                new(this) Result(move(other));
+            }
+            return *this;
+        }
+
+    private:
+        union {
+            T _value;
+            SharedPointer<Error> _error;
+        };
+        bool _ok;
+
+        void destroy() noexcept {
+            if(_ok)
+                _value.~T();
+            else
+                _error.~SharedPointer<Error>();
+        }
+    };
+
+    /// @brief Outcome of an operation that can fail but doesn't produce a value.
+    template<>
+    class Result<void> {
+    public:
+        /// @brief Default constructor.
+        /// @details Creates a successful result.
+        Result() noexcept
+                : _ok(true) {
+            // ...
+        }
+
+        /// @brief General constructor.
+        /// @details Creates a failed result.
+        /// @param error Error that stopped the operation. Must not be null.
+        Result(const SharedPointer<Error> &error) noexcept
+                : _ok(false) {
+            ASSERTF((bool)error, "A failed result needs an error");
+            new(&_error) SharedPointer<Error>(error);
+        }
+
+        /// @brief Copy constructor.
+        /// @param other Existing result to copy.
+        Result(const Result &other) noexcept
+                : _ok(other._ok) {
+            if(!_ok)
+                new(&_error) SharedPointer<Error>(other._error);
+        }
+
+        /// @brief Destructor.
+        /// @details Destroys the error, if there is one.
+        ~Result() noexcept {
+            if(!_ok)
+                _error.~SharedPointer<Error>();
+        }
+
+        /// @brief Checks whether the operation succeeded.
+        /// @return True if the operation succeeded.
+        /// @return False if the result holds an error.
+        bool isOk() const noexcept {
+            return _ok;
+        }
+
+        /// @brief Explicit bool cast.
+        /// @details Checks whether the operation succeeded.
+        /// @return True if the operation succeeded.
+        /// @return False if the result holds an error.
+        explicit operator bool() const noexcept {
+            return _ok;
+        }
+
+        /// @brief Retrieves the error that stopped the operation.
+        /// @details The result is asserted to have failed.
+        /// @return Error held by the result.
+        const SharedPointer<Error> &error() const noexcept {
+            ASSERTF(!_ok, "Attempt to get the error of a successful result");
+            return _error;
+        }
+
+        /// @brief Copy assignment operator.
+        /// @param other Existing result to copy.
+        /// @return Reference to this instance after it has been updated.
+        Result &operator=(const Result &other) noexcept {
+            if(this != &other) {
+                this->~Result();
+                new(this) Result(other);
+            }
+            return *this;
+        }
+
+    private:
+        union {
+            SharedPointer<Error> _error;
+        };
+        bool _ok;
+    };
+}
+
+#endif // HYPER_RESULT_H
@@ -0,0 +1,144 @@
+/// @file Rope.h
+/// Editable byte buffer for large texts, with cheap snapshots.
+
+#ifndef HYPER_ROPE_H
+#define HYPER_ROPE_H
+
+#include <cstddef>   // For size_t.
+#include "byte.h"
+
+namespace hyper {
+    namespace detail {
+        struct RopeNode;
+    }
+
+    /// @brief Byte buffer stored as a B-tree of chunks, built for large texts that are edited in place.
+    /// @details Bytes are kept in leaf chunks of about 2 KB, and each branch node holds up to 16 children
+    ///   along with the number of bytes and newlines under each of them.
+    ///   Finding a position or a line walks down the tree using those counts, so inserting, erasing,
+    ///   reading at a position and converting between positions and lines are all O(log n),
+    ///   however large the buffer grows. Leaves that become small after an erase are merged with their neighbors.
+    ///
+    ///   Nodes are reference counted and shared, so copying a rope is O(1) and gives an independent snapshot,
+    ///   such as for undo history. An edit copies only the nodes on its path that are shared with a snapshot;
+    ///   nodes this rope holds the only reference to are changed in place.
+    ///   Reference counts are atomic, so ropes sharing nodes can be used from different threads.
+    ///   A single rope must not be edited by one thread while another uses it.
+    class Rope {
+    public:
+        /// @brief Default constructor.
+        /// @details Creates an empty rope without allocating.
+        Rope() noexcept;
+
+        /// @brief General constructor.
+        /// @details Creates a rope holding a copy of some bytes.
+        ///   The tree is built bottom-up with full leaves, which is faster and more compact than appending.
+        /// @param data Bytes to copy.
+        /// @param size Number of bytes in @p data.
+        Rope(const byte *data, size_t size) noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Takes a snapshot of another rope, sharing all of its nodes.
+        /// @param other Rope to copy.
+        Rope(const Rope &other) noexcept;
+
+        /// @brief Move constructor.
+        /// @details Leaves the other rope empty.
+        /// @param other Rope to take the contents of.
+        Rope(Rope &&other) noexcept;
+
+        /// @brief Destructor.
+        /// @details Frees the nodes that aren't shared with another rope.
+        ~Rope() noexcept;
+
+        /// @brief Retrieves the number of bytes.
+        /// @return Length of the rope in bytes.
+        size_t size() const noexcept;
+
+        /// @brief Checks whether the rope has no bytes.
+        /// @return True if the rope is empty.
+        bool isEmpty() const noexcept {
+            return _root == nullptr;
+        }
+
+        /// @brief Retrieves the number of lines.
+        /// @details Lines are separated by newline bytes, so this is one more than the number of newlines.
+        ///   An empty rope has one empty line.
+        /// @return Number of lines.
+        size_t lineCount() const noexcept;
+
+        /// @brief Finds where a line starts.
+        /// @param line Index of the line, counting from zero. Must be less than @ref lineCount().
+        /// @return Position of the first byte of the line.
+        size_t lineStart(size_t line) const noexcept;
+
+        /// @brief Finds which line a position is on.
+        /// @param position Position in the rope, up to and including @ref size().
+        /// @return Index of the line, which is the number of newlines before @p position.
+        size_t lineOf(size_t position) const noexcept;
+
+        /// @brief Accesses the contiguous bytes stored at a position.
+        /// @details Walking a rope chunk by chunk is the fastest way to read it:
+        ///   @code
+        ///   for(size_t position = 0, length; position < rope.size(); position += length)
+        ///       process(rope.chunk(position, length), length);
+        ///   @endcode
+        /// @param position Position of the first byte. Must be less than @ref size().
+        /// @param[out] length Set to the number of bytes that follow in the same chunk, including the first.
+        /// @return Pointer to the byte at @p position. Valid until this rope is edited or destroyed.
+        const byte *chunk(size_t position, size_t &length) const noexcept;
+
+        /// @brief Copies bytes out of the rope.
+        /// @param position Position of the first byte to copy.
+        /// @param[out] output Destination for the bytes.
+        /// @param size Maximum number of bytes to copy.
+        /// @return Number of bytes copied, which is less than @p size if the end of the rope is reached.
+        size_t read(size_t position, byte *output, size_t size) const noexcept;
+
+        /// @brief Inserts bytes.
+        /// @param position Position to insert at, up to and including @ref size().
+        /// @param data Bytes to insert.
+        /// @param size Number of bytes in @p data.
+        void insert(size_t position, const byte *data, size_t size) noexcept;
+
+        /// @brief Adds bytes to the end.
+        /// @param data Bytes to add.
+        /// @param size Number of bytes in @p data.
+        void append(const byte *data, size_t size) noexcept {
+            insert(this->size(), data, size);
+        }
+
+        /// @brief Removes bytes.
+        /// @param position Position of the first byte to remove.
+        /// @param size Number of bytes to remove. The range must be within the rope.
+        void erase(size_t position, size_t size) noexcept;
+
+        /// @brief Removes every byte.
+        void clear() noexcept;
+
+        /// @brief Retrieves a byte.
+        /// @param position Position of the byte. Must be less than @ref size().
+        /// @return Byte at the position.
+        byte operator[](size_t position) const noexcept {
+            size_t length;
+            return *chunk(position, length);
+        }
+
+        /// @brief Assignment operator.
+        /// @details Takes a snapshot of another rope, releasing this rope's nodes.
+        /// @param other Rope to copy.
+        /// @return This rope.
+        Rope &operator=(const Rope &other) noexcept;
+
+        /// @brief Move assignment operator.
+        /// @details Leaves the other rope empty.
+        /// @param other Rope to take the contents of.
+        /// @return This rope.
+        Rope &operator=(Rope &&other) noexcept;
+
+    private:
+        detail::RopeNode *_root;
+    };
+}
+
+#endif // HYPER_ROPE_H
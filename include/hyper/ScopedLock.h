@@ -0,0 +1,41 @@
+/// @file ScopedLock.h
+/// Holds a lock for the scope it is declared in.
+
+#ifndef HYPER_SCOPED_LOCK_H
+#define HYPER_SCOPED_LOCK_H
+
+namespace hyper {
+    /// @brief Acquires a lock and releases it at the end of the scope.
+    /// @details This operates on the RAII principle, so the lock is released on every path out of the scope.
+    /// @tparam Lock Type of lock to hold. It must have @c lock() and @c unlock() methods.
+    template<typename Lock>
+    class ScopedLock {
+    public:
+        /// @brief General constructor.
+        /// @details Acquires the lock, waiting until it is available.
+        /// @param lock Lock to hold.
+        explicit ScopedLock(Lock &lock) noexcept
+                : _lock(lock) {
+            _lock.lock();
+        }
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        ScopedLock(const ScopedLock &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Releases the lock.
+        ~ScopedLock() noexcept {
+            _lock.unlock();
+        }
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        ScopedLock &operator=(const ScopedLock &other) = delete;
+
+    private:
+        Lock &_lock;
+    };
+}
+
+#endif // HYPER_SCOPED_LOCK_H
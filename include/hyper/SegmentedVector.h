@@ -0,0 +1,209 @@
+/// @file SegmentedVector.h
+/// Growable array whose elements never move.
+
+#ifndef HYPER_SEGMENTED_VECTOR_H
+#define HYPER_SEGMENTED_VECTOR_H
+
+#include <cstddef>   // For size_t.
+#include <new>       // For placement new.
+#include "assert.h"
+#include "utility.h"
+
+namespace hyper {
+    /// @brief Array that grows by adding segments instead of reallocating, so element addresses are stable.
+    /// @details Segment @c k holds @c firstSegmentSize * 2^k elements, so the segments double in size
+    ///   and a fixed table of segment pointers covers every possible index.
+    ///   Finding an element is a count-leading-zeros and a subtraction; there is no loop and no search.
+    ///   Since the table itself never moves, pointers and references to elements stay valid as the array grows,
+    ///   which makes this a good backing store for pools that hand out raw pointers.
+    ///
+    ///   Any number of threads can append at once without waiting on each other. Each append claims an index
+    ///   with one atomic add, installs the segment with a compare-and-swap if it is the first to reach it,
+    ///   constructs the element and sets that slot's constructed flag. A stalled append therefore only
+    ///   holds back its own slot: @ref size() counts every claimed slot, and a reader that runs while others
+    ///   keep appending checks @ref isConstructed() before touching an element.
+    /// @tparam T Type of element stored.
+    template<typename T>
+    class SegmentedVector {
+    public:
+        /// @brief Number of elements in the first segment.
+        static constexpr size_t firstSegmentSize = 16;
+
+        /// @brief Default constructor.
+        /// @details Creates an empty array without allocating.
+        SegmentedVector() noexcept
+                : _segments(), _size(0) {
+            // ...
+        }
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        SegmentedVector(const SegmentedVector &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Destroys the elements and frees the segments, along with their constructed flags.
+        ~SegmentedVector() noexcept {
+            clear();
+            for(auto &segment : _segments)
+                ::operator delete(segment);
+        }
+
+        /// @brief Appends an element.
+        /// @details Safe to call from several threads at once.
+        /// @param element Element to copy into the array.
+        /// @return Appended element, which stays at the same address for the life of the array.
+        T &pushBack(const T &element) noexcept {
+            T copy(element);
+            return pushBack(move(copy));
+        }
+
+        /// @brief Appends an element.
+        /// @details Safe to call from several threads at once.
+        /// @param element Element to move into the array.
+        /// @return Appended element, which stays at the same address for the life of the array.
+        T &pushBack(T &&element) noexcept {
+            const auto index = __atomic_fetch_add(&_size, 1, __ATOMIC_RELAXED);
+            size_t offset;
+            const auto segment = locate(index, offset);
+            auto storage = __atomic_load_n(&_segments[segment], __ATOMIC_ACQUIRE);
+            if(storage == nullptr) {
+                const auto allocated = allocateSegment(segment);
+                if(__atomic_compare_exchange_n(&_segments[segment], &storage, allocated, false,
+                                               __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+                    storage = allocated;
+                else
+                    ::operator delete(allocated);
+            }
+            auto slot = new(&storage[offset]) T(move(element));
+            __atomic_store_n(&flags(storage, segment)[offset], true, __ATOMIC_RELEASE);
+            return *slot;
+        }
+
+        /// @brief Retrieves the number of elements.
+        /// @details Counts every slot an append has claimed. While appends are still running,
+        ///   some of those slots may not be constructed yet; see @ref isConstructed().
+        ///   Once every appending thread has finished, every element below this count is constructed.
+        /// @return Number of elements claimed.
+        size_t size() const noexcept {
+            return __atomic_load_n(&_size, __ATOMIC_ACQUIRE);
+        }
+
+        /// @brief Checks whether the element at an index has finished being constructed.
+        /// @details A true result makes the element safe to read from any thread.
+        /// @param index Index of the element.
+        /// @return True if the element can be read.
+        bool isConstructed(size_t index) const noexcept {
+            if(index >= size())
+                return false;
+            size_t offset;
+            const auto segment = locate(index, offset);
+            const auto storage = __atomic_load_n(&_segments[segment], __ATOMIC_ACQUIRE);
+            return storage != nullptr && __atomic_load_n(&flags(storage, segment)[offset], __ATOMIC_ACQUIRE);
+        }
+
+        /// @brief Checks whether the array has no elements.
+        /// @return True if the array is empty.
+        bool isEmpty() const noexcept {
+            return size() == 0;
+        }
+
+        /// @brief Removes every element.
+        /// @details Segments are kept for reuse. No other thread may be using the array.
+        void clear() noexcept {
+            size_t index = 0;
+            for(size_t segment = 0; index < _size; segment++) {
+                const auto storage = _segments[segment];
+                const auto end = index + segmentSize(segment) < _size ? index + segmentSize(segment) : _size;
+                for(size_t offset = 0; index < end; index++, offset++) {
+                    if constexpr(!IsTriviallyDestructible<T>::value)
+                        storage[offset].~T();
+                    flags(storage, segment)[offset] = false;
+                }
+            }
+            _size = 0;
+        }
+
+        /// @brief Calls a function with each constructed element in order.
+        /// @details Walks one segment at a time, which is faster than indexing each element.
+        ///   Slots that are claimed but still being constructed by another thread are skipped.
+        /// @param visit Function to call with a reference to each element.
+        /// @tparam Visit Type of function to call.
+        template<typename Visit>
+        void forEach(Visit visit) noexcept {
+            const auto count = size();
+            size_t index = 0;
+            for(size_t segment = 0; index < count; segment++) {
+                const auto storage = __atomic_load_n(&_segments[segment], __ATOMIC_ACQUIRE);
+                const auto end = index + segmentSize(segment) < count ? index + segmentSize(segment) : count;
+                if(storage == nullptr) {
+                    index = end;
+                    continue;
+                }
+                const auto constructed = flags(storage, segment);
+                for(size_t offset = 0; index < end; index++, offset++)
+                    if(__atomic_load_n(&constructed[offset], __ATOMIC_ACQUIRE))
+                        visit(storage[offset]);
+            }
+        }
+
+        /// @brief Retrieves an element by index.
+        /// @param index Index of the element, which must be constructed.
+        /// @return Element at the index.
+        T &operator[](size_t index) noexcept {
+            ASSERTF(isConstructed(index), "Segmented vector index %zu out of range or not constructed", index);
+            size_t offset;
+            const auto segment = locate(index, offset);
+            return __atomic_load_n(&_segments[segment], __ATOMIC_ACQUIRE)[offset];
+        }
+
+        /// @copydoc operator[]()
+        const T &operator[](size_t index) const noexcept {
+            ASSERTF(isConstructed(index), "Segmented vector index %zu out of range or not constructed", index);
+            size_t offset;
+            const auto segment = locate(index, offset);
+            return __atomic_load_n(&_segments[segment], __ATOMIC_ACQUIRE)[offset];
+        }
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        SegmentedVector &operator=(const SegmentedVector &other) = delete;
+
+    private:
+        static constexpr size_t firstSegmentShift = 4;
+        static_assert(size_t(1) << firstSegmentShift == firstSegmentSize, "First segment size must match its shift");
+
+        // Enough segments to cover every index a size_t can hold.
+        static constexpr size_t segmentCount = sizeof(size_t) * 8 - firstSegmentShift;
+
+        T *_segments[segmentCount];
+        size_t _size;
+
+        static constexpr size_t segmentSize(size_t segment) noexcept {
+            return firstSegmentSize << segment;
+        }
+
+        // Each segment's constructed flags sit right after its elements, in the same allocation.
+        static bool *flags(T *storage, size_t segment) noexcept {
+            return reinterpret_cast<bool *>(storage + segmentSize(segment));
+        }
+
+        static T *allocateSegment(size_t segment) noexcept {
+            const auto count = segmentSize(segment);
+            const auto storage = static_cast<T *>(::operator new(count * (sizeof(T) + sizeof(bool))));
+            const auto constructed = flags(storage, segment);
+            for(size_t i = 0; i < count; i++)
+                constructed[i] = false;
+            return storage;
+        }
+
+        // Offsetting the index by the first segment's size makes each segment start at a power of two.
+        static size_t locate(size_t index, size_t &offset) noexcept {
+            const auto biased = index + firstSegmentSize;
+            const auto bit = sizeof(size_t) * 8 - 1 - static_cast<size_t>(__builtin_clzl(biased));
+            offset = biased - (size_t(1) << bit);
+            return bit - firstSegmentShift;
+        }
+    };
+}
+
+#endif // HYPER_SEGMENTED_VECTOR_H
@@ -0,0 +1,56 @@
+/// @file Semaphore.h
+/// Counting semaphore.
+
+#ifndef HYPER_SEMAPHORE_H
+#define HYPER_SEMAPHORE_H
+
+#include "integer.h"
+
+namespace hyper {
+    /// @brief Count of available permits that threads can wait on.
+    /// @details Acquiring takes a permit, sleeping until one is available, and releasing gives permits back.
+    ///   This is useful for bounding queues and limiting how many threads use a resource at once.
+    ///
+    ///   Acquiring and releasing are a single atomic operation when no thread has to sleep.
+    ///   Releasing only makes a system call if a thread is asleep.
+    class Semaphore {
+    public:
+        /// @brief General constructor.
+        /// @param initial Number of permits available to start with.
+        explicit Semaphore(uint32 initial = 0) noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        Semaphore(const Semaphore &other) = delete;
+
+        /// @brief Retrieves the number of available permits.
+        /// @return Number of permits, which may already be out of date.
+        uint32 value() const noexcept;
+
+        /// @brief Takes a permit, sleeping until one is available.
+        void acquire() noexcept;
+
+        /// @brief Takes a permit if one is available, without sleeping.
+        /// @return True if a permit was taken.
+        bool tryAcquire() noexcept;
+
+        /// @brief Takes a permit, sleeping for a limited time until one is available.
+        /// @param nanoseconds Longest time to wait.
+        /// @return True if a permit was taken, false if the time ran out.
+        bool tryAcquireFor(uint64 nanoseconds) noexcept;
+
+        /// @brief Gives back permits, waking threads waiting for them.
+        /// @param count Number of permits to give back.
+        void release(uint32 count = 1) noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        Semaphore &operator=(const Semaphore &other) = delete;
+
+    private:
+        uint32 _count;
+        uint32 _waiters;
+    };
+}
+
+#endif // HYPER_SEMAPHORE_H
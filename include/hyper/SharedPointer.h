@@ -64,7 +64,8 @@ namespace hyper {
         /// @param other Existing pointer to reference.
         /// @tparam Subtype Compatible pointer type.
         template<typename Subtype>
-        explicit SharedPointer(SharedPointer<Subtype> &&other) noexcept {
+        explicit SharedPointer(SharedPointer<Subtype> &&other) noexcept
+                : _counter(nullptr), _rawPointer(nullptr) {
             other.release(_counter, _rawPointer);
         }
 
@@ -131,6 +132,17 @@ namespace hyper {
             return _rawPointer;
         }
 
+        /// @brief Retrieves the number of shared pointers referencing the same instance.
+        /// @details Safe to call while other threads copy and destroy pointers to the instance.
+        ///   The count is loaded with acquire ordering, so a result of one means every other reference
+        ///   has been dropped and the writes made through them are visible.
+        ///   Since only a holder of a reference can create another, a count of one stays one
+        ///   until this pointer is copied.
+        /// @return Number of references, or zero if this pointer has been moved from.
+        size_t useCount() const noexcept {
+            return _counter == nullptr ? 0 : _counter->value();
+        }
+
         /// @brief Explicit bool cast.
         /// @details Checks if the pointer can be safely de-referenced (is not null).
         /// @return True if the pointer is not null, or false if it is null.
@@ -268,7 +280,8 @@ namespace hyper {
         /// @param other Existing pointer to reference.
         /// @tparam Subtype Compatible pointer type.
         template<typename Subtype>
-        explicit SharedPointer(SharedPointer<Subtype> &&other) noexcept {
+        explicit SharedPointer(SharedPointer<Subtype> &&other) noexcept
+                : _counter(nullptr), _rawPointer(nullptr) {
             other.release(_counter, _rawPointer);
         }
 
@@ -337,6 +350,17 @@ namespace hyper {
             return _rawPointer[index];
         }
 
+        /// @brief Retrieves the number of shared pointers referencing the same instance.
+        /// @details Safe to call while other threads copy and destroy pointers to the instance.
+        ///   The count is loaded with acquire ordering, so a result of one means every other reference
+        ///   has been dropped and the writes made through them are visible.
+        ///   Since only a holder of a reference can create another, a count of one stays one
+        ///   until this pointer is copied.
+        /// @return Number of references, or zero if this pointer has been moved from.
+        size_t useCount() const noexcept {
+            return _counter == nullptr ? 0 : _counter->value();
+        }
+
         /// @brief Explicit bool cast.
         /// @details Checks if the pointer can be safely de-referenced (is not null).
         /// @return True if the pointer is not null, or false if it is null.
@@ -430,6 +454,14 @@ namespace hyper {
         first.swap(second);
     };
 
+    /// @brief Shared pointers are trivially relocatable.
+    /// @details Nothing refers back to a shared pointer's own address,
+    ///   so moving one is the same as copying its two pointers and forgetting the original.
+    /// @tparam T Type the smart pointer references.
+    template<typename T>
+    struct IsTriviallyRelocatable<SharedPointer<T>> : BoolConstant<true> {
+    };
+
     /// @brief Utility method for creating shared pointers.
     /// @details Infers pointer types and creates a shared pointer for them.
     /// @param ptr Raw pointer to wrap.
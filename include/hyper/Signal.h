@@ -0,0 +1,410 @@
+/// @file Signal.h
+/// Broadcasting calls to many listeners.
+
+#ifndef HYPER_SIGNAL_H
+#define HYPER_SIGNAL_H
+
+#include <cstddef>   // For size_t.
+#include <new>       // For placement new.
+#include "integer.h"
+#include "utility.h"
+
+namespace hyper {
+    namespace detail {
+        /// @brief Copies of a list of values, used to hold the arguments of a queued call.
+        /// @tparam Values Types of the values to hold.
+        template<typename... Values>
+        struct StoredArguments {
+            template<typename Target, typename... Prefix>
+            void apply(Target &target, Prefix &...prefix) {
+                target(prefix...);
+            }
+        };
+
+        template<typename First, typename... Rest>
+        struct StoredArguments<First, Rest...> {
+            First first;
+            StoredArguments<Rest...> rest;
+
+            template<typename FirstArg, typename... RestArgs>
+            explicit StoredArguments(FirstArg &&firstArg, RestArgs &&...restArgs)
+                    : first(forward<FirstArg>(firstArg)), rest(forward<RestArgs>(restArgs)...) {
+                // ...
+            }
+
+            template<typename Target, typename... Prefix>
+            void apply(Target &target, Prefix &...prefix) {
+                rest.apply(target, prefix..., first);
+            }
+        };
+    }
+
+    /// @brief Base signal class.
+    /// @details This class and type parameters allow for abbreviated syntax for signals.
+    /// @tparam Signature Listener signature in the form: void(ARGUMENT_TYPES...)
+    template<typename Signature>
+    class Signal {
+        // ...
+    };
+
+    /// @brief Calls every connected listener when it is emitted.
+    /// @details Listeners are any callable that accepts the arguments, including @ref Function.
+    ///   Small listeners (up to four pointers in size) are stored inline in fixed-size chunks of slots,
+    ///   so connecting one doesn't allocate once the chunk exists and emitting walks contiguous memory
+    ///   with one indirect call per listener.
+    ///   Larger listeners are allocated separately.
+    ///
+    ///   Connecting returns a @ref Connection handle that disconnects the listener in constant time.
+    ///   Each slot has a generation that changes when its listener is disconnected,
+    ///   so a stale handle can never disconnect a listener that later reused the slot.
+    ///
+    ///   Listeners may connect and disconnect listeners, or emit the signal again, while it is being emitted.
+    ///   Listeners connected during an emit are first called by the next one.
+    ///   Listeners disconnected during an emit are not called again, and are destroyed once the emit finishes,
+    ///   so a listener can safely disconnect itself.
+    ///   A listener must not destroy the signal that is calling it.
+    ///
+    ///   Calls can also be queued with @ref enqueue() and delivered together with @ref flush(),
+    ///   for instance once per frame.
+    ///
+    ///   Signals are not thread-safe.
+    /// @tparam Args Types for the arguments passed to listeners.
+    template<typename... Args>
+    class Signal<void(Args...)> {
+    public:
+        /// @brief Handle for disconnecting a listener.
+        /// @details Handles are small values that can be copied freely.
+        ///   A default-constructed handle doesn't refer to any listener.
+        class Connection {
+        public:
+            /// @brief Default constructor.
+            /// @details Creates a handle that doesn't refer to any listener.
+            constexpr Connection() noexcept
+                    : _index(0), _generation(0) {
+                // ...
+            }
+
+            /// @brief Equality operator.
+            /// @param other Other handle to compare against.
+            /// @return True if the handles refer to the same connection.
+            constexpr bool operator==(const Connection &other) const noexcept {
+                return _index == other._index && _generation == other._generation;
+            }
+
+            /// @brief Inequality operator.
+            /// @param other Other handle to compare against.
+            /// @return True if the handles refer to different connections.
+            constexpr bool operator!=(const Connection &other) const noexcept {
+                return !(*this == other);
+            }
+
+        private:
+            friend class Signal;
+
+            uint32 _index;
+            uint32 _generation;
+
+            constexpr Connection(uint32 index, uint32 generation) noexcept
+                    : _index(index), _generation(generation) {
+                // ...
+            }
+        };
+
+        /// @brief Default constructor.
+        /// @details Creates a signal with no listeners.
+        Signal() noexcept
+                : _chunks(nullptr), _chunkCount(0), _slotCount(0), _listenerCount(0),
+                  _freeHead(none), _pendingHead(none), _emitDepth(0),
+                  _queue(nullptr), _queueCount(0), _queueCapacity(0) {
+            // ...
+        }
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        Signal(const Signal &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Destroys the listeners and discards any queued calls.
+        ~Signal() noexcept {
+            destroyQueue(_queue, _queueCount);
+            for(uint32 i = 0; i < _slotCount; i++) {
+                auto &slot = slotAt(i);
+                if(slot.state != SlotState::free)
+                    slot.destroy(slot.storage);
+            }
+            for(uint32 i = 0; i < _chunkCount; i++)
+                delete[] _chunks[i];
+            delete[] _chunks;
+        }
+
+        /// @brief Adds a listener.
+        /// @param listener Callable to call with the arguments each time the signal is emitted.
+        /// @return Handle for disconnecting the listener.
+        /// @tparam Listener Type of callable.
+        template<typename Listener>
+        Connection connect(Listener listener) noexcept {
+            uint32 index;
+            if(_freeHead != none && _emitDepth == 0) {
+                // Reusing slots while emitting could call the new listener in the current emit.
+                index = _freeHead;
+                _freeHead = slotAt(index).nextFree;
+            } else {
+                if((_slotCount & chunkMask) == 0)
+                    addChunk();
+                index = _slotCount++;
+            }
+
+            auto &slot = slotAt(index);
+            if constexpr(sizeof(Listener) <= inlineSize && alignof(Listener) <= storageAlignment) {
+                new(slot.storage) Listener(move(listener));
+                slot.invoke  = &invokeInline<Listener>;
+                slot.destroy = &destroyInline<Listener>;
+            } else {
+                new(slot.storage) Listener *(new Listener(move(listener)));
+                slot.invoke  = &invokeAllocated<Listener>;
+                slot.destroy = &destroyAllocated<Listener>;
+            }
+            slot.state = SlotState::active;
+            _listenerCount++;
+            return Connection(index, slot.generation);
+        }
+
+        /// @brief Removes a listener.
+        /// @param connection Handle returned by @ref connect().
+        /// @return True if the listener was removed.
+        /// @return False if the handle doesn't refer to a connected listener.
+        bool disconnect(Connection connection) noexcept {
+            if(!isConnected(connection))
+                return false;
+            release(connection._index);
+            return true;
+        }
+
+        /// @brief Checks whether a listener is still connected.
+        /// @param connection Handle returned by @ref connect().
+        /// @return True if the listener is connected.
+        /// @return False if the listener was disconnected or the handle is empty.
+        bool isConnected(Connection connection) const noexcept {
+            if(connection._index >= _slotCount)
+                return false;
+            const auto &slot = slotAt(connection._index);
+            return slot.state == SlotState::active && slot.generation == connection._generation;
+        }
+
+        /// @brief Removes every listener.
+        void disconnectAll() noexcept {
+            for(uint32 i = 0; i < _slotCount; i++)
+                if(slotAt(i).state == SlotState::active)
+                    release(i);
+        }
+
+        /// @brief Counts the connected listeners.
+        /// @return Number of listeners that will be called by the next emit.
+        size_t listenerCount() const noexcept {
+            return _listenerCount;
+        }
+
+        /// @brief Calls every listener.
+        /// @details Listeners are called in the order they occupy slots, which is not necessarily
+        ///   the order they were connected in once listeners have been disconnected.
+        /// @param args Arguments to pass to each listener.
+        void emit(Args... args) noexcept {
+            _emitDepth++;
+            const auto count = _slotCount;
+            for(uint32 i = 0; i < count; i++) {
+                auto &slot = slotAt(i);
+                if(slot.state == SlotState::active)
+                    slot.invoke(slot.storage, args...);
+            }
+            if(--_emitDepth == 0)
+                collect();
+        }
+
+        /// @brief Functor operator.
+        /// @details Calls every listener, the same as @ref emit().
+        /// @param args Arguments to pass to each listener.
+        void operator()(Args... args) noexcept {
+            emit(args...);
+        }
+
+        /// @brief Queues a call to deliver later.
+        /// @details The arguments are copied and held until @ref flush() is called.
+        /// @param args Arguments to pass to each listener.
+        void enqueue(Args... args) noexcept {
+            if(_queueCount == _queueCapacity) {
+                const size_t capacity = _queueCapacity == 0 ? 8 : _queueCapacity * 2;
+                auto queue = new QueuedCall[capacity];
+                for(size_t i = 0; i < _queueCount; i++)
+                    new(queue[i].bytes) Arguments(move(_queue[i].get()));
+                destroyQueue(_queue, _queueCount);
+                _queue = queue;
+                _queueCapacity = capacity;
+            }
+            new(_queue[_queueCount++].bytes) Arguments(args...);
+        }
+
+        /// @brief Counts the queued calls.
+        /// @return Number of calls waiting for @ref flush().
+        size_t queuedCount() const noexcept {
+            return _queueCount;
+        }
+
+        /// @brief Delivers every queued call in the order they were queued.
+        /// @details Calls queued by listeners during the flush are held for the next flush.
+        void flush() noexcept {
+            auto queue = _queue;
+            const auto count = _queueCount;
+            const auto capacity = _queueCapacity;
+            _queue = nullptr;
+            _queueCount = _queueCapacity = 0;
+
+            auto deliver = [this](auto &...values) { emit(values...); };
+            for(size_t i = 0; i < count; i++)
+                queue[i].get().apply(deliver);
+
+            // Keep the buffer for next time unless listeners queued more calls while it was being delivered.
+            if(_queue == nullptr) {
+                for(size_t i = 0; i < count; i++)
+                    queue[i].get().~Arguments();
+                _queue = queue;
+                _queueCapacity = capacity;
+            } else {
+                destroyQueue(queue, count);
+            }
+        }
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        Signal &operator=(const Signal &other) = delete;
+
+    private:
+        /// @brief Marks the end of a list of slots.
+        static constexpr uint32 none = ~uint32(0);
+
+        /// @brief Largest listener that is stored inside its slot.
+        static constexpr size_t inlineSize = 4 * sizeof(void *);
+
+        /// @brief Alignment of the inline listener storage.
+        static constexpr size_t storageAlignment = alignof(double) > alignof(void *) ? alignof(double) : alignof(void *);
+
+        /// @brief Number of bits of a slot index that pick the slot within a chunk.
+        static constexpr uint32 chunkBits = 4;
+        static constexpr uint32 chunkMask = (uint32(1) << chunkBits) - 1;
+
+        enum class SlotState : uint8 {
+            free,
+            active,
+            removed
+        };
+
+        /// @brief Storage for one listener.
+        struct Slot {
+            alignas(storageAlignment) unsigned char storage[inlineSize];
+            void (*invoke)(void *, Args...);
+            void (*destroy)(void *);
+            uint32 generation = 1;
+            uint32 nextFree = none;
+            SlotState state = SlotState::free;
+        };
+
+        using Arguments = detail::StoredArguments<typename RemoveReference<Args>::type...>;
+
+        /// @brief Uninitialized storage for the arguments of one queued call.
+        struct alignas(Arguments) QueuedCall {
+            unsigned char bytes[sizeof(Arguments)];
+
+            Arguments &get() noexcept {
+                return *reinterpret_cast<Arguments *>(bytes);
+            }
+        };
+
+        Slot **_chunks;
+        uint32 _chunkCount;
+        uint32 _slotCount;
+        uint32 _listenerCount;
+        uint32 _freeHead;
+        uint32 _pendingHead;
+        uint32 _emitDepth;
+        QueuedCall *_queue;
+        size_t _queueCount;
+        size_t _queueCapacity;
+
+        template<typename Listener>
+        static void invokeInline(void *storage, Args... args) {
+            (*static_cast<Listener *>(storage))(args...);
+        }
+
+        template<typename Listener>
+        static void destroyInline(void *storage) {
+            static_cast<Listener *>(storage)->~Listener();
+        }
+
+        template<typename Listener>
+        static void invokeAllocated(void *storage, Args... args) {
+            (**static_cast<Listener **>(storage))(args...);
+        }
+
+        template<typename Listener>
+        static void destroyAllocated(void *storage) {
+            delete *static_cast<Listener **>(storage);
+        }
+
+        Slot &slotAt(uint32 index) const noexcept {
+            return _chunks[index >> chunkBits][index & chunkMask];
+        }
+
+        /// @brief Allocates another chunk of slots.
+        /// @details Chunks never move, so listeners stay put while the signal is emitting.
+        void addChunk() noexcept {
+            // The chunk table is only reallocated when its size reaches a power of two.
+            if((_chunkCount & (_chunkCount - 1)) == 0) {
+                auto chunks = new Slot *[_chunkCount == 0 ? 1 : _chunkCount * 2];
+                for(uint32 i = 0; i < _chunkCount; i++)
+                    chunks[i] = _chunks[i];
+                delete[] _chunks;
+                _chunks = chunks;
+            }
+            _chunks[_chunkCount++] = new Slot[chunkMask + 1];
+        }
+
+        /// @brief Disconnects the listener in a slot.
+        /// @details While emitting, the listener may be running, so it is only destroyed once the emit finishes.
+        void release(uint32 index) noexcept {
+            auto &slot = slotAt(index);
+            if(++slot.generation == 0)
+                slot.generation = 1;
+            _listenerCount--;
+            if(_emitDepth > 0) {
+                slot.state = SlotState::removed;
+                slot.nextFree = _pendingHead;
+                _pendingHead = index;
+                return;
+            }
+            slot.destroy(slot.storage);
+            slot.state = SlotState::free;
+            slot.nextFree = _freeHead;
+            _freeHead = index;
+        }
+
+        /// @brief Destroys listeners that were disconnected during an emit.
+        void collect() noexcept {
+            while(_pendingHead != none) {
+                const auto index = _pendingHead;
+                auto &slot = slotAt(index);
+                _pendingHead = slot.nextFree;
+                slot.destroy(slot.storage);
+                slot.state = SlotState::free;
+                slot.nextFree = _freeHead;
+                _freeHead = index;
+            }
+        }
+
+        static void destroyQueue(QueuedCall *queue, size_t count) noexcept {
+            for(size_t i = 0; i < count; i++)
+                queue[i].get().~Arguments();
+            delete[] queue;
+        }
+    };
+}
+
+#endif // HYPER_SIGNAL_H
@@ -0,0 +1,91 @@
+/// @file SpinLock.h
+/// Lightweight lock for short critical sections.
+
+#ifndef HYPER_SPIN_LOCK_H
+#define HYPER_SPIN_LOCK_H
+
+#include "simd.h"
+
+#if defined(_WIN32)
+extern "C" __declspec(dllimport) int __stdcall SwitchToThread();
+#else
+#include <sched.h>   // For sched_yield().
+#endif
+
+namespace hyper {
+    /// @brief Tells the processor that the current thread is waiting in a spin loop.
+    /// @details This saves power and frees execution resources for a sibling hyper-thread.
+    inline void cpuRelax() noexcept {
+#if defined(HYPER_SIMD_AVX2) || defined(HYPER_SIMD_SSE2)
+        _mm_pause();
+#elif defined(__aarch64__) || defined(_M_ARM64)
+        __asm__ __volatile__("yield");
+#endif
+    }
+
+    /// @brief Gives up the rest of the current thread's time slice.
+    inline void yieldThread() noexcept {
+#if defined(_WIN32)
+        SwitchToThread();
+#else
+        sched_yield();
+#endif
+    }
+
+    /// @brief Mutual exclusion lock that waits by spinning.
+    /// @details The lock is a single byte, so it can be embedded in each shard or bucket of a data structure.
+    ///   Waiting threads spin on a plain read, so they don't bounce the cache line while the lock is held,
+    ///   and they yield to the scheduler if the lock is held for long.
+    ///   Only use this to protect a few instructions; it is not fair and does not put waiting threads to sleep.
+    /// @see ScopedLock for holding the lock until the end of a scope.
+    class SpinLock {
+    public:
+        /// @brief Default constructor.
+        /// @details Creates an unlocked lock.
+        constexpr SpinLock() noexcept
+                : _locked(false) {
+            // ...
+        }
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        SpinLock(const SpinLock &other) = delete;
+
+        /// @brief Acquires the lock, waiting until it is available.
+        void lock() noexcept {
+            while(__atomic_exchange_n(&_locked, true, __ATOMIC_ACQUIRE)) {
+                for(unsigned spins = 0; __atomic_load_n(&_locked, __ATOMIC_RELAXED); spins++) {
+                    if(spins < spinLimit)
+                        cpuRelax();
+                    else
+                        yieldThread();
+                }
+            }
+        }
+
+        /// @brief Attempts to acquire the lock without waiting.
+        /// @return True if the lock was acquired.
+        /// @return False if the lock is held by someone else.
+        bool tryLock() noexcept {
+            return !__atomic_load_n(&_locked, __ATOMIC_RELAXED) && !__atomic_exchange_n(&_locked, true, __ATOMIC_ACQUIRE);
+        }
+
+        /// @brief Releases the lock.
+        /// @details The lock must be held by the caller.
+        void unlock() noexcept {
+            __atomic_store_n(&_locked, false, __ATOMIC_RELEASE);
+        }
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        SpinLock &operator=(const SpinLock &other) = delete;
+
+    private:
+        /// @brief Number of times to spin before yielding to other threads.
+        static constexpr unsigned spinLimit = 64;
+
+        bool _locked;
+    };
+}
+
+#endif // HYPER_SPIN_LOCK_H
@@ -0,0 +1,35 @@
+/// @file SystemError.h
+/// Error reported by the operating system.
+
+#ifndef HYPER_SYSTEM_ERROR_H
+#define HYPER_SYSTEM_ERROR_H
+
+#include "Error.h"
+
+namespace hyper {
+    /// @brief Error reported by an operating system call.
+    /// @details Wraps the error number (@c errno) that the call failed with.
+    class SystemError : public Error {
+    public:
+        /// @brief General constructor.
+        /// @param code Error number reported by the operating system.
+        explicit SystemError(int code) noexcept;
+
+        /// @brief Destructor.
+        ~SystemError() noexcept override;
+
+        /// @brief Error message.
+        /// @details Describes the error number.
+        /// @return String containing the error message.
+        const char *message() const noexcept override;
+
+        /// @brief Retrieves the error number.
+        /// @return Error number reported by the operating system.
+        int code() const noexcept;
+
+    private:
+        int _code;
+    };
+}
+
+#endif // HYPER_SYSTEM_ERROR_H
@@ -0,0 +1,287 @@
+/// @file Task.h
+/// Coroutines that run asynchronously and produce a result.
+
+#ifndef HYPER_TASK_H
+#define HYPER_TASK_H
+
+#include <coroutine>   // Compiler support for coroutines is declared in the std namespace.
+#include <cstddef>     // For size_t.
+#include <new>         // For placement new.
+#include "assert.h"
+#include "Result.h"
+#include "utility.h"
+
+namespace hyper {
+    template<typename T = void>
+    class Task;
+
+    namespace detail {
+        /// @brief Allocates memory for a coroutine frame.
+        /// @details Frames are recycled through per-thread free lists grouped by size,
+        ///   so starting a coroutine usually doesn't touch the general-purpose allocator.
+        /// @param size Number of bytes needed for the frame.
+        /// @return Memory for the frame.
+        void *allocateFrame(size_t size) noexcept;
+
+        /// @brief Frees memory allocated by @ref allocateFrame().
+        /// @param frame Memory to free.
+        /// @param size Number of bytes that were requested for the frame.
+        void freeFrame(void *frame, size_t size) noexcept;
+
+        /// @brief Base for coroutine promises that allocates frames from the frame pool.
+        struct PooledPromise {
+            // Not noexcept, since the compiler would then expect a fallback for allocation failures.
+            static void *operator new(size_t size) {
+                return allocateFrame(size);
+            }
+
+            static void operator delete(void *frame, size_t size) noexcept {
+                freeFrame(frame, size);
+            }
+
+            void unhandled_exception() noexcept {
+                ASSERTF(false, "Coroutines can't throw exceptions");
+            }
+        };
+
+        /// @brief Common parts of the promise for all task types.
+        struct TaskPromiseBase : PooledPromise {
+            std::coroutine_handle<> continuation;
+            // Detached tasks sit on their event loop's list of spawned tasks, so the loop can destroy them.
+            TaskPromiseBase *nextSpawned = nullptr;
+            TaskPromiseBase **spawnedLink = nullptr;
+
+            void unlinkSpawned() noexcept {
+                *spawnedLink = nextSpawned;
+                if(nextSpawned != nullptr)
+                    nextSpawned->spawnedLink = spawnedLink;
+                spawnedLink = nullptr;
+            }
+
+            /// @brief Resumes whoever is awaiting the task when it finishes.
+            /// @details This transfers control directly to the awaiting coroutine (symmetric transfer),
+            ///   so chains of tasks finishing don't grow the stack.
+            struct FinalAwaiter {
+                bool await_ready() const noexcept {
+                    return false;
+                }
+
+                template<typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                    auto &promise = handle.promise();
+                    if(promise.spawnedLink != nullptr) {
+                        promise.unlinkSpawned();
+                        handle.destroy();
+                        return std::noop_coroutine();
+                    }
+                    if(promise.continuation)
+                        return promise.continuation;
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() const noexcept {
+                    // ...
+                }
+            };
+
+            std::suspend_always initial_suspend() const noexcept {
+                return {};
+            }
+
+            FinalAwaiter final_suspend() const noexcept {
+                return {};
+            }
+        };
+
+        /// @brief Promise for tasks that produce a value.
+        template<typename T>
+        struct TaskPromise : TaskPromiseBase {
+            alignas(Result<T>) unsigned char storage[sizeof(Result<T>)];
+            bool hasResult = false;
+
+            TaskPromise() noexcept = default;
+
+            TaskPromise(const TaskPromise &other) = delete;
+
+            ~TaskPromise() noexcept {
+                if(hasResult)
+                    result().~Result<T>();
+            }
+
+            TaskPromise &operator=(const TaskPromise &other) = delete;
+
+            Task<T> get_return_object() noexcept;
+
+            void return_value(Result<T> value) noexcept {
+                new(storage) Result<T>(move(value));
+                hasResult = true;
+            }
+
+            Result<T> &result() noexcept {
+                return *reinterpret_cast<Result<T> *>(storage);
+            }
+
+            Result<T> takeResult() noexcept {
+                return move(result());
+            }
+        };
+
+        /// @brief Promise for tasks that don't produce a value.
+        template<>
+        struct TaskPromise<void> : TaskPromiseBase {
+            Task<void> get_return_object() noexcept;
+
+            void return_void() const noexcept {
+                // ...
+            }
+
+            Result<void> takeResult() const noexcept {
+                return Result<void>();
+            }
+        };
+    }
+
+    class EventLoop;
+
+    /// @brief Coroutine that runs asynchronously and produces a result.
+    /// @details A task is a coroutine function that returns @c Task<T>.
+    ///   It finishes with @c co_return, giving either a value or an error as a @ref Result.
+    ///   Tasks that produce no value finish with a plain @c co_return.
+    ///
+    ///   Tasks are lazy: they don't start until they are awaited with @c co_await,
+    ///   which suspends the awaiting coroutine, runs the task, and resumes the awaiting coroutine with
+    ///   the task's result once it finishes. Control passes directly between the coroutines
+    ///   without growing the stack. Tasks that don't produce a value are started from outside a coroutine
+    ///   by handing them to @ref EventLoop::spawn().
+    ///
+    ///   Coroutine frames are allocated from a per-thread pool.
+    /// @tparam T Type of value the task produces.
+    template<typename T>
+    class Task {
+    public:
+        /// @brief Promise type used by the compiler to build the coroutine.
+        using promise_type = detail::TaskPromise<T>;
+
+        /// @brief Default constructor.
+        /// @details Creates a task that doesn't refer to a coroutine.
+        Task() noexcept
+                : _handle(nullptr) {
+            // ...
+        }
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        Task(const Task &other) = delete;
+
+        /// @brief Move constructor.
+        /// @details Takes ownership of an existing task.
+        /// @param other Existing task to take ownership of.
+        Task(Task &&other) noexcept
+                : _handle(other._handle) {
+            other._handle = nullptr;
+        }
+
+        /// @brief Destructor.
+        /// @details Destroys the coroutine, if it hasn't been handed off to run on its own.
+        ~Task() noexcept {
+            if(_handle)
+                _handle.destroy();
+        }
+
+        /// @brief Checks whether the task has finished.
+        /// @return True if the task has finished running.
+        /// @return False if it hasn't started, is suspended, or doesn't refer to a coroutine.
+        bool isDone() const noexcept {
+            return _handle && _handle.done();
+        }
+
+        /// @brief Awaits the task from a coroutine.
+        /// @return Awaitable that starts the task and produces its result.
+        auto operator co_await() &&noexcept {
+            return Awaiter{_handle};
+        }
+
+        /// @copydoc operator co_await()
+        auto operator co_await() &noexcept {
+            return Awaiter{_handle};
+        }
+
+        /// @brief Move assignment operator.
+        /// @param other Existing task to take ownership of.
+        /// @return Reference to this instance after it has been updated.
+        Task &operator=(Task &&other) noexcept {
+            if(this != &other) {
+                if(_handle)
+                    _handle.destroy();
+                _handle = other._handle;
+                other._handle = nullptr;
+            }
+            return *this;
+        }
+
+        /// @brief Assignment operator.
+        /// @details Copy assignment is deleted.
+        Task &operator=(const Task &other) = delete;
+
+    private:
+        friend promise_type;
+        friend class EventLoop;
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Handle _handle;
+
+        explicit Task(Handle handle) noexcept
+                : _handle(handle) {
+            // ...
+        }
+
+        /// @brief Hands the coroutine off to run on its own.
+        /// @details The coroutine frees itself when it finishes, and until then is kept on a list of spawned tasks.
+        /// @param spawned Head of the list of spawned tasks.
+        /// @return Handle for starting the coroutine.
+        std::coroutine_handle<> detach(detail::TaskPromiseBase *&spawned) noexcept {
+            ASSERTF(_handle, "Attempt to spawn an empty task");
+            auto handle = _handle;
+            _handle = nullptr;
+            auto &promise = handle.promise();
+            promise.nextSpawned = spawned;
+            promise.spawnedLink = &spawned;
+            if(spawned != nullptr)
+                spawned->spawnedLink = &promise.nextSpawned;
+            spawned = &promise;
+            return handle;
+        }
+
+        struct Awaiter {
+            Handle handle;
+
+            bool await_ready() const noexcept {
+                return !handle || handle.done();
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            Result<T> await_resume() noexcept {
+                ASSERTF((bool)handle, "Attempt to await an empty task");
+                return handle.promise().takeResult();
+            }
+        };
+    };
+
+    namespace detail {
+        template<typename T>
+        Task<T> TaskPromise<T>::get_return_object() noexcept {
+            return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+        }
+
+        inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+            return Task<void>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+        }
+    }
+}
+
+#endif // HYPER_TASK_H
@@ -0,0 +1,144 @@
+/// @file TaskGraph.h
+/// Dependency graph of work that runs once per frame.
+
+#ifndef HYPER_TASK_GRAPH_H
+#define HYPER_TASK_GRAPH_H
+
+#include <cstddef>   // For size_t.
+#include "Function.h"
+#include "integer.h"
+#include "ScopedLock.h"
+#include "SpinLock.h"
+
+namespace hyper {
+    /// @brief Directed acyclic graph of work items that can run in parallel.
+    /// @details Nodes are functions, and an edge from one node to another means the first must finish
+    ///   before the second starts. The graph is built once with @ref addNode() and @ref addEdge(),
+    ///   then @ref compile() lays it out for execution. After that, it can be run any number of times,
+    ///   such as once per frame, without allocating memory.
+    ///
+    ///   Each node counts its unfinished predecessors atomically, and becomes ready when the count reaches zero.
+    ///   Ready nodes are run critical-path-first: the node with the longest chain of work still behind it
+    ///   goes next, so the end of the frame isn't held up by a long chain that started late.
+    ///   Chain lengths are measured in node run times, so recompiling after a run refines the order.
+    ///
+    ///   Any number of threads can share the work of one run by calling @ref work().
+    class TaskGraph {
+    public:
+        /// @brief Default constructor.
+        /// @details Creates an empty graph.
+        TaskGraph() noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        TaskGraph(const TaskGraph &other) = delete;
+
+        /// @brief Destructor.
+        /// @details The graph must not be running.
+        ~TaskGraph() noexcept;
+
+        /// @brief Adds a work item to the graph.
+        /// @details The graph has to be compiled again before it is run.
+        /// @param work Function to call when the node runs.
+        /// @param name Label for the node in @ref toGraphviz(). Must outlive the graph. Can be null.
+        /// @return Index of the new node.
+        size_t addNode(const Function<void()> &work, const char *name = nullptr) noexcept;
+
+        /// @brief Adds a dependency between two nodes.
+        /// @details The graph has to be compiled again before it is run.
+        /// @param before Index of the node that must finish first.
+        /// @param after Index of the node that must wait for it.
+        void addEdge(size_t before, size_t after) noexcept;
+
+        /// @brief Prepares the graph to be run.
+        /// @details Groups the edges by node and ranks the nodes by the length of the path behind them.
+        ///   Each node is weighted by how long it took the last time it ran, if it has run before.
+        /// @return True if the graph is ready to run.
+        /// @return False if the edges form a cycle, in which case the graph can't be run.
+        bool compile() noexcept;
+
+        /// @brief Runs every node on the calling thread, in dependency order.
+        /// @details Equivalent to @ref start() followed by @ref work().
+        void run() noexcept;
+
+        /// @brief Resets the graph for a new run.
+        /// @details Nodes without predecessors become ready. The graph must be compiled and not already running.
+        void start() noexcept;
+
+        /// @brief Runs ready nodes until every node in the current run has finished.
+        /// @details Multiple threads can call this at the same time after @ref start() to run nodes in parallel.
+        ///   Threads wait for more nodes to become ready while other threads are still busy.
+        void work() noexcept;
+
+        /// @brief Checks whether the current run has finished.
+        /// @return True if every node has run since @ref start() was called.
+        bool isDone() const noexcept;
+
+        /// @brief Retrieves the number of nodes in the graph.
+        /// @return Number of nodes.
+        size_t nodeCount() const noexcept;
+
+        /// @brief Retrieves the number of edges in the graph.
+        /// @return Number of edges.
+        size_t edgeCount() const noexcept;
+
+        /// @brief Retrieves how long a node took the last time it ran.
+        /// @param node Index of the node.
+        /// @return Run time in nanoseconds, or zero if the node hasn't run.
+        uint64 nodeTime(size_t node) const noexcept;
+
+        /// @brief Describes the graph in the Graphviz dot language.
+        /// @details Nodes are labeled with their names and last run times.
+        ///   The output is truncated to fit the buffer, and is always null-terminated if the buffer isn't empty.
+        /// @param buffer Buffer to write the description to.
+        /// @param capacity Size of the buffer in bytes.
+        /// @return Length of the full description, not counting the null terminator.
+        ///   If this isn't less than @p capacity, the description was truncated.
+        size_t toGraphviz(char *buffer, size_t capacity) const noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        TaskGraph &operator=(const TaskGraph &other) = delete;
+
+    private:
+        struct Node {
+            Function<void()> work{};
+            const char *name = nullptr;
+            uint32 predecessorCount = 0;
+            uint32 successorOffset = 0;
+            uint64 priority = 0;
+            uint64 time = 0;
+        };
+
+        struct Edge {
+            uint32 before = 0;
+            uint32 after = 0;
+        };
+
+        Node *_nodes;
+        size_t _nodeCount;
+        size_t _nodeCapacity;
+        Edge *_edges;
+        size_t _edgeCount;
+        size_t _edgeCapacity;
+        uint32 *_successors;
+        uint32 *_pending;
+        uint32 *_ready;
+        size_t _readyCount;
+        size_t _remaining;
+        SpinLock _readyLock;
+        bool _compiled;
+
+        const uint32 *successorsBegin(uint32 node) const noexcept;
+
+        const uint32 *successorsEnd(uint32 node) const noexcept;
+
+        bool higherPriority(uint32 first, uint32 second) const noexcept;
+
+        void pushReady(uint32 node) noexcept;
+
+        bool popReady(uint32 &node) noexcept;
+    };
+}
+
+#endif // HYPER_TASK_GRAPH_H
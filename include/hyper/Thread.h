@@ -0,0 +1,118 @@
+/// @file Thread.h
+/// Operating system threads.
+
+#ifndef HYPER_THREAD_H
+#define HYPER_THREAD_H
+
+#include <cstddef>     // For size_t.
+#include <pthread.h>   // For pthread_t.
+#include "Function.h"
+#include "integer.h"
+#include "Result.h"
+
+namespace hyper {
+    /// @brief Scheduling priority of a thread relative to others in the process.
+    enum class ThreadPriority {
+        /// @brief Background work that should give way to everything else.
+        Low,
+
+        /// @brief Default priority.
+        Normal,
+
+        /// @brief Latency-sensitive work, such as audio or input.
+        /// @details Raising priority usually needs extra privileges from the operating system.
+        High
+    };
+
+    /// @brief Thread of execution that runs a function.
+    /// @details Threads are started with @ref start() and joined with @ref join().
+    ///   A thread that is still joinable when its @c Thread object is destroyed is joined then,
+    ///   so a thread can't outlive the object that controls it.
+    ///
+    ///   Threads can be named, which shows up in debuggers and profilers,
+    ///   and pinned to specific logical CPUs.
+    /// @see CpuTopology for choosing which CPUs to pin threads to.
+    class Thread {
+    public:
+        /// @brief Default constructor.
+        /// @details Creates a thread object that isn't running anything.
+        Thread() noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        Thread(const Thread &other) = delete;
+
+        /// @brief Move constructor.
+        /// @details Takes control of a running thread.
+        /// @param other Thread to take control of. It is left not running anything.
+        Thread(Thread &&other) noexcept;
+
+        /// @brief Destructor.
+        /// @details Waits for the thread to finish if it hasn't been joined.
+        ~Thread() noexcept;
+
+        /// @brief Starts running a function on a new thread.
+        /// @details The thread object must not already be joinable.
+        /// @param entry Function to run on the thread. The thread finishes when it returns.
+        /// @param name Name to give the thread. Truncated to 15 characters. Can be null.
+        /// @return Error if the operating system couldn't create the thread.
+        Result<void> start(const Function<void()> &entry, const char *name = nullptr) noexcept;
+
+        /// @brief Waits for the thread to finish.
+        /// @details Afterwards, the thread object is no longer joinable and can be started again.
+        void join() noexcept;
+
+        /// @brief Checks whether there is a thread to join.
+        /// @return True if a thread was started and hasn't been joined yet.
+        bool isJoinable() const noexcept;
+
+        /// @brief Restricts the thread to run only on specific logical CPUs.
+        /// @details The thread must be joinable.
+        /// @param cpus Indices of the logical CPUs the thread may run on.
+        /// @param count Number of indices in @p cpus.
+        /// @return Error if the operating system rejected the CPU set.
+        Result<void> setAffinity(const uint32 *cpus, size_t count) noexcept;
+
+        /// @brief Renames the thread.
+        /// @details The thread must be joinable.
+        /// @param name New name for the thread. Truncated to 15 characters.
+        /// @return Error if the operating system rejected the name.
+        Result<void> setName(const char *name) noexcept;
+
+        /// @brief Restricts the calling thread to run only on specific logical CPUs.
+        /// @param cpus Indices of the logical CPUs the thread may run on.
+        /// @param count Number of indices in @p cpus.
+        /// @return Error if the operating system rejected the CPU set.
+        static Result<void> setCurrentAffinity(const uint32 *cpus, size_t count) noexcept;
+
+        /// @brief Renames the calling thread.
+        /// @param name New name for the thread. Truncated to 15 characters.
+        /// @return Error if the operating system rejected the name.
+        static Result<void> setCurrentName(const char *name) noexcept;
+
+        /// @brief Changes the scheduling priority of the calling thread.
+        /// @param priority New priority.
+        /// @return Error if the process isn't allowed to use that priority.
+        static Result<void> setCurrentPriority(ThreadPriority priority) noexcept;
+
+        /// @brief Retrieves the operating system's identifier for the calling thread.
+        /// @return Thread identifier, as shown by debuggers and profilers.
+        static uint64 currentId() noexcept;
+
+        /// @brief Move assignment operator.
+        /// @details Joins the current thread, if any, then takes control of another.
+        /// @param other Thread to take control of. It is left not running anything.
+        /// @return Reference to this instance after it has been updated.
+        Thread &operator=(Thread &&other) noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        Thread &operator=(const Thread &other) = delete;
+
+    private:
+        pthread_t _handle;
+        bool _joinable;
+    };
+}
+
+#endif // HYPER_THREAD_H
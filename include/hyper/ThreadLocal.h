@@ -0,0 +1,190 @@
+/// @file ThreadLocal.h
+/// Per-thread values owned by an object.
+
+#ifndef HYPER_THREAD_LOCAL_H
+#define HYPER_THREAD_LOCAL_H
+
+#include "integer.h"
+
+namespace hyper {
+    namespace detail {
+        /// @brief Function that destroys a value stored in a thread slot.
+        using ThreadSlotDestroy = void (*)(void *value) noexcept;
+
+        /// @brief Value held by one thread for one @ref ThreadLocal.
+        struct ThreadSlot {
+            /// @brief Value, or null if the thread hasn't created one yet.
+            void *value;
+
+            /// @brief Destroys @ref value.
+            ThreadSlotDestroy destroy;
+        };
+
+        /// @brief Slots belonging to one thread.
+        /// @details Every thread that has used a @ref ThreadLocal is linked into a registry,
+        ///   so a @ref ThreadLocal that is destroyed can clean up the values of every thread.
+        struct ThreadSlots {
+            /// @brief Slots, indexed by the @ref ThreadLocal they belong to.
+            ThreadSlot *slots;
+
+            /// @brief Number of entries in @ref slots.
+            uint32 capacity;
+
+            /// @brief Whether these slots are linked into the registry.
+            bool registered;
+
+            /// @brief Previous thread in the registry.
+            ThreadSlots *previous;
+
+            /// @brief Next thread in the registry.
+            ThreadSlots *next;
+        };
+
+        /// @brief Slots of the current thread.
+        /// @details This uses the initial-exec TLS model, so it is reached with a fixed offset
+        ///   from the thread pointer instead of a call to @c __tls_get_addr().
+        ///   It has no constructor, so there is no guard to check on each access.
+        extern __thread ThreadSlots threadSlots __attribute__((tls_model("initial-exec")));
+
+        /// @brief Reserves a slot index for a new @ref ThreadLocal.
+        /// @return Index that no other live @ref ThreadLocal is using.
+        uint32 allocateThreadSlot() noexcept;
+
+        /// @brief Destroys every thread's value in a slot and makes the index available again.
+        /// @param index Slot index returned by @ref allocateThreadSlot().
+        void releaseThreadSlot(uint32 index) noexcept;
+
+        /// @brief Stores the current thread's value in a slot.
+        /// @details Grows the thread's slots if needed and registers the thread on its first use,
+        ///   so the value is destroyed when the thread exits.
+        /// @param index Slot index returned by @ref allocateThreadSlot().
+        /// @param value Value to store. The slot takes ownership of it.
+        /// @param destroy Function that destroys @p value.
+        void setThreadSlot(uint32 index, void *value, ThreadSlotDestroy destroy) noexcept;
+
+        /// @brief Calls a function with every thread's value in a slot.
+        /// @details Threads can't exit or destroy their value while this is running.
+        /// @param index Slot index returned by @ref allocateThreadSlot().
+        /// @param visit Function to call with each value and @p context.
+        /// @param context Passed to @p visit unchanged.
+        void visitThreadSlot(uint32 index, void (*visit)(void *value, void *context), void *context) noexcept;
+    }
+
+    /// @brief Object that holds a separate value for every thread.
+    /// @details Each thread gets its own value the first time it calls @ref get(),
+    ///   and the value is destroyed when the thread exits or the object is destroyed, whichever comes first.
+    ///   The values of the thread that ends the process, usually the main thread, are destroyed by an
+    ///   @c atexit() handler. Values of other threads still running at that point are not destroyed.
+    ///   Unlike a @c thread_local variable, these can be created and destroyed at any time,
+    ///   for instance one per pool or allocator instance.
+    ///
+    ///   Reading the value is a load from the thread pointer, a bounds check and a null check,
+    ///   with no function call and no initialization guard.
+    ///   Only the first access on each thread takes a lock.
+    /// @tparam T Type of value to hold.
+    template<typename T>
+    class ThreadLocal {
+    public:
+        /// @brief Default constructor.
+        /// @details Each thread's value is default constructed.
+        ThreadLocal() noexcept
+                : _index(detail::allocateThreadSlot()), _initial(nullptr), _make(&makeDefault) {
+            // ...
+        }
+
+        /// @brief General constructor.
+        /// @details Each thread's value is copied from @p initial.
+        /// @param initial Value to start each thread with.
+        explicit ThreadLocal(const T &initial) noexcept
+                : _index(detail::allocateThreadSlot()), _initial(new T(initial)), _make(&makeCopy) {
+            // ...
+        }
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        ThreadLocal(const ThreadLocal &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Destroys the value of every thread. No other thread may be using the object.
+        ~ThreadLocal() noexcept {
+            detail::releaseThreadSlot(_index);
+            delete _initial;
+        }
+
+        /// @brief Retrieves the current thread's value.
+        /// @details The value is created if this is the first time the thread has asked for it.
+        /// @return Value for the current thread.
+        T &get() noexcept {
+            const auto &current = detail::threadSlots;
+            if(_index < current.capacity) [[likely]] {
+                const auto value = current.slots[_index].value;
+                if(value != nullptr) [[likely]]
+                    return *static_cast<T *>(value);
+            }
+            return create();
+        }
+
+        /// @brief Retrieves the current thread's value without creating it.
+        /// @return Value for the current thread, or null if it hasn't been created.
+        T *tryGet() const noexcept {
+            const auto &current = detail::threadSlots;
+            if(_index < current.capacity)
+                return static_cast<T *>(current.slots[_index].value);
+            return nullptr;
+        }
+
+        /// @brief Calls a function with every thread's value.
+        /// @details Useful for combining per-thread counters or draining per-thread caches.
+        ///   Threads can't exit while this is running, but they may still be using their values,
+        ///   so the values need to be safe to read concurrently.
+        /// @param visit Function to call with a reference to each value.
+        /// @tparam Visit Type of function to call.
+        template<typename Visit>
+        void forEach(Visit visit) const noexcept {
+            detail::visitThreadSlot(_index, [](void *value, void *context) {
+                (*static_cast<Visit *>(context))(*static_cast<T *>(value));
+            }, &visit);
+        }
+
+        /// @brief Retrieves the current thread's value.
+        /// @return Value for the current thread.
+        T &operator*() noexcept {
+            return get();
+        }
+
+        /// @brief Accesses the current thread's value.
+        /// @return Value for the current thread.
+        T *operator->() noexcept {
+            return &get();
+        }
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        ThreadLocal &operator=(const ThreadLocal &other) = delete;
+
+    private:
+        uint32 _index;
+        T *_initial;
+        T *(*_make)(const T *initial) noexcept;
+
+        static T *makeDefault(const T *) noexcept {
+            return new T();
+        }
+
+        static T *makeCopy(const T *initial) noexcept {
+            return new T(*initial);
+        }
+
+        static void destroy(void *value) noexcept {
+            delete static_cast<T *>(value);
+        }
+
+        T &create() noexcept {
+            const auto value = _make(_initial);
+            detail::setThreadSlot(_index, value, &destroy);
+            return *value;
+        }
+    };
+}
+
+#endif // HYPER_THREAD_LOCAL_H
@@ -0,0 +1,153 @@
+/// @file TimerWheel.h
+/// Hierarchical timing wheel for large numbers of timeouts.
+
+#ifndef HYPER_TIMER_WHEEL_H
+#define HYPER_TIMER_WHEEL_H
+
+#include <cstddef>   // For size_t.
+#include "Function.h"
+#include "integer.h"
+
+namespace hyper {
+    /// @brief Schedules callbacks to run after a number of ticks.
+    /// @details Time is measured in ticks, which can be game loop frames, milliseconds, or any other unit.
+    ///   The owner moves time forward with @ref advance(), which runs every callback that has come due.
+    ///   Expired timers are collected first and then fired in a batch, in the order they expired.
+    ///
+    ///   Timers are intrusive: each @ref Timer is owned by the caller, such as a network session,
+    ///   and links itself into the wheel, so scheduling and cancelling are constant-time and never allocate.
+    ///   The wheel is a hierarchy of 64-slot rings, each covering 64 times the span of the one below.
+    ///   A timer is placed by how far away it is, and moves down a ring when time reaches its slot,
+    ///   so it is touched at most once per ring. Empty slots are skipped with a bit mask per ring,
+    ///   so advancing over a long idle period is cheap.
+    ///
+    ///   The wheel is not thread-safe. To drive it from a dedicated thread,
+    ///   guard the wheel and its timers with a lock, and use @ref nextTick() to decide how long to sleep.
+    class TimerWheel {
+    private:
+        // Each slot is a circular list with a sentinel link, so unlinking never needs to know which list it's in.
+        struct Link {
+            Link *previous = nullptr;
+            Link *next = nullptr;
+        };
+
+    public:
+        /// @brief Handle for a callback that can be scheduled on a wheel.
+        /// @details A timer can be scheduled on one wheel at a time,
+        ///   and it is cancelled automatically when destroyed.
+        class Timer : private Link {
+        public:
+            /// @brief General constructor.
+            /// @details Creates a timer that isn't scheduled.
+            /// @param callback Function to call each time the timer fires.
+            explicit Timer(const Function<void()> &callback) noexcept;
+
+            /// @brief Copy constructor.
+            /// @details Copy constructor is deleted.
+            Timer(const Timer &other) = delete;
+
+            /// @brief Destructor.
+            /// @details Cancels the timer if it is scheduled.
+            ~Timer() noexcept;
+
+            /// @brief Checks whether the timer is waiting to fire.
+            /// @return True if the timer is scheduled on a wheel.
+            bool isScheduled() const noexcept;
+
+            /// @brief Retrieves when the timer fires.
+            /// @details Only meaningful while the timer is scheduled.
+            /// @return Tick the timer fires at.
+            uint64 expiry() const noexcept;
+
+            /// @brief Assignment operator.
+            /// @details Assignment operator is deleted.
+            Timer &operator=(const Timer &other) = delete;
+
+        private:
+            friend class TimerWheel;
+
+            TimerWheel *_wheel;
+            uint64 _expiry;
+            uint32 _slot;
+            Function<void()> _callback;
+        };
+
+        /// @brief General constructor.
+        /// @details Creates a wheel with no timers.
+        /// @param start Tick to start the wheel's time at.
+        explicit TimerWheel(uint64 start = 0) noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        TimerWheel(const TimerWheel &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Timers still scheduled are cancelled without firing.
+        ~TimerWheel() noexcept;
+
+        /// @brief Schedules a timer to fire after a number of ticks.
+        /// @details A timer that is already scheduled is moved to the new time.
+        ///   Timers can be scheduled from inside a callback, including the timer that is firing.
+        /// @param timer Timer to schedule.
+        /// @param delay Number of ticks to wait. A delay of zero fires on the next tick.
+        void schedule(Timer &timer, uint64 delay) noexcept;
+
+        /// @brief Stops a timer from firing.
+        /// @details Timers can be cancelled from inside a callback, even if they have expired in the same batch.
+        /// @param timer Timer to cancel.
+        /// @return True if the timer was scheduled.
+        /// @return False if the timer wasn't scheduled on this wheel.
+        bool cancel(Timer &timer) noexcept;
+
+        /// @brief Moves time forward and fires the timers that come due.
+        /// @param ticks Number of ticks to move forward by.
+        /// @return Number of timers fired.
+        size_t advance(uint64 ticks = 1) noexcept;
+
+        /// @brief Moves time forward to a specific tick and fires the timers that come due.
+        /// @param tick Tick to move to. Time doesn't change if this is in the past.
+        /// @return Number of timers fired.
+        size_t advanceTo(uint64 tick) noexcept;
+
+        /// @brief Retrieves the current time.
+        /// @return Current tick.
+        uint64 now() const noexcept;
+
+        /// @brief Finds the earliest tick at which a timer might fire.
+        /// @details Distant timers are only tracked to the span of their ring's slot,
+        ///   so this can be earlier than the actual expiry; it is never later.
+        /// @param[out] tick Set to the earliest tick. Left unchanged if no timers are scheduled.
+        /// @return True if any timers are scheduled.
+        bool nextTick(uint64 &tick) const noexcept;
+
+        /// @brief Retrieves the number of scheduled timers.
+        /// @return Number of timers waiting to fire.
+        size_t size() const noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        TimerWheel &operator=(const TimerWheel &other) = delete;
+
+    private:
+        static constexpr uint32 slotBits = 6;
+        static constexpr uint32 slotCount = 1u << slotBits;
+        static constexpr uint32 levelCount = (64 + slotBits - 1) / slotBits;
+        static constexpr uint32 expiredSlot = slotCount * levelCount;
+
+        Link _slots[slotCount * levelCount];
+        Link _expired;
+        uint64 _occupied[levelCount];
+        uint64 _now;
+        size_t _size;
+
+        void insert(Timer &timer) noexcept;
+
+        void link(Timer &timer, uint32 slot) noexcept;
+
+        void unlink(Timer &timer) noexcept;
+
+        size_t fireExpired() noexcept;
+    };
+}
+
+#endif // HYPER_TIMER_WHEEL_H
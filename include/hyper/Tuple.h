@@ -0,0 +1,293 @@
+/// @file Tuple.h
+/// Fixed-size collection of values of different types.
+
+#ifndef HYPER_TUPLE_H
+#define HYPER_TUPLE_H
+
+#include <cstddef>   // For size_t.
+#include "utility.h"
+
+namespace hyper {
+    namespace detail {
+        /// @brief Compile-time list of indices.
+        /// @tparam Indices Indices in the list.
+        template<size_t... Indices>
+        struct IndexSequence {
+        };
+
+        /// @brief Adapts the compiler's sequence builtin to @ref IndexSequence.
+        template<typename T, T... Indices>
+        using MakeIndexSequenceOf = IndexSequence<Indices...>;
+
+        /// @brief List of indices from zero up to, but not including, a count.
+        /// @details Built by the compiler, so large tuples don't cost a template instantiation per element.
+        /// @tparam Count Number of indices.
+#if defined(__has_builtin) && __has_builtin(__make_integer_seq)
+        template<size_t Count>
+        using MakeIndexSequence = __make_integer_seq<MakeIndexSequenceOf, size_t, Count>;
+#else
+        template<size_t Count>
+        using MakeIndexSequence = IndexSequence<__integer_pack(Count)...>;
+#endif
+
+        /// @brief Holds a type without instantiating it, for returning types from overloads.
+        /// @tparam T Type to hold.
+        template<typename T>
+        struct TypeHolder {
+            /// @brief Held type.
+            typedef T type;
+        };
+
+        /// @brief Storage for one element of a tuple.
+        /// @details The index keeps elements of the same type apart.
+        ///   An empty element takes no space, since an empty leaf is an empty base class of the tuple.
+        /// @tparam Index Position of the element in the tuple.
+        /// @tparam T Type of the element.
+        template<size_t Index, typename T>
+        struct TupleLeaf {
+            /// @brief Element value.
+            [[no_unique_address]] T value;
+
+            /// @brief Default constructor.
+            /// @details Value-initializes the element.
+            constexpr TupleLeaf() noexcept
+                    : value() {
+                // ...
+            }
+
+            /// @brief General constructor.
+            /// @param initial Value to initialize the element from.
+            /// @tparam U Type of initial value.
+            template<typename U>
+            constexpr explicit TupleLeaf(U &&initial) noexcept
+                    : value(forward<U>(initial)) {
+                // ...
+            }
+        };
+
+        /// @brief Looks up the type of an element by its index.
+        /// @details Only declared: it is used in @c decltype, where the call picks the one leaf base with the index.
+        template<size_t Index, typename T>
+        TypeHolder<T> tupleElement(const TupleLeaf<Index, T> *);
+
+        template<typename Indices, typename... Ts>
+        struct TupleBase;
+
+        /// @brief Inherits one leaf per element.
+        template<size_t... Indices, typename... Ts>
+        struct TupleBase<IndexSequence<Indices...>, Ts...> : TupleLeaf<Indices, Ts>... {
+            constexpr TupleBase() noexcept = default;
+
+            template<typename... Us>
+            constexpr explicit TupleBase(Us &&... values) noexcept
+                    : TupleLeaf<Indices, Ts>(forward<Us>(values))... {
+                // ...
+            }
+        };
+
+        /// @brief Checks that a constructor's arguments aren't a single tuple, which would hide the copy constructor.
+        template<typename Tuple, typename... Us>
+        constexpr bool isTupleArguments = true;
+
+        template<typename Tuple, typename U>
+        constexpr bool isTupleArguments<Tuple, U> = !__is_same(Tuple, typename RemoveReference<U>::type)
+                                                    && !__is_same(const Tuple, typename RemoveReference<U>::type);
+    }
+
+    /// @brief Fixed-size collection of values of different types.
+    /// @details Elements are reached with @ref get(), by index or by type, or with structured bindings:
+    ///   @code
+    ///   Tuple<int, float> tuple(1, 2.0f);
+    ///   auto [count, scale] = tuple;
+    ///   @endcode
+    ///   Each element is stored in its own base class, and empty elements such as stateless function objects
+    ///   take up no space, so a tuple is no bigger than a struct of its non-empty members.
+    ///   Elements are looked up through overload resolution on those base classes,
+    ///   so compile time doesn't grow with the element's position.
+    /// @tparam Ts Types of the elements.
+    template<typename... Ts>
+    class Tuple : public detail::TupleBase<detail::MakeIndexSequence<sizeof...(Ts)>, Ts...> {
+    public:
+        /// @brief Number of elements.
+        static constexpr size_t size = sizeof...(Ts);
+
+        /// @brief Default constructor.
+        /// @details Value-initializes each element.
+        constexpr Tuple() noexcept = default;
+
+        /// @brief General constructor.
+        /// @details Initializes each element from the matching argument.
+        /// @param values Initial values for the elements, in order.
+        /// @tparam Us Types of the initial values.
+        template<typename... Us>
+        requires(sizeof...(Us) == sizeof...(Ts) && sizeof...(Ts) > 0 && detail::isTupleArguments<Tuple, Us...>)
+        constexpr Tuple(Us &&... values) noexcept
+                : detail::TupleBase<detail::MakeIndexSequence<sizeof...(Ts)>, Ts...>(forward<Us>(values)...) {
+            // ...
+        }
+
+        /// @brief Copy constructor.
+        /// @param other Tuple to copy elements from.
+        constexpr Tuple(const Tuple &other) noexcept = default;
+
+        /// @brief Move constructor.
+        /// @param other Tuple to move elements from.
+        constexpr Tuple(Tuple &&other) noexcept = default;
+
+        /// @brief Assignment operator.
+        /// @param other Tuple to copy elements from.
+        /// @return This tuple.
+        constexpr Tuple &operator=(const Tuple &other) noexcept = default;
+
+        /// @brief Move assignment operator.
+        /// @param other Tuple to move elements from.
+        /// @return This tuple.
+        constexpr Tuple &operator=(Tuple &&other) noexcept = default;
+
+        /// @brief Compares two tuples element by element.
+        /// @param other Tuple to compare against.
+        /// @return True if every element is equal.
+        constexpr bool operator==(const Tuple &other) const noexcept {
+            return equals(other, detail::MakeIndexSequence<sizeof...(Ts)>());
+        }
+
+        /// @brief Compares two tuples element by element.
+        /// @param other Tuple to compare against.
+        /// @return True if any element is different.
+        constexpr bool operator!=(const Tuple &other) const noexcept {
+            return !(*this == other);
+        }
+
+    private:
+        template<size_t... Indices>
+        constexpr bool equals(const Tuple &other, detail::IndexSequence<Indices...>) const noexcept {
+            return (... && (get<Indices>(*this) == get<Indices>(other)));
+        }
+    };
+
+    /// @brief Deduces the element types from the constructor arguments.
+    template<typename... Ts>
+    Tuple(Ts...) -> Tuple<Ts...>;
+
+    /// @brief Retrieves the type of a tuple element.
+    /// @tparam Index Position of the element.
+    /// @tparam TupleType Type of tuple.
+    template<size_t Index, typename TupleType>
+    using TupleElement = typename decltype(detail::tupleElement<Index>(static_cast<TupleType *>(nullptr)))::type;
+
+    /// @brief Accesses a tuple element by index.
+    /// @param tuple Tuple to access.
+    /// @return Reference to the element.
+    /// @tparam Index Position of the element.
+    /// @tparam Us Types of the tuple's elements.
+    template<size_t Index, typename... Us>
+    constexpr auto &get(Tuple<Us...> &tuple) noexcept {
+        typedef TupleElement<Index, Tuple<Us...>> T;
+        return static_cast<detail::TupleLeaf<Index, T> &>(tuple).value;
+    }
+
+    /// @copydoc get(Tuple<Us...>&)
+    template<size_t Index, typename... Us>
+    constexpr const auto &get(const Tuple<Us...> &tuple) noexcept {
+        typedef TupleElement<Index, Tuple<Us...>> T;
+        return static_cast<const detail::TupleLeaf<Index, T> &>(tuple).value;
+    }
+
+    /// @copydoc get(Tuple<Us...>&)
+    template<size_t Index, typename... Us>
+    constexpr auto &&get(Tuple<Us...> &&tuple) noexcept {
+        typedef TupleElement<Index, Tuple<Us...>> T;
+        return static_cast<T &&>(static_cast<detail::TupleLeaf<Index, T> &>(tuple).value);
+    }
+
+    namespace detail {
+        /// @brief Finds the leaf holding a type. Ambiguous, and so an error, if the type appears more than once.
+        template<typename T, size_t Index>
+        constexpr TupleLeaf<Index, T> &leafOfType(TupleLeaf<Index, T> &leaf) noexcept {
+            return leaf;
+        }
+
+        template<typename T, size_t Index>
+        constexpr const TupleLeaf<Index, T> &leafOfType(const TupleLeaf<Index, T> &leaf) noexcept {
+            return leaf;
+        }
+    }
+
+    /// @brief Accesses a tuple element by type.
+    /// @details The type must appear exactly once in the tuple.
+    /// @param tuple Tuple to access.
+    /// @return Reference to the element.
+    /// @tparam T Type of the element.
+    /// @tparam Us Types of the tuple's elements.
+    template<typename T, typename... Us>
+    constexpr T &get(Tuple<Us...> &tuple) noexcept {
+        return detail::leafOfType<T>(tuple).value;
+    }
+
+    /// @copydoc get(Tuple<Us...>&)
+    template<typename T, typename... Us>
+    constexpr const T &get(const Tuple<Us...> &tuple) noexcept {
+        return detail::leafOfType<T>(tuple).value;
+    }
+
+    namespace detail {
+        template<typename Function, typename TupleType, size_t... Indices>
+        constexpr decltype(auto) applyTuple(Function &&function, TupleType &&tuple, IndexSequence<Indices...>) {
+            return forward<Function>(function)(get<Indices>(forward<TupleType>(tuple))...);
+        }
+    }
+
+    /// @brief Calls a function with the elements of a tuple as its arguments.
+    /// @details Works with anything callable, including @ref Function.
+    /// @param function Function to call.
+    /// @param tuple Tuple holding the arguments, in order.
+    /// @return Result of the call.
+    /// @tparam Function Type of function to call.
+    /// @tparam Ts Types of the tuple's elements.
+    template<typename Function, typename... Ts>
+    constexpr decltype(auto) apply(Function &&function, Tuple<Ts...> &tuple) {
+        return detail::applyTuple(forward<Function>(function), tuple, detail::MakeIndexSequence<sizeof...(Ts)>());
+    }
+
+    /// @copydoc apply(Function&&, Tuple<Ts...>&)
+    template<typename Function, typename... Ts>
+    constexpr decltype(auto) apply(Function &&function, const Tuple<Ts...> &tuple) {
+        return detail::applyTuple(forward<Function>(function), tuple, detail::MakeIndexSequence<sizeof...(Ts)>());
+    }
+
+    /// @copydoc apply(Function&&, Tuple<Ts...>&)
+    template<typename Function, typename... Ts>
+    constexpr decltype(auto) apply(Function &&function, Tuple<Ts...> &&tuple) {
+        return detail::applyTuple(forward<Function>(function), move(tuple), detail::MakeIndexSequence<sizeof...(Ts)>());
+    }
+}
+
+/// @cond
+// Lets structured bindings unpack tuples.
+// The primary templates come from <utility> when there is one, since standard libraries may declare them
+// in an inline namespace, such as libc++'s std::__1, and a second declaration here would be ambiguous.
+// Structured bindings only need the primary templates to exist, so they are declared directly otherwise.
+#if __has_include(<utility>)
+#include <utility>
+#else
+namespace std {
+    template<typename T>
+    struct tuple_size;
+
+    template<size_t Index, typename T>
+    struct tuple_element;
+}
+#endif
+
+template<typename... Ts>
+struct std::tuple_size<hyper::Tuple<Ts...>> {
+    static constexpr size_t value = sizeof...(Ts);
+};
+
+template<size_t Index, typename... Ts>
+struct std::tuple_element<Index, hyper::Tuple<Ts...>> {
+    typedef hyper::TupleElement<Index, hyper::Tuple<Ts...>> type;
+};
+/// @endcond
+
+#endif // HYPER_TUPLE_H
@@ -308,6 +308,13 @@ namespace hyper {
         first.swap(second);
     };
 
+    /// @brief Unique pointers are trivially relocatable.
+    /// @details Moving one is the same as copying its pointer and forgetting the original.
+    /// @tparam T Type the smart pointer references.
+    template<typename T>
+    struct IsTriviallyRelocatable<UniquePointer<T>> : BoolConstant<true> {
+    };
+
     template<typename T>
     constexpr UniquePointer<T> createUnique(T *&&ptr) noexcept {
         return UniquePointer<T>(forward<T *>(ptr));
@@ -0,0 +1,64 @@
+/// @file WorkerPool.h
+/// Fixed set of worker threads placed on physical cores.
+
+#ifndef HYPER_WORKER_POOL_H
+#define HYPER_WORKER_POOL_H
+
+#include <cstddef>   // For size_t.
+#include "Function.h"
+#include "Thread.h"
+
+namespace hyper {
+    /// @brief Group of worker threads that run jobs together.
+    /// @details By default there is one worker per physical core, each pinned to its own core,
+    ///   so workers don't compete with each other for a core's execution units.
+    ///   Workers sleep until @ref run() gives them a job, and every worker runs each job once.
+    ///
+    ///   Jobs usually share out the work themselves, for instance by each calling @ref TaskGraph::work(),
+    ///   or by splitting a range using the worker index.
+    class WorkerPool {
+    public:
+        /// @brief General constructor.
+        /// @details Starts the workers. If the operating system can't create all of them,
+        ///   the pool carries on with those it could; check @ref size().
+        ///   If none of them start, jobs run on the thread that calls @ref run().
+        /// @param workerCount Number of workers. Zero means one per physical core.
+        ///   When there are more workers than cores, they wrap around to share cores.
+        /// @param name Prefix for the workers' thread names. The worker index is appended.
+        explicit WorkerPool(size_t workerCount = 0, const char *name = "worker") noexcept;
+
+        /// @brief Copy constructor.
+        /// @details Copy constructor is deleted.
+        WorkerPool(const WorkerPool &other) = delete;
+
+        /// @brief Destructor.
+        /// @details Stops and joins the workers. No job may be running.
+        ~WorkerPool() noexcept;
+
+        /// @brief Retrieves the number of workers.
+        /// @return Number of worker threads.
+        size_t size() const noexcept;
+
+        /// @brief Runs a job on every worker and waits for all of them to finish it.
+        /// @details Only one thread may call this at a time.
+        ///   A pool without workers runs the job once on the calling thread, as worker zero.
+        /// @param job Function to run. It is given the index of the worker running it,
+        ///   from zero to one less than @ref size(), or zero if there are no workers.
+        void run(const Function<void(size_t)> &job) noexcept;
+
+        /// @brief Assignment operator.
+        /// @details Assignment operator is deleted.
+        WorkerPool &operator=(const WorkerPool &other) = delete;
+
+    private:
+        struct State;
+
+        State *_state;
+        Thread *_threads;
+        size_t _size;
+
+        void work(size_t index) noexcept;
+    };
+}
+
+#endif // HYPER_WORKER_POOL_H
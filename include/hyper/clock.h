@@ -0,0 +1,139 @@
+/// @file clock.h
+/// Cheap monotonic timestamps and frame pacing.
+/// Timestamps come from the processor's cycle counter when it ticks at a constant rate,
+/// and from the operating system's monotonic clock otherwise.
+
+#ifndef HYPER_CLOCK_H
+#define HYPER_CLOCK_H
+
+#include "integer.h"
+
+namespace hyper {
+    namespace detail {
+        /// @brief Scale for converting timestamps to nanoseconds.
+        /// @details Set up on first use by @ref calibrateClock().
+        struct ClockScale {
+            /// @brief Nanoseconds per tick, as a fixed-point number with @ref shift fractional bits.
+            uint64 multiplier;
+
+            /// @brief Number of fractional bits in @ref multiplier.
+            uint32 shift;
+
+            /// @brief Whether timestamps come from the cycle counter instead of the monotonic clock.
+            bool useCounter;
+
+            /// @brief Whether the other fields have been set up.
+            bool calibrated;
+        };
+
+        /// @brief Scale shared by every thread.
+        extern ClockScale clockScale;
+
+        /// @brief Detects the timestamp source and measures the cycle counter against the monotonic clock.
+        /// @details This blocks for a few milliseconds the first time it is called.
+        ///   Other threads that call it meanwhile sleep until it finishes. Later calls return immediately.
+        void calibrateClock() noexcept;
+
+        /// @brief Reads the processor's cycle counter.
+        /// @return Number of ticks since an arbitrary point, or zero if there is no usable counter.
+        inline uint64 readCounter() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+            return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+            uint64 value;
+            __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+            return value;
+#else
+            return 0;
+#endif
+        }
+    }
+
+    /// @brief Reads the monotonic clock from the operating system.
+    /// @details On Linux this is usually answered by the vDSO without entering the kernel,
+    ///   but it is still several times slower than @ref readTimestamp().
+    /// @return Nanoseconds since an arbitrary point.
+    uint64 monotonicNow() noexcept;
+
+    /// @brief Checks whether the processor's cycle counter ticks at a constant rate.
+    /// @details Such a counter keeps time through frequency changes and sleep states,
+    ///   so it can be used as a clock.
+    /// @return True if timestamps come from the cycle counter.
+    /// @return False if they come from @ref monotonicNow().
+    bool hasInvariantTimestamp() noexcept;
+
+    /// @brief Reads the current timestamp.
+    /// @details This is the cheapest way to measure time, intended for profiling and timing short sections.
+    ///   Only differences between timestamps are meaningful; convert them with @ref timestampToNanoseconds().
+    /// @return Current timestamp in ticks.
+    inline uint64 readTimestamp() noexcept {
+        if(!__atomic_load_n(&detail::clockScale.calibrated, __ATOMIC_ACQUIRE))
+            detail::calibrateClock();
+        return detail::clockScale.useCounter ? detail::readCounter() : monotonicNow();
+    }
+
+    /// @brief Converts timestamp ticks to nanoseconds.
+    /// @details Uses a multiply and a shift instead of a division.
+    /// @param ticks Timestamp or difference between timestamps.
+    /// @return Equivalent number of nanoseconds.
+    inline uint64 timestampToNanoseconds(uint64 ticks) noexcept {
+        if(!__atomic_load_n(&detail::clockScale.calibrated, __ATOMIC_ACQUIRE))
+            detail::calibrateClock();
+        const auto product = static_cast<unsigned __int128>(ticks) * detail::clockScale.multiplier;
+        return static_cast<uint64>(product >> detail::clockScale.shift);
+    }
+
+    /// @brief Reads the current time.
+    /// @details This is based on @ref readTimestamp(), so it is cheap,
+    ///   but it doesn't share a starting point with @ref monotonicNow().
+    /// @return Nanoseconds since an arbitrary point.
+    inline uint64 now() noexcept {
+        return timestampToNanoseconds(readTimestamp());
+    }
+
+    /// @brief Suspends the calling thread.
+    /// @details The operating system may sleep for longer than asked, often by tens of microseconds or more.
+    /// @param nanoseconds Minimum time to sleep for.
+    void sleepFor(uint64 nanoseconds) noexcept;
+
+    /// @brief Paces a loop to a fixed rate, such as a game's frame rate.
+    /// @details Call @ref wait() once per frame. It sleeps for most of the time left in the frame,
+    ///   then spins for the rest, so frames start on time without burning a whole core.
+    ///   How early to stop sleeping is learned from how much the operating system has overslept before.
+    ///
+    ///   Frames are scheduled on a fixed grid, so short delays don't accumulate into drift.
+    ///   If a frame runs more than a whole period late, the grid restarts from the current time
+    ///   instead of rushing through the missed frames.
+    class FrameLimiter {
+    public:
+        /// @brief General constructor.
+        /// @details The first frame starts now.
+        /// @param period Length of each frame in nanoseconds.
+        explicit FrameLimiter(uint64 period) noexcept;
+
+        /// @brief Waits for the start of the next frame.
+        /// @return Nanoseconds since the previous call returned, or since construction.
+        uint64 wait() noexcept;
+
+        /// @brief Changes the length of each frame.
+        /// @details Takes effect from the next frame.
+        /// @param period Length of each frame in nanoseconds.
+        void setPeriod(uint64 period) noexcept;
+
+        /// @brief Retrieves the length of each frame.
+        /// @return Length of each frame in nanoseconds.
+        uint64 period() const noexcept;
+
+        /// @brief Retrieves how long before the deadline sleeping stops and spinning starts.
+        /// @return Current spin margin in nanoseconds.
+        uint64 spinMargin() const noexcept;
+
+    private:
+        uint64 _period;
+        uint64 _deadline;
+        uint64 _previous;
+        uint64 _spinMargin;
+    };
+}
+
+#endif // HYPER_CLOCK_H
@@ -0,0 +1,74 @@
+/// @file compression.h
+/// Block compression for sequences of unsigned integers.
+/// Values are split into blocks of 128 and each block is bit-packed with the narrowest width that fits most
+/// of its values (frame-of-reference or delta coded), with the few values that don't fit stored as patched exceptions.
+/// Packed blocks use a four-lane interleaved layout so that they can be unpacked four values at a time
+/// with the instruction set selected in simd.h.
+/// Delta decoding computes the prefix sum while unpacking.
+/// The codecs are implemented for @c uint32 and @c uint64.
+/// @note The encoded format stores multi-byte values in little-endian order.
+
+#ifndef HYPER_COMPRESSION_H
+#define HYPER_COMPRESSION_H
+
+#include <cstddef>   // For size_t.
+#include "byte.h"
+#include "integer.h"
+
+namespace hyper {
+    /// @brief Transform applied to values before they are bit-packed.
+    enum class IntegerCoding : uint8 {
+        /// @brief Each block stores its smallest value, and the differences from it are packed.
+        /// @details Best for values that are clustered but not sorted.
+        FrameOfReference = 0,
+
+        /// @brief The differences between consecutive values are packed.
+        /// @details Best for sorted values, such as IDs and timestamps.
+        ///   Unsorted values are still encoded correctly, but compress poorly.
+        Delta = 1
+    };
+
+    /// @brief Number of values in each packed block.
+    constexpr size_t compressionBlockSize = 128;
+
+    /// @brief Calculates the largest number of bytes that @ref encode() can write.
+    /// @param count Number of values to encode.
+    /// @return Worst-case size of the encoded data in bytes.
+    /// @tparam T Type of value to encode.
+    template<typename T>
+    constexpr size_t maxEncodedSize(size_t count) noexcept {
+        // Stream header, then each value as either a patched exception or a variable-length integer,
+        // plus each block's header and reference value.
+        return 11 + count * (sizeof(T) + 1 > (sizeof(T) * 8 + 6) / 7 ? sizeof(T) + 1 : (sizeof(T) * 8 + 6) / 7)
+               + (count / compressionBlockSize + 1) * (3 + sizeof(T));
+    }
+
+    /// @brief Compresses a sequence of integers.
+    /// @param input Values to compress.
+    /// @param count Number of values in @p input.
+    /// @param[out] output Destination for the compressed data.
+    ///   This must have room for at least @ref maxEncodedSize() bytes.
+    /// @param coding Transform to apply to values before packing them.
+    /// @return Number of bytes written to @p output.
+    /// @tparam T Type of value to compress.
+    template<typename T>
+    size_t encode(const T *input, size_t count, byte *output, IntegerCoding coding) noexcept;
+
+    /// @brief Retrieves the number of values stored in compressed data.
+    /// @details Use this to size the output before calling @ref decode().
+    /// @param input Compressed data produced by @ref encode().
+    /// @return Number of values that @ref decode() will write.
+    size_t decodedCount(const byte *input) noexcept;
+
+    /// @brief Decompresses a sequence of integers.
+    /// @param input Compressed data produced by @ref encode() for the same type.
+    /// @param[out] output Destination for the values.
+    ///   This must have room for @ref decodedCount() values.
+    /// @return Number of bytes read from @p input.
+    /// @tparam T Type of value to decompress.
+    /// @note The input is trusted; corrupt data is detected by assertions only.
+    template<typename T>
+    size_t decode(const byte *input, T *output) noexcept;
+}
+
+#endif // HYPER_COMPRESSION_H
@@ -0,0 +1,38 @@
+/// @file futex.h
+/// Waiting on a memory address.
+/// These are the building blocks for the blocking synchronization primitives.
+/// A thread sleeps until another thread changes a 32-bit word and wakes it,
+/// and the kernel only gets involved when there is someone to put to sleep or wake.
+
+#ifndef HYPER_FUTEX_H
+#define HYPER_FUTEX_H
+
+#include "integer.h"
+
+namespace hyper {
+    /// @brief Sleeps while a word holds an expected value.
+    /// @details The check and the sleep happen atomically, so a wake-up that comes after the word changes can't be missed.
+    ///   This can return spuriously, so callers check their condition again in a loop.
+    /// @param address Word to wait on.
+    /// @param expected Value the word must hold for the thread to sleep.
+    void futexWait(const uint32 *address, uint32 expected) noexcept;
+
+    /// @brief Sleeps while a word holds an expected value, for a limited time.
+    /// @details This can return spuriously, so callers check their condition again in a loop.
+    /// @param address Word to wait on.
+    /// @param expected Value the word must hold for the thread to sleep.
+    /// @param nanoseconds Longest time to sleep.
+    /// @return False if the time ran out, true otherwise.
+    bool futexWaitFor(const uint32 *address, uint32 expected, uint64 nanoseconds) noexcept;
+
+    /// @brief Wakes threads waiting on a word.
+    /// @param address Word the threads are waiting on.
+    /// @param count Largest number of threads to wake.
+    void futexWake(const uint32 *address, uint32 count) noexcept;
+
+    /// @brief Wakes every thread waiting on a word.
+    /// @param address Word the threads are waiting on.
+    void futexWakeAll(const uint32 *address) noexcept;
+}
+
+#endif // HYPER_FUTEX_H
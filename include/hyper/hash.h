@@ -0,0 +1,74 @@
+/// @file hash.h
+/// Fast non-cryptographic hash functions.
+/// These are intended for hash tables and probabilistic data structures,
+/// not for security-sensitive uses such as message authentication.
+
+#ifndef HYPER_HASH_H
+#define HYPER_HASH_H
+
+#include <cstddef>   // For size_t.
+#include <cstdint>   // For uintptr_t.
+#include "byte.h"
+#include "integer.h"
+
+namespace hyper {
+    /// @brief Hashes a sequence of bytes.
+    /// @details Reads eight bytes at a time and mixes them with 64x64 to 128-bit multiplications.
+    ///   Short keys (16 bytes or less) are hashed without a loop.
+    /// @param data Bytes to hash.
+    /// @param size Number of bytes in @p data.
+    /// @param seed Value that changes the hash function, for instance to get independent hashes of the same key.
+    /// @return 64-bit hash of the bytes.
+    uint64 hash(const byte *data, size_t size, uint64 seed = 0) noexcept;
+
+    /// @brief Hashes a 64-bit integer.
+    /// @details Every bit of the input affects every bit of the output (the finalizer from MurmurHash3).
+    ///   This is a bijection, so distinct inputs always produce distinct hashes.
+    /// @param value Integer to hash.
+    /// @return 64-bit hash of the integer.
+    inline constexpr uint64 hash(uint64 value) noexcept {
+        value ^= value >> 33;
+        value *= 0xFF51AFD7ED558CCDull;
+        value ^= value >> 33;
+        value *= 0xC4CEB9FE1A85EC53ull;
+        value ^= value >> 33;
+        return value;
+    }
+
+    /// @brief Maps a hash uniformly onto a range without division.
+    /// @details Uses the high bits of the 128-bit product, which is much faster than a modulo.
+    /// @param hash Hash value to map.
+    /// @param range Number of values in the range.
+    /// @return Value from zero up to, but not including, @p range.
+    inline constexpr uint64 reduceRange(uint64 hash, uint64 range) noexcept {
+        return static_cast<uint64>((static_cast<unsigned __int128>(hash) * range) >> 64);
+    }
+
+    /// @brief Default hash function for keys of hash tables.
+    /// @details Hashes any integer or enumeration type by converting it to 64 bits.
+    ///   Specialize this to use other types as keys.
+    /// @tparam T Type of key to hash.
+    template<typename T>
+    struct Hasher {
+        /// @brief Hashes a key.
+        /// @param value Key to hash.
+        /// @return 64-bit hash of the key.
+        constexpr uint64 operator()(const T &value) const noexcept {
+            return hash(static_cast<uint64>(value));
+        }
+    };
+
+    /// @brief Hashes pointers by their address.
+    /// @tparam T Type pointed to.
+    template<typename T>
+    struct Hasher<T *> {
+        /// @brief Hashes a pointer.
+        /// @param value Pointer to hash.
+        /// @return 64-bit hash of the address.
+        uint64 operator()(T *value) const noexcept {
+            return hash(static_cast<uint64>(reinterpret_cast<uintptr_t>(value)));
+        }
+    };
+}
+
+#endif // HYPER_HASH_H
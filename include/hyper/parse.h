@@ -0,0 +1,43 @@
+/// @file parse.h
+/// Conversion of decimal text to numbers, without allocating.
+/// The text doesn't need to be null-terminated, so fields can be converted where they are in a buffer.
+
+#ifndef HYPER_PARSE_H
+#define HYPER_PARSE_H
+
+#include <cstddef>   // For size_t.
+#include "float.h"
+#include "integer.h"
+
+namespace hyper {
+    /// @brief Converts decimal text to a signed integer.
+    /// @details Accepts an optional @c + or @c - sign followed by one or more digits, and nothing else.
+    /// @param text Text to convert.
+    /// @param size Number of bytes in @p text.
+    /// @param[out] value Set to the number. Not changed if the conversion fails.
+    /// @return True if the text is an integer that fits, false if it isn't or doesn't.
+    bool parseInt64(const char *text, size_t size, int64 &value) noexcept;
+
+    /// @brief Converts decimal text to an unsigned integer.
+    /// @details Accepts an optional sign followed by one or more digits, and nothing else.
+    ///   A @c - sign is only accepted on zero.
+    /// @param text Text to convert.
+    /// @param size Number of bytes in @p text.
+    /// @param[out] value Set to the number. Not changed if the conversion fails.
+    /// @return True if the text is an integer that fits, false if it isn't or doesn't.
+    bool parseUInt64(const char *text, size_t size, uint64 &value) noexcept;
+
+    /// @brief Converts decimal text to a double.
+    /// @details Accepts an optional sign, digits with an optional decimal point, and an optional exponent,
+    ///   such as @c -12, @c 3.25, @c .5 or @c 6.02e23. There must be at least one digit before the exponent.
+    ///   Up to 19 significant digits scaled by at most 10^22 is converted exactly with one multiply or divide,
+    ///   which covers most data. Other numbers are handed to @c strtod() for correct rounding;
+    ///   beyond 200 significant digits, the rest only decide whether the number is above a halfway point.
+    /// @param text Text to convert.
+    /// @param size Number of bytes in @p text.
+    /// @param[out] value Set to the number. Not changed if the conversion fails.
+    /// @return True if the text is a number, false if it isn't or is too large for a double.
+    bool parseFloat64(const char *text, size_t size, float64 &value) noexcept;
+}
+
+#endif // HYPER_PARSE_H
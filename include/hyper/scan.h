@@ -0,0 +1,180 @@
+/// @file scan.h
+/// Data-parallel prefix sum, reduction and stream compaction kernels.
+/// The kernels are vectorized with the instruction set selected in simd.h.
+/// They are implemented for the 32-bit and 64-bit types from integer.h and float.h:
+/// @c int32, @c uint32, @c int64, @c uint64, @c float32 and @c float64.
+/// @note Vectorized floating-point kernels add values in a different order than a sequential loop,
+///   so results may differ from one in the last bits due to rounding.
+/// @note Integer sums wrap around on overflow, including for signed types, the same as the vector instructions do.
+
+#ifndef HYPER_SCAN_H
+#define HYPER_SCAN_H
+
+#include <cstddef>   // For size_t.
+#include "integer.h"
+#include "float.h"
+
+namespace hyper {
+    class WorkerPool;
+
+    /// @brief Computes the inclusive prefix sum of an array.
+    /// @details Each element of @p output is the sum of @p initial and all elements in @p input up to and including
+    ///   the element at the same index.
+    ///   Scans can be split across workers by chunking the input:
+    ///   sum each chunk, exclusive scan the chunk sums, then scan each chunk with its carry as @p initial.
+    ///   The overload taking a @ref WorkerPool does this with one chunk per worker.
+    /// @param input Values to scan.
+    /// @param[out] output Destination for the scanned values. This may be the same array as @p input.
+    /// @param count Number of elements in @p input and @p output.
+    /// @param initial Value to add to every element, such as the carry from a previous chunk.
+    /// @return Sum of @p initial and every element in @p input, which is the carry for the next chunk.
+    /// @tparam T Type of element to scan.
+    template<typename T>
+    T inclusiveScan(const T *input, T *output, size_t count, T initial = T()) noexcept;
+
+    /// @brief Computes the exclusive prefix sum of an array.
+    /// @details Each element of @p output is the sum of @p initial and all elements in @p input before
+    ///   the element at the same index. The first element of @p output is @p initial.
+    /// @param input Values to scan.
+    /// @param[out] output Destination for the scanned values. This may be the same array as @p input.
+    /// @param count Number of elements in @p input and @p output.
+    /// @param initial Value to start the scan at, such as the carry from a previous chunk.
+    /// @return Sum of @p initial and every element in @p input, which is the carry for the next chunk.
+    /// @tparam T Type of element to scan.
+    template<typename T>
+    T exclusiveScan(const T *input, T *output, size_t count, T initial = T()) noexcept;
+
+    /// @brief Adds all values in an array.
+    /// @param input Values to add.
+    /// @param count Number of elements in @p input.
+    /// @return Sum of all values, or zero if @p count is zero.
+    /// @tparam T Type of element to add.
+    template<typename T>
+    T sum(const T *input, size_t count) noexcept;
+
+    /// @brief Finds the smallest value in an array.
+    /// @param input Values to search.
+    /// @param count Number of elements in @p input.
+    /// @return Smallest value, or the largest value @p T can hold if @p count is zero.
+    ///   Positive infinity is used as the largest value for floating-point types.
+    /// @tparam T Type of element to search.
+    template<typename T>
+    T minimum(const T *input, size_t count) noexcept;
+
+    /// @brief Finds the largest value in an array.
+    /// @param input Values to search.
+    /// @param count Number of elements in @p input.
+    /// @return Largest value, or the smallest value @p T can hold if @p count is zero.
+    ///   Negative infinity is used as the smallest value for floating-point types.
+    /// @tparam T Type of element to search.
+    template<typename T>
+    T maximum(const T *input, size_t count) noexcept;
+
+    /// @brief Copies the elements that have been flagged to keep into a packed array.
+    /// @details Elements keep their relative order.
+    /// @param input Values to filter.
+    /// @param keep Flags indicating which elements to keep, one for each element in @p input.
+    /// @param[out] output Destination for the kept elements.
+    ///   This must have room for @p count elements, even if fewer are kept.
+    ///   This may be the same array as @p input.
+    /// @param count Number of elements in @p input and @p keep.
+    /// @return Number of elements written to @p output.
+    /// @tparam T Type of element to filter.
+    template<typename T>
+    size_t compact(const T *input, const bool *keep, T *output, size_t count) noexcept;
+
+    /// @brief Copies the elements that satisfy a predicate into a packed array.
+    /// @details Elements keep their relative order.
+    ///   The copy is branch-free so that unpredictable predicates don't stall the pipeline.
+    /// @param input Values to filter.
+    /// @param[out] output Destination for the kept elements.
+    ///   This must have room for @p count elements, even if fewer are kept.
+    ///   This may be the same array as @p input.
+    /// @param count Number of elements in @p input.
+    /// @param predicate Callable that takes an element and returns true if it should be kept.
+    /// @return Number of elements written to @p output.
+    /// @tparam T Type of element to filter.
+    /// @tparam Predicate Type of callable instance used to test elements.
+    template<typename T, typename Predicate>
+    size_t compact(const T *input, T *output, size_t count, Predicate predicate) {
+        size_t written = 0;
+        for(size_t i = 0; i < count; i++) {
+            const T value = input[i];
+            output[written] = value;
+            written += predicate(value) ? 1 : 0;
+        }
+        return written;
+    }
+
+    /// @brief Computes the inclusive prefix sum of an array using a pool of workers.
+    /// @details Each worker sums an equal slice of @p input. An exclusive scan of the slice sums gives each
+    ///   slice its carry, and then each worker scans its slice with its carry as the initial value.
+    ///   Pools with fewer than two workers scan on the calling thread.
+    /// @param pool Workers to scan with. No other job may be running on it.
+    /// @param input Values to scan.
+    /// @param[out] output Destination for the scanned values. This may be the same array as @p input.
+    /// @param count Number of elements in @p input and @p output.
+    /// @param initial Value to add to every element.
+    /// @return Sum of @p initial and every element in @p input.
+    /// @tparam T Type of element to scan.
+    template<typename T>
+    T inclusiveScan(WorkerPool &pool, const T *input, T *output, size_t count, T initial = T()) noexcept;
+
+    /// @brief Computes the exclusive prefix sum of an array using a pool of workers.
+    /// @details Slices are carried the same way as for the parallel @ref inclusiveScan().
+    /// @param pool Workers to scan with. No other job may be running on it.
+    /// @param input Values to scan.
+    /// @param[out] output Destination for the scanned values. This may be the same array as @p input.
+    /// @param count Number of elements in @p input and @p output.
+    /// @param initial Value to start the scan at.
+    /// @return Sum of @p initial and every element in @p input.
+    /// @tparam T Type of element to scan.
+    template<typename T>
+    T exclusiveScan(WorkerPool &pool, const T *input, T *output, size_t count, T initial = T()) noexcept;
+
+    /// @brief Adds all values in an array using a pool of workers.
+    /// @details Each worker adds an equal slice, and the slice sums are then added together.
+    /// @param pool Workers to add with. No other job may be running on it.
+    /// @param input Values to add.
+    /// @param count Number of elements in @p input.
+    /// @return Sum of all values, or zero if @p count is zero.
+    /// @tparam T Type of element to add.
+    template<typename T>
+    T sum(WorkerPool &pool, const T *input, size_t count) noexcept;
+
+    /// @brief Finds the smallest value in an array using a pool of workers.
+    /// @param pool Workers to search with. No other job may be running on it.
+    /// @param input Values to search.
+    /// @param count Number of elements in @p input.
+    /// @return Smallest value, or the same value as the serial @ref minimum() if @p count is zero.
+    /// @tparam T Type of element to search.
+    template<typename T>
+    T minimum(WorkerPool &pool, const T *input, size_t count) noexcept;
+
+    /// @brief Finds the largest value in an array using a pool of workers.
+    /// @param pool Workers to search with. No other job may be running on it.
+    /// @param input Values to search.
+    /// @param count Number of elements in @p input.
+    /// @return Largest value, or the same value as the serial @ref maximum() if @p count is zero.
+    /// @tparam T Type of element to search.
+    template<typename T>
+    T maximum(WorkerPool &pool, const T *input, size_t count) noexcept;
+
+    /// @brief Copies the elements that have been flagged to keep into a packed array using a pool of workers.
+    /// @details Each worker compacts an equal slice into a scratch array. An exclusive scan of the kept counts
+    ///   gives each slice its offset in @p output, and then each worker copies its kept elements to that offset.
+    ///   Elements keep their relative order.
+    /// @param pool Workers to filter with. No other job may be running on it.
+    /// @param input Values to filter.
+    /// @param keep Flags indicating which elements to keep, one for each element in @p input.
+    /// @param[out] output Destination for the kept elements.
+    ///   This must have room for @p count elements, even if fewer are kept.
+    ///   This may be the same array as @p input.
+    /// @param count Number of elements in @p input and @p keep.
+    /// @return Number of elements written to @p output.
+    /// @tparam T Type of element to filter.
+    template<typename T>
+    size_t compact(WorkerPool &pool, const T *input, const bool *keep, T *output, size_t count) noexcept;
+}
+
+#endif // HYPER_SCAN_H
@@ -0,0 +1,106 @@
+/// @file simd.h
+/// Detection of the vector instruction sets available to the compiler.
+/// Exactly one of the @c HYPER_SIMD_* instruction set macros is defined,
+/// picking the widest set enabled by the compiler flags (for instance @c -mavx2 or @c -march=native).
+/// Code using these macros must always provide a scalar fallback for @c HYPER_SIMD_NONE.
+/// Helpers shared by the byte-scanning parsers are declared after the macros.
+
+#ifndef HYPER_SIMD_H
+#define HYPER_SIMD_H
+
+#if defined(__AVX2__)
+/// @def HYPER_SIMD_AVX2
+/// @brief Defined when 256-bit AVX2 integer and floating-point instructions are available.
+#define HYPER_SIMD_AVX2 1
+#include <immintrin.h>
+
+#elif defined(__SSE2__) || defined(_M_X64)
+/// @def HYPER_SIMD_SSE2
+/// @brief Defined when 128-bit SSE2 instructions are available.
+/// @details SSE2 is part of the x86-64 baseline, so this is the minimum for 64-bit x86 builds.
+#define HYPER_SIMD_SSE2 1
+#include <emmintrin.h>
+
+#elif defined(__aarch64__) || defined(_M_ARM64)
+/// @def HYPER_SIMD_NEON
+/// @brief Defined when 128-bit AArch64 NEON instructions are available.
+/// @details NEON is part of the AArch64 baseline.
+#define HYPER_SIMD_NEON 1
+#include <arm_neon.h>
+
+#else
+/// @def HYPER_SIMD_NONE
+/// @brief Defined when no supported vector instruction set is available.
+#define HYPER_SIMD_NONE 1
+#endif
+
+#if defined(__PCLMUL__)
+#include <wmmintrin.h>
+#endif
+
+#include "integer.h"
+
+namespace hyper {
+#if defined(HYPER_SIMD_AVX2)
+    /// @brief Packs the results of comparing a 64-byte block into a mask with one bit per byte.
+    /// @param low Comparison result for the first 32 bytes, with each byte all ones or all zeros.
+    /// @param high Comparison result for the last 32 bytes.
+    /// @return Mask with bit @c i set if byte @c i matched.
+    inline uint64 movemask(__m256i low, __m256i high) noexcept {
+        return static_cast<uint32>(_mm256_movemask_epi8(low))
+                | static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(high))) << 32;
+    }
+#elif defined(HYPER_SIMD_SSE2)
+    /// @brief Packs the results of comparing a 64-byte block into a mask with one bit per byte.
+    /// @param a Comparison result for the first 16 bytes, with each byte all ones or all zeros.
+    /// @param b Comparison result for the next 16 bytes.
+    /// @param c Comparison result for the next 16 bytes.
+    /// @param d Comparison result for the last 16 bytes.
+    /// @return Mask with bit @c i set if byte @c i matched.
+    inline uint64 movemask(__m128i a, __m128i b, __m128i c, __m128i d) noexcept {
+        return static_cast<uint64>(_mm_movemask_epi8(a))
+                | static_cast<uint64>(_mm_movemask_epi8(b)) << 16
+                | static_cast<uint64>(_mm_movemask_epi8(c)) << 32
+                | static_cast<uint64>(_mm_movemask_epi8(d)) << 48;
+    }
+#elif defined(HYPER_SIMD_NEON)
+    /// @brief Packs the results of comparing a 64-byte block into a mask with one bit per byte.
+    /// @details NEON has no movemask, so each lane keeps one bit of its byte's position
+    ///   and pairwise additions pack the bits together.
+    /// @param a Comparison result for the first 16 bytes, with each byte all ones or all zeros.
+    /// @param b Comparison result for the next 16 bytes.
+    /// @param c Comparison result for the next 16 bytes.
+    /// @param d Comparison result for the last 16 bytes.
+    /// @return Mask with bit @c i set if byte @c i matched.
+    inline uint64 movemask(uint8x16_t a, uint8x16_t b, uint8x16_t c, uint8x16_t d) noexcept {
+        const uint8x16_t bits = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+        auto sum = vpaddq_u8(vpaddq_u8(vandq_u8(a, bits), vandq_u8(b, bits)),
+                vpaddq_u8(vandq_u8(c, bits), vandq_u8(d, bits)));
+        sum = vpaddq_u8(sum, sum);
+        return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+    }
+#endif
+
+    /// @brief Computes, for each bit, the XOR of it and every bit below it.
+    /// @details Applied to a mask of quotes, this sets the bits from each opening quote
+    ///   up to, but not including, its closing quote. Uses a carry-less multiply when PCLMUL is available.
+    /// @param bits Bits to combine.
+    /// @return Prefix XOR of the bits.
+    inline uint64 prefixXor(uint64 bits) noexcept {
+#if defined(__PCLMUL__)
+        const auto product = _mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<int64>(bits)),
+                _mm_set1_epi8(static_cast<char>(0xFF)), 0);
+        return static_cast<uint64>(_mm_cvtsi128_si64(product));
+#else
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+#endif
+    }
+}
+
+#endif // HYPER_SIMD_H
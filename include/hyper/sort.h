@@ -0,0 +1,147 @@
+/// @file sort.h
+/// In-place sorting of arrays.
+
+#ifndef HYPER_SORT_H
+#define HYPER_SORT_H
+
+#include <cstddef>   // For size_t.
+#include "utility.h"
+
+namespace hyper {
+    namespace detail {
+        /// @brief Arrays this small or smaller are finished with insertion sort.
+        constexpr size_t insertionSortThreshold = 16;
+
+        template<typename T, typename Less>
+        void insertionSort(T *values, size_t count, Less &less) {
+            for(size_t i = 1; i < count; i++) {
+                if(!less(values[i], values[i - 1]))
+                    continue;
+                T value(move(values[i]));
+                size_t j = i;
+                for(; j > 0 && less(value, values[j - 1]); j--)
+                    values[j] = move(values[j - 1]);
+                values[j] = move(value);
+            }
+        }
+
+        template<typename T, typename Less>
+        void siftDown(T *values, size_t root, size_t count, Less &less) {
+            T value(move(values[root]));
+            for(size_t child; (child = 2 * root + 1) < count; root = child) {
+                if(child + 1 < count && less(values[child], values[child + 1]))
+                    child++;
+                if(!less(value, values[child]))
+                    break;
+                values[root] = move(values[child]);
+            }
+            values[root] = move(value);
+        }
+
+        template<typename T, typename Less>
+        void heapSort(T *values, size_t count, Less &less) {
+            for(size_t i = count / 2; i-- > 0;)
+                siftDown(values, i, count, less);
+            for(size_t end = count; end-- > 1;) {
+                swap(values[0], values[end]);
+                siftDown(values, 0, end, less);
+            }
+        }
+
+        template<typename T, typename Less>
+        void introSort(T *values, size_t count, size_t depth, Less &less) {
+            while(count > insertionSortThreshold) {
+                // Quicksort has degenerated, so switch to the guaranteed O(n log n) heap sort.
+                if(depth == 0) {
+                    heapSort(values, count, less);
+                    return;
+                }
+                depth--;
+
+                // Median of three, moved to the front as the pivot.
+                // The largest of the three stops the left scan from running off the end.
+                const size_t middle = count / 2;
+                if(less(values[middle], values[0]))
+                    swap(values[middle], values[0]);
+                if(less(values[count - 1], values[middle])) {
+                    swap(values[count - 1], values[middle]);
+                    if(less(values[middle], values[0]))
+                        swap(values[middle], values[0]);
+                }
+                swap(values[0], values[middle]);
+
+                size_t i = 1, j = count - 1;
+                while(true) {
+                    while(less(values[i], values[0]))
+                        i++;
+                    while(less(values[0], values[j]))
+                        j--;
+                    if(i >= j)
+                        break;
+                    swap(values[i], values[j]);
+                    i++;
+                    j--;
+                }
+                swap(values[0], values[j]);
+
+                // Recurse into the smaller side and loop on the larger one to bound the stack depth.
+                if(j < count - j - 1) {
+                    introSort(values, j, depth, less);
+                    values += j + 1;
+                    count  -= j + 1;
+                } else {
+                    introSort(values + j + 1, count - j - 1, depth, less);
+                    count = j;
+                }
+            }
+            insertionSort(values, count, less);
+        }
+    }
+
+    /// @brief Sorts an array in place.
+    /// @details Uses introsort: quicksort with a median-of-three pivot,
+    ///   falling back to heap sort if the recursion gets too deep and to insertion sort for small ranges.
+    ///   This runs in O(n log n) time in the worst case and does not allocate.
+    ///   The sort is not stable; equal elements may be reordered.
+    /// @param values Array to sort.
+    /// @param count Number of elements in @p values.
+    /// @param less Callable that takes two elements and returns true if the first belongs before the second.
+    /// @tparam T Type of element to sort.
+    /// @tparam Less Type of comparison callable.
+    template<typename T, typename Less>
+    void sort(T *values, size_t count, Less less) {
+        size_t depth = 0;
+        for(size_t n = count; n > 1; n >>= 1)
+            depth += 2;
+        detail::introSort(values, count, depth, less);
+    }
+
+    /// @brief Sorts an array in place in ascending order.
+    /// @details Elements are compared with @c operator<.
+    /// @param values Array to sort.
+    /// @param count Number of elements in @p values.
+    /// @tparam T Type of element to sort.
+    template<typename T>
+    void sort(T *values, size_t count) {
+        sort(values, count, [](const T &first, const T &second) { return first < second; });
+    }
+
+    /// @brief Removes adjacent duplicate elements from an array.
+    /// @details When the array is sorted, this leaves only unique elements at the front of the array.
+    /// @param values Array to remove duplicates from.
+    /// @param count Number of elements in @p values.
+    /// @return Number of elements remaining at the front of the array.
+    /// @tparam T Type of element in the array. Elements are compared with @c operator==.
+    template<typename T>
+    size_t unique(T *values, size_t count) {
+        if(count == 0)
+            return 0;
+        size_t kept = 1;
+        for(size_t i = 1; i < count; i++)
+            if(!(values[i] == values[kept - 1]))
+                values[kept++] = move(values[i]);
+        return kept;
+    }
+}
+
+#endif // HYPER_SORT_H
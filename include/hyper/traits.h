@@ -0,0 +1,312 @@
+/// @file traits.h
+/// Compile-time queries and transformations of types.
+/// These stand in for the standard type traits, which aren't available without the standard library.
+/// Most are answered directly by compiler builtins, so they cost no template recursion.
+
+#ifndef HYPER_TRAITS_H
+#define HYPER_TRAITS_H
+
+#include <cstddef>   // For size_t.
+
+namespace hyper {
+    /// @brief Compile-time boolean constant.
+    /// @tparam Value Value of the constant.
+    template<bool Value>
+    struct BoolConstant {
+        /// @brief Value of the constant.
+        static constexpr bool value = Value;
+    };
+
+    /// @brief Strips reference modifiers from a type.
+    /// @tparam T Type to strip references from.
+    template<typename T>
+    struct RemoveReference {
+        /// @brief Non-reference type.
+        /// @details This type has all references removed from @p T.
+        typedef T type;
+    };
+
+    /// @brief Strips reference modifiers from a type.
+    /// @details This specialization changes an lvalue reference type to just a type.
+    /// @tparam T Type to strip references from.
+    template<typename T>
+    struct RemoveReference<T &> {
+        /// @brief Non-reference type.
+        /// @details This type has all references removed from @p T.
+        typedef T type;
+    };
+
+    /// @brief Strips reference modifiers from a type.
+    /// @details This specialization changes an rvalue reference type to just a type.
+    /// @tparam T Type to strip references from.
+    template<typename T>
+    struct RemoveReference<T &&> {
+        /// @brief Non-reference type.
+        /// @details This type has all references removed from @p T.
+        typedef T type;
+    };
+
+    /// @brief Strips const and volatile qualifiers from a type.
+    /// @tparam T Type to strip qualifiers from.
+    template<typename T>
+    struct RemoveCv {
+        /// @brief Unqualified type.
+        typedef T type;
+    };
+
+    /// @copydoc RemoveCv
+    template<typename T>
+    struct RemoveCv<const T> {
+        /// @brief Unqualified type.
+        typedef T type;
+    };
+
+    /// @copydoc RemoveCv
+    template<typename T>
+    struct RemoveCv<volatile T> {
+        /// @brief Unqualified type.
+        typedef T type;
+    };
+
+    /// @copydoc RemoveCv
+    template<typename T>
+    struct RemoveCv<const volatile T> {
+        /// @brief Unqualified type.
+        typedef T type;
+    };
+
+    /// @brief Strips references and then const and volatile qualifiers from a type.
+    /// @tparam T Type to strip.
+    template<typename T>
+    struct RemoveCvRef {
+        /// @brief Unqualified, non-reference type.
+        typedef typename RemoveCv<typename RemoveReference<T>::type>::type type;
+    };
+
+    /// @brief Static check if a type is an lvalue and has a reference modifier.
+    /// @tparam T Type to check references of.
+    template<typename T>
+    struct IsLValueReference {
+        /// @brief Flag indicating whether the type is an lvalue and has a reference modifier.
+        static constexpr bool value = false;
+    };
+
+    /// @brief Static check if a type is an lvalue and has a reference modifier.
+    /// @details This specialization always results in true.
+    /// @tparam T Type to check references of.
+    template<typename T>
+    struct IsLValueReference<T&> {
+        /// @brief Flag indicating whether the type is an lvalue and has a reference modifier.
+        static constexpr bool value = true;
+    };
+
+    /// @brief Static check if two types are the same, including qualifiers.
+    /// @tparam T1 First type to compare.
+    /// @tparam T2 Second type to compare.
+    template<typename T1, typename T2>
+    struct IsSame : BoolConstant<__is_same(T1, T2)> {
+    };
+
+    /// @brief Static check if a type is an array.
+    /// @tparam T Type to check.
+    template<typename T>
+    struct IsArray : BoolConstant<false> {
+    };
+
+    /// @copydoc IsArray
+    template<typename T>
+    struct IsArray<T[]> : BoolConstant<true> {
+    };
+
+    /// @copydoc IsArray
+    template<typename T, size_t Size>
+    struct IsArray<T[Size]> : BoolConstant<true> {
+    };
+
+    /// @brief Strips one array dimension from a type.
+    /// @tparam T Type to strip.
+    template<typename T>
+    struct RemoveExtent {
+        /// @brief Element type, or @p T if it isn't an array.
+        typedef T type;
+    };
+
+    /// @copydoc RemoveExtent
+    template<typename T>
+    struct RemoveExtent<T[]> {
+        /// @brief Element type, or @p T if it isn't an array.
+        typedef T type;
+    };
+
+    /// @copydoc RemoveExtent
+    template<typename T, size_t Size>
+    struct RemoveExtent<T[Size]> {
+        /// @brief Element type, or @p T if it isn't an array.
+        typedef T type;
+    };
+
+    /// @brief Static check if a type is const-qualified.
+    /// @tparam T Type to check.
+    template<typename T>
+    struct IsConst : BoolConstant<false> {
+    };
+
+    /// @copydoc IsConst
+    template<typename T>
+    struct IsConst<const T> : BoolConstant<true> {
+    };
+
+    /// @brief Static check if a type is a reference.
+    /// @tparam T Type to check.
+    template<typename T>
+    struct IsReference : BoolConstant<false> {
+    };
+
+    /// @copydoc IsReference
+    template<typename T>
+    struct IsReference<T &> : BoolConstant<true> {
+    };
+
+    /// @copydoc IsReference
+    template<typename T>
+    struct IsReference<T &&> : BoolConstant<true> {
+    };
+
+    /// @brief Static check if a type is a function type (not a pointer to one).
+    /// @details Only functions and references can't be const-qualified, which tells them apart.
+    /// @tparam T Type to check.
+    template<typename T>
+    struct IsFunction : BoolConstant<!IsConst<const T>::value && !IsReference<T>::value> {
+    };
+
+    /// @brief Static check if a type is a class or struct without non-static data members or virtual functions.
+    /// @details Empty types can take no space as base classes or @c [[no_unique_address]] members.
+    /// @tparam T Type to check.
+    template<typename T>
+    struct IsEmpty : BoolConstant<__is_empty(T)> {
+    };
+
+    /// @brief Static check if a type is an enumeration.
+    /// @tparam T Type to check.
+    template<typename T>
+    struct IsEnum : BoolConstant<__is_enum(T)> {
+    };
+
+    /// @brief Static check if a type can be copied with @c memcpy.
+    /// @details True for scalars and for classes whose copy and move operations and destructor are all trivial.
+    /// @tparam T Type to check.
+    template<typename T>
+    struct IsTriviallyCopyable : BoolConstant<__is_trivially_copyable(T)> {
+    };
+
+    /// @brief Static check if destroying a type does nothing.
+    /// @details Containers can skip calling the destructors of such elements.
+    ///   Types with a deleted destructor can't be destroyed at all, so they aren't trivially destructible.
+    /// @tparam T Type to check.
+#if defined(__has_builtin) && __has_builtin(__is_trivially_destructible)
+    template<typename T>
+    struct IsTriviallyDestructible : BoolConstant<__is_trivially_destructible(T)> {
+    };
+#else
+    // The older builtin is true for deleted destructors, so destructibility is checked separately.
+    template<typename T>
+    struct IsTriviallyDestructible : BoolConstant<__has_trivial_destructor(T) && requires(T &value) { value.~T(); }> {
+    };
+#endif
+
+    /// @brief Static check if a type can be moved to a new address with @c memcpy, leaving the old copy unusable.
+    /// @details Relocating is a move construction followed by destroying the source.
+    ///   For many types that hold resources, such as owning pointers, this is the same as copying the bytes
+    ///   and forgetting the source, even though their move constructors and destructors aren't trivial.
+    ///   Trivially copyable types are always trivially relocatable;
+    ///   specialize this for other types that can be relocated by copying their bytes.
+    /// @tparam T Type to check.
+    template<typename T>
+    struct IsTriviallyRelocatable : BoolConstant<__is_trivially_copyable(T)> {
+    };
+
+    /// @brief Picks one of two types.
+    /// @tparam Condition Which type to pick.
+    /// @tparam IfTrue Type picked when @p Condition is true.
+    /// @tparam IfFalse Type picked when @p Condition is false.
+    template<bool Condition, typename IfTrue, typename IfFalse>
+    struct Conditional {
+        /// @brief Picked type.
+        typedef IfTrue type;
+    };
+
+    /// @copydoc Conditional
+    template<typename IfTrue, typename IfFalse>
+    struct Conditional<false, IfTrue, IfFalse> {
+        /// @brief Picked type.
+        typedef IfFalse type;
+    };
+
+    /// @brief Removes a template from overload resolution unless a condition holds.
+    /// @details Use as a defaulted template parameter or return type:
+    ///   @code
+    ///   template<typename T, typename = typename EnableIf<IsTriviallyCopyable<T>::value>::type>
+    ///   void copyBytes(T *destination, const T *source, size_t count);
+    ///   @endcode
+    ///   This is how the constraints below are expressed in code that can't use concepts.
+    /// @tparam Condition Whether the template is enabled.
+    /// @tparam T Type produced when enabled.
+    template<bool Condition, typename T = void>
+    struct EnableIf {
+    };
+
+    /// @copydoc EnableIf
+    template<typename T>
+    struct EnableIf<true, T> {
+        /// @brief Type produced when enabled.
+        typedef T type;
+    };
+
+    /// @brief Applies the conversions that happen when a type is passed by value.
+    /// @details References and qualifiers are removed, arrays become pointers to their elements
+    ///   and functions become function pointers.
+    /// @tparam T Type to convert.
+    template<typename T>
+    struct Decay {
+    private:
+        typedef typename RemoveReference<T>::type U;
+
+    public:
+        /// @brief Converted type.
+        typedef typename Conditional<IsArray<U>::value, typename RemoveExtent<U>::type *,
+                typename Conditional<IsFunction<U>::value, U *,
+                        typename RemoveCv<U>::type>::type>::type type;
+    };
+
+#if defined(__cpp_concepts)
+    /// @brief Satisfied when two types are the same.
+    template<typename T1, typename T2>
+    concept SameAs = __is_same(T1, T2) && __is_same(T2, T1);
+
+    /// @brief Satisfied by types that can be copied with @c memcpy.
+    template<typename T>
+    concept TriviallyCopyable = IsTriviallyCopyable<T>::value;
+
+    /// @brief Satisfied by types whose destructor does nothing.
+    template<typename T>
+    concept TriviallyDestructible = IsTriviallyDestructible<T>::value;
+
+    /// @brief Satisfied by types that can be moved to a new address with @c memcpy.
+    template<typename T>
+    concept TriviallyRelocatable = IsTriviallyRelocatable<T>::value;
+
+    /// @brief Satisfied by types that can be compared with @c operator==.
+    template<typename T>
+    concept EqualityComparable = requires(const T &first, const T &second) {
+        { first == second } -> SameAs<bool>;
+    };
+
+    /// @brief Satisfied by types that can be ordered with @c operator<.
+    template<typename T>
+    concept LessThanComparable = requires(const T &first, const T &second) {
+        { first < second } -> SameAs<bool>;
+    };
+#endif
+}
+
+#endif // HYPER_TRAITS_H
@@ -4,53 +4,11 @@
 #ifndef HYPER_UTILITY_H
 #define HYPER_UTILITY_H
 
-namespace hyper {
-    /// @brief Strips reference modifiers from a type.
-    /// @tparam T Type to strip references from.
-    template<typename T>
-    struct RemoveReference {
-        /// @brief Non-reference type.
-        /// @details This type has all references removed from @p T.
-        typedef T type;
-    };
-
-    /// @brief Strips reference modifiers from a type.
-    /// @details This specialization changes an lvalue reference type to just a type.
-    /// @tparam T Type to strip references from.
-    template<typename T>
-    struct RemoveReference<T &> {
-        /// @brief Non-reference type.
-        /// @details This type has all references removed from @p T.
-        typedef T type;
-    };
-
-    /// @brief Strips reference modifiers from a type.
-    /// @details This specialization changes an rvalue reference type to just a type.
-    /// @tparam T Type to strip references from.
-    template<typename T>
-    struct RemoveReference<T &&> {
-        /// @brief Non-reference type.
-        /// @details This type has all references removed from @p T.
-        typedef T type;
-    };
-
-    /// @brief Static check if a type is an lvalue and has a reference modifier.
-    /// @tparam T Type to check references of.
-    template<typename T>
-    struct IsLValueReference {
-        /// @brief Flag indicating whether the type is an lvalue and has a reference modifier.
-        static constexpr bool value = false;
-    };
-
-    /// @brief Static check if a type is an lvalue and has a reference modifier.
-    /// @details This specialization always results in true.
-    /// @tparam T Type to check references of.
-    template<typename T>
-    struct IsLValueReference<T&> {
-        /// @brief Flag indicating whether the type is an lvalue and has a reference modifier.
-        static constexpr bool value = true;
-    };
+#include <cstddef>   // For size_t.
+#include <new>       // For placement new.
+#include "traits.h"
 
+namespace hyper {
     /// @brief Forwards an expression reference as-is to another location.
     /// @details Forwards an rvalue reference as an rvalue
     ///   and an lvalue reference as an lvalue reference.
@@ -86,15 +44,46 @@ namespace hyper {
 
     /// @brief Swaps the value of two variables.
     /// @details Swaps the contents of @p first and @p second.
+    ///   Trivially relocatable types have their bytes exchanged,
+    ///   which skips the reference count traffic and null checks of three moves through a temporary.
     /// @param first First value to swap.
     /// @param second Second value to swap.
     /// @tparam T Type of values to swap.
     /// @note Types that have a more efficient swapping method should specialize this method.
     template<typename T>
     void swap(T &first, T &second) {
-        T temp(move(first));
-        first = move(second);
-        second = move(temp);
+        if constexpr(IsTriviallyRelocatable<T>::value) {
+            alignas(T) unsigned char temp[sizeof(T)];
+            __builtin_memcpy(temp, static_cast<void *>(&first), sizeof(T));
+            __builtin_memcpy(static_cast<void *>(&first), static_cast<void *>(&second), sizeof(T));
+            __builtin_memcpy(static_cast<void *>(&second), temp, sizeof(T));
+        } else {
+            T temp(move(first));
+            first = move(second);
+            second = move(temp);
+        }
+    }
+
+    /// @brief Moves values into uninitialized memory and destroys the originals.
+    /// @details Afterwards @p destination holds the values and @p source is uninitialized memory.
+    ///   Trivially relocatable types are copied as bytes in one pass;
+    ///   other types are move-constructed and destroyed one at a time.
+    ///   The ranges may overlap only if @p destination comes first.
+    /// @param destination Uninitialized memory to move the values into.
+    /// @param source Values to move.
+    /// @param count Number of values to move.
+    /// @tparam T Type of values to move.
+    template<typename T>
+    void relocate(T *destination, T *source, size_t count) noexcept {
+        if constexpr(IsTriviallyRelocatable<T>::value) {
+            if(count > 0)
+                __builtin_memmove(static_cast<void *>(destination), static_cast<void *>(source), count * sizeof(T));
+        } else {
+            for(size_t i = 0; i < count; i++) {
+                new(&destination[i]) T(move(source[i]));
+                source[i].~T();
+            }
+        }
     }
 }
 
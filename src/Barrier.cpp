@@ -0,0 +1,46 @@
+#include "hyper/assert.h"
+#include "hyper/Barrier.h"
+#include "hyper/futex.h"
+#include "hyper/SpinLock.h"
+
+namespace hyper {
+    Barrier::Barrier(uint32 threads, uint32 spinCount) noexcept
+            : _threads(threads), _spinCount(spinCount), _remaining(threads), _phase(0), _sleepers(0) {
+        ASSERTF(threads > 0, "Barrier needs at least one thread");
+    }
+
+    uint32 Barrier::threads() const noexcept {
+        return _threads;
+    }
+
+    uint32 Barrier::phase() const noexcept {
+        return __atomic_load_n(&_phase, __ATOMIC_ACQUIRE);
+    }
+
+    bool Barrier::arriveAndWait() noexcept {
+        // The phase has to be read before arriving, since the last thread may advance it right after.
+        const auto phase = __atomic_load_n(&_phase, __ATOMIC_RELAXED);
+        if(__atomic_sub_fetch(&_remaining, 1, __ATOMIC_ACQ_REL) == 0) {
+            // No thread can arrive for the next phase until the phase changes, so resetting first is safe.
+            __atomic_store_n(&_remaining, _threads, __ATOMIC_RELAXED);
+            __atomic_store_n(&_phase, phase + 1, __ATOMIC_SEQ_CST);
+            if(__atomic_load_n(&_sleepers, __ATOMIC_SEQ_CST) > 0)
+                futexWakeAll(&_phase);
+            return true;
+        }
+
+        for(uint32 spins = 0; spins < _spinCount; spins++) {
+            if(__atomic_load_n(&_phase, __ATOMIC_ACQUIRE) != phase)
+                return false;
+            cpuRelax();
+        }
+
+        // Registering before the final check pairs with the last thread, which checks for sleepers after advancing.
+        __atomic_add_fetch(&_sleepers, 1, __ATOMIC_SEQ_CST);
+        while(__atomic_load_n(&_phase, __ATOMIC_SEQ_CST) == phase)
+            futexWait(&_phase, phase);
+        __atomic_sub_fetch(&_sleepers, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        return false;
+    }
+}
@@ -0,0 +1,266 @@
+#include <cmath>   // For log(), floor() and round().
+#include "hyper/BinaryFuseFilter.h"
+#include "hyper/sort.h"
+
+namespace hyper {
+    namespace {
+        // Attempts with different seeds before construction gives up.
+        constexpr uint32 maxAttempts = 100;
+
+        // Number of queries to prefetch ahead in batched lookups.
+        constexpr size_t prefetchDistance = 16;
+
+        inline uint64 nextSeed(uint64 &state) noexcept {
+            state += 0x9E3779B97F4A7C15ull;
+            uint64 z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        inline uint8 fingerprint(uint64 hash) noexcept {
+            return static_cast<uint8>(hash ^ (hash >> 32));
+        }
+
+        inline uint32 mod3(uint32 x) noexcept {
+            return x > 2 ? x - 3 : x;
+        }
+    }
+
+    BinaryFuseFilter::BinaryFuseFilter() noexcept
+            : _seed(0), _segmentLength(0), _segmentLengthMask(0), _segmentCount(0),
+              _segmentCountLength(0), _arrayLength(0), _fingerprints(nullptr) {
+        // ...
+    }
+
+    BinaryFuseFilter::~BinaryFuseFilter() noexcept {
+        delete[] _fingerprints;
+    }
+
+    void BinaryFuseFilter::allocate(size_t count) noexcept {
+        delete[] _fingerprints;
+        if(count == 0) {
+            _segmentLength = _segmentLengthMask = _segmentCount = _segmentCountLength = _arrayLength = 0;
+            _fingerprints = nullptr;
+            return;
+        }
+
+        // Segment length and size factor are the empirically tuned values for arity 3 from the binary fuse paper.
+        const auto size = static_cast<double>(count);
+        _segmentLength = uint32(1) << static_cast<int>(floor(log(size) / log(3.33) + 2.25));
+        if(_segmentLength > 262144)
+            _segmentLength = 262144;
+        _segmentLengthMask = _segmentLength - 1;
+
+        double sizeFactor = count <= 1 ? 0 : 0.875 + 0.25 * log(1000000.0) / log(size);
+        if(sizeFactor < 1.125 && count > 1)
+            sizeFactor = 1.125;
+        const auto capacity = count <= 1 ? 0 : static_cast<uint32>(round(size * sizeFactor));
+        const uint32 initialSegments = (capacity + _segmentLength - 1) / _segmentLength;
+        _segmentCount = initialSegments > 2 ? initialSegments - 2 : 1;
+        _arrayLength = (_segmentCount + 2) * _segmentLength;
+        _segmentCountLength = _segmentCount * _segmentLength;
+        _fingerprints = new uint8[_arrayLength]();
+    }
+
+    uint32 BinaryFuseFilter::position(uint32 index, uint64 hash) const noexcept {
+        auto h = reduceRange(hash, _segmentCountLength) + index * _segmentLength;
+        // The three positions use different, non-overlapping 18-bit slices of the low 36 bits.
+        const uint64 low = hash & ((uint64(1) << 36) - 1);
+        h ^= (low >> (36 - 18 * index)) & _segmentLengthMask;
+        return static_cast<uint32>(h);
+    }
+
+    bool BinaryFuseFilter::build(const uint64 *keys, size_t count) noexcept {
+        allocate(count);
+        if(count == 0)
+            return true;
+
+        const uint32 capacity = _arrayLength;
+        auto order    = new uint64[count + 1]();
+        auto found    = new uint8[count];
+        auto alone    = new uint32[capacity];
+        auto t2count  = new uint8[capacity]();
+        auto t2hash   = new uint64[capacity]();
+
+        // Keys are bucketed by their first segment before they are added,
+        // so that the peeling pass walks memory roughly in order.
+        uint32 blockBits = 1;
+        while((uint32(1) << blockBits) < _segmentCount)
+            blockBits++;
+        const size_t blockCount = size_t(1) << blockBits;
+        auto startPositions = new size_t[blockCount];
+
+        // Duplicates that share all three slots with other keys can't be detected while adding keys,
+        // so if construction fails, the keys are copied and deduplicated before trying again.
+        const uint64 *source = keys;
+        uint64 *deduplicated = nullptr;
+        const size_t originalCount = count;
+
+        uint64 seedState = 0x726B2B9D438B9D4Dull;
+        bool built = false;
+        for(uint32 attempt = 0; attempt < maxAttempts && !built; attempt++) {
+            _seed = nextSeed(seedState);
+            for(size_t i = 0; i < blockCount; i++)
+                startPositions[i] = (i * count) >> blockBits;
+            order[count] = 1;
+            for(size_t i = 0; i < count; i++) {
+                const auto keyHash = hash(source[i] + _seed);
+                auto segment = static_cast<size_t>(keyHash >> (64 - blockBits));
+                while(order[startPositions[segment]] != 0)
+                    segment = (segment + 1) & (blockCount - 1);
+                order[startPositions[segment]] = keyHash;
+                startPositions[segment]++;
+            }
+
+            // Each slot tracks the number of keys mapped to it (upper six bits),
+            // the xor of which of the three positions those keys use it as (lower two bits),
+            // and the xor of their hashes.
+            bool error = false;
+            size_t duplicates = 0;
+            for(size_t i = 0; i < count; i++) {
+                const auto keyHash = order[i];
+                const auto h0 = position(0, keyHash);
+                const auto h1 = position(1, keyHash);
+                const auto h2 = position(2, keyHash);
+                t2count[h0] += 4;
+                t2hash[h0] ^= keyHash;
+                t2count[h1] += 4;
+                t2count[h1] ^= 1;
+                t2hash[h1] ^= keyHash;
+                t2count[h2] += 4;
+                t2count[h2] ^= 2;
+                t2hash[h2] ^= keyHash;
+                // A duplicate key cancels its own hash; drop it.
+                if((t2hash[h0] & t2hash[h1] & t2hash[h2]) == 0) {
+                    if((t2hash[h0] == 0 && t2count[h0] == 8) || (t2hash[h1] == 0 && t2count[h1] == 8)
+                       || (t2hash[h2] == 0 && t2count[h2] == 8)) {
+                        duplicates++;
+                        t2count[h0] -= 4;
+                        t2hash[h0] ^= keyHash;
+                        t2count[h1] -= 4;
+                        t2count[h1] ^= 1;
+                        t2hash[h1] ^= keyHash;
+                        t2count[h2] -= 4;
+                        t2count[h2] ^= 2;
+                        t2hash[h2] ^= keyHash;
+                    }
+                }
+                // The count overflowed, which means too many keys landed on one slot.
+                error |= t2count[h0] < 4 || t2count[h1] < 4 || t2count[h2] < 4;
+            }
+
+            size_t stackSize = 0;
+            if(!error) {
+                // Peel slots that have exactly one key, pushing the keys on a stack in peeling order.
+                size_t queueSize = 0;
+                for(uint32 i = 0; i < capacity; i++) {
+                    alone[queueSize] = i;
+                    queueSize += (t2count[i] >> 2) == 1 ? 1 : 0;
+                }
+                while(queueSize > 0) {
+                    const auto index = alone[--queueSize];
+                    if((t2count[index] >> 2) != 1)
+                        continue;
+                    const auto keyHash = t2hash[index];
+                    uint32 positions[5];
+                    positions[0] = position(0, keyHash);
+                    positions[1] = position(1, keyHash);
+                    positions[2] = position(2, keyHash);
+                    positions[3] = positions[0];
+                    positions[4] = positions[1];
+                    const uint32 which = t2count[index] & 3;
+                    found[stackSize] = static_cast<uint8>(which);
+                    order[stackSize] = keyHash;
+                    stackSize++;
+                    for(uint32 offset = 1; offset <= 2; offset++) {
+                        const auto other = positions[which + offset];
+                        alone[queueSize] = other;
+                        queueSize += (t2count[other] >> 2) == 2 ? 1 : 0;
+                        t2count[other] -= 4;
+                        t2count[other] ^= static_cast<uint8>(mod3(which + offset));
+                        t2hash[other] ^= keyHash;
+                    }
+                }
+                built = stackSize + duplicates == count;
+            }
+
+            if(built) {
+                // Assign fingerprints in reverse peeling order so that each key's slot is free when it is reached.
+                for(size_t i = stackSize; i-- > 0;) {
+                    const auto keyHash = order[i];
+                    uint32 positions[5];
+                    positions[0] = position(0, keyHash);
+                    positions[1] = position(1, keyHash);
+                    positions[2] = position(2, keyHash);
+                    positions[3] = positions[0];
+                    positions[4] = positions[1];
+                    const uint32 which = found[i];
+                    _fingerprints[positions[which]] = static_cast<uint8>(fingerprint(keyHash)
+                            ^ _fingerprints[positions[which + 1]] ^ _fingerprints[positions[which + 2]]);
+                }
+            } else {
+                if(deduplicated == nullptr) {
+                    deduplicated = new uint64[count];
+                    for(size_t i = 0; i < count; i++)
+                        deduplicated[i] = keys[i];
+                    sort(deduplicated, count);
+                    count  = unique(deduplicated, count);
+                    source = deduplicated;
+                }
+                for(size_t i = 0; i <= originalCount; i++)
+                    order[i] = 0;
+                for(uint32 i = 0; i < capacity; i++) {
+                    t2count[i] = 0;
+                    t2hash[i]  = 0;
+                }
+            }
+        }
+
+        delete[] deduplicated;
+        delete[] startPositions;
+        delete[] t2hash;
+        delete[] t2count;
+        delete[] alone;
+        delete[] found;
+        delete[] order;
+        if(!built)
+            allocate(0);
+        return built;
+    }
+
+    bool BinaryFuseFilter::contains(uint64 key) const noexcept {
+        if(_segmentCountLength == 0)
+            return false;
+        const auto keyHash = hash(key + _seed);
+        const auto f = fingerprint(keyHash) ^ _fingerprints[position(0, keyHash)]
+                ^ _fingerprints[position(1, keyHash)] ^ _fingerprints[position(2, keyHash)];
+        return f == 0;
+    }
+
+    void BinaryFuseFilter::contains(const uint64 *keys, size_t count, bool *results) const noexcept {
+        if(_segmentCountLength == 0) {
+            for(size_t i = 0; i < count; i++)
+                results[i] = false;
+            return;
+        }
+        auto prefetch = [this](uint64 key) {
+            const auto keyHash = hash(key + _seed);
+            __builtin_prefetch(&_fingerprints[position(0, keyHash)]);
+            __builtin_prefetch(&_fingerprints[position(1, keyHash)]);
+            __builtin_prefetch(&_fingerprints[position(2, keyHash)]);
+        };
+        const size_t warmup = count < prefetchDistance ? count : prefetchDistance;
+        for(size_t i = 0; i < warmup; i++)
+            prefetch(keys[i]);
+        for(size_t i = 0; i < count; i++) {
+            if(i + prefetchDistance < count)
+                prefetch(keys[i + prefetchDistance]);
+            results[i] = contains(keys[i]);
+        }
+    }
+
+    size_t BinaryFuseFilter::sizeInBytes() const noexcept {
+        return _arrayLength;
+    }
+}
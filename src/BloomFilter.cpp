@@ -0,0 +1,69 @@
+#include "hyper/BloomFilter.h"
+
+namespace hyper {
+    namespace {
+        // Odd multipliers that pick an independent bit in each word from the same 32 bits of hash.
+        constexpr uint32 salts[8] = {
+                0x47B6137Bu, 0x44974D91u, 0x8824AD5Bu, 0xA2B7289Du,
+                0x705495C7u, 0x2DF1424Bu, 0x9EFC4947u, 0x5C6BFB31u
+        };
+
+        // Number of queries to prefetch ahead in batched lookups.
+        constexpr size_t prefetchDistance = 16;
+    }
+
+    BloomFilter::BloomFilter(size_t keyCount, size_t bitsPerKey) noexcept
+            : _blocks(nullptr), _blockCount((keyCount * bitsPerKey + 511) / 512) {
+        if(_blockCount == 0)
+            _blockCount = 1;
+        _blocks = new Block[_blockCount]();
+    }
+
+    BloomFilter::~BloomFilter() noexcept {
+        delete[] _blocks;
+    }
+
+    void BloomFilter::computeMask(uint64 hash, uint64 (&mask)[8]) noexcept {
+        const auto low = static_cast<uint32>(hash);
+        for(size_t i = 0; i < 8; i++)
+            mask[i] = uint64(1) << ((low * salts[i]) >> 26);
+    }
+
+    void BloomFilter::insertHash(uint64 hash) noexcept {
+        uint64 mask[8];
+        computeMask(hash, mask);
+        auto &block = _blocks[reduceRange(hash, _blockCount)];
+        for(size_t i = 0; i < 8; i++)
+            block.words[i] |= mask[i];
+    }
+
+    bool BloomFilter::containsHash(uint64 hash) const noexcept {
+        uint64 mask[8];
+        computeMask(hash, mask);
+        const auto &block = _blocks[reduceRange(hash, _blockCount)];
+        uint64 missing = 0;
+        for(size_t i = 0; i < 8; i++)
+            missing |= mask[i] & ~block.words[i];
+        return missing == 0;
+    }
+
+    void BloomFilter::containsHashes(const uint64 *hashes, size_t count, bool *results) const noexcept {
+        const size_t warmup = count < prefetchDistance ? count : prefetchDistance;
+        for(size_t i = 0; i < warmup; i++)
+            __builtin_prefetch(&_blocks[reduceRange(hashes[i], _blockCount)]);
+        for(size_t i = 0; i < count; i++) {
+            if(i + prefetchDistance < count)
+                __builtin_prefetch(&_blocks[reduceRange(hashes[i + prefetchDistance], _blockCount)]);
+            results[i] = containsHash(hashes[i]);
+        }
+    }
+
+    void BloomFilter::clear() noexcept {
+        for(size_t i = 0; i < _blockCount; i++)
+            _blocks[i] = Block();
+    }
+
+    size_t BloomFilter::sizeInBytes() const noexcept {
+        return _blockCount * sizeof(Block);
+    }
+}
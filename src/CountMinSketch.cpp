@@ -0,0 +1,129 @@
+#include "hyper/CountMinSketch.h"
+#include "hyper/assert.h"
+#include "hyper/limits.h"
+
+namespace hyper {
+    namespace {
+        // Serialized header: magic, version, two reserved bytes, then width, depth and total.
+        constexpr uint8 serialMagic   = 0x43;
+        constexpr uint8 serialVersion = 1;
+        constexpr size_t headerSize   = 4 + 3 * sizeof(uint64);
+
+        inline uint32 saturatingAdd(uint32 a, uint32 b) noexcept {
+            const uint32 sum = a + b;
+            return sum < a ? maxValue<uint32>() : sum;
+        }
+
+        inline void storeUInt64(byte *output, uint64 value) noexcept {
+            __builtin_memcpy(output, &value, sizeof(value));
+        }
+
+        inline uint64 loadUInt64(const byte *input) noexcept {
+            uint64 value;
+            __builtin_memcpy(&value, input, sizeof(value));
+            return value;
+        }
+    }
+
+    CountMinSketch::CountMinSketch(size_t width, size_t depth) noexcept
+            : _counters(nullptr), _width(width), _depth(depth), _total(0) {
+        ASSERTF(width > 0 && depth > 0, "Count-Min sketch dimensions must be non-zero, got %zu x %zu", width, depth);
+        _counters = new uint32[width * depth]();
+    }
+
+    CountMinSketch::~CountMinSketch() noexcept {
+        delete[] _counters;
+    }
+
+    size_t CountMinSketch::column(uint64 keyHash, uint64 step, size_t row) const noexcept {
+        // Double hashing gives each row an independent column from two hashes.
+        return static_cast<size_t>(reduceRange(keyHash + row * step, _width));
+    }
+
+    void CountMinSketch::addHash(uint64 keyHash, uint32 count) noexcept {
+        _total += count;
+        const uint64 step = hash(keyHash) | 1;
+        const uint32 target = saturatingAdd(estimateHash(keyHash), count);
+        for(size_t row = 0; row < _depth; row++) {
+            auto &counter = _counters[row * _width + column(keyHash, step, row)];
+            if(counter < target)
+                counter = target;
+        }
+    }
+
+    uint32 CountMinSketch::estimateHash(uint64 keyHash) const noexcept {
+        const uint64 step = hash(keyHash) | 1;
+        uint32 smallest = maxValue<uint32>();
+        for(size_t row = 0; row < _depth; row++) {
+            const auto counter = _counters[row * _width + column(keyHash, step, row)];
+            if(counter < smallest)
+                smallest = counter;
+        }
+        return smallest;
+    }
+
+    uint64 CountMinSketch::totalCount() const noexcept {
+        return _total;
+    }
+
+    bool CountMinSketch::merge(const CountMinSketch &other) noexcept {
+        if(other._width != _width || other._depth != _depth)
+            return false;
+        const size_t count = _width * _depth;
+        for(size_t i = 0; i < count; i++)
+            _counters[i] = saturatingAdd(_counters[i], other._counters[i]);
+        _total += other._total;
+        return true;
+    }
+
+    void CountMinSketch::clear() noexcept {
+        const size_t count = _width * _depth;
+        for(size_t i = 0; i < count; i++)
+            _counters[i] = 0;
+        _total = 0;
+    }
+
+    size_t CountMinSketch::width() const noexcept {
+        return _width;
+    }
+
+    size_t CountMinSketch::depth() const noexcept {
+        return _depth;
+    }
+
+    size_t CountMinSketch::serializedSize() const noexcept {
+        return headerSize + _width * _depth * sizeof(uint32);
+    }
+
+    size_t CountMinSketch::serialize(byte *output) const noexcept {
+        output[0] = byte(serialMagic);
+        output[1] = byte(serialVersion);
+        output[2] = byte(0);
+        output[3] = byte(0);
+        storeUInt64(output + 4, _width);
+        storeUInt64(output + 4 + sizeof(uint64), _depth);
+        storeUInt64(output + 4 + 2 * sizeof(uint64), _total);
+        const size_t counterBytes = _width * _depth * sizeof(uint32);
+        __builtin_memcpy(output + headerSize, _counters, counterBytes);
+        return headerSize + counterBytes;
+    }
+
+    bool CountMinSketch::deserialize(const byte *input, size_t size) noexcept {
+        if(size < headerSize || toInt(input[0]) != serialMagic || toInt(input[1]) != serialVersion)
+            return false;
+        const uint64 width = loadUInt64(input + 4);
+        const uint64 depth = loadUInt64(input + 4 + sizeof(uint64));
+        // Check the dimensions against the data size without letting the product overflow.
+        if(width == 0 || depth == 0 || width > (size - headerSize) / sizeof(uint32) / depth
+           || width * depth * sizeof(uint32) != size - headerSize)
+            return false;
+
+        delete[] _counters;
+        _width  = static_cast<size_t>(width);
+        _depth  = static_cast<size_t>(depth);
+        _total  = loadUInt64(input + 4 + 2 * sizeof(uint64));
+        _counters = new uint32[_width * _depth];
+        __builtin_memcpy(_counters, input + headerSize, _width * _depth * sizeof(uint32));
+        return true;
+    }
+}
@@ -12,26 +12,24 @@ namespace hyper {
     }
 
     size_t Counter::value() const noexcept {
-        return _count;
+        return __atomic_load_n(&_count, __ATOMIC_ACQUIRE);
     }
 
     size_t Counter::increment() noexcept {
-        auto value = _count;
-        _count++;
-        return value;
+        return __atomic_fetch_add(&_count, 1, __ATOMIC_RELAXED);
     }
 
     size_t Counter::decrement() noexcept {
-        auto value = _count;
-        if(_count > 0)
-            _count--;
+        // A failed exchange reloads the current value, so the loop retries until it wins or reaches zero.
+        auto value = __atomic_load_n(&_count, __ATOMIC_RELAXED);
+        while(value > 0 && !__atomic_compare_exchange_n(&_count, &value, value - 1, true,
+                                                          __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+            continue;
         return value;
     }
 
     size_t Counter::reset() noexcept {
-        auto value = _count;
-        _count = 0;
-        return value;
+        return __atomic_exchange_n(&_count, 0, __ATOMIC_ACQ_REL);
     }
 
     Counter &Counter::operator++() noexcept {
@@ -0,0 +1,190 @@
+#include <cstdio>     // For snprintf().
+#include <fcntl.h>    // For open().
+#include <unistd.h>   // For read(), close() and sysconf().
+#include "hyper/assert.h"
+#include "hyper/CpuTopology.h"
+
+namespace hyper {
+    namespace {
+        // Cache indices to check for the last-level cache. Most processors have four or five.
+        constexpr uint32 maxCacheIndex = 16;
+
+        // Marks a cache key made up from the package, for machines that don't describe their caches.
+        constexpr uint32 packageCacheKey = 0x80000000;
+
+        bool readFile(const char *path, char *buffer, size_t capacity) noexcept {
+            const int fd = open(path, O_RDONLY);
+            if(fd < 0)
+                return false;
+            const auto length = read(fd, buffer, capacity - 1);
+            close(fd);
+            if(length <= 0)
+                return false;
+            buffer[length] = '\0';
+            return true;
+        }
+
+        // Visits every number in a CPU list such as "0-3,8,10-11".
+        template<typename Visit>
+        void parseList(const char *text, Visit visit) noexcept {
+            while(*text >= '0' && *text <= '9') {
+                uint32 first = 0;
+                for(; *text >= '0' && *text <= '9'; text++)
+                    first = first * 10 + static_cast<uint32>(*text - '0');
+                uint32 last = first;
+                if(*text == '-') {
+                    last = 0;
+                    for(text++; *text >= '0' && *text <= '9'; text++)
+                        last = last * 10 + static_cast<uint32>(*text - '0');
+                }
+                for(auto id = first; id <= last; id++)
+                    visit(id);
+                if(*text == ',')
+                    text++;
+            }
+        }
+
+        bool readFirstInList(const char *path, uint32 &first) noexcept {
+            char buffer[1024];
+            if(!readFile(path, buffer, sizeof(buffer)))
+                return false;
+            bool found = false;
+            parseList(buffer, [&](uint32 id) {
+                if(!found)
+                    first = id;
+                found = true;
+            });
+            return found;
+        }
+
+        bool readNumber(const char *path, long &value) noexcept {
+            char buffer[32];
+            if(!readFile(path, buffer, sizeof(buffer)))
+                return false;
+            const char *text = buffer;
+            const bool negative = *text == '-';
+            if(negative)
+                text++;
+            if(*text < '0' || *text > '9')
+                return false;
+            value = 0;
+            for(; *text >= '0' && *text <= '9'; text++)
+                value = value * 10 + (*text - '0');
+            if(negative)
+                value = -value;
+            return true;
+        }
+
+        // Finds the dense index for a key, adding it if it hasn't been seen before.
+        uint32 densify(uint32 *keys, size_t &count, uint32 key) noexcept {
+            for(size_t i = 0; i < count; i++)
+                if(keys[i] == key)
+                    return static_cast<uint32>(i);
+            keys[count] = key;
+            return static_cast<uint32>(count++);
+        }
+
+        uint32 readCacheKey(uint32 cpu, uint32 package) noexcept {
+            char path[128];
+            for(uint32 index = 0; index < maxCacheIndex; index++) {
+                long level;
+                snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/level", cpu, index);
+                if(!readNumber(path, level))
+                    break;
+                if(level != 3)
+                    continue;
+                uint32 first;
+                snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/shared_cpu_list", cpu, index);
+                if(readFirstInList(path, first))
+                    return first;
+            }
+            return packageCacheKey | package;
+        }
+    }
+
+    CpuTopology::CpuTopology() noexcept
+            : _cpus(nullptr), _count(0), _coreCount(0), _cacheCount(0), _packageCount(0), _primaries(nullptr) {
+        // Find the online CPUs, falling back to a plain count if the list isn't available.
+        char buffer[1024];
+        uint32 *ids;
+        if(readFile("/sys/devices/system/cpu/online", buffer, sizeof(buffer))) {
+            parseList(buffer, [this](uint32) { _count++; });
+            ids = new uint32[_count > 0 ? _count : 1];
+            size_t filled = 0;
+            parseList(buffer, [&](uint32 id) { ids[filled++] = id; });
+        } else {
+            const long online = sysconf(_SC_NPROCESSORS_ONLN);
+            _count = online > 0 ? static_cast<size_t>(online) : 1;
+            ids = new uint32[_count];
+            for(size_t i = 0; i < _count; i++)
+                ids[i] = static_cast<uint32>(i);
+        }
+        if(_count == 0) {
+            _count = 1;
+            ids[0] = 0;
+        }
+
+        _cpus = new LogicalCpu[_count];
+        _primaries = new uint32[_count];
+        auto coreKeys = new uint32[_count];
+        auto cacheKeys = new uint32[_count];
+        auto packageKeys = new uint32[_count];
+        char path[128];
+        for(size_t i = 0; i < _count; i++) {
+            const auto id = ids[i];
+            // Physical cores are identified by their lowest-numbered SMT sibling.
+            uint32 coreKey = id;
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/thread_siblings_list", id);
+            readFirstInList(path, coreKey);
+            long package = 0;
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", id);
+            if(!readNumber(path, package) || package < 0)
+                package = 0;
+            const auto packageKey = static_cast<uint32>(package);
+
+            auto &cpu = _cpus[i];
+            cpu.id = id;
+            const auto coreCount = _coreCount;
+            cpu.core = densify(coreKeys, _coreCount, coreKey);
+            if(_coreCount > coreCount)
+                _primaries[cpu.core] = id;
+            cpu.cache = densify(cacheKeys, _cacheCount, readCacheKey(id, packageKey));
+            cpu.package = densify(packageKeys, _packageCount, packageKey);
+        }
+        delete[] ids;
+        delete[] coreKeys;
+        delete[] cacheKeys;
+        delete[] packageKeys;
+    }
+
+    CpuTopology::~CpuTopology() noexcept {
+        delete[] _cpus;
+        delete[] _primaries;
+    }
+
+    size_t CpuTopology::logicalCount() const noexcept {
+        return _count;
+    }
+
+    const LogicalCpu &CpuTopology::logical(size_t index) const noexcept {
+        ASSERTF(index < _count, "Logical CPU index %zu out of range", index);
+        return _cpus[index];
+    }
+
+    size_t CpuTopology::coreCount() const noexcept {
+        return _coreCount;
+    }
+
+    size_t CpuTopology::cacheCount() const noexcept {
+        return _cacheCount;
+    }
+
+    size_t CpuTopology::packageCount() const noexcept {
+        return _packageCount;
+    }
+
+    uint32 CpuTopology::primaryCpu(size_t core) const noexcept {
+        ASSERTF(core < _coreCount, "Core index %zu out of range", core);
+        return _primaries[core];
+    }
+}
@@ -0,0 +1,237 @@
+#include "hyper/Csv.h"
+#include "hyper/simd.h"
+
+namespace hyper {
+    namespace {
+        /// @brief Bit masks of the interesting bytes in a 64-byte block, one bit per byte.
+        struct BlockMasks {
+            uint64 quote;
+            uint64 delimiter;
+            uint64 newline;
+        };
+
+#if defined(HYPER_SIMD_AVX2)
+        void classify(const byte *block, char delimiter, BlockMasks &masks) noexcept {
+            const auto low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+            const auto high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+            const auto equal = [low, high](char value) {
+                const auto match = _mm256_set1_epi8(value);
+                return movemask(_mm256_cmpeq_epi8(low, match), _mm256_cmpeq_epi8(high, match));
+            };
+            masks.quote = equal('"');
+            masks.delimiter = equal(delimiter);
+            masks.newline = equal('\n');
+        }
+#elif defined(HYPER_SIMD_SSE2)
+        void classify(const byte *block, char delimiter, BlockMasks &masks) noexcept {
+            __m128i bytes[4];
+            for(size_t i = 0; i < 4; i++)
+                bytes[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i));
+            const auto equal = [&bytes](char value) {
+                const auto match = _mm_set1_epi8(value);
+                return movemask(_mm_cmpeq_epi8(bytes[0], match), _mm_cmpeq_epi8(bytes[1], match),
+                        _mm_cmpeq_epi8(bytes[2], match), _mm_cmpeq_epi8(bytes[3], match));
+            };
+            masks.quote = equal('"');
+            masks.delimiter = equal(delimiter);
+            masks.newline = equal('\n');
+        }
+#elif defined(HYPER_SIMD_NEON)
+        void classify(const byte *block, char delimiter, BlockMasks &masks) noexcept {
+            uint8x16_t bytes[4];
+            for(size_t i = 0; i < 4; i++)
+                bytes[i] = vld1q_u8(reinterpret_cast<const uint8 *>(block + 16 * i));
+            const auto equal = [&bytes](char value) {
+                const auto match = vdupq_n_u8(static_cast<uint8>(value));
+                return movemask(vceqq_u8(bytes[0], match), vceqq_u8(bytes[1], match),
+                        vceqq_u8(bytes[2], match), vceqq_u8(bytes[3], match));
+            };
+            masks.quote = equal('"');
+            masks.delimiter = equal(delimiter);
+            masks.newline = equal('\n');
+        }
+#else
+        void classify(const byte *block, char delimiter, BlockMasks &masks) noexcept {
+            masks = BlockMasks{0, 0, 0};
+            for(size_t i = 0; i < 64; i++) {
+                const auto value = static_cast<char>(block[i]);
+                const auto bit = static_cast<uint64>(1) << i;
+                if(value == '"')
+                    masks.quote |= bit;
+                else if(value == delimiter)
+                    masks.delimiter |= bit;
+                else if(value == '\n')
+                    masks.newline |= bit;
+            }
+        }
+#endif
+
+        /// @brief Classifies the 64 bytes at an offset, leaving out bytes at or past a limit.
+        void classify(const byte *data, size_t offset, size_t limit, char delimiter, BlockMasks &masks) noexcept {
+            if(limit - offset >= 64) {
+                classify(data + offset, delimiter, masks);
+                return;
+            }
+            byte padded[64] = {};
+            __builtin_memcpy(padded, data + offset, limit - offset);
+            classify(padded, delimiter, masks);
+            const uint64 valid = (static_cast<uint64>(1) << (limit - offset)) - 1;
+            masks.quote &= valid;
+            masks.delimiter &= valid;
+            masks.newline &= valid;
+        }
+    }
+
+    size_t CsvField::unescape(char *output) const noexcept {
+        if(!quoted) {
+            __builtin_memcpy(output, data, size);
+            return size;
+        }
+        size_t length = 0;
+        for(size_t i = 0; i < size; i++) {
+            output[length++] = data[i];
+            if(data[i] == '"' && i + 1 < size && data[i + 1] == '"')
+                i++;
+        }
+        return length;
+    }
+
+    CsvReader::CsvReader(const byte *data, size_t size, char delimiter) noexcept
+            : _data(data), _size(size), _delimiter(delimiter), _block(0), _next(0), _separators(0),
+              _quoteCarry(0), _fieldStart(0), _fields(new CsvField[16]), _fieldCount(0), _fieldCapacity(16) {
+        // ...
+    }
+
+    CsvReader::~CsvReader() noexcept {
+        delete[] _fields;
+    }
+
+    bool CsvReader::next() noexcept {
+        _fieldCount = 0;
+        while(true) {
+            while(_separators == 0) {
+                if(_next >= _size) {
+                    // The last record doesn't need to end with a newline.
+                    const bool blank = _fieldStart >= _size
+                            || (_fieldStart + 1 == _size && static_cast<char>(_data[_fieldStart]) == '\r');
+                    if(_fieldCount == 0 && blank) {
+                        _fieldStart = _size;
+                        return false;
+                    }
+                    addField(_fieldStart, _size, true);
+                    _fieldStart = _size;
+                    return true;
+                }
+                load();
+            }
+            const size_t position = _block + static_cast<size_t>(__builtin_ctzll(_separators));
+            _separators &= _separators - 1;
+            const bool lineEnd = static_cast<char>(_data[position]) == '\n';
+            if(lineEnd && _fieldCount == 0 && (position == _fieldStart
+                    || (position == _fieldStart + 1 && static_cast<char>(_data[_fieldStart]) == '\r'))) {
+                _fieldStart = position + 1;
+                continue;
+            }
+            addField(_fieldStart, position, lineEnd);
+            _fieldStart = position + 1;
+            if(lineEnd)
+                return true;
+        }
+    }
+
+    void CsvReader::load() noexcept {
+        BlockMasks masks;
+        classify(_data, _next, _size, _delimiter, masks);
+        // A doubled quote inside a quoted field flips the state twice, so it stays inside.
+        const uint64 inQuotes = prefixXor(masks.quote) ^ _quoteCarry;
+        _quoteCarry = static_cast<uint64>(static_cast<int64>(inQuotes) >> 63);
+        _separators = (masks.delimiter | masks.newline) & ~inQuotes;
+        _block = _next;
+        _next += 64;
+    }
+
+    void CsvReader::addField(size_t start, size_t end, bool lineEnd) noexcept {
+        if(_fieldCount == _fieldCapacity) {
+            auto *fields = new CsvField[2 * _fieldCapacity];
+            __builtin_memcpy(fields, _fields, _fieldCount * sizeof(CsvField));
+            delete[] _fields;
+            _fields = fields;
+            _fieldCapacity *= 2;
+        }
+        const auto *text = reinterpret_cast<const char *>(_data);
+        if(lineEnd && end > start && text[end - 1] == '\r')
+            end--;
+        CsvField &field = _fields[_fieldCount++];
+        if(end == start || text[start] != '"') {
+            field = CsvField{text + start, end - start, false};
+            return;
+        }
+        // Anything after the closing quote is ignored, and an unclosed quote runs to the end of the field.
+        size_t close = end;
+        while(close > start + 1 && text[close - 1] != '"')
+            close--;
+        if(close == start + 1)
+            close = end + 1;
+        field = CsvField{text + start + 1, close - start - 2, true};
+    }
+
+    void CsvReader::split(WorkerPool &pool, const byte *data, size_t size, size_t *boundaries) noexcept {
+        const size_t count = pool.size();
+        if(count == 0) {
+            boundaries[0] = 0;
+            boundaries[1] = size;
+            return;
+        }
+        const auto sliceStart = [size, count](size_t index) {
+            return static_cast<size_t>(static_cast<unsigned __int128>(size) * index / count);
+        };
+
+        // Count quotes in each slice, keeping only the parity.
+        pool.run(Function<void(size_t)>([data, boundaries, &sliceStart](size_t worker) {
+            const size_t end = sliceStart(worker + 1);
+            uint64 quotes = 0;
+            for(size_t offset = sliceStart(worker); offset < end; offset += 64) {
+                BlockMasks masks;
+                classify(data, offset, end, ',', masks);
+                quotes += static_cast<uint64>(__builtin_popcountll(masks.quote));
+            }
+            boundaries[worker] = quotes & 1;
+        }));
+
+        // Exclusive prefix XOR: each slice starts inside quotes if an odd number came before it.
+        size_t inside = 0;
+        for(size_t i = 0; i < count; i++) {
+            const size_t parity = boundaries[i];
+            boundaries[i] = inside;
+            inside ^= parity;
+        }
+
+        // Find the first newline outside quotes in each slice.
+        pool.run(Function<void(size_t)>([data, size, boundaries, &sliceStart](size_t worker) {
+            const size_t end = sliceStart(worker + 1);
+            uint64 carry = boundaries[worker] != 0 ? ~static_cast<uint64>(0) : 0;
+            boundaries[worker] = size + 1;
+            if(worker == 0)
+                return;
+            for(size_t offset = sliceStart(worker); offset < end; offset += 64) {
+                BlockMasks masks;
+                classify(data, offset, end, ',', masks);
+                const uint64 inQuotes = prefixXor(masks.quote) ^ carry;
+                carry = static_cast<uint64>(static_cast<int64>(inQuotes) >> 63);
+                const uint64 newlines = masks.newline & ~inQuotes;
+                if(newlines != 0) {
+                    boundaries[worker] = offset + static_cast<size_t>(__builtin_ctzll(newlines)) + 1;
+                    return;
+                }
+            }
+        }));
+
+        // A slice without a record boundary belongs to the chunk before it.
+        boundaries[count] = size;
+        for(size_t i = count - 1; i > 0; i--) {
+            if(boundaries[i] > boundaries[i + 1])
+                boundaries[i] = boundaries[i + 1];
+        }
+        boundaries[0] = 0;
+    }
+}
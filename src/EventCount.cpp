@@ -0,0 +1,44 @@
+#include "hyper/EventCount.h"
+#include "hyper/futex.h"
+
+namespace hyper {
+    EventCount::EventCount() noexcept
+            : _epoch(0), _waiters(0) {
+        // ...
+    }
+
+    EventCount::Key EventCount::prepareWait() noexcept {
+        // Registering before the caller checks its condition again pairs with advance(),
+        // which checks for waiters after the producer's change, so one of the two always sees the other.
+        __atomic_add_fetch(&_waiters, 1, __ATOMIC_SEQ_CST);
+        return __atomic_load_n(&_epoch, __ATOMIC_SEQ_CST);
+    }
+
+    void EventCount::cancelWait() noexcept {
+        __atomic_sub_fetch(&_waiters, 1, __ATOMIC_RELAXED);
+    }
+
+    void EventCount::wait(Key key) noexcept {
+        while(__atomic_load_n(&_epoch, __ATOMIC_ACQUIRE) == key)
+            futexWait(&_epoch, key);
+        __atomic_sub_fetch(&_waiters, 1, __ATOMIC_RELAXED);
+    }
+
+    void EventCount::notify() noexcept {
+        if(advance())
+            futexWake(&_epoch, 1);
+    }
+
+    void EventCount::notifyAll() noexcept {
+        if(advance())
+            futexWakeAll(&_epoch);
+    }
+
+    bool EventCount::advance() noexcept {
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if(__atomic_load_n(&_waiters, __ATOMIC_SEQ_CST) == 0)
+            return false;
+        __atomic_add_fetch(&_epoch, 1, __ATOMIC_RELEASE);
+        return true;
+    }
+}
@@ -0,0 +1,215 @@
+#include <cerrno>   // For errno values.
+#include <poll.h>   // For poll().
+#include "hyper/clock.h"
+#include "hyper/EventLoop.h"
+#include "hyper/SystemError.h"
+
+namespace hyper {
+    namespace {
+        // Timers are ordered by deadline, and then by the order they were added, so equal deadlines stay fair.
+        template<typename Timer>
+        inline bool earlier(const Timer &first, const Timer &second) noexcept {
+            return first.deadline < second.deadline
+                   || (first.deadline == second.deadline && first.sequence < second.sequence);
+        }
+
+        template<typename T>
+        T *grow(T *array, size_t count, size_t &capacity) noexcept {
+            capacity = capacity == 0 ? 16 : capacity * 2;
+            auto resized = new T[capacity];
+            for(size_t i = 0; i < count; i++)
+                resized[i] = array[i];
+            delete[] array;
+            return resized;
+        }
+    }
+
+    EventLoop::ScheduleAwaiter::ScheduleAwaiter(EventLoop *loop, uint64 deadline) noexcept
+            : _loop(loop), _deadline(deadline) {
+        // ...
+    }
+
+    void EventLoop::ScheduleAwaiter::await_suspend(std::coroutine_handle<> handle) const noexcept {
+        if(_deadline == 0)
+            _loop->schedule(handle);
+        else
+            _loop->addTimer(_deadline, handle);
+    }
+
+    EventLoop::IoAwaiter::IoAwaiter(EventLoop *loop, int fd, short events) noexcept
+            : _loop(loop), _fd(fd), _events(events), _returnedEvents(0) {
+        // ...
+    }
+
+    void EventLoop::IoAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept {
+        _loop->addWaiter(this, handle);
+    }
+
+    Result<void> EventLoop::IoAwaiter::await_resume() const noexcept {
+        if(_returnedEvents & POLLNVAL)
+            return Result<void>(SharedPointer<Error>(new SystemError(EBADF)));
+        // A hang-up still lets readers see the end of the stream, so only report it to writers.
+        if((_returnedEvents & POLLERR) || ((_returnedEvents & POLLHUP) && (_events & POLLOUT)))
+            return Result<void>(SharedPointer<Error>(new SystemError(EIO)));
+        return Result<void>();
+    }
+
+    EventLoop::EventLoop() noexcept
+            : _ready(nullptr), _readyHead(0), _readyCount(0), _readyCapacity(0),
+              _timers(nullptr), _timerCount(0), _timerCapacity(0), _timerSequence(0),
+              _waiters(nullptr), _waiterCount(0), _waiterCapacity(0), _pollBuffer(nullptr),
+              _spawned(nullptr) {
+        // ...
+    }
+
+    EventLoop::~EventLoop() noexcept {
+        // A suspended task owns the tasks it is awaiting, so destroying the spawned tasks frees every pending frame.
+        // The handles queued below belong to those frames and are only dropped.
+        while(_spawned != nullptr) {
+            auto &promise = static_cast<detail::TaskPromise<void> &>(*_spawned);
+            promise.unlinkSpawned();
+            std::coroutine_handle<detail::TaskPromise<void>>::from_promise(promise).destroy();
+        }
+        delete[] _ready;
+        delete[] _timers;
+        delete[] _waiters;
+        delete[] static_cast<pollfd *>(_pollBuffer);
+    }
+
+    void EventLoop::spawn(Task<void> &&task) noexcept {
+        schedule(task.detach(_spawned));
+    }
+
+    void EventLoop::schedule(std::coroutine_handle<> handle) noexcept {
+        if(_readyCount == _readyCapacity) {
+            // Unwrap the ring buffer while copying it to the larger array.
+            const size_t capacity = _readyCapacity == 0 ? 16 : _readyCapacity * 2;
+            auto ready = new std::coroutine_handle<>[capacity];
+            for(size_t i = 0; i < _readyCount; i++)
+                ready[i] = _ready[(_readyHead + i) % _readyCapacity];
+            delete[] _ready;
+            _ready = ready;
+            _readyHead = 0;
+            _readyCapacity = capacity;
+        }
+        _ready[(_readyHead + _readyCount) % _readyCapacity] = handle;
+        _readyCount++;
+    }
+
+    EventLoop::ScheduleAwaiter EventLoop::yield() noexcept {
+        return ScheduleAwaiter(this, 0);
+    }
+
+    EventLoop::ScheduleAwaiter EventLoop::sleep(uint64 nanoseconds) noexcept {
+        return ScheduleAwaiter(this, now() + nanoseconds);
+    }
+
+    EventLoop::IoAwaiter EventLoop::readable(int fd) noexcept {
+        return IoAwaiter(this, fd, POLLIN);
+    }
+
+    EventLoop::IoAwaiter EventLoop::writable(int fd) noexcept {
+        return IoAwaiter(this, fd, POLLOUT);
+    }
+
+    void EventLoop::addTimer(uint64 deadline, std::coroutine_handle<> handle) noexcept {
+        if(_timerCount == _timerCapacity)
+            _timers = grow(_timers, _timerCount, _timerCapacity);
+        // Sift the new timer up the binary heap.
+        const Timer timer{deadline, _timerSequence++, handle};
+        size_t index = _timerCount++;
+        while(index > 0) {
+            const size_t parent = (index - 1) / 2;
+            if(!earlier(timer, _timers[parent]))
+                break;
+            _timers[index] = _timers[parent];
+            index = parent;
+        }
+        _timers[index] = timer;
+    }
+
+    void EventLoop::addWaiter(IoAwaiter *awaiter, std::coroutine_handle<> handle) noexcept {
+        if(_waiterCount == _waiterCapacity) {
+            _waiters = grow(_waiters, _waiterCount, _waiterCapacity);
+            delete[] static_cast<pollfd *>(_pollBuffer);
+            _pollBuffer = new pollfd[_waiterCapacity];
+        }
+        _waiters[_waiterCount++] = Waiter{awaiter, handle};
+    }
+
+    void EventLoop::pollWaiters(int timeout) noexcept {
+        auto fds = static_cast<pollfd *>(_pollBuffer);
+        for(size_t i = 0; i < _waiterCount; i++) {
+            fds[i].fd = _waiters[i].awaiter->_fd;
+            fds[i].events = _waiters[i].awaiter->_events;
+            fds[i].revents = 0;
+        }
+        if(poll(fds, static_cast<nfds_t>(_waiterCount), timeout) <= 0)
+            return;
+
+        // Move ready waiters to the ready queue, compacting the rest in place.
+        size_t kept = 0;
+        for(size_t i = 0; i < _waiterCount; i++) {
+            if(fds[i].revents != 0) {
+                _waiters[i].awaiter->_returnedEvents = fds[i].revents;
+                schedule(_waiters[i].handle);
+            } else {
+                _waiters[kept++] = _waiters[i];
+            }
+        }
+        _waiterCount = kept;
+    }
+
+    bool EventLoop::runOnce(bool wait) noexcept {
+        // Wait no longer than until the next timer is due, or forever if only file descriptors are pending.
+        int timeout = 0;
+        if(wait && _readyCount == 0) {
+            if(_timerCount > 0) {
+                const auto current = now();
+                const auto deadline = _timers[0].deadline;
+                const uint64 remaining = deadline > current ? (deadline - current + 999999) / 1000000 : 0;
+                timeout = remaining > 0x7FFFFFFF ? 0x7FFFFFFF : static_cast<int>(remaining);
+            } else if(_waiterCount > 0) {
+                timeout = -1;
+            }
+        }
+        if(_waiterCount > 0 || timeout > 0)
+            pollWaiters(timeout);
+
+        const auto current = now();
+        while(_timerCount > 0 && _timers[0].deadline <= current) {
+            schedule(_timers[0].handle);
+            // Sift the last timer down from the top of the heap.
+            const Timer last = _timers[--_timerCount];
+            size_t index = 0;
+            for(size_t child; (child = 2 * index + 1) < _timerCount; index = child) {
+                if(child + 1 < _timerCount && earlier(_timers[child + 1], _timers[child]))
+                    child++;
+                if(!earlier(_timers[child], last))
+                    break;
+                _timers[index] = _timers[child];
+            }
+            if(_timerCount > 0)
+                _timers[index] = last;
+        }
+
+        // Only resume coroutines that were ready at the start, so tasks that keep yielding can't starve timers.
+        for(size_t count = _readyCount; count > 0; count--) {
+            const auto handle = _ready[_readyHead];
+            _readyHead = (_readyHead + 1) % _readyCapacity;
+            _readyCount--;
+            handle.resume();
+        }
+        return _readyCount > 0 || _timerCount > 0 || _waiterCount > 0;
+    }
+
+    void EventLoop::run() noexcept {
+        while(runOnce(true))
+            continue;
+    }
+
+    uint64 EventLoop::now() noexcept {
+        // Use the operating system's clock, since it is what poll() sleeps against.
+        return monotonicNow();
+    }
+}
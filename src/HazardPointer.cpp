@@ -0,0 +1,213 @@
+#include <linux/membarrier.h>   // For MEMBARRIER_CMD_PRIVATE_EXPEDITED.
+#include <pthread.h>            // For pthread_once().
+#include <sys/syscall.h>        // For SYS_membarrier.
+#include <unistd.h>             // For syscall().
+#include "hyper/assert.h"
+#include "hyper/HazardPointer.h"
+#include "hyper/sort.h"
+
+namespace hyper {
+    namespace detail {
+        bool hazardAsymmetricFence = false;
+
+        struct HazardRecord {
+            void *hazards[HazardDomain::slotsPerThread];
+            HazardRecord *next;
+            bool active;
+            // The rest is only touched by the thread that owns the record.
+            uint32 usedSlots;
+            struct Retired {
+                void *object;
+                void (*reclaim)(void *) noexcept;
+            } *retired;
+            size_t retiredCount;
+            size_t retiredCapacity;
+        };
+    }
+
+    namespace {
+        // Retired objects a thread collects before scanning. Scanning costs about the same
+        // whatever the number of retired objects, so batching spreads it out.
+        constexpr size_t minimumScanThreshold = 64;
+
+        pthread_once_t fenceOnce = PTHREAD_ONCE_INIT;
+
+        long membarrier(int command) noexcept {
+            return syscall(SYS_membarrier, command, 0, 0);
+        }
+
+        void registerFence() noexcept {
+            const auto supported = membarrier(MEMBARRIER_CMD_QUERY);
+            if(supported < 0 || (supported & MEMBARRIER_CMD_PRIVATE_EXPEDITED) == 0)
+                return;
+            if(membarrier(MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED) != 0)
+                return;
+            __atomic_store_n(&detail::hazardAsymmetricFence, true, __ATOMIC_RELEASE);
+        }
+
+        // Pairs with the light fence in every reader.
+        void heavyFence() noexcept {
+            if(!detail::hazardAsymmetricFence || membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED) != 0)
+                __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        }
+
+        bool contains(const void *const *sorted, size_t count, const void *pointer) noexcept {
+            size_t low = 0;
+            size_t high = count;
+            while(low < high) {
+                const auto middle = low + (high - low) / 2;
+                if(sorted[middle] < pointer)
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+            return low < count && sorted[low] == pointer;
+        }
+    }
+
+    HazardDomain::Binding::~Binding() noexcept {
+        // The record's retired objects stay with it, and are scanned by the next thread to take it.
+        if(record != nullptr)
+            __atomic_store_n(&record->active, false, __ATOMIC_RELEASE);
+    }
+
+    HazardDomain::HazardDomain() noexcept
+            : _records(nullptr), _bindings(nullptr) {
+        pthread_once(&fenceOnce, registerFence);
+        _bindings = new ThreadLocal<Binding>(Binding{this, nullptr});
+    }
+
+    HazardDomain::~HazardDomain() noexcept {
+        delete _bindings;
+        auto record = _records;
+        while(record != nullptr) {
+            for(size_t i = 0; i < record->retiredCount; i++)
+                record->retired[i].reclaim(record->retired[i].object);
+            delete[] record->retired;
+            const auto next = record->next;
+            delete record;
+            record = next;
+        }
+    }
+
+    size_t HazardDomain::reclaim() noexcept {
+        return scan(*threadRecord());
+    }
+
+    size_t HazardDomain::retiredCount() const noexcept {
+        size_t count = 0;
+        for(auto record = __atomic_load_n(&_records, __ATOMIC_ACQUIRE); record != nullptr; record = record->next)
+            if(__atomic_load_n(&record->active, __ATOMIC_ACQUIRE))
+                count += __atomic_load_n(&record->retiredCount, __ATOMIC_RELAXED);
+        return count;
+    }
+
+    detail::HazardRecord *HazardDomain::threadRecord() noexcept {
+        auto &binding = _bindings->get();
+        if(binding.record != nullptr) [[likely]]
+            return binding.record;
+
+        // Reuse a record left by a thread that has exited, along with its retired objects.
+        for(auto record = __atomic_load_n(&_records, __ATOMIC_ACQUIRE); record != nullptr; record = record->next) {
+            bool active = false;
+            if(!__atomic_load_n(&record->active, __ATOMIC_RELAXED)
+               && __atomic_compare_exchange_n(&record->active, &active, true, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                binding.record = record;
+                return record;
+            }
+        }
+
+        // Records are never removed, so pushing onto the front of the list is the only concurrent change.
+        auto record = new detail::HazardRecord{{}, nullptr, true, 0, nullptr, 0, 0};
+        auto head = __atomic_load_n(&_records, __ATOMIC_RELAXED);
+        do {
+            record->next = head;
+        } while(!__atomic_compare_exchange_n(&_records, &head, record, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+        binding.record = record;
+        return record;
+    }
+
+    void HazardDomain::retire(void *object, void (*reclaim)(void *) noexcept) noexcept {
+        auto &record = *threadRecord();
+        if(record.retiredCount == record.retiredCapacity) {
+            const auto capacity = record.retiredCapacity > 0 ? record.retiredCapacity * 2 : minimumScanThreshold;
+            const auto retired = new detail::HazardRecord::Retired[capacity];
+            for(size_t i = 0; i < record.retiredCount; i++)
+                retired[i] = record.retired[i];
+            delete[] record.retired;
+            record.retired = retired;
+            record.retiredCapacity = capacity;
+        }
+        record.retired[record.retiredCount] = {object, reclaim};
+        __atomic_store_n(&record.retiredCount, record.retiredCount + 1, __ATOMIC_RELAXED);
+
+        // Scale the threshold with the number of hazards, so each scan frees a good share of what it checks.
+        size_t hazardCount = 0;
+        for(auto other = __atomic_load_n(&_records, __ATOMIC_ACQUIRE); other != nullptr; other = other->next)
+            hazardCount += slotsPerThread;
+        const auto threshold = hazardCount * 2 > minimumScanThreshold ? hazardCount * 2 : minimumScanThreshold;
+        if(record.retiredCount >= threshold)
+            scan(record);
+    }
+
+    size_t HazardDomain::scan(detail::HazardRecord &record) noexcept {
+        if(record.retiredCount == 0)
+            return 0;
+        // Makes every reader's hazard store visible before they are collected,
+        // and makes unlinking the retired objects visible to every reader.
+        heavyFence();
+
+        size_t recordCount = 0;
+        const auto head = __atomic_load_n(&_records, __ATOMIC_ACQUIRE);
+        for(auto other = head; other != nullptr; other = other->next)
+            recordCount++;
+        const auto hazards = new const void *[recordCount * slotsPerThread];
+        size_t hazardCount = 0;
+        for(auto other = head; other != nullptr; other = other->next)
+            for(auto &slot : other->hazards) {
+                const auto pointer = __atomic_load_n(&slot, __ATOMIC_ACQUIRE);
+                if(pointer != nullptr)
+                    hazards[hazardCount++] = pointer;
+            }
+        sort(hazards, hazardCount);
+        hazardCount = unique(hazards, hazardCount);
+
+        // Keep protected objects at the front of the list and move the rest out before freeing any.
+        // Reclaiming can retire more objects onto this record and start a nested scan,
+        // which must only see the entries still kept.
+        const auto count = record.retiredCount;
+        const auto unprotected = new detail::HazardRecord::Retired[count];
+        size_t kept = 0;
+        size_t freed = 0;
+        for(size_t i = 0; i < count; i++) {
+            const auto retired = record.retired[i];
+            if(contains(hazards, hazardCount, retired.object))
+                record.retired[kept++] = retired;
+            else
+                unprotected[freed++] = retired;
+        }
+        delete[] hazards;
+        __atomic_store_n(&record.retiredCount, kept, __ATOMIC_RELAXED);
+        for(size_t i = 0; i < freed; i++)
+            unprotected[i].reclaim(unprotected[i].object);
+        delete[] unprotected;
+        return freed;
+    }
+
+    HazardPointer::HazardPointer(HazardDomain &domain) noexcept
+            : _record(domain.threadRecord()), _slot(nullptr) {
+        for(uint32 i = 0; i < HazardDomain::slotsPerThread; i++) {
+            if((_record->usedSlots & (1u << i)) == 0) {
+                _record->usedSlots |= 1u << i;
+                _slot = &_record->hazards[i];
+                return;
+            }
+        }
+        ASSERTF(false, "A thread can't hold more than %zu hazard pointers", HazardDomain::slotsPerThread);
+    }
+
+    HazardPointer::~HazardPointer() noexcept {
+        clear();
+        _record->usedSlots &= ~(1u << (_slot - _record->hazards));
+    }
+}
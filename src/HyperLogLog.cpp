@@ -0,0 +1,340 @@
+#include <cmath>   // For log() and sqrt().
+#include "hyper/HyperLogLog.h"
+#include "hyper/assert.h"
+#include "hyper/float.h"
+#include "hyper/simd.h"
+#include "hyper/sort.h"
+
+namespace hyper {
+    namespace {
+        // Precision of the sparse representation.
+        // Sparse entries are the 25-bit register index shifted above a 7-bit rank.
+        constexpr uint32 sparsePrecision = 25;
+        constexpr uint32 rankBits = 7;
+        constexpr uint32 rankMask = (uint32(1) << rankBits) - 1;
+
+        // Serialized header: magic, version, precision, representation.
+        constexpr uint8 serialMagic   = 0x48;
+        constexpr uint8 serialVersion = 1;
+        constexpr size_t headerSize   = 4;
+
+        inline uint32 sparseEntry(uint64 keyHash) noexcept {
+            const auto index = static_cast<uint32>(keyHash >> (64 - sparsePrecision));
+            const uint64 rest = keyHash << sparsePrecision;
+            const uint32 rank = rest == 0 ? 64 - sparsePrecision + 1 : static_cast<uint32>(__builtin_clzll(rest)) + 1;
+            return index << rankBits | rank;
+        }
+
+        inline uint32 sparseIndex(uint32 entry) noexcept {
+            return entry >> rankBits;
+        }
+
+        // Converts a sparse entry to the register index and rank it represents at a lower precision.
+        // The bits of the sparse index below the register index are the start of the dense rank's run of zeros.
+        inline void denseRegister(uint32 entry, uint32 precision, uint32 &index, uint8 &rank) noexcept {
+            const uint32 extraBits = sparsePrecision - precision;
+            const uint32 sparse = sparseIndex(entry);
+            const uint32 extra  = sparse & ((uint32(1) << extraBits) - 1);
+            index = sparse >> extraBits;
+            if(extra != 0)
+                rank = static_cast<uint8>(static_cast<uint32>(__builtin_clz(extra)) - (32 - extraBits) + 1);
+            else
+                rank = static_cast<uint8>(extraBits + (entry & rankMask));
+        }
+
+        // Takes the larger of each pair of registers.
+        void maxRegisters(uint8 *target, const uint8 *source, size_t count) noexcept {
+            size_t i = 0;
+#if defined(HYPER_SIMD_AVX2)
+            for(; i + 32 <= count; i += 32) {
+                const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(target + i));
+                const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(target + i), _mm256_max_epu8(a, b));
+            }
+#elif defined(HYPER_SIMD_SSE2)
+            for(; i + 16 <= count; i += 16) {
+                const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(target + i));
+                const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(target + i), _mm_max_epu8(a, b));
+            }
+#elif defined(HYPER_SIMD_NEON)
+            for(; i + 16 <= count; i += 16)
+                vst1q_u8(target + i, vmaxq_u8(vld1q_u8(target + i), vld1q_u8(source + i)));
+#endif
+            for(; i < count; i++)
+                if(source[i] > target[i])
+                    target[i] = source[i];
+        }
+
+        // Sum of x^(2^k) * 2^(k-1), the correction for registers that are still zero.
+        double sigma(double x) noexcept {
+            if(x == 1.0)
+                return infinity<float64>();
+            double y = 1.0, z = x, previous;
+            do {
+                x *= x;
+                previous = z;
+                z += x * y;
+                y += y;
+            } while(z != previous);
+            return z;
+        }
+
+        // Correction for registers that have saturated.
+        double tau(double x) noexcept {
+            if(x == 0.0 || x == 1.0)
+                return 0.0;
+            double y = 1.0, z = 1.0 - x, previous;
+            do {
+                x = sqrt(x);
+                previous = z;
+                y *= 0.5;
+                z -= (1.0 - x) * (1.0 - x) * y;
+            } while(z != previous);
+            return z / 3.0;
+        }
+
+        inline void storeUInt32(byte *output, uint32 value) noexcept {
+            __builtin_memcpy(output, &value, sizeof(value));
+        }
+
+        inline uint32 loadUInt32(const byte *input) noexcept {
+            uint32 value;
+            __builtin_memcpy(&value, input, sizeof(value));
+            return value;
+        }
+    }
+
+    HyperLogLog::HyperLogLog(uint8 precision) noexcept
+            : _precision(precision), _registers(nullptr), _sparse(nullptr), _sparseCount(0), _sparseCapacity(0),
+              _pending(new uint32[pendingCapacity]), _pendingCount(0) {
+        ASSERTF(precision >= minPrecision && precision <= maxPrecision,
+                "HyperLogLog precision must be from 4 to 18, got %d", precision);
+    }
+
+    HyperLogLog::~HyperLogLog() noexcept {
+        releaseSparse();
+        delete[] _registers;
+    }
+
+    void HyperLogLog::insertHash(uint64 keyHash) noexcept {
+        if(_registers != nullptr) {
+            const auto index = static_cast<size_t>(keyHash >> (64 - _precision));
+            const uint64 rest = keyHash << _precision;
+            const auto rank = static_cast<uint8>(rest == 0 ? 64 - _precision + 1 : __builtin_clzll(rest) + 1);
+            if(rank > _registers[index])
+                _registers[index] = rank;
+            return;
+        }
+
+        _pending[_pendingCount++] = sparseEntry(keyHash);
+        if(_pendingCount == pendingCapacity) {
+            flush();
+            // Sparse entries take four bytes and registers take one, so switch once that is smaller.
+            if(_sparseCount > (size_t(1) << _precision) / 4)
+                convertToDense();
+        }
+    }
+
+    void HyperLogLog::flush() const noexcept {
+        if(_pendingCount == 0)
+            return;
+        sort(_pending, _pendingCount);
+        mergeSparse(_pending, _pendingCount);
+        _pendingCount = 0;
+    }
+
+    void HyperLogLog::mergeSparse(const uint32 *entries, size_t count) const noexcept {
+        // Entries sort by index and then by rank, so the last entry for an index has the largest rank.
+        const size_t capacity = _sparseCount + count;
+        auto merged = capacity > _sparseCapacity ? new uint32[capacity * 2] : new uint32[_sparseCapacity];
+        size_t i = 0, j = 0, size = 0;
+        while(i < _sparseCount || j < count) {
+            uint32 entry;
+            if(j == count || (i < _sparseCount && _sparse[i] < entries[j]))
+                entry = _sparse[i++];
+            else
+                entry = entries[j++];
+            if(size > 0 && sparseIndex(merged[size - 1]) == sparseIndex(entry))
+                merged[size - 1] = entry;
+            else
+                merged[size++] = entry;
+        }
+        _sparseCapacity = capacity > _sparseCapacity ? capacity * 2 : _sparseCapacity;
+        delete[] _sparse;
+        _sparse = merged;
+        _sparseCount = size;
+    }
+
+    void HyperLogLog::applySparse(const uint32 *entries, size_t count) noexcept {
+        for(size_t i = 0; i < count; i++) {
+            uint32 index;
+            uint8 rank;
+            denseRegister(entries[i], _precision, index, rank);
+            if(rank > _registers[index])
+                _registers[index] = rank;
+        }
+    }
+
+    void HyperLogLog::convertToDense() noexcept {
+        flush();
+        _registers = new uint8[size_t(1) << _precision]();
+        applySparse(_sparse, _sparseCount);
+        releaseSparse();
+    }
+
+    void HyperLogLog::releaseSparse() noexcept {
+        delete[] _sparse;
+        delete[] _pending;
+        _sparse  = nullptr;
+        _pending = nullptr;
+        _sparseCount = _sparseCapacity = _pendingCount = 0;
+    }
+
+    uint64 HyperLogLog::estimate() const noexcept {
+        if(_registers == nullptr) {
+            // Linear counting at the sparse precision is nearly exact for the cardinalities kept sparse.
+            flush();
+            const double buckets = static_cast<double>(uint64(1) << sparsePrecision);
+            const double empty   = buckets - static_cast<double>(_sparseCount);
+            return static_cast<uint64>(buckets * log(buckets / empty) + 0.5);
+        }
+
+        const uint32 maxRank = 64 - _precision + 1;
+        uint32 histogram[64] = {};
+        const size_t registerCount = size_t(1) << _precision;
+        for(size_t i = 0; i < registerCount; i++)
+            histogram[_registers[i]]++;
+
+        const auto m = static_cast<double>(registerCount);
+        double z = m * tau(1.0 - histogram[maxRank] / m);
+        for(uint32 k = maxRank - 1; k >= 1; k--)
+            z = 0.5 * (z + histogram[k]);
+        z += m * sigma(histogram[0] / m);
+        const double alpha = 1.0 / (2.0 * log(2.0));
+        return static_cast<uint64>(alpha * m * m / z + 0.5);
+    }
+
+    bool HyperLogLog::merge(const HyperLogLog &other) noexcept {
+        if(other._precision != _precision)
+            return false;
+        if(&other == this)
+            return true;
+
+        if(other._registers != nullptr) {
+            if(_registers == nullptr)
+                convertToDense();
+            maxRegisters(_registers, other._registers, size_t(1) << _precision);
+            return true;
+        }
+
+        other.flush();
+        if(_registers != nullptr) {
+            applySparse(other._sparse, other._sparseCount);
+        } else {
+            flush();
+            mergeSparse(other._sparse, other._sparseCount);
+            if(_sparseCount > (size_t(1) << _precision) / 4)
+                convertToDense();
+        }
+        return true;
+    }
+
+    void HyperLogLog::clear() noexcept {
+        delete[] _registers;
+        _registers = nullptr;
+        releaseSparse();
+        _pending = new uint32[pendingCapacity];
+    }
+
+    uint8 HyperLogLog::precision() const noexcept {
+        return _precision;
+    }
+
+    bool HyperLogLog::isSparse() const noexcept {
+        return _registers == nullptr;
+    }
+
+    size_t HyperLogLog::serializedSize() const noexcept {
+        if(_registers != nullptr)
+            return headerSize + (size_t(1) << _precision);
+        flush();
+        return headerSize + sizeof(uint32) + _sparseCount * sizeof(uint32);
+    }
+
+    size_t HyperLogLog::serialize(byte *output) const noexcept {
+        output[0] = byte(serialMagic);
+        output[1] = byte(serialVersion);
+        output[2] = byte(_precision);
+        output[3] = byte(_registers == nullptr ? 0 : 1);
+        if(_registers != nullptr) {
+            const size_t registerCount = size_t(1) << _precision;
+            __builtin_memcpy(output + headerSize, _registers, registerCount);
+            return headerSize + registerCount;
+        }
+
+        flush();
+        auto cursor = output + headerSize;
+        storeUInt32(cursor, static_cast<uint32>(_sparseCount));
+        cursor += sizeof(uint32);
+        for(size_t i = 0; i < _sparseCount; i++, cursor += sizeof(uint32))
+            storeUInt32(cursor, _sparse[i]);
+        return static_cast<size_t>(cursor - output);
+    }
+
+    bool HyperLogLog::deserialize(const byte *input, size_t size) noexcept {
+        if(size < headerSize || toInt(input[0]) != serialMagic || toInt(input[1]) != serialVersion)
+            return false;
+        const auto precision = static_cast<uint8>(toInt(input[2]));
+        const auto mode      = toInt(input[3]);
+        if(precision < minPrecision || precision > maxPrecision || mode > 1)
+            return false;
+
+        if(mode == 1) {
+            const size_t registerCount = size_t(1) << precision;
+            const auto maxRank = static_cast<uint8>(64 - precision + 1);
+            if(size != headerSize + registerCount)
+                return false;
+            for(size_t i = 0; i < registerCount; i++)
+                if(toInt(input[headerSize + i]) > maxRank)
+                    return false;
+
+            delete[] _registers;
+            releaseSparse();
+            _precision = precision;
+            _registers = new uint8[registerCount];
+            __builtin_memcpy(_registers, input + headerSize, registerCount);
+            return true;
+        }
+
+        if(size < headerSize + sizeof(uint32))
+            return false;
+        const size_t count = loadUInt32(input + headerSize);
+        if(size - headerSize - sizeof(uint32) != count * sizeof(uint32))
+            return false;
+        const auto entries = input + headerSize + sizeof(uint32);
+        for(size_t i = 0; i < count; i++) {
+            // Entries must be strictly ordered by index, with a rank the hash could have produced.
+            const auto entry = loadUInt32(entries + i * sizeof(uint32));
+            const auto rank  = entry & rankMask;
+            if(rank == 0 || rank > 64 - sparsePrecision + 1)
+                return false;
+            if(i > 0 && sparseIndex(loadUInt32(entries + (i - 1) * sizeof(uint32))) >= sparseIndex(entry))
+                return false;
+        }
+
+        delete[] _registers;
+        _registers = nullptr;
+        releaseSparse();
+        _precision = precision;
+        _pending = new uint32[pendingCapacity];
+        _sparseCapacity = count > 0 ? count : 1;
+        _sparse = new uint32[_sparseCapacity];
+        _sparseCount = count;
+        for(size_t i = 0; i < count; i++)
+            _sparse[i] = loadUInt32(entries + i * sizeof(uint32));
+        if(_sparseCount > (size_t(1) << _precision) / 4)
+            convertToDense();
+        return true;
+    }
+}
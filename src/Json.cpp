@@ -0,0 +1,675 @@
+#include "hyper/Json.h"
+#include "hyper/parse.h"
+#include "hyper/simd.h"
+
+namespace hyper {
+    namespace {
+        using detail::JsonTapeEntry;
+
+        constexpr uint64 onesPerByte = 0x0101010101010101ull;
+        constexpr uint64 highBitPerByte = 0x8080808080808080ull;
+
+        SharedPointer<Error> error(JsonErrorCode code, size_t offset) noexcept {
+            return SharedPointer<Error>(new JsonError(code, offset));
+        }
+
+        SharedPointer<Error> error(JsonErrorCode code) noexcept {
+            return SharedPointer<Error>(new JsonError(code));
+        }
+
+        /// @brief Bit masks of the interesting bytes in a 64-byte block, one bit per byte.
+        struct BlockMasks {
+            uint64 quote;
+            uint64 backslash;
+            uint64 whitespace;
+            uint64 operators;
+        };
+
+        // Setting bit 5 folds '[' and ']' onto '{' and '}', and doesn't change ',' or ':',
+        // so four comparisons find all six structural operators.
+#if defined(HYPER_SIMD_AVX2)
+        void classify(const byte *block, BlockMasks &masks) noexcept {
+            const auto low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+            const auto high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+            const auto equal = [](__m256i bytes, char value) {
+                return _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(value));
+            };
+            const auto whitespace = [&equal](__m256i bytes) {
+                return _mm256_or_si256(_mm256_or_si256(equal(bytes, ' '), equal(bytes, '\t')),
+                        _mm256_or_si256(equal(bytes, '\n'), equal(bytes, '\r')));
+            };
+            const auto operators = [&equal](__m256i bytes) {
+                const auto folded = _mm256_or_si256(bytes, _mm256_set1_epi8(0x20));
+                return _mm256_or_si256(_mm256_or_si256(equal(folded, '{'), equal(folded, '}')),
+                        _mm256_or_si256(equal(bytes, ','), equal(bytes, ':')));
+            };
+            masks.quote = movemask(equal(low, '"'), equal(high, '"'));
+            masks.backslash = movemask(equal(low, '\\'), equal(high, '\\'));
+            masks.whitespace = movemask(whitespace(low), whitespace(high));
+            masks.operators = movemask(operators(low), operators(high));
+        }
+#elif defined(HYPER_SIMD_SSE2)
+        void classify(const byte *block, BlockMasks &masks) noexcept {
+            __m128i bytes[4];
+            for(size_t i = 0; i < 4; i++)
+                bytes[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i));
+            const auto equal = [](__m128i value, char match) {
+                return _mm_cmpeq_epi8(value, _mm_set1_epi8(match));
+            };
+            __m128i quote[4], backslash[4], whitespace[4], operators[4];
+            for(size_t i = 0; i < 4; i++) {
+                const auto folded = _mm_or_si128(bytes[i], _mm_set1_epi8(0x20));
+                quote[i] = equal(bytes[i], '"');
+                backslash[i] = equal(bytes[i], '\\');
+                whitespace[i] = _mm_or_si128(_mm_or_si128(equal(bytes[i], ' '), equal(bytes[i], '\t')),
+                        _mm_or_si128(equal(bytes[i], '\n'), equal(bytes[i], '\r')));
+                operators[i] = _mm_or_si128(_mm_or_si128(equal(folded, '{'), equal(folded, '}')),
+                        _mm_or_si128(equal(bytes[i], ','), equal(bytes[i], ':')));
+            }
+            masks.quote = movemask(quote[0], quote[1], quote[2], quote[3]);
+            masks.backslash = movemask(backslash[0], backslash[1], backslash[2], backslash[3]);
+            masks.whitespace = movemask(whitespace[0], whitespace[1], whitespace[2], whitespace[3]);
+            masks.operators = movemask(operators[0], operators[1], operators[2], operators[3]);
+        }
+#elif defined(HYPER_SIMD_NEON)
+        void classify(const byte *block, BlockMasks &masks) noexcept {
+            uint8x16_t bytes[4];
+            for(size_t i = 0; i < 4; i++)
+                bytes[i] = vld1q_u8(reinterpret_cast<const uint8 *>(block + 16 * i));
+            const auto equal = [](uint8x16_t value, char match) {
+                return vceqq_u8(value, vdupq_n_u8(static_cast<uint8>(match)));
+            };
+            uint8x16_t quote[4], backslash[4], whitespace[4], operators[4];
+            for(size_t i = 0; i < 4; i++) {
+                const auto folded = vorrq_u8(bytes[i], vdupq_n_u8(0x20));
+                quote[i] = equal(bytes[i], '"');
+                backslash[i] = equal(bytes[i], '\\');
+                whitespace[i] = vorrq_u8(vorrq_u8(equal(bytes[i], ' '), equal(bytes[i], '\t')),
+                        vorrq_u8(equal(bytes[i], '\n'), equal(bytes[i], '\r')));
+                operators[i] = vorrq_u8(vorrq_u8(equal(folded, '{'), equal(folded, '}')),
+                        vorrq_u8(equal(bytes[i], ','), equal(bytes[i], ':')));
+            }
+            masks.quote = movemask(quote[0], quote[1], quote[2], quote[3]);
+            masks.backslash = movemask(backslash[0], backslash[1], backslash[2], backslash[3]);
+            masks.whitespace = movemask(whitespace[0], whitespace[1], whitespace[2], whitespace[3]);
+            masks.operators = movemask(operators[0], operators[1], operators[2], operators[3]);
+        }
+#else
+        void classify(const byte *block, BlockMasks &masks) noexcept {
+            masks = BlockMasks{0, 0, 0, 0};
+            for(size_t i = 0; i < 64; i++) {
+                const auto value = static_cast<char>(block[i]);
+                const auto bit = static_cast<uint64>(1) << i;
+                const auto folded = static_cast<char>(value | 0x20);
+                if(value == '"')
+                    masks.quote |= bit;
+                else if(value == '\\')
+                    masks.backslash |= bit;
+                else if(value == ' ' || value == '\t' || value == '\n' || value == '\r')
+                    masks.whitespace |= bit;
+                else if(folded == '{' || folded == '}' || value == ',' || value == ':')
+                    masks.operators |= bit;
+            }
+        }
+#endif
+
+        bool isWhitespace(uint8 value) noexcept {
+            return value == ' ' || value == '\t' || value == '\n' || value == '\r';
+        }
+
+        /// @brief Checks whether a byte can follow a number or literal.
+        bool isTerminator(uint8 value) noexcept {
+            return isWhitespace(value) || value == ',' || value == ':'
+                    || value == ']' || value == '}' || value == '[' || value == '{';
+        }
+
+        bool isDigit(uint8 value) noexcept {
+            return value >= '0' && value <= '9';
+        }
+
+        /// @brief Checks a UTF-8 sequence, rejecting overlong forms, surrogates and code points past U+10FFFF.
+        /// @return Length of the sequence, or zero if it isn't valid.
+        size_t utf8Length(const uint8 *text, size_t available) noexcept {
+            const auto isContinuation = [text](size_t i) {
+                return (text[i] & 0xC0) == 0x80;
+            };
+            const uint8 first = text[0];
+            if(first < 0xC2)
+                return 0;
+            if(first < 0xE0)
+                return available >= 2 && isContinuation(1) ? 2 : 0;
+            if(first < 0xF0) {
+                if(available < 3 || !isContinuation(1) || !isContinuation(2))
+                    return 0;
+                if((first == 0xE0 && text[1] < 0xA0) || (first == 0xED && text[1] >= 0xA0))
+                    return 0;
+                return 3;
+            }
+            if(first < 0xF5) {
+                if(available < 4 || !isContinuation(1) || !isContinuation(2) || !isContinuation(3))
+                    return 0;
+                if((first == 0xF0 && text[1] < 0x90) || (first == 0xF4 && text[1] >= 0x90))
+                    return 0;
+                return 4;
+            }
+            return 0;
+        }
+
+        /// @brief Reads four hexadecimal digits.
+        /// @return The value, or a negative number if a digit isn't hexadecimal.
+        int32 parseHex(const uint8 *text) noexcept {
+            int32 value = 0;
+            for(size_t i = 0; i < 4; i++) {
+                const uint8 digit = text[i];
+                value <<= 4;
+                if(digit >= '0' && digit <= '9')
+                    value |= digit - '0';
+                else if((digit | 0x20) >= 'a' && (digit | 0x20) <= 'f')
+                    value |= (digit | 0x20) - 'a' + 10;
+                else
+                    return -1;
+            }
+            return value;
+        }
+
+        size_t encodeUtf8(uint32 codePoint, char *output) noexcept {
+            if(codePoint < 0x80) {
+                output[0] = static_cast<char>(codePoint);
+                return 1;
+            }
+            if(codePoint < 0x800) {
+                output[0] = static_cast<char>(0xC0 | codePoint >> 6);
+                output[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                return 2;
+            }
+            if(codePoint < 0x10000) {
+                output[0] = static_cast<char>(0xE0 | codePoint >> 12);
+                output[1] = static_cast<char>(0x80 | (codePoint >> 6 & 0x3F));
+                output[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                return 3;
+            }
+            output[0] = static_cast<char>(0xF0 | codePoint >> 18);
+            output[1] = static_cast<char>(0x80 | (codePoint >> 12 & 0x3F));
+            output[2] = static_cast<char>(0x80 | (codePoint >> 6 & 0x3F));
+            output[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+            return 4;
+        }
+    }
+
+    JsonDocument::JsonDocument() noexcept
+            : _input(nullptr), _size(0), _indices(nullptr), _indexCapacity(0), _tape(nullptr),
+              _tapeCapacity(0), _tapeSize(0), _strings(nullptr), _stringCapacity(0), _stringSize(0) {
+        // ...
+    }
+
+    JsonDocument::~JsonDocument() noexcept {
+        delete[] _indices;
+        delete[] _tape;
+        delete[] _strings;
+    }
+
+    Result<void> JsonDocument::parse(const byte *data, size_t size) noexcept {
+        if(size >= 0xFFFFFFFFu)
+            return error(JsonErrorCode::TooLarge, 0);
+        _input = data;
+        _size = size;
+        _tapeSize = 0;
+        _stringSize = 0;
+        // There can't be more structural characters than bytes, or more tape entries than structural characters.
+        if(_indexCapacity < size) {
+            delete[] _indices;
+            _indices = new uint32[size];
+            _indexCapacity = size;
+        }
+        const size_t count = index();
+        if(count == 0)
+            return error(JsonErrorCode::Empty, size);
+        if(_tapeCapacity < count) {
+            delete[] _tape;
+            _tape = new JsonTapeEntry[count];
+            _tapeCapacity = count;
+        }
+        return build(count);
+    }
+
+    // Stage one: find the structural characters and the first byte of each scalar, outside of strings.
+    // Only backslashes need a scalar loop, and they are rare in most documents.
+    size_t JsonDocument::index() noexcept {
+        uint64 escapeCarry = 0;
+        uint64 stringCarry = 0;
+        uint64 scalarCarry = 0;
+        size_t count = 0;
+        for(size_t offset = 0; offset < _size; offset += 64) {
+            BlockMasks masks;
+            if(_size - offset >= 64)
+                classify(_input + offset, masks);
+            else {
+                byte padded[64];
+                for(size_t i = 0; i < 64; i++)
+                    padded[i] = byte(' ');
+                __builtin_memcpy(padded, _input + offset, _size - offset);
+                classify(padded, masks);
+            }
+
+            // Each backslash that isn't escaped itself escapes the byte after it.
+            uint64 escaped = escapeCarry;
+            escapeCarry = 0;
+            for(uint64 bits = masks.backslash; bits != 0; bits &= bits - 1) {
+                const auto bit = static_cast<uint32>(__builtin_ctzll(bits));
+                if((escaped >> bit & 1) != 0)
+                    continue;
+                if(bit == 63)
+                    escapeCarry = 1;
+                else
+                    escaped |= static_cast<uint64>(1) << (bit + 1);
+            }
+
+            const uint64 quote = masks.quote & ~escaped;
+            const uint64 inString = prefixXor(quote) ^ stringCarry;
+            stringCarry = static_cast<uint64>(static_cast<int64>(inString) >> 63);
+            // Everything inside a string except its opening quote.
+            const uint64 stringTail = inString ^ quote;
+
+            // A scalar starts at any byte that isn't whitespace or an operator and doesn't follow
+            // another such byte. Quotes are left out of the follow mask, so a value glued to the end
+            // of a string is still found and rejected.
+            const uint64 scalar = ~(masks.operators | masks.whitespace);
+            const uint64 unquotedScalar = scalar & ~quote;
+            const uint64 followsScalar = unquotedScalar << 1 | scalarCarry;
+            scalarCarry = unquotedScalar >> 63;
+            uint64 structural = (masks.operators | (scalar & ~followsScalar)) & ~stringTail;
+
+            for(; structural != 0; structural &= structural - 1)
+                _indices[count++] = static_cast<uint32>(offset + static_cast<size_t>(__builtin_ctzll(structural)));
+        }
+        return count;
+    }
+
+    // Stage two: check the grammar and write each value to the tape.
+    // Containers are opened on an explicit stack, and patched with their size and end when closed.
+    Result<void> JsonDocument::build(size_t count) noexcept {
+        struct Open {
+            size_t tape;
+            uint32 count;
+        };
+        enum class State {
+            Value,
+            Key,
+            After,
+            Close
+        };
+
+        Open stack[maxDepth];
+        size_t depth = 0;
+        size_t i = 0;
+        const auto peek = [this, count](size_t k) {
+            return k < count ? static_cast<uint8>(_input[_indices[k]]) : static_cast<uint8>(0);
+        };
+        const auto offset = [this, count](size_t k) {
+            return k < count ? static_cast<size_t>(_indices[k]) : _size;
+        };
+        const auto literal = [this](size_t position, const char *text, size_t length) {
+            if(_size - position < length)
+                return false;
+            for(size_t k = 0; k < length; k++) {
+                if(static_cast<char>(_input[position + k]) != text[k])
+                    return false;
+            }
+            return position + length == _size || isTerminator(static_cast<uint8>(_input[position + length]));
+        };
+
+        auto state = State::Value;
+        while(true) {
+            switch(state) {
+                case State::Value: {
+                    if(i == count)
+                        return error(JsonErrorCode::UnexpectedEnd, _size);
+                    const size_t position = _indices[i];
+                    JsonTapeEntry &entry = _tape[_tapeSize];
+                    state = State::After;
+                    switch(static_cast<char>(_input[position])) {
+                        case '{':
+                        case '[': {
+                            if(depth == maxDepth)
+                                return error(JsonErrorCode::DepthExceeded, position);
+                            const bool object = static_cast<char>(_input[position]) == '{';
+                            entry.kind = static_cast<uint32>(object ? JsonType::Object : JsonType::Array);
+                            entry.length = 0;
+                            entry.payload = 0;
+                            stack[depth++] = Open{_tapeSize, 0};
+                            if(peek(i + 1) == (object ? '}' : ']'))
+                                state = State::Close;
+                            else if(object)
+                                state = State::Key;
+                            else
+                                state = State::Value;
+                            break;
+                        }
+                        case '"': {
+                            const auto result = parseString(position, entry);
+                            if(!result)
+                                return result;
+                            break;
+                        }
+                        case 't':
+                        case 'f':
+                        case 'n': {
+                            const auto first = static_cast<char>(_input[position]);
+                            const char *text = first == 't' ? "true" : first == 'f' ? "false" : "null";
+                            const size_t length = first == 'f' ? 5 : 4;
+                            if(!literal(position, text, length))
+                                return error(JsonErrorCode::InvalidLiteral, position);
+                            entry.kind = static_cast<uint32>(first == 'n' ? JsonType::Null : JsonType::Boolean);
+                            entry.length = first == 't' ? 1 : 0;
+                            entry.payload = position;
+                            break;
+                        }
+                        default: {
+                            const auto value = static_cast<uint8>(_input[position]);
+                            if(value != '-' && !isDigit(value))
+                                return error(JsonErrorCode::UnexpectedCharacter, position);
+                            const auto result = parseNumber(position, entry);
+                            if(!result)
+                                return result;
+                            break;
+                        }
+                    }
+                    _tapeSize++;
+                    i++;
+                    break;
+                }
+                case State::Key: {
+                    if(peek(i) != '"')
+                        return error(i == count ? JsonErrorCode::UnexpectedEnd : JsonErrorCode::ExpectedKey, offset(i));
+                    const auto result = parseString(_indices[i], _tape[_tapeSize]);
+                    if(!result)
+                        return result;
+                    _tapeSize++;
+                    i++;
+                    if(peek(i) != ':')
+                        return error(i == count ? JsonErrorCode::UnexpectedEnd : JsonErrorCode::ExpectedColon, offset(i));
+                    i++;
+                    state = State::Value;
+                    break;
+                }
+                case State::After: {
+                    if(depth == 0) {
+                        if(i != count)
+                            return error(JsonErrorCode::TrailingContent, offset(i));
+                        return Result<void>();
+                    }
+                    Open &open = stack[depth - 1];
+                    open.count++;
+                    const bool object = _tape[open.tape].type() == JsonType::Object;
+                    const uint8 next = peek(i);
+                    if(next == ',') {
+                        i++;
+                        state = object ? State::Key : State::Value;
+                    } else if(next == (object ? '}' : ']'))
+                        state = State::Close;
+                    else
+                        return error(i == count ? JsonErrorCode::UnexpectedEnd : JsonErrorCode::ExpectedCommaOrEnd, offset(i));
+                    break;
+                }
+                case State::Close: {
+                    const Open &open = stack[--depth];
+                    _tape[open.tape].length = open.count;
+                    _tape[open.tape].payload = _tapeSize;
+                    i++;
+                    state = State::After;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Strings without escapes are left in the input. The first escape moves the string to the
+    // document's buffer, which is sized for the whole input, since decoding never makes a string longer.
+    Result<void> JsonDocument::parseString(size_t position, JsonTapeEntry &entry) noexcept {
+        const auto *text = reinterpret_cast<const uint8 *>(_input);
+        size_t end = position + 1;
+        while(end < _size) {
+            // Skip eight plain bytes at a time: no quote, backslash, control character or high bit.
+            if(_size - end >= 8) {
+                uint64 word;
+                __builtin_memcpy(&word, text + end, 8);
+                const uint64 quote = word ^ (onesPerByte * '"');
+                const uint64 backslash = word ^ (onesPerByte * '\\');
+                const uint64 special = ((quote - onesPerByte) & ~quote) | ((backslash - onesPerByte) & ~backslash)
+                        | ((word - onesPerByte * 0x20) & ~word) | word;
+                if((special & highBitPerByte) == 0) {
+                    end += 8;
+                    continue;
+                }
+            }
+            const uint8 value = text[end];
+            if(value == '"') {
+                entry.kind = static_cast<uint32>(JsonType::String);
+                entry.length = static_cast<uint32>(end - position - 1);
+                entry.payload = position + 1;
+                return Result<void>();
+            }
+            if(value == '\\')
+                break;
+            if(value < 0x20)
+                return error(JsonErrorCode::ControlCharacter, end);
+            if(value < 0x80)
+                end++;
+            else {
+                const size_t length = utf8Length(text + end, _size - end);
+                if(length == 0)
+                    return error(JsonErrorCode::InvalidUtf8, end);
+                end += length;
+            }
+        }
+        if(end >= _size)
+            return error(JsonErrorCode::UnclosedString, position);
+
+        if(_stringCapacity < _size) {
+            delete[] _strings;
+            _strings = new char[_size];
+            _stringCapacity = _size;
+        }
+        const size_t start = _stringSize;
+        char *output = _strings + _stringSize;
+        __builtin_memcpy(output, text + position + 1, end - position - 1);
+        output += end - position - 1;
+        while(end < _size) {
+            const uint8 value = text[end];
+            if(value == '"') {
+                _stringSize = static_cast<size_t>(output - _strings);
+                entry.kind = static_cast<uint32>(JsonType::String) | JsonTapeEntry::decoded;
+                entry.length = static_cast<uint32>(_stringSize - start);
+                entry.payload = start;
+                return Result<void>();
+            }
+            if(value < 0x20)
+                return error(JsonErrorCode::ControlCharacter, end);
+            if(value >= 0x80) {
+                const size_t length = utf8Length(text + end, _size - end);
+                if(length == 0)
+                    return error(JsonErrorCode::InvalidUtf8, end);
+                __builtin_memcpy(output, text + end, length);
+                output += length;
+                end += length;
+                continue;
+            }
+            if(value != '\\') {
+                *output++ = static_cast<char>(value);
+                end++;
+                continue;
+            }
+            if(end + 1 == _size)
+                break;
+            switch(static_cast<char>(text[end + 1])) {
+                case '"':
+                case '\\':
+                case '/':
+                    *output++ = static_cast<char>(text[end + 1]);
+                    break;
+                case 'b':
+                    *output++ = '\b';
+                    break;
+                case 'f':
+                    *output++ = '\f';
+                    break;
+                case 'n':
+                    *output++ = '\n';
+                    break;
+                case 'r':
+                    *output++ = '\r';
+                    break;
+                case 't':
+                    *output++ = '\t';
+                    break;
+                case 'u': {
+                    const int32 unit = _size - end >= 6 ? parseHex(text + end + 2) : -1;
+                    if(unit < 0 || (unit >= 0xDC00 && unit <= 0xDFFF))
+                        return error(JsonErrorCode::InvalidEscape, end);
+                    auto codePoint = static_cast<uint32>(unit);
+                    if(unit >= 0xD800 && unit <= 0xDBFF) {
+                        // A high surrogate must be followed by an escaped low surrogate.
+                        const int32 low = _size - end >= 12 && text[end + 6] == '\\' && text[end + 7] == 'u'
+                                ? parseHex(text + end + 8) : -1;
+                        if(low < 0xDC00 || low > 0xDFFF)
+                            return error(JsonErrorCode::InvalidEscape, end);
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + static_cast<uint32>(low - 0xDC00);
+                        end += 6;
+                    }
+                    output += encodeUtf8(codePoint, output);
+                    end += 4;
+                    break;
+                }
+                default:
+                    return error(JsonErrorCode::InvalidEscape, end);
+            }
+            end += 2;
+        }
+        return error(JsonErrorCode::UnclosedString, position);
+    }
+
+    // Numbers are only checked against the grammar here. They are converted when read.
+    Result<void> JsonDocument::parseNumber(size_t position, JsonTapeEntry &entry) noexcept {
+        const auto *text = reinterpret_cast<const uint8 *>(_input);
+        const auto digit = [this, text](size_t k) {
+            return k < _size && isDigit(text[k]);
+        };
+        size_t end = position;
+        bool integer = true;
+        if(text[end] == '-')
+            end++;
+        if(!digit(end))
+            return error(JsonErrorCode::InvalidNumber, position);
+        if(text[end] == '0')
+            end++;
+        else {
+            while(digit(end))
+                end++;
+        }
+        if(end < _size && text[end] == '.') {
+            integer = false;
+            if(!digit(++end))
+                return error(JsonErrorCode::InvalidNumber, position);
+            while(digit(end))
+                end++;
+        }
+        if(end < _size && (text[end] | 0x20) == 'e') {
+            integer = false;
+            end++;
+            if(end < _size && (text[end] == '+' || text[end] == '-'))
+                end++;
+            if(!digit(end))
+                return error(JsonErrorCode::InvalidNumber, position);
+            while(digit(end))
+                end++;
+        }
+        if(end < _size && !isTerminator(text[end]))
+            return error(JsonErrorCode::InvalidNumber, position);
+        entry.kind = static_cast<uint32>(JsonType::Number) | (integer ? JsonTapeEntry::integer : 0);
+        entry.length = static_cast<uint32>(end - position);
+        entry.payload = position;
+        return Result<void>();
+    }
+
+    const JsonTapeEntry &JsonValue::entry() const noexcept {
+        return _document->_tape[_index];
+    }
+
+    size_t JsonValue::next(size_t index) const noexcept {
+        const JsonTapeEntry &entry = _document->_tape[index];
+        const auto type = entry.type();
+        return type == JsonType::Array || type == JsonType::Object ? static_cast<size_t>(entry.payload) : index + 1;
+    }
+
+    JsonString JsonValue::string() const noexcept {
+        const JsonTapeEntry &entry = this->entry();
+        const char *data = (entry.kind & JsonTapeEntry::decoded) != 0
+                ? _document->_strings + entry.payload
+                : reinterpret_cast<const char *>(_document->_input) + entry.payload;
+        return JsonString{data, entry.length};
+    }
+
+    Result<bool> JsonValue::getBool() const noexcept {
+        if(type() != JsonType::Boolean)
+            return error(JsonErrorCode::IncorrectType);
+        return entry().length != 0;
+    }
+
+    Result<int64> JsonValue::getInt64() const noexcept {
+        const JsonTapeEntry &entry = this->entry();
+        if(entry.type() != JsonType::Number || (entry.kind & JsonTapeEntry::integer) == 0)
+            return error(JsonErrorCode::IncorrectType);
+        int64 value;
+        if(!parseInt64(reinterpret_cast<const char *>(_document->_input) + entry.payload, entry.length, value))
+            return error(JsonErrorCode::NumberOutOfRange, entry.payload);
+        return value;
+    }
+
+    Result<uint64> JsonValue::getUInt64() const noexcept {
+        const JsonTapeEntry &entry = this->entry();
+        if(entry.type() != JsonType::Number || (entry.kind & JsonTapeEntry::integer) == 0)
+            return error(JsonErrorCode::IncorrectType);
+        uint64 value;
+        if(!parseUInt64(reinterpret_cast<const char *>(_document->_input) + entry.payload, entry.length, value))
+            return error(JsonErrorCode::NumberOutOfRange, entry.payload);
+        return value;
+    }
+
+    Result<float64> JsonValue::getDouble() const noexcept {
+        const JsonTapeEntry &entry = this->entry();
+        if(entry.type() != JsonType::Number)
+            return error(JsonErrorCode::IncorrectType);
+        float64 value;
+        if(!parseFloat64(reinterpret_cast<const char *>(_document->_input) + entry.payload, entry.length, value))
+            return error(JsonErrorCode::NumberOutOfRange, entry.payload);
+        return value;
+    }
+
+    Result<JsonString> JsonValue::getString() const noexcept {
+        if(type() != JsonType::String)
+            return error(JsonErrorCode::IncorrectType);
+        return string();
+    }
+
+    Result<JsonValue> JsonValue::field(const char *key) const noexcept {
+        if(type() != JsonType::Object)
+            return error(JsonErrorCode::IncorrectType);
+        const size_t end = entry().payload;
+        for(size_t i = _index + 1; i < end; i = next(i + 1)) {
+            if(JsonValue(_document, i).string() == key)
+                return JsonValue(_document, i + 1);
+        }
+        return error(JsonErrorCode::MissingField);
+    }
+
+    Result<JsonValue> JsonValue::element(size_t index) const noexcept {
+        if(type() != JsonType::Array)
+            return error(JsonErrorCode::IncorrectType);
+        if(index >= entry().length)
+            return error(JsonErrorCode::IndexOutOfRange);
+        size_t i = _index + 1;
+        for(; index > 0; index--)
+            i = next(i);
+        return JsonValue(_document, i);
+    }
+}
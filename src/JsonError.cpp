@@ -0,0 +1,75 @@
+#include <cstdio>   // For snprintf().
+#include "hyper/JsonError.h"
+#include "hyper/integer.h" // For maxValue().
+
+namespace hyper {
+    namespace {
+        const char *describe(JsonErrorCode code) noexcept {
+            switch(code) {
+                case JsonErrorCode::Empty:
+                    return "No JSON value";
+                case JsonErrorCode::TooLarge:
+                    return "JSON input too large";
+                case JsonErrorCode::DepthExceeded:
+                    return "JSON nested too deeply";
+                case JsonErrorCode::UnexpectedCharacter:
+                    return "Unexpected character";
+                case JsonErrorCode::UnclosedString:
+                    return "Unclosed string";
+                case JsonErrorCode::InvalidEscape:
+                    return "Invalid escape sequence";
+                case JsonErrorCode::ControlCharacter:
+                    return "Unescaped control character in string";
+                case JsonErrorCode::InvalidUtf8:
+                    return "Invalid UTF-8 in string";
+                case JsonErrorCode::InvalidNumber:
+                    return "Invalid number";
+                case JsonErrorCode::InvalidLiteral:
+                    return "Invalid literal";
+                case JsonErrorCode::UnexpectedEnd:
+                    return "Unexpected end of input";
+                case JsonErrorCode::ExpectedKey:
+                    return "Expected string key";
+                case JsonErrorCode::ExpectedColon:
+                    return "Expected colon after key";
+                case JsonErrorCode::ExpectedCommaOrEnd:
+                    return "Expected comma or end of container";
+                case JsonErrorCode::TrailingContent:
+                    return "Unexpected content after value";
+                case JsonErrorCode::IncorrectType:
+                    return "Value has a different type";
+                case JsonErrorCode::NumberOutOfRange:
+                    return "Number out of range";
+                case JsonErrorCode::MissingField:
+                    return "No such field";
+                case JsonErrorCode::IndexOutOfRange:
+                    return "Index out of range";
+            }
+            return "Unknown JSON error";
+        }
+    }
+
+    JsonError::JsonError(JsonErrorCode code, size_t offset) noexcept
+            : _code(code), _offset(offset), _message() {
+        snprintf(_message, sizeof(_message), "%s at byte %zu", describe(code), offset);
+    }
+
+    JsonError::JsonError(JsonErrorCode code) noexcept
+            : _code(code), _offset(maxValue<size_t>()), _message() {
+        snprintf(_message, sizeof(_message), "%s", describe(code));
+    }
+
+    JsonError::~JsonError() noexcept = default;
+
+    const char *JsonError::message() const noexcept {
+        return _message;
+    }
+
+    JsonErrorCode JsonError::code() const noexcept {
+        return _code;
+    }
+
+    size_t JsonError::offset() const noexcept {
+        return _offset;
+    }
+}
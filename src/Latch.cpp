@@ -0,0 +1,39 @@
+#include "hyper/assert.h"
+#include "hyper/futex.h"
+#include "hyper/Latch.h"
+
+namespace hyper {
+    Latch::Latch(uint32 count) noexcept
+            : _count(count), _waiters(0) {
+        // ...
+    }
+
+    void Latch::countDown(uint32 count) noexcept {
+        const auto previous = __atomic_fetch_sub(&_count, count, __ATOMIC_SEQ_CST);
+        ASSERTF(previous >= count, "Latch counted down below zero");
+        const auto remaining = previous - count;
+        if(remaining == 0 && __atomic_load_n(&_waiters, __ATOMIC_SEQ_CST) > 0)
+            futexWakeAll(&_count);
+    }
+
+    bool Latch::isReady() const noexcept {
+        return __atomic_load_n(&_count, __ATOMIC_ACQUIRE) == 0;
+    }
+
+    void Latch::wait() const noexcept {
+        auto count = __atomic_load_n(&_count, __ATOMIC_ACQUIRE);
+        if(count == 0)
+            return;
+        // Registering before the final check pairs with countDown(), which checks for waiters after reaching zero.
+        __atomic_add_fetch(&_waiters, 1, __ATOMIC_SEQ_CST);
+        while((count = __atomic_load_n(&_count, __ATOMIC_SEQ_CST)) != 0)
+            futexWait(&_count, count);
+        __atomic_sub_fetch(&_waiters, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    }
+
+    void Latch::arriveAndWait() noexcept {
+        countDown();
+        wait();
+    }
+}
@@ -0,0 +1,534 @@
+#include <new>   // For placement new.
+#include "hyper/assert.h"
+#include "hyper/integer.h"
+#include "hyper/Rope.h"
+#include "hyper/simd.h"
+
+namespace hyper {
+    namespace detail {
+        /// @brief Header shared by rope leaves and branches.
+        struct RopeNode {
+            uint32 refs;
+            // Zero for leaves. All leaves are at the same depth.
+            uint32 height;
+            // Number of bytes in a leaf, or of children in a branch.
+            uint32 count;
+            // Number of newlines in a leaf. Branches keep counts for each child instead.
+            uint32 newlines;
+        };
+    }
+
+    namespace {
+        using detail::RopeNode;
+
+        // Leaves fill a 2 KB allocation.
+        constexpr size_t leafCapacity = 2048 - sizeof(RopeNode);
+        constexpr size_t branchCapacity = 16;
+        constexpr byte newline = byte('\n');
+
+        struct Leaf : RopeNode {
+            byte data[leafCapacity];
+        };
+
+        struct Branch : RopeNode {
+            RopeNode *children[branchCapacity];
+            // Bytes and newlines under each child, so a walk down the tree never has to visit siblings.
+            size_t lengths[branchCapacity];
+            size_t lines[branchCapacity];
+        };
+
+        inline Leaf *asLeaf(RopeNode *node) noexcept {
+            return static_cast<Leaf *>(node);
+        }
+
+        inline Branch *asBranch(RopeNode *node) noexcept {
+            return static_cast<Branch *>(node);
+        }
+
+        size_t countNewlines(const byte *data, size_t size) noexcept {
+            size_t count = 0;
+            size_t i = 0;
+#if defined(HYPER_SIMD_AVX2)
+            const auto match = _mm256_set1_epi8('\n');
+            for(; i + 32 <= size; i += 32) {
+                const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+                const auto mask = static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, match)));
+                count += static_cast<size_t>(__builtin_popcount(mask));
+            }
+#elif defined(HYPER_SIMD_SSE2)
+            const auto match = _mm_set1_epi8('\n');
+            for(; i + 16 <= size; i += 16) {
+                const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+                const auto mask = static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, match)));
+                count += static_cast<size_t>(__builtin_popcount(mask));
+            }
+#elif defined(HYPER_SIMD_NEON)
+            const auto match = vdupq_n_u8('\n');
+            const auto one = vdupq_n_u8(1);
+            for(; i + 16 <= size; i += 16) {
+                const auto bytes = vld1q_u8(reinterpret_cast<const uint8 *>(data + i));
+                count += vaddvq_u8(vandq_u8(vceqq_u8(bytes, match), one));
+            }
+#endif
+            for(; i < size; i++)
+                count += data[i] == newline;
+            return count;
+        }
+
+        Leaf *createLeaf() noexcept {
+            auto leaf = new Leaf;
+            leaf->refs = 1;
+            leaf->height = 0;
+            leaf->count = 0;
+            leaf->newlines = 0;
+            return leaf;
+        }
+
+        Branch *createBranch(uint32 height) noexcept {
+            auto branch = new Branch;
+            branch->refs = 1;
+            branch->height = height;
+            branch->count = 0;
+            branch->newlines = 0;
+            return branch;
+        }
+
+        void retain(RopeNode *node) noexcept {
+            __atomic_fetch_add(&node->refs, 1, __ATOMIC_RELAXED);
+        }
+
+        void release(RopeNode *node) noexcept {
+            if(__atomic_sub_fetch(&node->refs, 1, __ATOMIC_ACQ_REL) != 0)
+                return;
+            if(node->height == 0) {
+                delete asLeaf(node);
+                return;
+            }
+            auto branch = asBranch(node);
+            for(size_t i = 0; i < branch->count; i++)
+                release(branch->children[i]);
+            delete branch;
+        }
+
+        void totals(RopeNode *node, size_t &length, size_t &lines) noexcept {
+            if(node->height == 0) {
+                length = node->count;
+                lines = node->newlines;
+                return;
+            }
+            auto branch = asBranch(node);
+            length = 0;
+            lines = 0;
+            for(size_t i = 0; i < branch->count; i++) {
+                length += branch->lengths[i];
+                lines += branch->lines[i];
+            }
+        }
+
+        // Stores a child's counts in its parent.
+        void summarize(Branch *branch, size_t index) noexcept {
+            totals(branch->children[index], branch->lengths[index], branch->lines[index]);
+        }
+
+        // Returns a node that only the caller references, copying the node if it is shared.
+        // The caller's reference to the original is handed over either way.
+        RopeNode *own(RopeNode *node) noexcept {
+            if(__atomic_load_n(&node->refs, __ATOMIC_ACQUIRE) == 1)
+                return node;
+            RopeNode *copy;
+            if(node->height == 0) {
+                auto leaf = createLeaf();
+                leaf->count = node->count;
+                leaf->newlines = node->newlines;
+                __builtin_memcpy(leaf->data, asLeaf(node)->data, node->count);
+                copy = leaf;
+            } else {
+                auto source = asBranch(node);
+                auto branch = createBranch(node->height);
+                branch->count = source->count;
+                for(size_t i = 0; i < source->count; i++) {
+                    branch->children[i] = source->children[i];
+                    branch->lengths[i] = source->lengths[i];
+                    branch->lines[i] = source->lines[i];
+                    retain(branch->children[i]);
+                }
+                copy = branch;
+            }
+            release(node);
+            return copy;
+        }
+
+        // Adds a child after an index, splitting the branch if it is full.
+        // Returns the new right half of the branch if it was split, or null.
+        Branch *insertChild(Branch *branch, size_t index, RopeNode *child) noexcept {
+            Branch *split = nullptr;
+            auto target = branch;
+            if(branch->count == branchCapacity) {
+                constexpr size_t half = branchCapacity / 2;
+                split = createBranch(branch->height);
+                for(size_t i = half; i < branchCapacity; i++) {
+                    split->children[i - half] = branch->children[i];
+                    split->lengths[i - half] = branch->lengths[i];
+                    split->lines[i - half] = branch->lines[i];
+                }
+                split->count = branchCapacity - half;
+                branch->count = half;
+                if(index >= half) {
+                    target = split;
+                    index -= half;
+                }
+            }
+            for(size_t i = target->count; i > index; i--) {
+                target->children[i] = target->children[i - 1];
+                target->lengths[i] = target->lengths[i - 1];
+                target->lines[i] = target->lines[i - 1];
+            }
+            target->children[index] = child;
+            target->count++;
+            summarize(target, index);
+            return split;
+        }
+
+        void removeChild(Branch *branch, size_t index) noexcept {
+            for(size_t i = index + 1; i < branch->count; i++) {
+                branch->children[i - 1] = branch->children[i];
+                branch->lengths[i - 1] = branch->lengths[i];
+                branch->lines[i - 1] = branch->lines[i];
+            }
+            branch->count--;
+        }
+
+        // Inserts at most a leaf's worth of bytes into a subtree the caller holds a reference to.
+        // Returns the updated node, and sets split to a new right sibling if the node overflowed.
+        RopeNode *insertInto(RopeNode *node, size_t position, const byte *data, size_t size,
+                             RopeNode *&split) noexcept {
+            node = own(node);
+            split = nullptr;
+            if(node->height == 0) {
+                auto leaf = asLeaf(node);
+                if(leaf->count + size <= leafCapacity) {
+                    __builtin_memmove(leaf->data + position + size, leaf->data + position, leaf->count - position);
+                    __builtin_memcpy(leaf->data + position, data, size);
+                    leaf->count += static_cast<uint32>(size);
+                    leaf->newlines += static_cast<uint32>(countNewlines(data, size));
+                    return leaf;
+                }
+                // Lay the combined bytes out in order, then split them evenly between this leaf and a new one.
+                byte combined[2 * leafCapacity];
+                const size_t total = leaf->count + size;
+                __builtin_memcpy(combined, leaf->data, position);
+                __builtin_memcpy(combined + position, data, size);
+                __builtin_memcpy(combined + position + size, leaf->data + position, leaf->count - position);
+                const size_t half = total / 2;
+                auto right = createLeaf();
+                __builtin_memcpy(leaf->data, combined, half);
+                __builtin_memcpy(right->data, combined + half, total - half);
+                leaf->count = static_cast<uint32>(half);
+                right->count = static_cast<uint32>(total - half);
+                leaf->newlines = static_cast<uint32>(countNewlines(leaf->data, leaf->count));
+                right->newlines = static_cast<uint32>(countNewlines(right->data, right->count));
+                split = right;
+                return leaf;
+            }
+            auto branch = asBranch(node);
+            // At a boundary between children, the left one is picked, so appends land in the last leaf.
+            size_t index = 0;
+            while(index + 1 < branch->count && position > branch->lengths[index])
+                position -= branch->lengths[index++];
+            RopeNode *childSplit;
+            branch->children[index] = insertInto(branch->children[index], position, data, size, childSplit);
+            summarize(branch, index);
+            if(childSplit != nullptr)
+                split = insertChild(branch, index + 1, childSplit);
+            return branch;
+        }
+
+        // Joins two adjacent children into the left one if they fit, and returns whether they did.
+        bool mergeChildren(Branch *branch, size_t index) noexcept {
+            auto left = branch->children[index];
+            auto right = branch->children[index + 1];
+            if(left->height == 0) {
+                if(left->count + right->count > leafCapacity)
+                    return false;
+                left = own(left);
+                __builtin_memcpy(asLeaf(left)->data + left->count, asLeaf(right)->data, right->count);
+                left->count += right->count;
+                left->newlines += right->newlines;
+            } else {
+                if(left->count + right->count > branchCapacity)
+                    return false;
+                left = own(left);
+                auto target = asBranch(left);
+                auto source = asBranch(right);
+                for(size_t i = 0; i < source->count; i++) {
+                    target->children[target->count + i] = source->children[i];
+                    target->lengths[target->count + i] = source->lengths[i];
+                    target->lines[target->count + i] = source->lines[i];
+                    retain(source->children[i]);
+                }
+                target->count += source->count;
+            }
+            release(right);
+            branch->children[index] = left;
+            summarize(branch, index);
+            removeChild(branch, index + 1);
+            return true;
+        }
+
+        // Removes a range of bytes from a subtree the caller holds a reference to.
+        // Returns the updated node, or null if nothing is left in it.
+        RopeNode *eraseFrom(RopeNode *node, size_t position, size_t size) noexcept {
+            node = own(node);
+            if(node->height == 0) {
+                auto leaf = asLeaf(node);
+                leaf->newlines -= static_cast<uint32>(countNewlines(leaf->data + position, size));
+                __builtin_memmove(leaf->data + position, leaf->data + position + size,
+                                  leaf->count - position - size);
+                leaf->count -= static_cast<uint32>(size);
+                if(leaf->count == 0) {
+                    release(leaf);
+                    return nullptr;
+                }
+                return leaf;
+            }
+            auto branch = asBranch(node);
+            size_t index = 0;
+            while(position >= branch->lengths[index])
+                position -= branch->lengths[index++];
+            const size_t first = index;
+            while(size > 0) {
+                const auto length = branch->lengths[index];
+                const auto removed = length - position < size ? length - position : size;
+                if(removed == length) {
+                    // Whole children are dropped without visiting their subtrees.
+                    release(branch->children[index]);
+                    removeChild(branch, index);
+                } else {
+                    const auto child = eraseFrom(branch->children[index], position, removed);
+                    branch->children[index] = child;
+                    summarize(branch, index);
+                    index++;
+                }
+                size -= removed;
+                position = 0;
+            }
+            if(branch->count == 0) {
+                release(branch);
+                return nullptr;
+            }
+            // Only the children at the edges of the range were changed, so only they can have become small.
+            for(size_t i = first > 0 ? first - 1 : 0; i + 1 < branch->count && i <= first + 1;)
+                if(!mergeChildren(branch, i))
+                    i++;
+            return branch;
+        }
+
+        // Descends to the leaf holding a position, leaving the position relative to that leaf.
+        Leaf *findLeaf(RopeNode *node, size_t &position) noexcept {
+            while(node->height > 0) {
+                auto branch = asBranch(node);
+                size_t index = 0;
+                while(index + 1 < branch->count && position >= branch->lengths[index])
+                    position -= branch->lengths[index++];
+                node = branch->children[index];
+            }
+            return asLeaf(node);
+        }
+    }
+
+    Rope::Rope() noexcept
+            : _root(nullptr) {
+        // ...
+    }
+
+    Rope::Rope(const byte *data, size_t size) noexcept
+            : _root(nullptr) {
+        if(size == 0)
+            return;
+        // Fill leaves, then group each level into full branches until a single root is left.
+        size_t count = (size + leafCapacity - 1) / leafCapacity;
+        auto level = new RopeNode *[count];
+        for(size_t i = 0; i < count; i++) {
+            auto leaf = createLeaf();
+            const auto offset = i * leafCapacity;
+            leaf->count = static_cast<uint32>(size - offset < leafCapacity ? size - offset : leafCapacity);
+            __builtin_memcpy(leaf->data, data + offset, leaf->count);
+            leaf->newlines = static_cast<uint32>(countNewlines(leaf->data, leaf->count));
+            level[i] = leaf;
+        }
+        for(uint32 height = 1; count > 1; height++) {
+            const auto parents = (count + branchCapacity - 1) / branchCapacity;
+            for(size_t i = 0; i < parents; i++) {
+                auto branch = createBranch(height);
+                for(size_t j = i * branchCapacity; j < count && j < (i + 1) * branchCapacity; j++) {
+                    branch->children[branch->count] = level[j];
+                    summarize(branch, branch->count++);
+                }
+                level[i] = branch;
+            }
+            count = parents;
+        }
+        _root = level[0];
+        delete[] level;
+    }
+
+    Rope::Rope(const Rope &other) noexcept
+            : _root(other._root) {
+        if(_root != nullptr)
+            retain(_root);
+    }
+
+    Rope::Rope(Rope &&other) noexcept
+            : _root(other._root) {
+        other._root = nullptr;
+    }
+
+    Rope::~Rope() noexcept {
+        if(_root != nullptr)
+            release(_root);
+    }
+
+    size_t Rope::size() const noexcept {
+        if(_root == nullptr)
+            return 0;
+        size_t length, lines;
+        totals(_root, length, lines);
+        return length;
+    }
+
+    size_t Rope::lineCount() const noexcept {
+        if(_root == nullptr)
+            return 1;
+        size_t length, lines;
+        totals(_root, length, lines);
+        return lines + 1;
+    }
+
+    size_t Rope::lineStart(size_t line) const noexcept {
+        ASSERTF(line < lineCount(), "Line %zu is past the end of the rope", line);
+        if(line == 0)
+            return 0;
+        // Find the newline that ends the previous line.
+        size_t position = 0;
+        auto node = _root;
+        while(node->height > 0) {
+            auto branch = asBranch(node);
+            size_t index = 0;
+            while(line > branch->lines[index]) {
+                line -= branch->lines[index];
+                position += branch->lengths[index++];
+            }
+            node = branch->children[index];
+        }
+        auto leaf = asLeaf(node);
+        for(size_t i = 0;; i++)
+            if(leaf->data[i] == newline && --line == 0)
+                return position + i + 1;
+    }
+
+    size_t Rope::lineOf(size_t position) const noexcept {
+        ASSERTF(position <= size(), "Position %zu is past the end of the rope", position);
+        if(_root == nullptr)
+            return 0;
+        size_t line = 0;
+        auto node = _root;
+        while(node->height > 0) {
+            auto branch = asBranch(node);
+            size_t index = 0;
+            while(index + 1 < branch->count && position >= branch->lengths[index]) {
+                position -= branch->lengths[index];
+                line += branch->lines[index++];
+            }
+            node = branch->children[index];
+        }
+        return line + countNewlines(asLeaf(node)->data, position);
+    }
+
+    const byte *Rope::chunk(size_t position, size_t &length) const noexcept {
+        ASSERTF(position < size(), "Position %zu is past the end of the rope", position);
+        auto leaf = findLeaf(_root, position);
+        length = leaf->count - position;
+        return leaf->data + position;
+    }
+
+    size_t Rope::read(size_t position, byte *output, size_t size) const noexcept {
+        const auto total = this->size();
+        if(position >= total)
+            return 0;
+        if(size > total - position)
+            size = total - position;
+        for(size_t copied = 0, length; copied < size; copied += length) {
+            const auto data = chunk(position + copied, length);
+            if(length > size - copied)
+                length = size - copied;
+            __builtin_memcpy(output + copied, data, length);
+        }
+        return size;
+    }
+
+    void Rope::insert(size_t position, const byte *data, size_t size) noexcept {
+        ASSERTF(position <= this->size(), "Position %zu is past the end of the rope", position);
+        if(size == 0)
+            return;
+        if(_root == nullptr)
+            _root = createLeaf();
+        // Insert a leaf's worth at a time, so a leaf overflows into at most one new sibling.
+        while(size > 0) {
+            const auto piece = size < leafCapacity ? size : leafCapacity;
+            RopeNode *split;
+            _root = insertInto(_root, position, data, piece, split);
+            if(split != nullptr) {
+                auto root = createBranch(_root->height + 1);
+                root->children[0] = _root;
+                root->children[1] = split;
+                root->count = 2;
+                summarize(root, 0);
+                summarize(root, 1);
+                _root = root;
+            }
+            position += piece;
+            data += piece;
+            size -= piece;
+        }
+    }
+
+    void Rope::erase(size_t position, size_t size) noexcept {
+        ASSERTF(position + size <= this->size(), "Range %zu+%zu is past the end of the rope", position, size);
+        if(size == 0)
+            return;
+        _root = eraseFrom(_root, position, size);
+        // Drop roots left with a single child, so the tree is no taller than it needs to be.
+        while(_root != nullptr && _root->height > 0 && _root->count == 1) {
+            auto child = asBranch(_root)->children[0];
+            retain(child);
+            release(_root);
+            _root = child;
+        }
+    }
+
+    void Rope::clear() noexcept {
+        if(_root != nullptr)
+            release(_root);
+        _root = nullptr;
+    }
+
+    Rope &Rope::operator=(const Rope &other) noexcept {
+        // Retaining first keeps self-assignment from freeing the nodes.
+        if(other._root != nullptr)
+            retain(other._root);
+        if(_root != nullptr)
+            release(_root);
+        _root = other._root;
+        return *this;
+    }
+
+    Rope &Rope::operator=(Rope &&other) noexcept {
+        if(this != &other) {
+            if(_root != nullptr)
+                release(_root);
+            _root = other._root;
+            other._root = nullptr;
+        }
+        return *this;
+    }
+}
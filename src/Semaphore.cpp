@@ -0,0 +1,55 @@
+#include "hyper/clock.h"
+#include "hyper/futex.h"
+#include "hyper/Semaphore.h"
+
+namespace hyper {
+    Semaphore::Semaphore(uint32 initial) noexcept
+            : _count(initial), _waiters(0) {
+        // ...
+    }
+
+    uint32 Semaphore::value() const noexcept {
+        return __atomic_load_n(&_count, __ATOMIC_RELAXED);
+    }
+
+    void Semaphore::acquire() noexcept {
+        if(tryAcquire())
+            return;
+        // Registering as a waiter before checking the count again pairs with release(),
+        // which adds to the count before checking for waiters, so one of the two always sees the other.
+        __atomic_add_fetch(&_waiters, 1, __ATOMIC_SEQ_CST);
+        while(!tryAcquire())
+            futexWait(&_count, 0);
+        __atomic_sub_fetch(&_waiters, 1, __ATOMIC_RELAXED);
+    }
+
+    bool Semaphore::tryAcquire() noexcept {
+        auto count = __atomic_load_n(&_count, __ATOMIC_SEQ_CST);
+        while(count > 0)
+            if(__atomic_compare_exchange_n(&_count, &count, count - 1, true, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+                return true;
+        return false;
+    }
+
+    bool Semaphore::tryAcquireFor(uint64 nanoseconds) noexcept {
+        if(tryAcquire())
+            return true;
+        const auto deadline = monotonicNow() + nanoseconds;
+        __atomic_add_fetch(&_waiters, 1, __ATOMIC_SEQ_CST);
+        bool acquired;
+        while(!(acquired = tryAcquire())) {
+            const auto now = monotonicNow();
+            if(now >= deadline)
+                break;
+            futexWaitFor(&_count, 0, deadline - now);
+        }
+        __atomic_sub_fetch(&_waiters, 1, __ATOMIC_RELAXED);
+        return acquired;
+    }
+
+    void Semaphore::release(uint32 count) noexcept {
+        __atomic_add_fetch(&_count, count, __ATOMIC_SEQ_CST);
+        if(__atomic_load_n(&_waiters, __ATOMIC_SEQ_CST) > 0)
+            futexWake(&_count, count);
+    }
+}
@@ -0,0 +1,19 @@
+#include <cstring>   // For strerror().
+#include "hyper/SystemError.h"
+
+namespace hyper {
+    SystemError::SystemError(int code) noexcept
+            : _code(code) {
+        // ...
+    }
+
+    SystemError::~SystemError() noexcept = default;
+
+    const char *SystemError::message() const noexcept {
+        return strerror(_code);
+    }
+
+    int SystemError::code() const noexcept {
+        return _code;
+    }
+}
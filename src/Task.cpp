@@ -0,0 +1,89 @@
+#include <new>         // For operator new.
+#include <pthread.h>   // For pthread_key_create().
+#include "hyper/Task.h"
+#include "hyper/integer.h"
+
+namespace hyper {
+    namespace {
+        // Frames are pooled in size classes of 64 bytes, up to 2 KiB.
+        // Larger frames are rare and go straight to the general-purpose allocator.
+        constexpr size_t frameGranularity = 64;
+        constexpr size_t frameClassCount  = 32;
+
+        // Most frames each thread keeps cached per size class, so a burst of coroutines doesn't pin memory forever.
+        constexpr uint32 maxCachedFrames = 256;
+
+        struct FreeFrame {
+            FreeFrame *next;
+        };
+
+        // Trivially constructible, so reaching it costs no more than any other thread-local access.
+        struct FramePool {
+            FreeFrame *lists[frameClassCount];
+            uint32 counts[frameClassCount];
+            bool registered;
+        };
+
+        __thread FramePool framePool __attribute__((tls_model("initial-exec")));
+
+        pthread_once_t keyOnce = PTHREAD_ONCE_INIT;
+        pthread_key_t exitKey;
+
+        // Runs when a thread that cached frames exits.
+        // Frames freed after this, by other exit handlers, register the thread again and are freed on the next pass.
+        void destroyPool(void *) noexcept {
+            for(size_t i = 0; i < frameClassCount; i++) {
+                auto list = framePool.lists[i];
+                while(list != nullptr) {
+                    auto next = list->next;
+                    ::operator delete(list);
+                    list = next;
+                }
+                framePool.lists[i] = nullptr;
+                framePool.counts[i] = 0;
+            }
+            framePool.registered = false;
+        }
+
+        void createKey() noexcept {
+            pthread_key_create(&exitKey, destroyPool);
+        }
+
+        inline size_t frameClass(size_t size) noexcept {
+            return (size + frameGranularity - 1) / frameGranularity - 1;
+        }
+    }
+
+    namespace detail {
+        void *allocateFrame(size_t size) noexcept {
+            const auto sizeClass = frameClass(size);
+            if(sizeClass >= frameClassCount)
+                return ::operator new(size);
+            auto &list = framePool.lists[sizeClass];
+            if(list == nullptr)
+                return ::operator new((sizeClass + 1) * frameGranularity);
+            auto frame = list;
+            list = frame->next;
+            framePool.counts[sizeClass]--;
+            return frame;
+        }
+
+        void freeFrame(void *frame, size_t size) noexcept {
+            const auto sizeClass = frameClass(size);
+            if(sizeClass >= frameClassCount || framePool.counts[sizeClass] >= maxCachedFrames) {
+                ::operator delete(frame);
+                return;
+            }
+            if(!framePool.registered) [[unlikely]] {
+                pthread_once(&keyOnce, createKey);
+                // Any non-null value makes the thread library call the destructor at exit.
+                pthread_setspecific(exitKey, &framePool);
+                framePool.registered = true;
+            }
+            auto entry = static_cast<FreeFrame *>(frame);
+            entry->next = framePool.lists[sizeClass];
+            framePool.lists[sizeClass] = entry;
+            framePool.counts[sizeClass]++;
+        }
+    }
+}
@@ -0,0 +1,297 @@
+#include <cstdio>   // For snprintf().
+#include "hyper/assert.h"
+#include "hyper/clock.h"
+#include "hyper/TaskGraph.h"
+
+namespace hyper {
+    namespace {
+        // Number of times to spin while waiting for nodes to become ready before yielding to other threads.
+        constexpr unsigned spinLimit = 64;
+
+        template<typename T>
+        T *grow(T *array, size_t count, size_t &capacity) noexcept {
+            capacity = capacity == 0 ? 16 : capacity * 2;
+            auto resized = new T[capacity];
+            for(size_t i = 0; i < count; i++)
+                resized[i] = array[i];
+            delete[] array;
+            return resized;
+        }
+
+        // Appends formatted text to a buffer, counting the full length even once the buffer is full.
+        class Writer {
+        public:
+            Writer(char *buffer, size_t capacity) noexcept
+                    : _buffer(buffer), _capacity(capacity), _length(0) {
+                if(_capacity > 0)
+                    _buffer[0] = '\0';
+            }
+
+            template<typename... Args>
+            void write(const char *format, Args... args) noexcept {
+                char *position = _length < _capacity ? _buffer + _length : nullptr;
+                const size_t space = _length < _capacity ? _capacity - _length : 0;
+                const int written = snprintf(position, space, format, args...);
+                if(written > 0)
+                    _length += static_cast<size_t>(written);
+            }
+
+            void writeQuoted(const char *text) noexcept {
+                write("\"");
+                for(; *text != '\0'; text++) {
+                    if(*text == '"' || *text == '\\')
+                        write("\\%c", *text);
+                    else
+                        write("%c", *text);
+                }
+                write("\"");
+            }
+
+            size_t length() const noexcept {
+                return _length;
+            }
+
+        private:
+            char *_buffer;
+            size_t _capacity;
+            size_t _length;
+        };
+    }
+
+    TaskGraph::TaskGraph() noexcept
+            : _nodes(nullptr), _nodeCount(0), _nodeCapacity(0),
+              _edges(nullptr), _edgeCount(0), _edgeCapacity(0),
+              _successors(nullptr), _pending(nullptr), _ready(nullptr),
+              _readyCount(0), _remaining(0), _readyLock(), _compiled(false) {
+        // ...
+    }
+
+    TaskGraph::~TaskGraph() noexcept {
+        delete[] _nodes;
+        delete[] _edges;
+        delete[] _successors;
+        delete[] _pending;
+        delete[] _ready;
+    }
+
+    size_t TaskGraph::addNode(const Function<void()> &work, const char *name) noexcept {
+        ASSERTF(isDone(), "Attempt to modify a task graph while it is running");
+        if(_nodeCount == _nodeCapacity)
+            _nodes = grow(_nodes, _nodeCount, _nodeCapacity);
+        auto &node = _nodes[_nodeCount];
+        node.work = work;
+        node.name = name;
+        node.time = 0;
+        _compiled = false;
+        return _nodeCount++;
+    }
+
+    void TaskGraph::addEdge(size_t before, size_t after) noexcept {
+        ASSERTF(isDone(), "Attempt to modify a task graph while it is running");
+        ASSERTF(before < _nodeCount && after < _nodeCount, "Edge refers to a node that doesn't exist");
+        if(_edgeCount == _edgeCapacity)
+            _edges = grow(_edges, _edgeCount, _edgeCapacity);
+        _edges[_edgeCount++] = Edge{static_cast<uint32>(before), static_cast<uint32>(after)};
+        _compiled = false;
+    }
+
+    bool TaskGraph::compile() noexcept {
+        ASSERTF(isDone(), "Attempt to compile a task graph while it is running");
+        delete[] _successors;
+        delete[] _pending;
+        delete[] _ready;
+        _successors = new uint32[_edgeCount];
+        _pending = new uint32[_nodeCount];
+        _ready = new uint32[_nodeCount];
+        _compiled = false;
+
+        // Group successors by node, counting sort style: count, prefix sum, then fill.
+        for(size_t i = 0; i < _nodeCount; i++) {
+            _nodes[i].predecessorCount = 0;
+            _nodes[i].successorOffset = 0;
+        }
+        for(size_t i = 0; i < _edgeCount; i++) {
+            _nodes[_edges[i].before].successorOffset++;
+            _nodes[_edges[i].after].predecessorCount++;
+        }
+        uint32 offset = 0;
+        for(size_t i = 0; i < _nodeCount; i++) {
+            const auto count = _nodes[i].successorOffset;
+            _nodes[i].successorOffset = offset;
+            offset += count;
+        }
+        // Filling advances each node's offset to the start of the next node's successors, so shift them back after.
+        for(size_t i = 0; i < _edgeCount; i++)
+            _successors[_nodes[_edges[i].before].successorOffset++] = _edges[i].after;
+        for(size_t i = _nodeCount; i > 0; i--)
+            _nodes[i - 1].successorOffset = i > 1 ? _nodes[i - 2].successorOffset : 0;
+
+        // Sort the nodes topologically, using the ready array as the queue.
+        size_t sorted = 0;
+        for(size_t i = 0; i < _nodeCount; i++) {
+            _pending[i] = _nodes[i].predecessorCount;
+            if(_pending[i] == 0)
+                _ready[sorted++] = static_cast<uint32>(i);
+        }
+        for(size_t i = 0; i < sorted; i++) {
+            const auto node = _ready[i];
+            for(auto successor = successorsBegin(node); successor != successorsEnd(node); successor++)
+                if(--_pending[*successor] == 0)
+                    _ready[sorted++] = *successor;
+        }
+        if(sorted != _nodeCount)
+            return false;
+
+        // Walk back from the sinks to find the longest weighted path from each node.
+        for(size_t i = _nodeCount; i > 0; i--) {
+            const auto node = _ready[i - 1];
+            uint64 longest = 0;
+            for(auto successor = successorsBegin(node); successor != successorsEnd(node); successor++)
+                if(_nodes[*successor].priority > longest)
+                    longest = _nodes[*successor].priority;
+            _nodes[node].priority = longest + _nodes[node].time + 1;
+        }
+        _compiled = true;
+        return true;
+    }
+
+    void TaskGraph::run() noexcept {
+        start();
+        work();
+    }
+
+    void TaskGraph::start() noexcept {
+        ASSERTF(_compiled, "Attempt to run a task graph that hasn't been compiled");
+        ASSERTF(isDone(), "Attempt to start a task graph that is already running");
+        _readyCount = 0;
+        for(size_t i = 0; i < _nodeCount; i++) {
+            _pending[i] = _nodes[i].predecessorCount;
+            if(_pending[i] == 0)
+                pushReady(static_cast<uint32>(i));
+        }
+        __atomic_store_n(&_remaining, _nodeCount, __ATOMIC_RELEASE);
+    }
+
+    void TaskGraph::work() noexcept {
+        unsigned spins = 0;
+        while(__atomic_load_n(&_remaining, __ATOMIC_ACQUIRE) > 0) {
+            uint32 node;
+            if(!popReady(node)) {
+                if(spins++ < spinLimit)
+                    cpuRelax();
+                else
+                    yieldThread();
+                continue;
+            }
+            spins = 0;
+
+            const auto begin = readTimestamp();
+            _nodes[node].work();
+            _nodes[node].time = timestampToNanoseconds(readTimestamp() - begin);
+
+            // Take the lock once for all of the successors this node releases.
+            bool locked = false;
+            for(auto successor = successorsBegin(node); successor != successorsEnd(node); successor++) {
+                if(__atomic_sub_fetch(&_pending[*successor], 1, __ATOMIC_ACQ_REL) == 0) {
+                    if(!locked) {
+                        _readyLock.lock();
+                        locked = true;
+                    }
+                    pushReady(*successor);
+                }
+            }
+            if(locked)
+                _readyLock.unlock();
+            __atomic_sub_fetch(&_remaining, 1, __ATOMIC_ACQ_REL);
+        }
+    }
+
+    bool TaskGraph::isDone() const noexcept {
+        return __atomic_load_n(&_remaining, __ATOMIC_ACQUIRE) == 0;
+    }
+
+    size_t TaskGraph::nodeCount() const noexcept {
+        return _nodeCount;
+    }
+
+    size_t TaskGraph::edgeCount() const noexcept {
+        return _edgeCount;
+    }
+
+    uint64 TaskGraph::nodeTime(size_t node) const noexcept {
+        ASSERTF(node < _nodeCount, "Node index %zu out of range", node);
+        return _nodes[node].time;
+    }
+
+    size_t TaskGraph::toGraphviz(char *buffer, size_t capacity) const noexcept {
+        Writer writer(buffer, capacity);
+        writer.write("digraph TaskGraph {\n");
+        for(size_t i = 0; i < _nodeCount; i++) {
+            writer.write("    n%zu [label=", i);
+            if(_nodes[i].name != nullptr)
+                writer.writeQuoted(_nodes[i].name);
+            else
+                writer.write("\"%zu\"", i);
+            if(_nodes[i].time > 0)
+                writer.write(", xlabel=\"%.1f us\"", static_cast<double>(_nodes[i].time) / 1000.0);
+            writer.write("];\n");
+        }
+        for(size_t i = 0; i < _edgeCount; i++)
+            writer.write("    n%u -> n%u;\n", _edges[i].before, _edges[i].after);
+        writer.write("}\n");
+        return writer.length();
+    }
+
+    const uint32 *TaskGraph::successorsBegin(uint32 node) const noexcept {
+        return _successors + _nodes[node].successorOffset;
+    }
+
+    const uint32 *TaskGraph::successorsEnd(uint32 node) const noexcept {
+        return node + 1 < _nodeCount ? _successors + _nodes[node + 1].successorOffset : _successors + _edgeCount;
+    }
+
+    bool TaskGraph::higherPriority(uint32 first, uint32 second) const noexcept {
+        const auto firstPriority = _nodes[first].priority;
+        const auto secondPriority = _nodes[second].priority;
+        return firstPriority > secondPriority || (firstPriority == secondPriority && first < second);
+    }
+
+    void TaskGraph::pushReady(uint32 node) noexcept {
+        // Sift the node up the binary heap. The heap can hold every node, so it never needs to grow.
+        // The count is stored atomically because idle threads peek at it without the lock.
+        size_t index = _readyCount;
+        __atomic_store_n(&_readyCount, index + 1, __ATOMIC_RELAXED);
+        while(index > 0) {
+            const size_t parent = (index - 1) / 2;
+            if(!higherPriority(node, _ready[parent]))
+                break;
+            _ready[index] = _ready[parent];
+            index = parent;
+        }
+        _ready[index] = node;
+    }
+
+    bool TaskGraph::popReady(uint32 &node) noexcept {
+        // Peek without the lock first, so idle threads don't fight over it.
+        if(__atomic_load_n(&_readyCount, __ATOMIC_RELAXED) == 0)
+            return false;
+        ScopedLock<SpinLock> guard(_readyLock);
+        if(_readyCount == 0)
+            return false;
+        node = _ready[0];
+        // Sift the last node down from the top of the heap.
+        const auto last = _ready[_readyCount - 1];
+        __atomic_store_n(&_readyCount, _readyCount - 1, __ATOMIC_RELAXED);
+        size_t index = 0;
+        for(size_t child; (child = 2 * index + 1) < _readyCount; index = child) {
+            if(child + 1 < _readyCount && higherPriority(_ready[child + 1], _ready[child]))
+                child++;
+            if(!higherPriority(_ready[child], last))
+                break;
+            _ready[index] = _ready[child];
+        }
+        if(_readyCount > 0)
+            _ready[index] = last;
+        return true;
+    }
+}
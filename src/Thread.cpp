@@ -0,0 +1,152 @@
+#include <cerrno>           // For errno.
+#include <sched.h>          // For sched_setaffinity() and CPU_SET().
+#include <sys/resource.h>   // For setpriority().
+#include <sys/syscall.h>    // For SYS_gettid.
+#include <unistd.h>         // For syscall().
+#include "hyper/assert.h"
+#include "hyper/SystemError.h"
+#include "hyper/Thread.h"
+
+namespace hyper {
+    namespace {
+        // Linux limits thread names to 16 bytes, including the terminator.
+        constexpr size_t maxNameLength = 15;
+
+        // Nice values used for each priority. Lower is more favored.
+        constexpr int lowNice = 10;
+        constexpr int highNice = -10;
+
+        struct Start {
+            Function<void()> entry;
+            char name[maxNameLength + 1];
+        };
+
+        void copyName(char *destination, const char *name) noexcept {
+            size_t length = 0;
+            if(name != nullptr)
+                for(; length < maxNameLength && name[length] != '\0'; length++)
+                    destination[length] = name[length];
+            destination[length] = '\0';
+        }
+
+        void *run(void *argument) noexcept {
+            auto start = static_cast<Start *>(argument);
+            if(start->name[0] != '\0')
+                pthread_setname_np(pthread_self(), start->name);
+            const auto entry = start->entry;
+            delete start;
+            entry();
+            return nullptr;
+        }
+
+        Result<void> fillSet(cpu_set_t &set, const uint32 *cpus, size_t count) noexcept {
+            CPU_ZERO(&set);
+            for(size_t i = 0; i < count; i++) {
+                if(cpus[i] >= CPU_SETSIZE)
+                    return Result<void>(SharedPointer<Error>(new SystemError(EINVAL)));
+                CPU_SET(cpus[i], &set);
+            }
+            return Result<void>();
+        }
+
+        Result<void> check(int code) noexcept {
+            if(code != 0)
+                return Result<void>(SharedPointer<Error>(new SystemError(code)));
+            return Result<void>();
+        }
+    }
+
+    Thread::Thread() noexcept
+            : _handle(), _joinable(false) {
+        // ...
+    }
+
+    Thread::Thread(Thread &&other) noexcept
+            : _handle(other._handle), _joinable(other._joinable) {
+        other._joinable = false;
+    }
+
+    Thread::~Thread() noexcept {
+        join();
+    }
+
+    Result<void> Thread::start(const Function<void()> &entry, const char *name) noexcept {
+        ASSERTF(!_joinable, "Attempt to start a thread that is already running");
+        auto start = new Start{entry, {}};
+        copyName(start->name, name);
+        const int code = pthread_create(&_handle, nullptr, run, start);
+        if(code != 0) {
+            delete start;
+            return check(code);
+        }
+        _joinable = true;
+        return Result<void>();
+    }
+
+    void Thread::join() noexcept {
+        if(!_joinable)
+            return;
+        pthread_join(_handle, nullptr);
+        _joinable = false;
+    }
+
+    bool Thread::isJoinable() const noexcept {
+        return _joinable;
+    }
+
+    Result<void> Thread::setAffinity(const uint32 *cpus, size_t count) noexcept {
+        ASSERTF(_joinable, "Attempt to set the affinity of a thread that isn't running");
+        cpu_set_t set;
+        auto filled = fillSet(set, cpus, count);
+        if(!filled)
+            return filled;
+        return check(pthread_setaffinity_np(_handle, sizeof(set), &set));
+    }
+
+    Result<void> Thread::setName(const char *name) noexcept {
+        ASSERTF(_joinable, "Attempt to name a thread that isn't running");
+        char truncated[maxNameLength + 1];
+        copyName(truncated, name);
+        return check(pthread_setname_np(_handle, truncated));
+    }
+
+    Result<void> Thread::setCurrentAffinity(const uint32 *cpus, size_t count) noexcept {
+        cpu_set_t set;
+        auto filled = fillSet(set, cpus, count);
+        if(!filled)
+            return filled;
+        return check(pthread_setaffinity_np(pthread_self(), sizeof(set), &set));
+    }
+
+    Result<void> Thread::setCurrentName(const char *name) noexcept {
+        char truncated[maxNameLength + 1];
+        copyName(truncated, name);
+        return check(pthread_setname_np(pthread_self(), truncated));
+    }
+
+    Result<void> Thread::setCurrentPriority(ThreadPriority priority) noexcept {
+        // On Linux, nice values apply to individual threads when given a thread identifier.
+        int nice = 0;
+        if(priority == ThreadPriority::Low)
+            nice = lowNice;
+        else if(priority == ThreadPriority::High)
+            nice = highNice;
+        if(setpriority(PRIO_PROCESS, static_cast<id_t>(currentId()), nice) != 0)
+            return check(errno);
+        return Result<void>();
+    }
+
+    uint64 Thread::currentId() noexcept {
+        return static_cast<uint64>(syscall(SYS_gettid));
+    }
+
+    Thread &Thread::operator=(Thread &&other) noexcept {
+        if(this != &other) {
+            join();
+            _handle = other._handle;
+            _joinable = other._joinable;
+            other._joinable = false;
+        }
+        return *this;
+    }
+}
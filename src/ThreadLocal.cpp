@@ -0,0 +1,151 @@
+#include <cstdlib>     // For atexit().
+#include <pthread.h>   // For thread-specific keys and mutexes.
+#include "hyper/ThreadLocal.h"
+
+namespace hyper {
+    namespace detail {
+        __thread ThreadSlots threadSlots __attribute__((tls_model("initial-exec")));
+    }
+
+    namespace {
+        // Smallest number of slots a thread is given, to avoid growing one at a time.
+        constexpr uint32 minimumCapacity = 16;
+
+        // Recursive, so values may use other ThreadLocals while they are being created or destroyed.
+        pthread_mutex_t registryMutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+        detail::ThreadSlots *registry = nullptr;
+
+        // Indices given back by destroyed ThreadLocals, reused before handing out new ones.
+        uint32 *freeIndices = nullptr;
+        uint32 freeCount = 0;
+        uint32 freeCapacity = 0;
+        uint32 nextIndex = 0;
+
+        pthread_once_t keyOnce = PTHREAD_ONCE_INIT;
+        pthread_key_t exitKey;
+
+        void link(detail::ThreadSlots &slots) noexcept {
+            slots.previous = nullptr;
+            slots.next = registry;
+            if(registry != nullptr)
+                registry->previous = &slots;
+            registry = &slots;
+            slots.registered = true;
+        }
+
+        void unlink(detail::ThreadSlots &slots) noexcept {
+            if(slots.previous != nullptr)
+                slots.previous->next = slots.next;
+            else
+                registry = slots.next;
+            if(slots.next != nullptr)
+                slots.next->previous = slots.previous;
+            slots.previous = nullptr;
+            slots.next = nullptr;
+            slots.registered = false;
+        }
+
+        // Runs when a registered thread exits.
+        void destroyThread(void *) noexcept {
+            auto &current = detail::threadSlots;
+            pthread_mutex_lock(&registryMutex);
+            unlink(current);
+            const auto slots = current.slots;
+            const auto capacity = current.capacity;
+            current.slots = nullptr;
+            current.capacity = 0;
+            pthread_mutex_unlock(&registryMutex);
+
+            // Once unlinked, no other thread can reach these values, so destroy them without the lock.
+            // A destructor that uses a ThreadLocal registers the thread again,
+            // and the thread library or the exit handler calls this again afterwards.
+            for(uint32 i = 0; i < capacity; i++)
+                if(slots[i].value != nullptr)
+                    slots[i].destroy(slots[i].value);
+            delete[] slots;
+        }
+
+        // Runs when the process exits. The thread library only destroys the values of threads that exit themselves,
+        // which leaves those of the thread calling exit(), usually the main thread.
+        void destroyExitingThread() noexcept {
+            while(detail::threadSlots.registered)
+                destroyThread(nullptr);
+        }
+
+        void createKey() noexcept {
+            pthread_key_create(&exitKey, destroyThread);
+            atexit(destroyExitingThread);
+        }
+    }
+
+    namespace detail {
+        uint32 allocateThreadSlot() noexcept {
+            pthread_mutex_lock(&registryMutex);
+            const auto index = freeCount > 0 ? freeIndices[--freeCount] : nextIndex++;
+            pthread_mutex_unlock(&registryMutex);
+            return index;
+        }
+
+        void releaseThreadSlot(uint32 index) noexcept {
+            pthread_mutex_lock(&registryMutex);
+            // The mutex is recursive, so a destructor can create or release other values on this thread.
+            // The values are re-read after each one, since destructors can grow this thread's slots.
+            for(auto slots = registry; slots != nullptr; slots = slots->next) {
+                if(index >= slots->capacity)
+                    continue;
+                auto &slot = slots->slots[index];
+                const auto value = slot.value;
+                if(value == nullptr)
+                    continue;
+                slot.value = nullptr;
+                slot.destroy(value);
+            }
+
+            if(freeCount == freeCapacity) {
+                const auto capacity = freeCapacity > 0 ? freeCapacity * 2 : minimumCapacity;
+                const auto indices = new uint32[capacity];
+                for(uint32 i = 0; i < freeCount; i++)
+                    indices[i] = freeIndices[i];
+                delete[] freeIndices;
+                freeIndices = indices;
+                freeCapacity = capacity;
+            }
+            freeIndices[freeCount++] = index;
+            pthread_mutex_unlock(&registryMutex);
+        }
+
+        void setThreadSlot(uint32 index, void *value, ThreadSlotDestroy destroy) noexcept {
+            auto &current = threadSlots;
+            pthread_mutex_lock(&registryMutex);
+            if(index >= current.capacity) {
+                auto capacity = current.capacity > 0 ? current.capacity * 2 : minimumCapacity;
+                while(capacity <= index)
+                    capacity *= 2;
+                const auto slots = new ThreadSlot[capacity];
+                for(uint32 i = 0; i < current.capacity; i++)
+                    slots[i] = current.slots[i];
+                for(auto i = current.capacity; i < capacity; i++)
+                    slots[i] = {nullptr, nullptr};
+                delete[] current.slots;
+                current.slots = slots;
+                current.capacity = capacity;
+            }
+            current.slots[index] = {value, destroy};
+            if(!current.registered) {
+                link(current);
+                pthread_once(&keyOnce, createKey);
+                // Any non-null value makes the thread library call the destructor at exit.
+                pthread_setspecific(exitKey, &current);
+            }
+            pthread_mutex_unlock(&registryMutex);
+        }
+
+        void visitThreadSlot(uint32 index, void (*visit)(void *value, void *context), void *context) noexcept {
+            pthread_mutex_lock(&registryMutex);
+            for(auto slots = registry; slots != nullptr; slots = slots->next)
+                if(index < slots->capacity && slots->slots[index].value != nullptr)
+                    visit(slots->slots[index].value, context);
+            pthread_mutex_unlock(&registryMutex);
+        }
+    }
+}
@@ -0,0 +1,170 @@
+#include "hyper/limits.h"
+#include "hyper/TimerWheel.h"
+
+namespace hyper {
+    TimerWheel::Timer::Timer(const Function<void()> &callback) noexcept
+            : Link(), _wheel(nullptr), _expiry(0), _slot(0), _callback(callback) {
+        // ...
+    }
+
+    TimerWheel::Timer::~Timer() noexcept {
+        if(_wheel != nullptr)
+            _wheel->cancel(*this);
+    }
+
+    bool TimerWheel::Timer::isScheduled() const noexcept {
+        return _wheel != nullptr;
+    }
+
+    uint64 TimerWheel::Timer::expiry() const noexcept {
+        return _expiry;
+    }
+
+    TimerWheel::TimerWheel(uint64 start) noexcept
+            : _slots(), _expired(), _occupied(), _now(start), _size(0) {
+        for(auto &slot : _slots)
+            slot.previous = slot.next = &slot;
+        _expired.previous = _expired.next = &_expired;
+    }
+
+    TimerWheel::~TimerWheel() noexcept {
+        // Detach the timers, so they don't try to cancel themselves later.
+        auto release = [](Link &sentinel) {
+            for(auto link = sentinel.next; link != &sentinel;) {
+                auto timer = static_cast<Timer *>(link);
+                link = link->next;
+                timer->previous = timer->next = nullptr;
+                timer->_wheel = nullptr;
+            }
+        };
+        for(auto &slot : _slots)
+            release(slot);
+        release(_expired);
+    }
+
+    void TimerWheel::schedule(Timer &timer, uint64 delay) noexcept {
+        if(timer._wheel != nullptr)
+            timer._wheel->cancel(timer);
+        if(delay == 0)
+            delay = 1;
+        timer._expiry = delay > maxValue<uint64>() - _now ? maxValue<uint64>() : _now + delay;
+        timer._wheel = this;
+        insert(timer);
+        _size++;
+    }
+
+    bool TimerWheel::cancel(Timer &timer) noexcept {
+        if(timer._wheel != this)
+            return false;
+        unlink(timer);
+        timer._wheel = nullptr;
+        _size--;
+        return true;
+    }
+
+    size_t TimerWheel::advance(uint64 ticks) noexcept {
+        return advanceTo(ticks > maxValue<uint64>() - _now ? maxValue<uint64>() : _now + ticks);
+    }
+
+    size_t TimerWheel::advanceTo(uint64 tick) noexcept {
+        // Jump straight from one occupied slot to the next, instead of stepping through every tick.
+        uint64 next;
+        while(tick > _now && nextTick(next) && next <= tick) {
+            _now = next;
+            // Time has just reached the start of a slot in one or more rings.
+            // Timers in those slots move down to the rings below, or expire if they are due now.
+            for(uint32 level = levelCount; level > 0; level--) {
+                const auto index = static_cast<uint32>(_now >> ((level - 1) * slotBits)) & (slotCount - 1);
+                if((_occupied[level - 1] & (uint64(1) << index)) == 0)
+                    continue;
+                auto &sentinel = _slots[(level - 1) * slotCount + index];
+                auto link = sentinel.next;
+                sentinel.previous = sentinel.next = &sentinel;
+                _occupied[level - 1] &= ~(uint64(1) << index);
+                while(link != &sentinel) {
+                    auto timer = static_cast<Timer *>(link);
+                    link = link->next;
+                    insert(*timer);
+                }
+            }
+        }
+        if(tick > _now)
+            _now = tick;
+        return fireExpired();
+    }
+
+    uint64 TimerWheel::now() const noexcept {
+        return _now;
+    }
+
+    bool TimerWheel::nextTick(uint64 &tick) const noexcept {
+        // Rings hold only timers after the current slot in the same span of the ring above,
+        // so the first ring with a later occupied slot has the earliest one.
+        for(uint32 level = 0; level < levelCount; level++) {
+            const uint32 shift = level * slotBits;
+            const auto index = static_cast<uint32>(_now >> shift) & (slotCount - 1);
+            const uint64 later = index + 1 < slotCount ? ~uint64(0) << (index + 1) : 0;
+            const uint64 candidates = _occupied[level] & later;
+            if(candidates == 0)
+                continue;
+            const uint32 parentShift = shift + slotBits;
+            const uint64 base = parentShift < 64 ? (_now >> parentShift) << parentShift : 0;
+            tick = base | (static_cast<uint64>(__builtin_ctzll(candidates)) << shift);
+            return true;
+        }
+        return false;
+    }
+
+    size_t TimerWheel::size() const noexcept {
+        return _size;
+    }
+
+    void TimerWheel::insert(Timer &timer) noexcept {
+        if(timer._expiry <= _now) {
+            link(timer, expiredSlot);
+            return;
+        }
+        // The ring is picked by the highest digit where the expiry differs from the current time.
+        const auto difference = timer._expiry ^ _now;
+        const auto level = static_cast<uint32>(63 - __builtin_clzll(difference)) / slotBits;
+        const auto index = static_cast<uint32>(timer._expiry >> (level * slotBits)) & (slotCount - 1);
+        link(timer, level * slotCount + index);
+        _occupied[level] |= uint64(1) << index;
+    }
+
+    void TimerWheel::link(Timer &timer, uint32 slot) noexcept {
+        // Append to the end, so timers that expire together fire in the order they were scheduled.
+        auto &sentinel = slot == expiredSlot ? _expired : _slots[slot];
+        timer._slot = slot;
+        timer.previous = sentinel.previous;
+        timer.next = &sentinel;
+        sentinel.previous->next = &timer;
+        sentinel.previous = &timer;
+    }
+
+    void TimerWheel::unlink(Timer &timer) noexcept {
+        timer.previous->next = timer.next;
+        timer.next->previous = timer.previous;
+        if(timer._slot != expiredSlot) {
+            auto &sentinel = _slots[timer._slot];
+            if(sentinel.next == &sentinel)
+                _occupied[timer._slot / slotCount] &= ~(uint64(1) << (timer._slot % slotCount));
+        }
+        timer.previous = timer.next = nullptr;
+    }
+
+    size_t TimerWheel::fireExpired() noexcept {
+        size_t fired = 0;
+        while(_expired.next != &_expired) {
+            auto &timer = *static_cast<Timer *>(_expired.next);
+            unlink(timer);
+            timer._wheel = nullptr;
+            _size--;
+            fired++;
+            // Hold a reference to the callback, in case it destroys its own timer.
+            const auto callback = timer._callback;
+            callback();
+        }
+        return fired;
+    }
+}
@@ -0,0 +1,93 @@
+#include <cstdio>      // For snprintf().
+#include <pthread.h>   // For mutexes and condition variables.
+#include "hyper/assert.h"
+#include "hyper/CpuTopology.h"
+#include "hyper/WorkerPool.h"
+
+namespace hyper {
+    struct WorkerPool::State {
+        pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+        pthread_cond_t started = PTHREAD_COND_INITIALIZER;
+        pthread_cond_t finished = PTHREAD_COND_INITIALIZER;
+        const Function<void(size_t)> *job = nullptr;
+        uint64 generation = 0;
+        size_t pending = 0;
+        bool stopping = false;
+    };
+
+    WorkerPool::WorkerPool(size_t workerCount, const char *name) noexcept
+            : _state(new State), _threads(nullptr), _size(workerCount) {
+        CpuTopology topology;
+        if(_size == 0)
+            _size = topology.coreCount();
+        _threads = new Thread[_size];
+        for(size_t i = 0; i < _size; i++) {
+            // Thread names are truncated to what the system allows when the thread starts.
+            char threadName[64];
+            snprintf(threadName, sizeof(threadName), "%s %zu", name, i);
+            // Carry on with the workers that did start if the operating system runs out of threads.
+            if(!_threads[i].start(Function<void()>([this, i]() { work(i); }), threadName)) {
+                _size = i;
+                break;
+            }
+            // Pinning is only a placement hint, so a restricted CPU set isn't worth failing over.
+            const auto cpu = topology.primaryCpu(i % topology.coreCount());
+            _threads[i].setAffinity(&cpu, 1);
+        }
+    }
+
+    WorkerPool::~WorkerPool() noexcept {
+        pthread_mutex_lock(&_state->mutex);
+        _state->stopping = true;
+        pthread_cond_broadcast(&_state->started);
+        pthread_mutex_unlock(&_state->mutex);
+        delete[] _threads;
+        pthread_mutex_destroy(&_state->mutex);
+        pthread_cond_destroy(&_state->started);
+        pthread_cond_destroy(&_state->finished);
+        delete _state;
+    }
+
+    size_t WorkerPool::size() const noexcept {
+        return _size;
+    }
+
+    void WorkerPool::run(const Function<void(size_t)> &job) noexcept {
+        // Without workers the job would never run, so the caller does the work itself.
+        if(_size == 0) {
+            job(0);
+            return;
+        }
+        pthread_mutex_lock(&_state->mutex);
+        ASSERTF(_state->pending == 0, "Attempt to run a job while another is running");
+        _state->job = &job;
+        _state->pending = _size;
+        _state->generation++;
+        pthread_cond_broadcast(&_state->started);
+        while(_state->pending > 0)
+            pthread_cond_wait(&_state->finished, &_state->mutex);
+        _state->job = nullptr;
+        pthread_mutex_unlock(&_state->mutex);
+    }
+
+    void WorkerPool::work(size_t index) noexcept {
+        uint64 seen = 0;
+        pthread_mutex_lock(&_state->mutex);
+        while(true) {
+            while(_state->generation == seen && !_state->stopping)
+                pthread_cond_wait(&_state->started, &_state->mutex);
+            if(_state->stopping)
+                break;
+            seen = _state->generation;
+            const auto job = _state->job;
+            pthread_mutex_unlock(&_state->mutex);
+
+            (*job)(index);
+
+            pthread_mutex_lock(&_state->mutex);
+            if(--_state->pending == 0)
+                pthread_cond_signal(&_state->finished);
+        }
+        pthread_mutex_unlock(&_state->mutex);
+    }
+}
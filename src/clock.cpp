@@ -0,0 +1,153 @@
+#include <cerrno>      // For EINTR.
+#include <pthread.h>   // For pthread_once().
+#include <time.h>      // For clock_gettime() and nanosleep().
+#include "hyper/clock.h"
+#include "hyper/SpinLock.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>   // For __get_cpuid().
+#endif
+
+namespace hyper {
+    namespace detail {
+        ClockScale clockScale = {uint64(1) << 32, 32, false, false};
+    }
+
+    namespace {
+        // Timestamps are converted with 32 fractional bits, which keeps the error far below a nanosecond per second.
+        constexpr uint32 scaleShift = 32;
+
+        // How long to compare the cycle counter against the monotonic clock.
+        // Longer gives a more accurate rate, but delays the first timestamp.
+        constexpr uint64 calibrationTime = 10000000;
+
+        // Limits for how early the frame limiter stops sleeping.
+        constexpr uint64 minSpinMargin = 50000;
+        constexpr uint64 maxSpinMargin = 5000000;
+        constexpr uint64 initialSpinMargin = 1000000;
+
+        // Calibration sleeps, so threads that need the clock meanwhile block on this instead of spinning.
+        pthread_once_t calibrationOnce = PTHREAD_ONCE_INIT;
+
+        bool detectInvariantCounter() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+            // CPUID leaf 0x80000007 reports an invariant TSC in bit 8 of EDX.
+            unsigned eax, ebx, ecx, edx;
+            if(!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+                return false;
+            return (edx & (1u << 8)) != 0;
+#elif defined(__aarch64__)
+            // The generic timer always runs at a fixed frequency.
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        // Reads the counter between two readings of the monotonic clock, pairing it with their midpoint.
+        void sample(uint64 &ticks, uint64 &nanoseconds) noexcept {
+            const auto before = monotonicNow();
+            ticks = detail::readCounter();
+            const auto after = monotonicNow();
+            nanoseconds = before + (after - before) / 2;
+        }
+
+        uint64 measureMultiplier() noexcept {
+#if defined(__aarch64__)
+            // The counter's frequency is published by the system, so there's nothing to measure.
+            uint64 frequency;
+            __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(frequency));
+            if(frequency != 0)
+                return static_cast<uint64>((static_cast<unsigned __int128>(1000000000) << scaleShift) / frequency);
+#endif
+            uint64 startTicks, startTime, endTicks, endTime;
+            sample(startTicks, startTime);
+            sleepFor(calibrationTime);
+            sample(endTicks, endTime);
+            if(endTicks <= startTicks || endTime <= startTime)
+                return 0;
+            return static_cast<uint64>((static_cast<unsigned __int128>(endTime - startTime) << scaleShift)
+                                       / (endTicks - startTicks));
+        }
+
+        void calibrate() noexcept {
+            // Fall back to the monotonic clock, which is already in nanoseconds, if the counter can't be used.
+            uint64 multiplier = detectInvariantCounter() ? measureMultiplier() : 0;
+            detail::clockScale.useCounter = multiplier != 0;
+            detail::clockScale.multiplier = multiplier != 0 ? multiplier : uint64(1) << scaleShift;
+            detail::clockScale.shift = scaleShift;
+            __atomic_store_n(&detail::clockScale.calibrated, true, __ATOMIC_RELEASE);
+        }
+    }
+
+    void detail::calibrateClock() noexcept {
+        pthread_once(&calibrationOnce, calibrate);
+    }
+
+    uint64 monotonicNow() noexcept {
+        timespec time{};
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return static_cast<uint64>(time.tv_sec) * 1000000000ull + static_cast<uint64>(time.tv_nsec);
+    }
+
+    bool hasInvariantTimestamp() noexcept {
+        if(!__atomic_load_n(&detail::clockScale.calibrated, __ATOMIC_ACQUIRE))
+            detail::calibrateClock();
+        return detail::clockScale.useCounter;
+    }
+
+    void sleepFor(uint64 nanoseconds) noexcept {
+        timespec remaining{};
+        remaining.tv_sec = static_cast<time_t>(nanoseconds / 1000000000ull);
+        remaining.tv_nsec = static_cast<long>(nanoseconds % 1000000000ull);
+        // Keep sleeping for whatever is left if a signal interrupts the sleep.
+        while(nanosleep(&remaining, &remaining) != 0 && errno == EINTR)
+            continue;
+    }
+
+    FrameLimiter::FrameLimiter(uint64 period) noexcept
+            : _period(period), _deadline(0), _previous(now()), _spinMargin(initialSpinMargin) {
+        _deadline = _previous + _period;
+    }
+
+    uint64 FrameLimiter::wait() noexcept {
+        const auto current = now();
+        if(current < _deadline) {
+            const auto remaining = _deadline - current;
+            if(remaining > _spinMargin) {
+                const auto request = remaining - _spinMargin;
+                const auto before = now();
+                sleepFor(request);
+                const auto slept = now() - before;
+                const auto overslept = slept > request ? slept - request : 0;
+                // Jump up to cover a long oversleep right away, but only ease back down when sleeps get shorter.
+                auto margin = _spinMargin - _spinMargin / 16;
+                if(overslept + minSpinMargin > margin)
+                    margin = overslept + minSpinMargin;
+                _spinMargin = margin < minSpinMargin ? minSpinMargin : margin > maxSpinMargin ? maxSpinMargin : margin;
+            }
+            while(now() < _deadline)
+                cpuRelax();
+        }
+
+        const auto start = now();
+        _deadline += _period;
+        if(start >= _deadline)
+            _deadline = start + _period;
+        const auto elapsed = start - _previous;
+        _previous = start;
+        return elapsed;
+    }
+
+    void FrameLimiter::setPeriod(uint64 period) noexcept {
+        _period = period;
+    }
+
+    uint64 FrameLimiter::period() const noexcept {
+        return _period;
+    }
+
+    uint64 FrameLimiter::spinMargin() const noexcept {
+        return _spinMargin;
+    }
+}
@@ -0,0 +1,459 @@
+#include "hyper/compression.h"
+#include "hyper/assert.h"
+#include "hyper/scan.h"
+#include "hyper/simd.h"
+
+namespace hyper {
+    namespace {
+        constexpr size_t laneCount  = 4;
+        constexpr size_t laneLength = compressionBlockSize / laneCount;
+
+        /* Packed block layout:
+         *   value i belongs to lane (i % 4) and is the (i / 4)th value packed into that lane.
+         *   Lane l is a little-endian bit stream stored in 32-bit words l, l + 4, l + 8, ...
+         * Unpacking one 128-bit word of each lane at a time yields four consecutive values,
+         * so the unpacked vectors are already in order for the prefix sum. */
+
+#if defined(HYPER_SIMD_AVX2) || defined(HYPER_SIMD_SSE2)
+        struct Lanes {
+            typedef __m128i Vector;
+
+            static Vector load(const byte *p) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+            static void store(uint32 *p, Vector v) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+            static Vector broadcast(uint32 s) noexcept { return _mm_set1_epi32(static_cast<int>(s)); }
+            static Vector shiftRight(Vector v, uint32 s) noexcept { return _mm_srl_epi32(v, _mm_cvtsi32_si128(static_cast<int>(s))); }
+            static Vector shiftLeft(Vector v, uint32 s) noexcept { return _mm_sll_epi32(v, _mm_cvtsi32_si128(static_cast<int>(s))); }
+            static Vector bitOr(Vector a, Vector b) noexcept { return _mm_or_si128(a, b); }
+            static Vector bitAnd(Vector a, Vector b) noexcept { return _mm_and_si128(a, b); }
+            static Vector add(Vector a, Vector b) noexcept { return _mm_add_epi32(a, b); }
+
+            static Vector prefix(Vector v) noexcept {
+                v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+                return _mm_add_epi32(v, _mm_slli_si128(v, 8));
+            }
+
+            static Vector broadcastLast(Vector v) noexcept { return _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3)); }
+        };
+
+#elif defined(HYPER_SIMD_NEON)
+        struct Lanes {
+            typedef uint32x4_t Vector;
+
+            static Vector load(const byte *p) noexcept { return vreinterpretq_u32_u8(vld1q_u8(reinterpret_cast<const uint8 *>(p))); }
+            static void store(uint32 *p, Vector v) noexcept { vst1q_u32(p, v); }
+            static Vector broadcast(uint32 s) noexcept { return vdupq_n_u32(s); }
+            static Vector shiftRight(Vector v, uint32 s) noexcept { return vshlq_u32(v, vdupq_n_s32(-static_cast<int32>(s))); }
+            static Vector shiftLeft(Vector v, uint32 s) noexcept { return vshlq_u32(v, vdupq_n_s32(static_cast<int32>(s))); }
+            static Vector bitOr(Vector a, Vector b) noexcept { return vorrq_u32(a, b); }
+            static Vector bitAnd(Vector a, Vector b) noexcept { return vandq_u32(a, b); }
+            static Vector add(Vector a, Vector b) noexcept { return vaddq_u32(a, b); }
+
+            static Vector prefix(Vector v) noexcept {
+                v = vaddq_u32(v, vextq_u32(vdupq_n_u32(0), v, 3));
+                return vaddq_u32(v, vextq_u32(vdupq_n_u32(0), v, 2));
+            }
+
+            static Vector broadcastLast(Vector v) noexcept { return vdupq_n_u32(vgetq_lane_u32(v, 3)); }
+        };
+
+#else
+        // Portable fallback that processes the four lanes with plain integer operations.
+        struct Lanes {
+            struct Vector {
+                uint32 lane[laneCount];
+            };
+
+            static Vector load(const byte *p) noexcept {
+                Vector v;
+                __builtin_memcpy(v.lane, p, sizeof(v.lane));
+                return v;
+            }
+
+            static void store(uint32 *p, Vector v) noexcept {
+                __builtin_memcpy(p, v.lane, sizeof(v.lane));
+            }
+
+            static Vector broadcast(uint32 s) noexcept {
+                return Vector{{s, s, s, s}};
+            }
+
+            static Vector shiftRight(Vector v, uint32 s) noexcept {
+                for(auto &lane : v.lane)
+                    lane >>= s;
+                return v;
+            }
+
+            static Vector shiftLeft(Vector v, uint32 s) noexcept {
+                for(auto &lane : v.lane)
+                    lane <<= s;
+                return v;
+            }
+
+            static Vector bitOr(Vector a, Vector b) noexcept {
+                for(size_t i = 0; i < laneCount; i++)
+                    a.lane[i] |= b.lane[i];
+                return a;
+            }
+
+            static Vector bitAnd(Vector a, Vector b) noexcept {
+                for(size_t i = 0; i < laneCount; i++)
+                    a.lane[i] &= b.lane[i];
+                return a;
+            }
+
+            static Vector add(Vector a, Vector b) noexcept {
+                for(size_t i = 0; i < laneCount; i++)
+                    a.lane[i] += b.lane[i];
+                return a;
+            }
+
+            static Vector prefix(Vector v) noexcept {
+                for(size_t i = 1; i < laneCount; i++)
+                    v.lane[i] += v.lane[i - 1];
+                return v;
+            }
+
+            static Vector broadcastLast(Vector v) noexcept {
+                return broadcast(v.lane[laneCount - 1]);
+            }
+        };
+#endif
+
+        /// Writes unpacked values as-is.
+        struct StoreSink {
+            uint32 *output;
+
+            void operator()(size_t index, Lanes::Vector values) noexcept {
+                Lanes::store(output + index * laneCount, values);
+            }
+        };
+
+        /// Adds the block's reference value while writing.
+        struct ReferenceSink {
+            uint32 *output;
+            Lanes::Vector reference;
+
+            void operator()(size_t index, Lanes::Vector values) noexcept {
+                Lanes::store(output + index * laneCount, Lanes::add(values, reference));
+            }
+        };
+
+        /// Computes the running sum of unpacked deltas while writing.
+        struct DeltaSink {
+            uint32 *output;
+            Lanes::Vector carry;
+
+            void operator()(size_t index, Lanes::Vector values) noexcept {
+                carry = Lanes::add(Lanes::prefix(values), carry);
+                Lanes::store(output + index * laneCount, carry);
+                carry = Lanes::broadcastLast(carry);
+            }
+        };
+
+        // With the width known at compile time, the loop unrolls and every offset becomes a constant.
+        template<uint32 Bits, typename Sink>
+        inline void unpackBlock(const byte *packed, Sink &sink) noexcept {
+            constexpr uint32 mask = Bits == 32 ? 0xFFFFFFFFu : (1u << (Bits & 31)) - 1;
+            const auto maskVector = Lanes::broadcast(mask);
+            for(uint32 j = 0; j < laneLength; j++) {
+                if constexpr(Bits == 0) {
+                    sink(j, maskVector);
+                } else {
+                    const uint32 offset = j * Bits;
+                    const uint32 word   = offset / 32;
+                    const uint32 shift  = offset % 32;
+                    auto values = Lanes::shiftRight(Lanes::load(packed + word * 16), shift);
+                    if(shift + Bits > 32)
+                        values = Lanes::bitOr(values, Lanes::shiftLeft(Lanes::load(packed + (word + 1) * 16), 32 - shift));
+                    sink(j, Lanes::bitAnd(values, maskVector));
+                }
+            }
+        }
+
+        template<uint32 Bits, typename Sink>
+        inline void unpack(uint32 bits, const byte *packed, Sink &sink) noexcept {
+            if constexpr(Bits <= 32) {
+                if(bits == Bits)
+                    unpackBlock<Bits>(packed, sink);
+                else
+                    unpack<Bits + 1>(bits, packed, sink);
+            }
+        }
+
+        void pack(const uint64 *values, uint32 bits, byte *packed) noexcept {
+            const size_t wordCount = laneCount * bits;
+            uint32 words[laneCount * 32] = {};
+            const uint64 mask = (uint64(1) << bits) - 1;
+            for(size_t i = 0; i < compressionBlockSize; i++) {
+                const auto low    = static_cast<uint32>(values[i] & mask);
+                const auto lane   = i % laneCount;
+                const auto offset = (i / laneCount) * bits;
+                const auto word   = offset / 32;
+                const auto shift  = offset % 32;
+                words[word * laneCount + lane] |= low << shift;
+                if(shift + bits > 32)
+                    words[(word + 1) * laneCount + lane] |= low >> (32 - shift);
+            }
+            __builtin_memcpy(packed, words, wordCount * sizeof(uint32));
+        }
+
+        inline uint32 bitWidth(uint64 value) noexcept {
+            return value == 0 ? 0 : 64 - static_cast<uint32>(__builtin_clzll(value));
+        }
+
+        inline byte *writeVarint(byte *output, uint64 value) noexcept {
+            while(value >= 0x80) {
+                *output++ = byte((value & 0x7F) | 0x80);
+                value >>= 7;
+            }
+            *output++ = byte(value);
+            return output;
+        }
+
+        inline const byte *readVarint(const byte *input, uint64 &value) noexcept {
+            value = 0;
+            for(uint32 shift = 0;; shift += 7) {
+                ASSERTF(shift < 64, "Variable-length integer is too long");
+                const auto next = static_cast<uint64>(*input++);
+                value |= (next & 0x7F) << shift;
+                if((next & 0x80) == 0)
+                    return input;
+            }
+        }
+
+        template<typename T>
+        inline void writeValue(byte *output, T value) noexcept {
+            __builtin_memcpy(output, &value, sizeof(T));
+        }
+
+        template<typename T>
+        inline T readValue(const byte *input) noexcept {
+            T value;
+            __builtin_memcpy(&value, input, sizeof(T));
+            return value;
+        }
+
+        /* Block layout:
+         *   width (1 byte), exception count (1 byte), exception high-part size (1 byte, only with exceptions),
+         *   reference value (frame-of-reference only), packed words (16 bytes per bit of width),
+         *   exception positions (1 byte each), exception high parts (little-endian). */
+
+        template<typename T>
+        byte *encodeBlock(const T *input, IntegerCoding coding, T &previous, byte *output) noexcept {
+            uint64 values[compressionBlockSize];
+            T reference = T();
+            if(coding == IntegerCoding::Delta) {
+                for(size_t i = 0; i < compressionBlockSize; i++) {
+                    values[i] = static_cast<T>(input[i] - previous);
+                    previous  = input[i];
+                }
+            } else {
+                reference = minimum(input, compressionBlockSize);
+                for(size_t i = 0; i < compressionBlockSize; i++)
+                    values[i] = static_cast<T>(input[i] - reference);
+            }
+
+            // Pick the width that minimizes the block size, counting exceptions for values that don't fit.
+            size_t widthCounts[65] = {};
+            uint32 maxWidth = 0;
+            for(auto value : values) {
+                const auto width = bitWidth(value);
+                widthCounts[width]++;
+                maxWidth = width > maxWidth ? width : maxWidth;
+            }
+            uint32 bits = maxWidth < 32 ? maxWidth : 32;
+            size_t exceptions = 0;
+            for(uint32 width = bits + 1; width <= maxWidth; width++)
+                exceptions += widthCounts[width];
+            auto cost = [maxWidth](uint32 width, size_t count) {
+                return 16 * width + (count > 0 ? 1 + count * (1 + (maxWidth - width + 7) / 8) : 0);
+            };
+            size_t bestCost = cost(bits, exceptions);
+            for(uint32 width = bits, excess = static_cast<uint32>(exceptions); width-- > 0;) {
+                excess += static_cast<uint32>(widthCounts[width + 1]);
+                const auto candidate = cost(width, excess);
+                if(candidate < bestCost) {
+                    bestCost   = candidate;
+                    bits       = width;
+                    exceptions = excess;
+                }
+            }
+            const auto highBytes = (maxWidth - bits + 7) / 8;
+
+            *output++ = byte(bits);
+            *output++ = byte(exceptions);
+            if(exceptions > 0)
+                *output++ = byte(highBytes);
+            if(coding == IntegerCoding::FrameOfReference) {
+                writeValue(output, reference);
+                output += sizeof(T);
+            }
+            pack(values, bits, output);
+            output += laneCount * bits * sizeof(uint32);
+
+            if(exceptions > 0) {
+                byte *highs = output + exceptions;
+                for(size_t i = 0; i < compressionBlockSize; i++) {
+                    if(bitWidth(values[i]) > bits) {
+                        *output++ = byte(i);
+                        const auto high = values[i] >> bits;
+                        for(uint32 b = 0; b < highBytes; b++)
+                            *highs++ = byte((high >> (8 * b)) & 0xFF);
+                    }
+                }
+                output = highs;
+            }
+            return output;
+        }
+
+        struct BlockHeader {
+            uint32 bits;
+            size_t exceptions;
+            uint32 highBytes;
+        };
+
+        inline const byte *readBlockHeader(const byte *input, BlockHeader &header) noexcept {
+            header.bits       = static_cast<uint32>(*input++);
+            header.exceptions = static_cast<size_t>(*input++);
+            header.highBytes  = header.exceptions > 0 ? static_cast<uint32>(*input++) : 0;
+            ASSERTF(header.bits <= 32, "Invalid packed width %u", header.bits);
+            ASSERTF(header.exceptions <= compressionBlockSize, "Invalid exception count");
+            return input;
+        }
+
+        template<typename T>
+        inline const byte *applyExceptions(const byte *input, const BlockHeader &header, T *output) noexcept {
+            const byte *highs = input + header.exceptions;
+            for(size_t e = 0; e < header.exceptions; e++) {
+                const auto position = static_cast<size_t>(input[e]);
+                uint64 high = 0;
+                for(uint32 b = 0; b < header.highBytes; b++)
+                    high |= static_cast<uint64>(*highs++) << (8 * b);
+                output[position] |= static_cast<T>(high << header.bits);
+            }
+            return highs;
+        }
+
+        const byte *decodeBlock(const byte *input, IntegerCoding coding, uint32 &previous, uint32 *output) noexcept {
+            BlockHeader header;
+            input = readBlockHeader(input, header);
+            uint32 reference = 0;
+            if(coding == IntegerCoding::FrameOfReference) {
+                reference = readValue<uint32>(input);
+                input += sizeof(uint32);
+            }
+            const byte *packed = input;
+            input += laneCount * header.bits * sizeof(uint32);
+
+            if(header.exceptions == 0) {
+                // Common case: fuse the reference addition or prefix sum into the unpacking.
+                if(coding == IntegerCoding::Delta) {
+                    DeltaSink sink{output, Lanes::broadcast(previous)};
+                    unpack<0>(header.bits, packed, sink);
+                    previous = output[compressionBlockSize - 1];
+                } else {
+                    ReferenceSink sink{output, Lanes::broadcast(reference)};
+                    unpack<0>(header.bits, packed, sink);
+                }
+                return input;
+            }
+
+            StoreSink sink{output};
+            unpack<0>(header.bits, packed, sink);
+            input = applyExceptions(input, header, output);
+            if(coding == IntegerCoding::Delta) {
+                previous = inclusiveScan(output, output, compressionBlockSize, previous);
+            } else {
+                for(size_t i = 0; i < compressionBlockSize; i++)
+                    output[i] += reference;
+            }
+            return input;
+        }
+
+        const byte *decodeBlock(const byte *input, IntegerCoding coding, uint64 &previous, uint64 *output) noexcept {
+            BlockHeader header;
+            input = readBlockHeader(input, header);
+            uint64 reference = 0;
+            if(coding == IntegerCoding::FrameOfReference) {
+                reference = readValue<uint64>(input);
+                input += sizeof(uint64);
+            }
+            uint32 low[compressionBlockSize];
+            StoreSink sink{low};
+            unpack<0>(header.bits, input, sink);
+            input += laneCount * header.bits * sizeof(uint32);
+
+            for(size_t i = 0; i < compressionBlockSize; i++)
+                output[i] = low[i];
+            input = applyExceptions(input, header, output);
+            if(coding == IntegerCoding::Delta) {
+                previous = inclusiveScan(output, output, compressionBlockSize, previous);
+            } else {
+                for(size_t i = 0; i < compressionBlockSize; i++)
+                    output[i] += reference;
+            }
+            return input;
+        }
+    }
+
+    template<typename T>
+    size_t encode(const T *input, size_t count, byte *output, IntegerCoding coding) noexcept {
+        byte *start = output;
+        *output++ = byte(coding);
+        output = writeVarint(output, count);
+
+        T previous = T();
+        size_t i = 0;
+        for(; i + compressionBlockSize <= count; i += compressionBlockSize)
+            output = encodeBlock(input + i, coding, previous, output);
+
+        // The remainder is too short to pack, so it is stored as variable-length integers.
+        for(; i < count; i++) {
+            if(coding == IntegerCoding::Delta) {
+                output   = writeVarint(output, static_cast<T>(input[i] - previous));
+                previous = input[i];
+            } else {
+                output = writeVarint(output, input[i]);
+            }
+        }
+        return static_cast<size_t>(output - start);
+    }
+
+    size_t decodedCount(const byte *input) noexcept {
+        uint64 count;
+        readVarint(input + 1, count);
+        return static_cast<size_t>(count);
+    }
+
+    template<typename T>
+    size_t decode(const byte *input, T *output) noexcept {
+        const byte *start = input;
+        const auto coding = static_cast<IntegerCoding>(*input++);
+        ASSERTF(coding == IntegerCoding::Delta || coding == IntegerCoding::FrameOfReference,
+                "Invalid integer coding %d", toInt(start[0]));
+        uint64 count;
+        input = readVarint(input, count);
+
+        T previous = T();
+        size_t i = 0;
+        for(; i + compressionBlockSize <= count; i += compressionBlockSize)
+            input = decodeBlock(input, coding, previous, output + i);
+
+        for(; i < count; i++) {
+            uint64 value;
+            input = readVarint(input, value);
+            if(coding == IntegerCoding::Delta) {
+                previous  = static_cast<T>(previous + value);
+                output[i] = previous;
+            } else {
+                output[i] = static_cast<T>(value);
+            }
+        }
+        return static_cast<size_t>(input - start);
+    }
+
+    template size_t encode<uint32>(const uint32 *, size_t, byte *, IntegerCoding) noexcept;
+    template size_t encode<uint64>(const uint64 *, size_t, byte *, IntegerCoding) noexcept;
+    template size_t decode<uint32>(const byte *, uint32 *) noexcept;
+    template size_t decode<uint64>(const byte *, uint64 *) noexcept;
+}
@@ -0,0 +1,38 @@
+#include <cerrno>           // For ETIMEDOUT.
+#include <climits>          // For INT_MAX.
+#include <linux/futex.h>    // For FUTEX_WAIT and FUTEX_WAKE.
+#include <sys/syscall.h>    // For SYS_futex.
+#include <time.h>           // For timespec.
+#include <unistd.h>         // For syscall().
+#include "hyper/futex.h"
+
+namespace hyper {
+    namespace {
+        constexpr uint64 nanosecondsPerSecond = 1000000000;
+
+        // Every waiter is in this process, so the kernel can skip looking up shared mappings.
+        long futex(const uint32 *address, int operation, uint32 value, const timespec *timeout) noexcept {
+            return syscall(SYS_futex, address, operation | FUTEX_PRIVATE_FLAG, value, timeout, nullptr, 0);
+        }
+    }
+
+    void futexWait(const uint32 *address, uint32 expected) noexcept {
+        futex(address, FUTEX_WAIT, expected, nullptr);
+    }
+
+    bool futexWaitFor(const uint32 *address, uint32 expected, uint64 nanoseconds) noexcept {
+        // FUTEX_WAIT takes a relative timeout.
+        timespec timeout;
+        timeout.tv_sec = static_cast<time_t>(nanoseconds / nanosecondsPerSecond);
+        timeout.tv_nsec = static_cast<long>(nanoseconds % nanosecondsPerSecond);
+        return futex(address, FUTEX_WAIT, expected, &timeout) == 0 || errno != ETIMEDOUT;
+    }
+
+    void futexWake(const uint32 *address, uint32 count) noexcept {
+        futex(address, FUTEX_WAKE, count, nullptr);
+    }
+
+    void futexWakeAll(const uint32 *address) noexcept {
+        futex(address, FUTEX_WAKE, INT_MAX, nullptr);
+    }
+}
@@ -0,0 +1,82 @@
+#include "hyper/hash.h"
+
+namespace hyper {
+    namespace {
+        constexpr uint64 secret[4] = {
+                0x2D358DCCAA6C78A5ull, 0x8BB84B93962EACC9ull, 0x4B33A62ED433D4A3ull, 0x4D5A2DA51DE1AA47ull
+        };
+
+        inline void multiply(uint64 &low, uint64 &high) noexcept {
+            const auto product = static_cast<unsigned __int128>(low) * high;
+            low  = static_cast<uint64>(product);
+            high = static_cast<uint64>(product >> 64);
+        }
+
+        inline uint64 mix(uint64 a, uint64 b) noexcept {
+            multiply(a, b);
+            return a ^ b;
+        }
+
+        inline uint64 read64(const byte *p) noexcept {
+            uint64 value;
+            __builtin_memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        inline uint64 read32(const byte *p) noexcept {
+            uint32 value;
+            __builtin_memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        // Reads one to three bytes.
+        inline uint64 readSmall(const byte *p, size_t size) noexcept {
+            return (static_cast<uint64>(p[0]) << 16) | (static_cast<uint64>(p[size >> 1]) << 8)
+                   | static_cast<uint64>(p[size - 1]);
+        }
+    }
+
+    uint64 hash(const byte *data, size_t size, uint64 seed) noexcept {
+        seed ^= mix(seed ^ secret[0], secret[1]);
+        uint64 a, b;
+        if(size <= 16) {
+            if(size >= 4) {
+                // Two overlapping pairs of 4-byte reads cover every byte.
+                const size_t offset = (size >> 3) << 2;
+                a = (read32(data) << 32) | read32(data + offset);
+                b = (read32(data + size - 4) << 32) | read32(data + size - 4 - offset);
+            } else if(size > 0) {
+                a = readSmall(data, size);
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            const byte *p = data;
+            size_t remaining = size;
+            if(remaining > 48) {
+                // Three independent lanes keep the multipliers busy.
+                uint64 lane1 = seed, lane2 = seed;
+                do {
+                    seed  = mix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+                    lane1 = mix(read64(p + 16) ^ secret[2], read64(p + 24) ^ lane1);
+                    lane2 = mix(read64(p + 32) ^ secret[3], read64(p + 40) ^ lane2);
+                    p += 48;
+                    remaining -= 48;
+                } while(remaining > 48);
+                seed ^= lane1 ^ lane2;
+            }
+            while(remaining > 16) {
+                seed = mix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+                p += 16;
+                remaining -= 16;
+            }
+            a = read64(p + remaining - 16);
+            b = read64(p + remaining - 8);
+        }
+        a ^= secret[1];
+        b ^= seed;
+        multiply(a, b);
+        return mix(a ^ secret[0] ^ size, b ^ secret[1]);
+    }
+}
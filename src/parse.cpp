@@ -0,0 +1,173 @@
+#include <cstdio>    // For snprintf().
+#include <cstdlib>   // For strtod().
+#include "hyper/parse.h"
+
+namespace hyper {
+    namespace {
+        /// @brief Powers of ten that doubles represent exactly.
+        constexpr float64 exactPowers[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        /// @brief Most significant digits passed to @c strtod().
+        constexpr size_t maxDigits = 200;
+
+        bool isDigit(char value) noexcept {
+            return value >= '0' && value <= '9';
+        }
+
+        bool parseMagnitude(const char *text, size_t size, bool &negative, uint64 &magnitude) noexcept {
+            size_t i = 0;
+            negative = false;
+            if(size > 0 && (text[0] == '+' || text[0] == '-')) {
+                negative = text[0] == '-';
+                i++;
+            }
+            if(i == size)
+                return false;
+            uint64 result = 0;
+            for(; i < size; i++) {
+                if(!isDigit(text[i]))
+                    return false;
+                if(__builtin_mul_overflow(result, 10, &result)
+                        || __builtin_add_overflow(result, static_cast<uint64>(text[i] - '0'), &result))
+                    return false;
+            }
+            magnitude = result;
+            return true;
+        }
+
+        // Rewrites the number as its significant digits and an exponent, so strtod() gets
+        // a bounded, null-terminated copy. Digits past the limit are replaced by a single 1 if any of them
+        // are nonzero, which keeps the number on the same side of a rounding halfway point.
+        bool parseSlow(const char *mantissa, const char *mantissaEnd, bool negative, int64 exponent,
+                float64 &value) noexcept {
+            char buffer[maxDigits + 32];
+            size_t length = 0;
+            if(negative)
+                buffer[length++] = '-';
+            size_t kept = 0;
+            bool sticky = false;
+            bool fraction = false;
+            for(const char *digit = mantissa; digit < mantissaEnd; digit++) {
+                if(*digit == '.') {
+                    fraction = true;
+                    continue;
+                }
+                if(fraction)
+                    exponent--;
+                if(kept == 0 && *digit == '0')
+                    continue;
+                if(kept < maxDigits) {
+                    buffer[length++] = *digit;
+                    kept++;
+                } else {
+                    exponent++;
+                    sticky = sticky || *digit != '0';
+                }
+            }
+            if(sticky) {
+                buffer[length++] = '1';
+                exponent--;
+            }
+            exponent = exponent < -1000000 ? -1000000 : exponent > 1000000 ? 1000000 : exponent;
+            snprintf(buffer + length, sizeof(buffer) - length, "e%lld", static_cast<long long>(exponent));
+            const float64 result = strtod(buffer, nullptr);
+            if(result == infinity<float64>() || result == negativeInfinity<float64>())
+                return false;
+            value = result;
+            return true;
+        }
+    }
+
+    bool parseInt64(const char *text, size_t size, int64 &value) noexcept {
+        bool negative;
+        uint64 magnitude;
+        if(!parseMagnitude(text, size, negative, magnitude))
+            return false;
+        const auto limit = static_cast<uint64>(maxValue<int64>());
+        if(magnitude > limit + (negative ? 1 : 0))
+            return false;
+        value = negative ? static_cast<int64>(0 - magnitude) : static_cast<int64>(magnitude);
+        return true;
+    }
+
+    bool parseUInt64(const char *text, size_t size, uint64 &value) noexcept {
+        bool negative;
+        uint64 magnitude;
+        if(!parseMagnitude(text, size, negative, magnitude) || (negative && magnitude != 0))
+            return false;
+        value = magnitude;
+        return true;
+    }
+
+    bool parseFloat64(const char *text, size_t size, float64 &value) noexcept {
+        size_t i = 0;
+        bool negative = false;
+        if(size > 0 && (text[0] == '+' || text[0] == '-')) {
+            negative = text[0] == '-';
+            i++;
+        }
+
+        // Keep the first 19 significant digits, which always fit in 64 bits.
+        const char *mantissaStart = text + i;
+        uint64 mantissa = 0;
+        size_t significant = 0;
+        size_t digits = 0;
+        int64 exponent = 0;
+        bool truncated = false;
+        bool fraction = false;
+        for(; i < size; i++) {
+            if(text[i] == '.' && !fraction) {
+                fraction = true;
+                continue;
+            }
+            if(!isDigit(text[i]))
+                break;
+            const auto digit = static_cast<uint64>(text[i] - '0');
+            digits++;
+            if(significant < 19) {
+                mantissa = mantissa * 10 + digit;
+                significant += mantissa != 0 ? 1 : 0;
+                exponent -= fraction ? 1 : 0;
+            } else {
+                exponent += fraction ? 0 : 1;
+                truncated = truncated || digit != 0;
+            }
+        }
+        if(digits == 0)
+            return false;
+        const char *mantissaEnd = text + i;
+
+        int64 explicitExponent = 0;
+        if(i < size && (text[i] | 0x20) == 'e') {
+            i++;
+            const bool negativeExponent = i < size && text[i] == '-';
+            if(i < size && (text[i] == '+' || text[i] == '-'))
+                i++;
+            if(i == size || !isDigit(text[i]))
+                return false;
+            for(; i < size && isDigit(text[i]); i++) {
+                if(explicitExponent < 100000)
+                    explicitExponent = explicitExponent * 10 + (text[i] - '0');
+            }
+            explicitExponent = negativeExponent ? -explicitExponent : explicitExponent;
+        }
+        if(i != size)
+            return false;
+
+        if(mantissa == 0 && !truncated) {
+            value = negative ? -0.0 : 0.0;
+            return true;
+        }
+        exponent += explicitExponent;
+        if(!truncated && mantissa <= (static_cast<uint64>(1) << 53) && exponent >= -22 && exponent <= 22) {
+            const auto magnitude = static_cast<float64>(mantissa);
+            const float64 result = exponent < 0 ? magnitude / exactPowers[-exponent] : magnitude * exactPowers[exponent];
+            value = negative ? -result : result;
+            return true;
+        }
+        return parseSlow(mantissaStart, mantissaEnd, negative, explicitExponent, value);
+    }
+}
@@ -0,0 +1,727 @@
+#include "hyper/scan.h"
+#include "hyper/simd.h"
+#include "hyper/WorkerPool.h"
+
+namespace hyper {
+    namespace {
+        /// @brief Identity values for the min and max reductions.
+        template<typename T>
+        struct Bounds {
+            static T lowest() noexcept {
+                return minValue<T>();
+            }
+
+            static T highest() noexcept {
+                return maxValue<T>();
+            }
+        };
+
+        template<>
+        struct Bounds<float32> {
+            static float32 lowest() noexcept {
+                return negativeInfinity<float32>();
+            }
+
+            static float32 highest() noexcept {
+                return infinity<float32>();
+            }
+        };
+
+        template<>
+        struct Bounds<float64> {
+            static float64 lowest() noexcept {
+                return negativeInfinity<float64>();
+            }
+
+            static float64 highest() noexcept {
+                return infinity<float64>();
+            }
+        };
+
+        /// @brief Type that values are added as.
+        /// @details Signed integers are added as unsigned so that overflow wraps, like it does in the vector kernels,
+        ///   instead of being undefined.
+        template<typename T>
+        struct Accumulator {
+            typedef T Type;
+        };
+
+        template<>
+        struct Accumulator<int32> {
+            typedef uint32 Type;
+        };
+
+        template<>
+        struct Accumulator<int64> {
+            typedef uint64 Type;
+        };
+
+        template<typename T>
+        T wrappingAdd(T first, T second) noexcept {
+            typedef typename Accumulator<T>::Type Type;
+            return static_cast<T>(static_cast<Type>(first) + static_cast<Type>(second));
+        }
+
+        template<typename T>
+        T scalarInclusiveScan(const T *input, T *output, size_t count, T total) noexcept {
+            for(size_t i = 0; i < count; i++) {
+                total = wrappingAdd(total, input[i]);
+                output[i] = total;
+            }
+            return total;
+        }
+
+        template<typename T>
+        T scalarExclusiveScan(const T *input, T *output, size_t count, T total) noexcept {
+            for(size_t i = 0; i < count; i++) {
+                const T value = input[i];
+                output[i] = total;
+                total = wrappingAdd(total, value);
+            }
+            return total;
+        }
+
+        // Four independent accumulators break the loop-carried dependency,
+        // which lets the compiler pipeline (and often vectorize) the loops.
+        template<typename T>
+        T scalarSum(const T *input, size_t count, T total) noexcept {
+            T partial[4] = {T(), T(), T(), T()};
+            size_t i = 0;
+            for(; i + 4 <= count; i += 4) {
+                partial[0] = wrappingAdd(partial[0], input[i]);
+                partial[1] = wrappingAdd(partial[1], input[i + 1]);
+                partial[2] = wrappingAdd(partial[2], input[i + 2]);
+                partial[3] = wrappingAdd(partial[3], input[i + 3]);
+            }
+            for(; i < count; i++)
+                total = wrappingAdd(total, input[i]);
+            return wrappingAdd(total, wrappingAdd(wrappingAdd(partial[0], partial[1]), wrappingAdd(partial[2], partial[3])));
+        }
+
+        template<typename T>
+        T scalarMinimum(const T *input, size_t count, T result) noexcept {
+            for(size_t i = 0; i < count; i++)
+                result = input[i] < result ? input[i] : result;
+            return result;
+        }
+
+        template<typename T>
+        T scalarMaximum(const T *input, size_t count, T result) noexcept {
+            for(size_t i = 0; i < count; i++)
+                result = result < input[i] ? input[i] : result;
+            return result;
+        }
+
+        template<typename T>
+        size_t scalarCompact(const T *input, const bool *keep, T *output, size_t count, size_t written) noexcept {
+            for(size_t i = 0; i < count; i++) {
+                output[written] = input[i];
+                written += keep[i] ? 1 : 0;
+            }
+            return written;
+        }
+
+        /* Each instruction set provides a lane descriptor with the same static interface:
+         *   Scalar, Vector, width,
+         *   load(), store(), broadcast(), add(), min(), max(),
+         *   prefix()    - inclusive scan within a single vector,
+         *   shiftUp()   - moves every lane up by one and inserts zero in the first lane,
+         *   broadcastLast() - copies the last lane to every lane.
+         * The generic algorithms below are written once against this interface. */
+
+#if defined(HYPER_SIMD_AVX2)
+        struct Int32Lanes {
+            typedef int32 Scalar;
+            typedef __m256i Vector;
+            static constexpr size_t width = 8;
+
+            static Vector load(const Scalar *p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+            static void store(Scalar *p, Vector v) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+            static Vector broadcast(Scalar s) noexcept { return _mm256_set1_epi32(s); }
+            static Vector add(Vector a, Vector b) noexcept { return _mm256_add_epi32(a, b); }
+            static Vector min(Vector a, Vector b) noexcept { return _mm256_min_epi32(a, b); }
+            static Vector max(Vector a, Vector b) noexcept { return _mm256_max_epi32(a, b); }
+
+            static Vector prefix(Vector v) noexcept {
+                v = _mm256_add_epi32(v, _mm256_slli_si256(v, 4));
+                v = _mm256_add_epi32(v, _mm256_slli_si256(v, 8));
+                // Carry the last lane of the low half into every lane of the high half.
+                const Vector low = _mm256_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3));
+                return _mm256_add_epi32(v, _mm256_permute2x128_si256(low, low, 0x08));
+            }
+
+            static Vector shiftUp(Vector v) noexcept {
+                const Vector shifted = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6));
+                return _mm256_blend_epi32(shifted, _mm256_setzero_si256(), 0x01);
+            }
+
+            static Vector broadcastLast(Vector v) noexcept {
+                return _mm256_permutevar8x32_epi32(v, _mm256_set1_epi32(7));
+            }
+        };
+
+        struct UInt32Lanes : Int32Lanes {
+            typedef uint32 Scalar;
+
+            static Vector load(const Scalar *p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+            static void store(Scalar *p, Vector v) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+            static Vector broadcast(Scalar s) noexcept { return _mm256_set1_epi32(static_cast<int>(s)); }
+            static Vector min(Vector a, Vector b) noexcept { return _mm256_min_epu32(a, b); }
+            static Vector max(Vector a, Vector b) noexcept { return _mm256_max_epu32(a, b); }
+        };
+
+        struct Float32Lanes {
+            typedef float32 Scalar;
+            typedef __m256 Vector;
+            static constexpr size_t width = 8;
+
+            static Vector load(const Scalar *p) noexcept { return _mm256_loadu_ps(p); }
+            static void store(Scalar *p, Vector v) noexcept { _mm256_storeu_ps(p, v); }
+            static Vector broadcast(Scalar s) noexcept { return _mm256_set1_ps(s); }
+            static Vector add(Vector a, Vector b) noexcept { return _mm256_add_ps(a, b); }
+            static Vector min(Vector a, Vector b) noexcept { return _mm256_min_ps(a, b); }
+            static Vector max(Vector a, Vector b) noexcept { return _mm256_max_ps(a, b); }
+
+            static Vector prefix(Vector v) noexcept {
+                v = _mm256_add_ps(v, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(v), 4)));
+                v = _mm256_add_ps(v, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(v), 8)));
+                const Vector low = _mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3));
+                return _mm256_add_ps(v, _mm256_permute2f128_ps(low, low, 0x08));
+            }
+
+            static Vector shiftUp(Vector v) noexcept {
+                const Vector shifted = _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6));
+                return _mm256_blend_ps(shifted, _mm256_setzero_ps(), 0x01);
+            }
+
+            static Vector broadcastLast(Vector v) noexcept {
+                return _mm256_permutevar8x32_ps(v, _mm256_set1_epi32(7));
+            }
+        };
+
+        // Shuffle control for packing the kept lanes of eight 32-bit values to the front of a vector.
+        // Entry m holds the source lane indices for keep mask m, packed as 4-bit nibbles.
+        struct CompactTable {
+            uint32 entries[256];
+
+            constexpr CompactTable() noexcept
+                    : entries() {
+                for(uint32 mask = 0; mask < 256; mask++) {
+                    uint32 packed = 0;
+                    uint32 next   = 0;
+                    for(uint32 lane = 0; lane < 8; lane++) {
+                        if(mask & (1u << lane)) {
+                            packed |= lane << (next * 4);
+                            next++;
+                        }
+                    }
+                    entries[mask] = packed;
+                }
+            }
+        };
+
+        constexpr CompactTable compactTable;
+
+        size_t compact32(const uint32 *input, const bool *keep, uint32 *output, size_t count) noexcept {
+            const __m256i shifts = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+            size_t written = 0;
+            size_t i = 0;
+            for(; i + 8 <= count; i += 8) {
+                // Gather the eight flag bytes, each zero or one, into the bits of an 8-bit mask.
+                uint64 flags;
+                __builtin_memcpy(&flags, keep + i, sizeof(flags));
+                const auto mask = static_cast<uint32>((flags * 0x0102040810204080ull) >> 56);
+                const __m256i indices = _mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(compactTable.entries[mask])), shifts);
+                const __m256i values  = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(output + written),
+                        _mm256_permutevar8x32_epi32(values, indices));
+                written += static_cast<size_t>(__builtin_popcount(mask));
+            }
+            return scalarCompact(input + i, keep + i, output, count - i, written);
+        }
+
+#elif defined(HYPER_SIMD_SSE2)
+        struct Int32Lanes {
+            typedef int32 Scalar;
+            typedef __m128i Vector;
+            static constexpr size_t width = 4;
+
+            static Vector load(const Scalar *p) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+            static void store(Scalar *p, Vector v) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+            static Vector broadcast(Scalar s) noexcept { return _mm_set1_epi32(s); }
+            static Vector add(Vector a, Vector b) noexcept { return _mm_add_epi32(a, b); }
+
+            // SSE2 has no 32-bit min/max, so select with a comparison mask instead.
+            static Vector select(Vector mask, Vector a, Vector b) noexcept {
+                return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+            }
+
+            static Vector min(Vector a, Vector b) noexcept { return select(_mm_cmplt_epi32(a, b), a, b); }
+            static Vector max(Vector a, Vector b) noexcept { return select(_mm_cmpgt_epi32(a, b), a, b); }
+
+            static Vector prefix(Vector v) noexcept {
+                v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+                return _mm_add_epi32(v, _mm_slli_si128(v, 8));
+            }
+
+            static Vector shiftUp(Vector v) noexcept { return _mm_slli_si128(v, 4); }
+            static Vector broadcastLast(Vector v) noexcept { return _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3)); }
+        };
+
+        struct UInt32Lanes : Int32Lanes {
+            typedef uint32 Scalar;
+
+            static Vector load(const Scalar *p) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+            static void store(Scalar *p, Vector v) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+            static Vector broadcast(Scalar s) noexcept { return _mm_set1_epi32(static_cast<int>(s)); }
+
+            // Flipping the sign bit maps unsigned order onto signed order.
+            static Vector min(Vector a, Vector b) noexcept {
+                const Vector sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+                return select(_mm_cmplt_epi32(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign)), a, b);
+            }
+
+            static Vector max(Vector a, Vector b) noexcept {
+                const Vector sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+                return select(_mm_cmpgt_epi32(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign)), a, b);
+            }
+        };
+
+        struct Float32Lanes {
+            typedef float32 Scalar;
+            typedef __m128 Vector;
+            static constexpr size_t width = 4;
+
+            static Vector load(const Scalar *p) noexcept { return _mm_loadu_ps(p); }
+            static void store(Scalar *p, Vector v) noexcept { _mm_storeu_ps(p, v); }
+            static Vector broadcast(Scalar s) noexcept { return _mm_set1_ps(s); }
+            static Vector add(Vector a, Vector b) noexcept { return _mm_add_ps(a, b); }
+            static Vector min(Vector a, Vector b) noexcept { return _mm_min_ps(a, b); }
+            static Vector max(Vector a, Vector b) noexcept { return _mm_max_ps(a, b); }
+
+            static Vector prefix(Vector v) noexcept {
+                v = _mm_add_ps(v, shiftUp(v));
+                return _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 8)));
+            }
+
+            static Vector shiftUp(Vector v) noexcept { return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)); }
+            static Vector broadcastLast(Vector v) noexcept { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)); }
+        };
+
+#elif defined(HYPER_SIMD_NEON)
+        struct Int32Lanes {
+            typedef int32 Scalar;
+            typedef int32x4_t Vector;
+            static constexpr size_t width = 4;
+
+            static Vector load(const Scalar *p) noexcept { return vld1q_s32(p); }
+            static void store(Scalar *p, Vector v) noexcept { vst1q_s32(p, v); }
+            static Vector broadcast(Scalar s) noexcept { return vdupq_n_s32(s); }
+            static Vector add(Vector a, Vector b) noexcept { return vaddq_s32(a, b); }
+            static Vector min(Vector a, Vector b) noexcept { return vminq_s32(a, b); }
+            static Vector max(Vector a, Vector b) noexcept { return vmaxq_s32(a, b); }
+
+            static Vector prefix(Vector v) noexcept {
+                v = vaddq_s32(v, vextq_s32(vdupq_n_s32(0), v, 3));
+                return vaddq_s32(v, vextq_s32(vdupq_n_s32(0), v, 2));
+            }
+
+            static Vector shiftUp(Vector v) noexcept { return vextq_s32(vdupq_n_s32(0), v, 3); }
+            static Vector broadcastLast(Vector v) noexcept { return vdupq_n_s32(vgetq_lane_s32(v, 3)); }
+        };
+
+        struct UInt32Lanes {
+            typedef uint32 Scalar;
+            typedef uint32x4_t Vector;
+            static constexpr size_t width = 4;
+
+            static Vector load(const Scalar *p) noexcept { return vld1q_u32(p); }
+            static void store(Scalar *p, Vector v) noexcept { vst1q_u32(p, v); }
+            static Vector broadcast(Scalar s) noexcept { return vdupq_n_u32(s); }
+            static Vector add(Vector a, Vector b) noexcept { return vaddq_u32(a, b); }
+            static Vector min(Vector a, Vector b) noexcept { return vminq_u32(a, b); }
+            static Vector max(Vector a, Vector b) noexcept { return vmaxq_u32(a, b); }
+
+            static Vector prefix(Vector v) noexcept {
+                v = vaddq_u32(v, vextq_u32(vdupq_n_u32(0), v, 3));
+                return vaddq_u32(v, vextq_u32(vdupq_n_u32(0), v, 2));
+            }
+
+            static Vector shiftUp(Vector v) noexcept { return vextq_u32(vdupq_n_u32(0), v, 3); }
+            static Vector broadcastLast(Vector v) noexcept { return vdupq_n_u32(vgetq_lane_u32(v, 3)); }
+        };
+
+        struct Float32Lanes {
+            typedef float32 Scalar;
+            typedef float32x4_t Vector;
+            static constexpr size_t width = 4;
+
+            static Vector load(const Scalar *p) noexcept { return vld1q_f32(p); }
+            static void store(Scalar *p, Vector v) noexcept { vst1q_f32(p, v); }
+            static Vector broadcast(Scalar s) noexcept { return vdupq_n_f32(s); }
+            static Vector add(Vector a, Vector b) noexcept { return vaddq_f32(a, b); }
+            static Vector min(Vector a, Vector b) noexcept { return vminq_f32(a, b); }
+            static Vector max(Vector a, Vector b) noexcept { return vmaxq_f32(a, b); }
+
+            static Vector prefix(Vector v) noexcept {
+                v = vaddq_f32(v, vextq_f32(vdupq_n_f32(0), v, 3));
+                return vaddq_f32(v, vextq_f32(vdupq_n_f32(0), v, 2));
+            }
+
+            static Vector shiftUp(Vector v) noexcept { return vextq_f32(vdupq_n_f32(0), v, 3); }
+            static Vector broadcastLast(Vector v) noexcept { return vdupq_n_f32(vgetq_lane_f32(v, 3)); }
+        };
+
+        // Byte shuffle control for packing the kept lanes of four 32-bit values to the front of a vector.
+        struct CompactTable {
+            uint8 entries[16][16];
+
+            constexpr CompactTable() noexcept
+                    : entries() {
+                for(uint32 mask = 0; mask < 16; mask++) {
+                    uint32 next = 0;
+                    for(uint32 lane = 0; lane < 4; lane++) {
+                        if(mask & (1u << lane)) {
+                            for(uint32 b = 0; b < 4; b++)
+                                entries[mask][next * 4 + b] = static_cast<uint8>(lane * 4 + b);
+                            next++;
+                        }
+                    }
+                    // Unused lanes read from the first lane; they are overwritten by the next store.
+                    for(; next < 4; next++)
+                        for(uint32 b = 0; b < 4; b++)
+                            entries[mask][next * 4 + b] = static_cast<uint8>(b);
+                }
+            }
+        };
+
+        constexpr CompactTable compactTable;
+
+        size_t compact32(const uint32 *input, const bool *keep, uint32 *output, size_t count) noexcept {
+            size_t written = 0;
+            size_t i = 0;
+            for(; i + 4 <= count; i += 4) {
+                const uint32 mask = (keep[i] ? 1u : 0u) | (keep[i + 1] ? 2u : 0u)
+                        | (keep[i + 2] ? 4u : 0u) | (keep[i + 3] ? 8u : 0u);
+                const uint8x16_t values = vreinterpretq_u8_u32(vld1q_u32(input + i));
+                vst1q_u32(output + written, vreinterpretq_u32_u8(vqtbl1q_u8(values, vld1q_u8(compactTable.entries[mask]))));
+                written += static_cast<size_t>(__builtin_popcount(mask));
+            }
+            return scalarCompact(input + i, keep + i, output, count - i, written);
+        }
+#endif
+
+#if !defined(HYPER_SIMD_NONE)
+        template<typename Lanes>
+        typename Lanes::Scalar vectorInclusiveScan(const typename Lanes::Scalar *input, typename Lanes::Scalar *output,
+                                                   size_t count, typename Lanes::Scalar initial) noexcept {
+            auto carry = Lanes::broadcast(initial);
+            size_t i = 0;
+            for(; i + Lanes::width <= count; i += Lanes::width) {
+                const auto scanned = Lanes::add(Lanes::prefix(Lanes::load(input + i)), carry);
+                Lanes::store(output + i, scanned);
+                carry = Lanes::broadcastLast(scanned);
+            }
+            typename Lanes::Scalar lanes[Lanes::width];
+            Lanes::store(lanes, carry);
+            return scalarInclusiveScan(input + i, output + i, count - i, lanes[0]);
+        }
+
+        template<typename Lanes>
+        typename Lanes::Scalar vectorExclusiveScan(const typename Lanes::Scalar *input, typename Lanes::Scalar *output,
+                                                   size_t count, typename Lanes::Scalar initial) noexcept {
+            auto carry = Lanes::broadcast(initial);
+            size_t i = 0;
+            for(; i + Lanes::width <= count; i += Lanes::width) {
+                const auto scanned = Lanes::prefix(Lanes::load(input + i));
+                Lanes::store(output + i, Lanes::add(Lanes::shiftUp(scanned), carry));
+                carry = Lanes::broadcastLast(Lanes::add(scanned, carry));
+            }
+            typename Lanes::Scalar lanes[Lanes::width];
+            Lanes::store(lanes, carry);
+            return scalarExclusiveScan(input + i, output + i, count - i, lanes[0]);
+        }
+
+        // Applies a lane-wise operation across two accumulators, then folds the lanes together.
+        template<typename Lanes, typename Operation, typename Fold>
+        typename Lanes::Scalar vectorReduce(const typename Lanes::Scalar *input, size_t count,
+                                            typename Lanes::Scalar identity, Operation operation, Fold fold) noexcept {
+            auto first  = Lanes::broadcast(identity);
+            auto second = first;
+            size_t i = 0;
+            for(; i + 2 * Lanes::width <= count; i += 2 * Lanes::width) {
+                first  = operation(first, Lanes::load(input + i));
+                second = operation(second, Lanes::load(input + i + Lanes::width));
+            }
+            if(i + Lanes::width <= count) {
+                first = operation(first, Lanes::load(input + i));
+                i += Lanes::width;
+            }
+            typename Lanes::Scalar lanes[Lanes::width];
+            Lanes::store(lanes, operation(first, second));
+            auto result = fold(input + i, count - i, identity);
+            for(size_t lane = 0; lane < Lanes::width; lane++)
+                result = fold(&lanes[lane], 1, result);
+            return result;
+        }
+
+        template<typename Lanes>
+        typename Lanes::Scalar vectorSum(const typename Lanes::Scalar *input, size_t count) noexcept {
+            typedef typename Lanes::Scalar Scalar;
+            return vectorReduce<Lanes>(input, count, Scalar(),
+                    [](typename Lanes::Vector a, typename Lanes::Vector b) { return Lanes::add(a, b); },
+                    [](const Scalar *values, size_t n, Scalar total) { return scalarSum(values, n, total); });
+        }
+
+        template<typename Lanes>
+        typename Lanes::Scalar vectorMinimum(const typename Lanes::Scalar *input, size_t count) noexcept {
+            typedef typename Lanes::Scalar Scalar;
+            return vectorReduce<Lanes>(input, count, Bounds<Scalar>::highest(),
+                    [](typename Lanes::Vector a, typename Lanes::Vector b) { return Lanes::min(a, b); },
+                    [](const Scalar *values, size_t n, Scalar result) { return scalarMinimum(values, n, result); });
+        }
+
+        template<typename Lanes>
+        typename Lanes::Scalar vectorMaximum(const typename Lanes::Scalar *input, size_t count) noexcept {
+            typedef typename Lanes::Scalar Scalar;
+            return vectorReduce<Lanes>(input, count, Bounds<Scalar>::lowest(),
+                    [](typename Lanes::Vector a, typename Lanes::Vector b) { return Lanes::max(a, b); },
+                    [](const Scalar *values, size_t n, Scalar result) { return scalarMaximum(values, n, result); });
+        }
+#endif
+
+        /* Kernel selection.
+         * The generic templates are used for types without a vector implementation,
+         * and the non-template overloads take priority for types that have one. */
+
+        template<typename T>
+        T inclusiveScanKernel(const T *input, T *output, size_t count, T initial) noexcept {
+            return scalarInclusiveScan(input, output, count, initial);
+        }
+
+        template<typename T>
+        T exclusiveScanKernel(const T *input, T *output, size_t count, T initial) noexcept {
+            return scalarExclusiveScan(input, output, count, initial);
+        }
+
+        template<typename T>
+        T sumKernel(const T *input, size_t count) noexcept {
+            return scalarSum(input, count, T());
+        }
+
+        template<typename T>
+        T minimumKernel(const T *input, size_t count) noexcept {
+            return scalarMinimum(input, count, Bounds<T>::highest());
+        }
+
+        template<typename T>
+        T maximumKernel(const T *input, size_t count) noexcept {
+            return scalarMaximum(input, count, Bounds<T>::lowest());
+        }
+
+        template<typename T>
+        size_t compactKernel(const T *input, const bool *keep, T *output, size_t count) noexcept {
+            return scalarCompact(input, keep, output, count, 0);
+        }
+
+#if !defined(HYPER_SIMD_NONE)
+#define HYPER_SCAN_VECTOR_KERNELS(Type, Lanes) \
+        Type inclusiveScanKernel(const Type *input, Type *output, size_t count, Type initial) noexcept { \
+            return vectorInclusiveScan<Lanes>(input, output, count, initial); \
+        } \
+        Type exclusiveScanKernel(const Type *input, Type *output, size_t count, Type initial) noexcept { \
+            return vectorExclusiveScan<Lanes>(input, output, count, initial); \
+        } \
+        Type sumKernel(const Type *input, size_t count) noexcept { \
+            return vectorSum<Lanes>(input, count); \
+        } \
+        Type minimumKernel(const Type *input, size_t count) noexcept { \
+            return vectorMinimum<Lanes>(input, count); \
+        } \
+        Type maximumKernel(const Type *input, size_t count) noexcept { \
+            return vectorMaximum<Lanes>(input, count); \
+        }
+
+        HYPER_SCAN_VECTOR_KERNELS(int32, Int32Lanes)
+        HYPER_SCAN_VECTOR_KERNELS(uint32, UInt32Lanes)
+        HYPER_SCAN_VECTOR_KERNELS(float32, Float32Lanes)
+#undef HYPER_SCAN_VECTOR_KERNELS
+#endif
+
+#if defined(HYPER_SIMD_AVX2) || defined(HYPER_SIMD_NEON)
+        // Compaction only moves bits, so every 32-bit type shares the same kernel.
+        size_t compactKernel(const int32 *input, const bool *keep, int32 *output, size_t count) noexcept {
+            return compact32(reinterpret_cast<const uint32 *>(input), keep, reinterpret_cast<uint32 *>(output), count);
+        }
+
+        size_t compactKernel(const uint32 *input, const bool *keep, uint32 *output, size_t count) noexcept {
+            return compact32(input, keep, output, count);
+        }
+
+        size_t compactKernel(const float32 *input, const bool *keep, float32 *output, size_t count) noexcept {
+            return compact32(reinterpret_cast<const uint32 *>(input), keep, reinterpret_cast<uint32 *>(output), count);
+        }
+#endif
+    }
+
+    template<typename T>
+    T inclusiveScan(const T *input, T *output, size_t count, T initial) noexcept {
+        return inclusiveScanKernel(input, output, count, initial);
+    }
+
+    template<typename T>
+    T exclusiveScan(const T *input, T *output, size_t count, T initial) noexcept {
+        return exclusiveScanKernel(input, output, count, initial);
+    }
+
+    template<typename T>
+    T sum(const T *input, size_t count) noexcept {
+        return sumKernel(input, count);
+    }
+
+    template<typename T>
+    T minimum(const T *input, size_t count) noexcept {
+        return minimumKernel(input, count);
+    }
+
+    template<typename T>
+    T maximum(const T *input, size_t count) noexcept {
+        return maximumKernel(input, count);
+    }
+
+    template<typename T>
+    size_t compact(const T *input, const bool *keep, T *output, size_t count) noexcept {
+        return compactKernel(input, keep, output, count);
+    }
+
+    namespace {
+        /// @brief Finds where a worker's slice of an array starts.
+        size_t sliceStart(size_t count, size_t slices, size_t index) noexcept {
+            return static_cast<size_t>(static_cast<unsigned __int128>(count) * index / slices);
+        }
+
+        /// @brief Runs a reduction over equal slices of an array and combines the slice results.
+        template<typename T, typename Reduce, typename Combine>
+        T parallelReduce(WorkerPool &pool, const T *input, size_t count, Reduce reduce, Combine combine) noexcept {
+            const size_t slices = pool.size();
+            if(slices < 2)
+                return reduce(input, count);
+            auto results = new T[slices];
+            pool.run(Function<void(size_t)>([input, count, slices, results, &reduce](size_t worker) {
+                const size_t start = sliceStart(count, slices, worker);
+                results[worker] = reduce(input + start, sliceStart(count, slices, worker + 1) - start);
+            }));
+            T result = results[0];
+            for(size_t i = 1; i < slices; i++)
+                result = combine(result, results[i]);
+            delete[] results;
+            return result;
+        }
+
+        /// @brief Scans equal slices of an array, carrying the sum of each slice into the next.
+        template<typename T, typename Scan>
+        T parallelScan(WorkerPool &pool, const T *input, T *output, size_t count, T initial, Scan scan) noexcept {
+            const size_t slices = pool.size();
+            if(slices < 2)
+                return scan(input, output, count, initial);
+            auto carries = new T[slices];
+            pool.run(Function<void(size_t)>([input, count, slices, carries](size_t worker) {
+                const size_t start = sliceStart(count, slices, worker);
+                carries[worker] = sumKernel(input + start, sliceStart(count, slices, worker + 1) - start);
+            }));
+            const T total = exclusiveScanKernel(carries, carries, slices, initial);
+            pool.run(Function<void(size_t)>([input, output, count, slices, carries, &scan](size_t worker) {
+                const size_t start = sliceStart(count, slices, worker);
+                const size_t end   = sliceStart(count, slices, worker + 1);
+                scan(input + start, output + start, end - start, carries[worker]);
+            }));
+            delete[] carries;
+            return total;
+        }
+    }
+
+    template<typename T>
+    T inclusiveScan(WorkerPool &pool, const T *input, T *output, size_t count, T initial) noexcept {
+        return parallelScan(pool, input, output, count, initial,
+                [](const T *in, T *out, size_t length, T carry) { return inclusiveScanKernel(in, out, length, carry); });
+    }
+
+    template<typename T>
+    T exclusiveScan(WorkerPool &pool, const T *input, T *output, size_t count, T initial) noexcept {
+        return parallelScan(pool, input, output, count, initial,
+                [](const T *in, T *out, size_t length, T carry) { return exclusiveScanKernel(in, out, length, carry); });
+    }
+
+    template<typename T>
+    T sum(WorkerPool &pool, const T *input, size_t count) noexcept {
+        return parallelReduce(pool, input, count,
+                [](const T *in, size_t length) { return sumKernel(in, length); },
+                [](T a, T b) { return wrappingAdd(a, b); });
+    }
+
+    template<typename T>
+    T minimum(WorkerPool &pool, const T *input, size_t count) noexcept {
+        return parallelReduce(pool, input, count,
+                [](const T *in, size_t length) { return minimumKernel(in, length); },
+                [](T a, T b) { return b < a ? b : a; });
+    }
+
+    template<typename T>
+    T maximum(WorkerPool &pool, const T *input, size_t count) noexcept {
+        return parallelReduce(pool, input, count,
+                [](const T *in, size_t length) { return maximumKernel(in, length); },
+                [](T a, T b) { return a < b ? b : a; });
+    }
+
+    template<typename T>
+    size_t compact(WorkerPool &pool, const T *input, const bool *keep, T *output, size_t count) noexcept {
+        const size_t slices = pool.size();
+        if(slices < 2)
+            return compactKernel(input, keep, output, count);
+        // The kernels store whole vectors past the last kept element,
+        // so each slice is compacted within its own range of a scratch array before being moved into place.
+        auto scratch = new T[count];
+        auto offsets = new size_t[slices];
+        pool.run(Function<void(size_t)>([input, keep, count, slices, scratch, offsets](size_t worker) {
+            const size_t start = sliceStart(count, slices, worker);
+            const size_t end   = sliceStart(count, slices, worker + 1);
+            offsets[worker] = compactKernel(input + start, keep + start, scratch + start, end - start);
+        }));
+        size_t written = 0;
+        for(size_t i = 0; i < slices; i++) {
+            const size_t kept = offsets[i];
+            offsets[i] = written;
+            written += kept;
+        }
+        pool.run(Function<void(size_t)>([output, count, slices, scratch, offsets, written](size_t worker) {
+            const size_t start = sliceStart(count, slices, worker);
+            const size_t end   = worker + 1 < slices ? offsets[worker + 1] : written;
+            __builtin_memcpy(output + offsets[worker], scratch + start, (end - offsets[worker]) * sizeof(T));
+        }));
+        delete[] offsets;
+        delete[] scratch;
+        return written;
+    }
+
+#define HYPER_SCAN_INSTANTIATE(Type) \
+    template Type inclusiveScan<Type>(const Type *, Type *, size_t, Type) noexcept; \
+    template Type exclusiveScan<Type>(const Type *, Type *, size_t, Type) noexcept; \
+    template Type sum<Type>(const Type *, size_t) noexcept; \
+    template Type minimum<Type>(const Type *, size_t) noexcept; \
+    template Type maximum<Type>(const Type *, size_t) noexcept; \
+    template size_t compact<Type>(const Type *, const bool *, Type *, size_t) noexcept; \
+    template Type inclusiveScan<Type>(WorkerPool &, const Type *, Type *, size_t, Type) noexcept; \
+    template Type exclusiveScan<Type>(WorkerPool &, const Type *, Type *, size_t, Type) noexcept; \
+    template Type sum<Type>(WorkerPool &, const Type *, size_t) noexcept; \
+    template Type minimum<Type>(WorkerPool &, const Type *, size_t) noexcept; \
+    template Type maximum<Type>(WorkerPool &, const Type *, size_t) noexcept; \
+    template size_t compact<Type>(WorkerPool &, const Type *, const bool *, Type *, size_t) noexcept;
+
+    HYPER_SCAN_INSTANTIATE(int32)
+    HYPER_SCAN_INSTANTIATE(uint32)
+    HYPER_SCAN_INSTANTIATE(int64)
+    HYPER_SCAN_INSTANTIATE(uint64)
+    HYPER_SCAN_INSTANTIATE(float32)
+    HYPER_SCAN_INSTANTIATE(float64)
+#undef HYPER_SCAN_INSTANTIATE
+}
@@ -0,0 +1,56 @@
+#include "common.h"
+#include "hyper/Barrier.h"
+#include "hyper/Thread.h"
+
+using namespace hyper;
+
+TEST(Barrier, SingleThread) {
+    TEST_DESCRIPTION("A barrier for one thread should never block");
+    Barrier barrier(1);
+    EXPECT_TRUE(barrier.arriveAndWait());
+    EXPECT_TRUE(barrier.arriveAndWait());
+    EXPECT_EQ(2u, barrier.phase());
+}
+
+namespace {
+    void runPhases(uint32 threadCount, uint32 spinCount) {
+        constexpr int phases = 200;
+        Barrier barrier(threadCount, spinCount);
+        int counters[phases] = {};
+        int serial = 0;
+        bool inStep = true;
+        auto threads = new Thread[threadCount];
+        for(uint32 t = 0; t < threadCount; t++)
+            ASSERT_TRUE(threads[t].start(Function<void()>([&]() {
+                for(int phase = 0; phase < phases; phase++) {
+                    __atomic_add_fetch(&counters[phase], 1, __ATOMIC_RELAXED);
+                    if(barrier.arriveAndWait())
+                        serial++;
+                    // Every thread has arrived, so this phase's counter is final.
+                    if(counters[phase] != static_cast<int>(threadCount))
+                        __atomic_store_n(&inStep, false, __ATOMIC_RELAXED);
+                }
+            })));
+        for(uint32 t = 0; t < threadCount; t++)
+            threads[t].join();
+        delete[] threads;
+        EXPECT_TRUE(inStep);
+        EXPECT_EQ(phases, serial);
+        EXPECT_EQ(static_cast<uint32>(phases), barrier.phase());
+    }
+}
+
+TEST(Barrier, KeepsThreadsInStep) {
+    TEST_DESCRIPTION("No thread should start a phase until every thread has finished the previous one");
+    runPhases(4, Barrier::defaultSpinCount);
+}
+
+TEST(Barrier, Sleeping) {
+    TEST_DESCRIPTION("Threads that go straight to sleep should still be woken each phase");
+    runPhases(4, 0);
+}
+
+TEST(Barrier, ManyThreads) {
+    TEST_DESCRIPTION("The barrier should work with more threads than processors");
+    runPhases(32, 64);
+}
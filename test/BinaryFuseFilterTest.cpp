@@ -0,0 +1,102 @@
+#include "common.h"
+#include "hyper/BinaryFuseFilter.h"
+
+using namespace hyper;
+
+TEST(BinaryFuseFilter, DefaultConstructor) {
+    TEST_DESCRIPTION("A filter that hasn't been built should not contain any keys");
+    BinaryFuseFilter filter;
+    EXPECT_FALSE(filter.contains(42));
+    EXPECT_EQ(0u, filter.sizeInBytes());
+}
+
+TEST(BinaryFuseFilter, BuildEmpty) {
+    TEST_DESCRIPTION("Building from no keys should succeed and contain nothing");
+    BinaryFuseFilter filter;
+    EXPECT_TRUE(filter.build(nullptr, 0));
+    EXPECT_FALSE(filter.contains(42));
+}
+
+TEST(BinaryFuseFilter, SmallSets) {
+    TEST_DESCRIPTION("Sets of every small size should build without false negatives");
+    uint64 keys[64];
+    for(size_t count = 1; count <= 64; count++) {
+        for(size_t i = 0; i < count; i++)
+            keys[i] = i * 1000003;
+        BinaryFuseFilter filter;
+        ASSERT_TRUE(filter.build(keys, count)) << "Count " << count;
+        for(size_t i = 0; i < count; i++)
+            EXPECT_TRUE(filter.contains(keys[i]));
+    }
+}
+
+TEST(BinaryFuseFilter, FalsePositiveRate) {
+    TEST_DESCRIPTION("About one in 256 absent keys should be reported, using about 9 bits per key");
+    const size_t count = 200000;
+    auto keys = new uint64[count];
+    for(size_t i = 0; i < count; i++)
+        keys[i] = hash(uint64(i));
+    BinaryFuseFilter filter;
+    ASSERT_TRUE(filter.build(keys, count));
+    for(size_t i = 0; i < count; i++)
+        ASSERT_TRUE(filter.contains(keys[i]));
+    size_t falsePositives = 0;
+    for(size_t i = count; i < 2 * count; i++)
+        falsePositives += filter.contains(hash(uint64(i))) ? 1 : 0;
+    EXPECT_LT(falsePositives, count / 200);
+    EXPECT_LT(filter.sizeInBytes() * 8, count * 10);
+    delete[] keys;
+}
+
+TEST(BinaryFuseFilter, Duplicates) {
+    TEST_DESCRIPTION("Duplicate keys should not prevent the filter from being built");
+    uint64 keys[1000];
+    for(size_t i = 0; i < 1000; i++)
+        keys[i] = i % 300;
+    BinaryFuseFilter filter;
+    ASSERT_TRUE(filter.build(keys, 1000));
+    for(uint64 key = 0; key < 300; key++)
+        EXPECT_TRUE(filter.contains(key));
+}
+
+TEST(BinaryFuseFilter, Rebuild) {
+    TEST_DESCRIPTION("Building again should replace the previous keys");
+    uint64 first[100], second[100];
+    for(uint64 i = 0; i < 100; i++) {
+        first[i]  = i;
+        second[i] = i + 1000000;
+    }
+    BinaryFuseFilter filter;
+    ASSERT_TRUE(filter.build(first, 100));
+    ASSERT_TRUE(filter.build(second, 100));
+    size_t found = 0;
+    for(uint64 i = 0; i < 100; i++) {
+        EXPECT_TRUE(filter.contains(second[i]));
+        found += filter.contains(first[i]) ? 1 : 0;
+    }
+    EXPECT_LT(found, 10u);
+}
+
+TEST(BinaryFuseFilter, Batch) {
+    TEST_DESCRIPTION("Batched queries should match individual queries");
+    uint64 keys[500], queries[1000];
+    for(uint64 i = 0; i < 500; i++)
+        keys[i] = i * 7;
+    for(uint64 i = 0; i < 1000; i++)
+        queries[i] = i * 7 / 2;
+    BinaryFuseFilter filter;
+    ASSERT_TRUE(filter.build(keys, 500));
+    bool results[1000];
+    filter.contains(queries, 1000, results);
+    for(size_t i = 0; i < 1000; i++)
+        EXPECT_EQ(filter.contains(queries[i]), results[i]);
+}
+
+TEST(BinaryFuseFilter, ByteKeys) {
+    TEST_DESCRIPTION("Byte keys should be found when built from their hashes");
+    const char name[] = "player-1234";
+    uint64 key = hash(reinterpret_cast<const byte *>(name), sizeof(name));
+    BinaryFuseFilter filter;
+    ASSERT_TRUE(filter.build(&key, 1));
+    EXPECT_TRUE(filter.contains(reinterpret_cast<const byte *>(name), sizeof(name)));
+}
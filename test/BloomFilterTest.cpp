@@ -0,0 +1,67 @@
+#include "common.h"
+#include "hyper/BloomFilter.h"
+
+using namespace hyper;
+
+TEST(BloomFilter, Empty) {
+    TEST_DESCRIPTION("An empty filter should not contain any keys");
+    BloomFilter filter(100);
+    for(uint64 i = 0; i < 100; i++)
+        EXPECT_FALSE(filter.containsHash(hash(i)));
+}
+
+TEST(BloomFilter, NoFalseNegatives) {
+    TEST_DESCRIPTION("Every inserted key should be found");
+    BloomFilter filter(10000);
+    for(uint64 i = 0; i < 10000; i++)
+        filter.insertHash(hash(i));
+    for(uint64 i = 0; i < 10000; i++)
+        ASSERT_TRUE(filter.containsHash(hash(i)));
+}
+
+TEST(BloomFilter, FalsePositiveRate) {
+    TEST_DESCRIPTION("About one in a hundred absent keys should be reported at 10 bits per key");
+    const uint64 count = 100000;
+    BloomFilter filter(count);
+    for(uint64 i = 0; i < count; i++)
+        filter.insertHash(hash(i));
+    size_t falsePositives = 0;
+    for(uint64 i = count; i < 2 * count; i++)
+        falsePositives += filter.containsHash(hash(i)) ? 1 : 0;
+    EXPECT_LT(falsePositives, count * 3 / 100);
+    EXPECT_GE(filter.sizeInBytes(), count * 10 / 8);
+    EXPECT_LT(filter.sizeInBytes(), count * 10 / 8 + 64);
+}
+
+TEST(BloomFilter, ByteKeys) {
+    TEST_DESCRIPTION("Byte keys should be hashed so that inserted keys are found");
+    BloomFilter filter(10);
+    const char key[] = "asset/texture.png";
+    const char other[] = "asset/model.obj";
+    filter.insert(reinterpret_cast<const byte *>(key), sizeof(key));
+    EXPECT_TRUE(filter.contains(reinterpret_cast<const byte *>(key), sizeof(key)));
+    EXPECT_FALSE(filter.contains(reinterpret_cast<const byte *>(other), sizeof(other)));
+}
+
+TEST(BloomFilter, Batch) {
+    TEST_DESCRIPTION("Batched queries should match individual queries");
+    BloomFilter filter(1000);
+    uint64 hashes[2000];
+    for(uint64 i = 0; i < 2000; i++) {
+        hashes[i] = hash(i);
+        if(i % 2 == 0)
+            filter.insertHash(hashes[i]);
+    }
+    bool results[2000];
+    filter.containsHashes(hashes, 2000, results);
+    for(size_t i = 0; i < 2000; i++)
+        EXPECT_EQ(filter.containsHash(hashes[i]), results[i]);
+}
+
+TEST(BloomFilter, Clear) {
+    TEST_DESCRIPTION("Clearing should remove every inserted key");
+    BloomFilter filter(10);
+    filter.insertHash(hash(uint64(42)));
+    filter.clear();
+    EXPECT_FALSE(filter.containsHash(hash(uint64(42))));
+}
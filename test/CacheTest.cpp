@@ -0,0 +1,165 @@
+#include <thread>
+#include "common.h"
+#include "hyper/Cache.h"
+#include "util/DestructorSpy.h"
+
+using namespace hyper;
+
+TEST(Cache, Miss) {
+    TEST_DESCRIPTION("Looking up a missing key should leave the value unchanged");
+    Cache<int> cache(100);
+    SharedPointer<int> value(new int(5));
+    EXPECT_FALSE(cache.find(1, value));
+    EXPECT_EQ(5, *value);
+}
+
+TEST(Cache, InsertAndFind) {
+    TEST_DESCRIPTION("An inserted value should be found under its key");
+    Cache<int> cache(100);
+    EXPECT_TRUE(cache.insert(1, SharedPointer<int>(new int(10))));
+    EXPECT_TRUE(cache.insert(2, SharedPointer<int>(new int(20))));
+    SharedPointer<int> value;
+    ASSERT_TRUE(cache.find(1, value));
+    EXPECT_EQ(10, *value);
+    ASSERT_TRUE(cache.find(2, value));
+    EXPECT_EQ(20, *value);
+    EXPECT_EQ(2u, cache.size());
+}
+
+TEST(Cache, Replace) {
+    TEST_DESCRIPTION("Inserting an existing key should replace its value and cost");
+    Cache<int> cache(1000, 1);
+    cache.insert(7, SharedPointer<int>(new int(1)), 10);
+    cache.insert(7, SharedPointer<int>(new int(2)), 30);
+    SharedPointer<int> value;
+    ASSERT_TRUE(cache.find(7, value));
+    EXPECT_EQ(2, *value);
+    EXPECT_EQ(1u, cache.size());
+    EXPECT_EQ(30u, cache.cost());
+}
+
+TEST(Cache, Erase) {
+    TEST_DESCRIPTION("Erasing should remove a key once and report whether it was there");
+    Cache<int> cache(100);
+    cache.insert(3, SharedPointer<int>(new int(3)));
+    EXPECT_TRUE(cache.erase(3));
+    EXPECT_FALSE(cache.erase(3));
+    SharedPointer<int> value;
+    EXPECT_FALSE(cache.find(3, value));
+}
+
+TEST(Cache, CostBound) {
+    TEST_DESCRIPTION("The total cost should never exceed the capacity");
+    Cache<int> cache(1000, 4);
+    for(uint64 i = 0; i < 5000; i++) {
+        cache.insert(i, SharedPointer<int>(new int(static_cast<int>(i))), 1 + i % 7);
+        ASSERT_LE(cache.cost(), 1000u);
+    }
+    EXPECT_GT(cache.cost(), 900u);
+}
+
+TEST(Cache, TooLarge) {
+    TEST_DESCRIPTION("A value that costs more than a shard can hold should not be stored");
+    Cache<int> cache(100, 4);
+    EXPECT_FALSE(cache.insert(1, SharedPointer<int>(new int(1)), 26));
+    EXPECT_EQ(0u, cache.size());
+}
+
+TEST(Cache, KeepsFrequentlyUsed) {
+    TEST_DESCRIPTION("Values that are read often should survive a scan of one-off keys");
+    Cache<int> cache(100, 1);
+    SharedPointer<int> value;
+    for(uint64 i = 0; i < 50; i++)
+        cache.insert(i, SharedPointer<int>(new int(static_cast<int>(i))));
+    for(uint64 round = 0; round < 2; round++)
+        for(uint64 i = 0; i < 50; i++)
+            cache.find(i, value);
+    for(uint64 i = 1000; i < 2000; i++)
+        cache.insert(i, SharedPointer<int>(new int(static_cast<int>(i))));
+    size_t hits = 0;
+    for(uint64 i = 0; i < 50; i++)
+        hits += cache.find(i, value) ? 1 : 0;
+    EXPECT_GE(hits, 45u);
+}
+
+TEST(Cache, GhostSurvivesGrowth) {
+    TEST_DESCRIPTION("A key evicted before the table grows should still go to the main queue when inserted again");
+    Cache<int> cache(100, 1);
+    SharedPointer<int> value;
+    // Evict key 0 while the table is small, so it is remembered as a ghost.
+    cache.insert(0, SharedPointer<int>(new int(0)), 50);
+    cache.insert(1, SharedPointer<int>(new int(1)), 60);
+    ASSERT_FALSE(cache.find(0, value));
+    // Grow the table without evicting anything else.
+    for(uint64 i = 2; i < 42; i++)
+        cache.insert(i, SharedPointer<int>(new int(static_cast<int>(i))));
+    cache.insert(0, SharedPointer<int>(new int(0)));
+    // Only a key in the main queue survives a scan of one-off keys.
+    for(uint64 i = 1000; i < 2000; i++)
+        cache.insert(i, SharedPointer<int>(new int(static_cast<int>(i))));
+    EXPECT_TRUE(cache.find(0, value));
+}
+
+TEST(Cache, ValueOutlivesRemoval) {
+    TEST_DESCRIPTION("A value held by a reader should stay alive after it is removed from the cache");
+    int destroyed = 0;
+    Cache<DestructorSpy> cache(10, 1);
+    cache.insert(1, SharedPointer<DestructorSpy>(new DestructorSpy(&destroyed)));
+    SharedPointer<DestructorSpy> held;
+    ASSERT_TRUE(cache.find(1, held));
+    cache.insert(1, SharedPointer<DestructorSpy>(new DestructorSpy()));
+    EXPECT_EQ(0, destroyed);
+    cache.erase(1);
+    EXPECT_EQ(0, destroyed);
+    held.expire();
+    EXPECT_EQ(1, destroyed);
+}
+
+TEST(Cache, EvictsUnused) {
+    TEST_DESCRIPTION("Values that were never read should be evicted first");
+    int destroyed = 0;
+    Cache<DestructorSpy> cache(10, 1);
+    for(uint64 i = 0; i < 10; i++)
+        cache.insert(i, SharedPointer<DestructorSpy>(new DestructorSpy(&destroyed)));
+    SharedPointer<DestructorSpy> value;
+    ASSERT_TRUE(cache.find(5, value));
+    cache.insert(10, SharedPointer<DestructorSpy>(new DestructorSpy()));
+    EXPECT_EQ(1, destroyed);
+    EXPECT_FALSE(cache.find(0, value));
+    EXPECT_TRUE(cache.find(5, value));
+}
+
+TEST(Cache, Clear) {
+    TEST_DESCRIPTION("Clearing should remove every entry and reset the cost");
+    Cache<int> cache(100);
+    for(uint64 i = 0; i < 50; i++)
+        cache.insert(i, SharedPointer<int>(new int(1)));
+    cache.clear();
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_EQ(0u, cache.cost());
+}
+
+TEST(Cache, Concurrent) {
+    TEST_DESCRIPTION("Concurrent readers and writers should always see consistent values");
+    Cache<uint64> cache(512, 8);
+    std::thread threads[4];
+    bool consistent[4] = {};
+    for(size_t t = 0; t < 4; t++)
+        threads[t] = std::thread([&cache, &consistent, t]() {
+            bool ok = true;
+            SharedPointer<uint64> value;
+            for(uint64 i = 0; i < 20000; i++) {
+                const uint64 key = hash(i * 4 + t) % 1024;
+                if(cache.find(key, value))
+                    ok &= *value == key * 3;
+                else
+                    cache.insert(key, SharedPointer<uint64>(new uint64(key * 3)), 1 + key % 3);
+            }
+            consistent[t] = ok;
+        });
+    for(auto &thread : threads)
+        thread.join();
+    for(auto ok : consistent)
+        EXPECT_TRUE(ok);
+    EXPECT_LE(cache.cost(), 512u);
+}
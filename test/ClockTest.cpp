@@ -0,0 +1,76 @@
+#include "common.h"
+#include "hyper/clock.h"
+
+using namespace hyper;
+
+TEST(Clock, Monotonic) {
+    TEST_DESCRIPTION("Successive readings should never go backwards");
+    auto previousTimestamp = readTimestamp();
+    auto previousTime = now();
+    auto previousSystem = monotonicNow();
+    for(int i = 0; i < 10000; i++) {
+        const auto timestamp = readTimestamp();
+        const auto time = now();
+        const auto system = monotonicNow();
+        ASSERT_LE(previousTimestamp, timestamp);
+        ASSERT_LE(previousTime, time);
+        ASSERT_LE(previousSystem, system);
+        previousTimestamp = timestamp;
+        previousTime = time;
+        previousSystem = system;
+    }
+}
+
+TEST(Clock, Conversion) {
+    TEST_DESCRIPTION("Converting ticks to nanoseconds should be linear");
+    EXPECT_EQ(0u, timestampToNanoseconds(0));
+    const auto one = timestampToNanoseconds(1000000);
+    const auto two = timestampToNanoseconds(2000000);
+    EXPECT_NEAR(static_cast<double>(2 * one), static_cast<double>(two), 1.0);
+}
+
+TEST(Clock, MatchesMonotonicClock) {
+    TEST_DESCRIPTION("Time measured with timestamps should agree with the operating system's clock");
+    const auto startSystem = monotonicNow();
+    const auto startTimestamp = readTimestamp();
+    sleepFor(30000000);
+    const auto endTimestamp = readTimestamp();
+    const auto endSystem = monotonicNow();
+    const auto measured = static_cast<double>(timestampToNanoseconds(endTimestamp - startTimestamp));
+    const auto expected = static_cast<double>(endSystem - startSystem);
+    EXPECT_GE(expected, 30000000.0);
+    EXPECT_NEAR(expected, measured, expected * 0.01);
+}
+
+TEST(Clock, SleepFor) {
+    TEST_DESCRIPTION("Sleeping should last at least as long as asked");
+    const auto start = monotonicNow();
+    sleepFor(2000000);
+    EXPECT_GE(monotonicNow() - start, 2000000u);
+}
+
+TEST(FrameLimiter, Paces) {
+    TEST_DESCRIPTION("Frames should not start before their scheduled time");
+    constexpr uint64 period = 4000000;
+    const auto start = now();
+    FrameLimiter limiter(period);
+    EXPECT_EQ(period, limiter.period());
+    uint64 total = 0;
+    for(int i = 0; i < 10; i++)
+        total += limiter.wait();
+    const auto elapsed = now() - start;
+    EXPECT_GE(elapsed, 10 * period);
+    EXPECT_GE(total, 10 * period);
+    EXPECT_GE(limiter.spinMargin(), 50000u);
+}
+
+TEST(FrameLimiter, SkipsMissedFrames) {
+    TEST_DESCRIPTION("A frame that runs long should not make the next frames rush to catch up");
+    constexpr uint64 period = 2000000;
+    FrameLimiter limiter(period);
+    limiter.wait();
+    sleepFor(5 * period);
+    limiter.wait();
+    // The late frame restarts the schedule, so the next one still waits a full period.
+    EXPECT_GE(limiter.wait(), period);
+}
@@ -0,0 +1,126 @@
+#include "common.h"
+#include "hyper/compression.h"
+
+using namespace hyper;
+
+// Encodes and decodes the values, then checks that they survived the round trip.
+template<typename T>
+static size_t roundTrip(const T *values, size_t count, IntegerCoding coding) {
+    auto encoded = new byte[maxEncodedSize<T>(count)];
+    const auto written = encode(values, count, encoded, coding);
+    EXPECT_LE(written, maxEncodedSize<T>(count));
+    EXPECT_EQ(count, decodedCount(encoded));
+
+    auto decoded = new T[count + 1];
+    EXPECT_EQ(written, decode(encoded, decoded));
+    for(size_t i = 0; i < count; i++) {
+        if(values[i] != decoded[i]) {
+            ADD_FAILURE() << "Mismatch at index " << i << ": expected " << values[i] << ", got " << decoded[i];
+            break;
+        }
+    }
+    delete[] decoded;
+    delete[] encoded;
+    return written;
+}
+
+TEST(compression, Empty) {
+    TEST_DESCRIPTION("An empty sequence should round trip");
+    roundTrip<uint32>(nullptr, 0, IntegerCoding::Delta);
+    roundTrip<uint64>(nullptr, 0, IntegerCoding::FrameOfReference);
+}
+
+TEST(compression, SortedDelta) {
+    TEST_DESCRIPTION("Sorted values with small gaps should compress to a few bits each");
+    const size_t count = 10000;
+    auto values = new uint32[count];
+    uint32 value = 1000000;
+    for(size_t i = 0; i < count; i++) {
+        value += static_cast<uint32>(i * 7 % 11);
+        values[i] = value;
+    }
+    const auto size = roundTrip(values, count, IntegerCoding::Delta);
+    EXPECT_LT(size, count);
+    delete[] values;
+}
+
+TEST(compression, DeltaExceptions) {
+    TEST_DESCRIPTION("Rare large gaps should be patched without widening the whole block");
+    const size_t count = 1000;
+    auto values = new uint32[count];
+    uint32 value = 0;
+    for(size_t i = 0; i < count; i++) {
+        value += (i % 50 == 0) ? 1000000u : 3u;
+        values[i] = value;
+    }
+    const auto size = roundTrip(values, count, IntegerCoding::Delta);
+    EXPECT_LT(size, count);
+    delete[] values;
+}
+
+TEST(compression, UnsortedDelta) {
+    TEST_DESCRIPTION("Unsorted values should still decode correctly with delta coding");
+    const size_t count = 777;
+    auto values = new uint32[count];
+    uint32 state = 12345;
+    for(size_t i = 0; i < count; i++) {
+        state = state * 1103515245u + 12345u;
+        values[i] = state;
+    }
+    roundTrip(values, count, IntegerCoding::Delta);
+    delete[] values;
+}
+
+TEST(compression, FrameOfReference) {
+    TEST_DESCRIPTION("Clustered values should be packed relative to the block minimum");
+    const size_t count = 512;
+    auto values = new uint32[count];
+    for(size_t i = 0; i < count; i++)
+        values[i] = 4000000000u + static_cast<uint32>(i * 37 % 200);
+    const auto size = roundTrip(values, count, IntegerCoding::FrameOfReference);
+    EXPECT_LT(size, count * 2);
+    delete[] values;
+}
+
+TEST(compression, FullWidth) {
+    TEST_DESCRIPTION("Values that need every bit should round trip");
+    uint32 values[300];
+    for(size_t i = 0; i < 300; i++)
+        values[i] = (i % 2) ? maxValue<uint32>() : static_cast<uint32>(i);
+    roundTrip(values, 300, IntegerCoding::FrameOfReference);
+    roundTrip(values, 300, IntegerCoding::Delta);
+}
+
+TEST(compression, EveryWidth) {
+    TEST_DESCRIPTION("Blocks of every packed width should round trip");
+    uint32 values[compressionBlockSize];
+    for(uint32 bits = 0; bits <= 32; bits++) {
+        const uint32 mask = bits == 32 ? maxValue<uint32>() : (1u << bits) - 1;
+        for(size_t i = 0; i < compressionBlockSize; i++)
+            values[i] = static_cast<uint32>(i * 2654435761u) & mask;
+        roundTrip(values, compressionBlockSize, IntegerCoding::FrameOfReference);
+    }
+}
+
+TEST(compression, Timestamps64) {
+    TEST_DESCRIPTION("Sorted 64-bit timestamps should compress to a few bytes each");
+    const size_t count = 5000;
+    auto values = new uint64[count];
+    uint64 time = 1700000000000000000ull;
+    for(size_t i = 0; i < count; i++) {
+        time += 16000000 + (i * 7919 % 5000);
+        values[i] = time;
+    }
+    const auto size = roundTrip(values, count, IntegerCoding::Delta);
+    EXPECT_LT(size, count * 4);
+    delete[] values;
+}
+
+TEST(compression, Large64) {
+    TEST_DESCRIPTION("64-bit values wider than the packed width should be stored as exceptions");
+    uint64 values[260];
+    for(size_t i = 0; i < 260; i++)
+        values[i] = (i % 3 == 0) ? maxValue<uint64>() - i : i;
+    roundTrip(values, 260, IntegerCoding::FrameOfReference);
+    roundTrip(values, 260, IntegerCoding::Delta);
+}
@@ -0,0 +1,159 @@
+#include "common.h"
+#include "hyper/ConcurrentHashMap.h"
+#include "hyper/Thread.h"
+
+using namespace hyper;
+
+TEST(ConcurrentHashMap, InsertFind) {
+    TEST_DESCRIPTION("Inserted keys should be found with their values");
+    ConcurrentHashMap<uint64, int> map;
+    EXPECT_TRUE(map.insert(1, 10));
+    EXPECT_TRUE(map.insert(2, 20));
+    int value = 0;
+    EXPECT_TRUE(map.find(1, value));
+    EXPECT_EQ(10, value);
+    EXPECT_TRUE(map.find(2, value));
+    EXPECT_EQ(20, value);
+    EXPECT_FALSE(map.find(3, value));
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_FALSE(map.contains(3));
+    EXPECT_EQ(2u, map.size());
+}
+
+TEST(ConcurrentHashMap, Replace) {
+    TEST_DESCRIPTION("Inserting an existing key should replace its value");
+    ConcurrentHashMap<uint64, int> map;
+    EXPECT_TRUE(map.insert(7, 1));
+    EXPECT_FALSE(map.insert(7, 2));
+    int value = 0;
+    EXPECT_TRUE(map.find(7, value));
+    EXPECT_EQ(2, value);
+    EXPECT_EQ(1u, map.size());
+}
+
+TEST(ConcurrentHashMap, Erase) {
+    TEST_DESCRIPTION("Erased keys should no longer be found and can be added again");
+    ConcurrentHashMap<uint64, int> map;
+    map.insert(1, 1);
+    map.insert(2, 2);
+    EXPECT_TRUE(map.erase(1));
+    EXPECT_FALSE(map.erase(1));
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_EQ(1u, map.size());
+    EXPECT_TRUE(map.insert(1, 3));
+    int value = 0;
+    EXPECT_TRUE(map.find(1, value));
+    EXPECT_EQ(3, value);
+}
+
+TEST(ConcurrentHashMap, Grows) {
+    TEST_DESCRIPTION("The table should grow and keep every key");
+    ConcurrentHashMap<uint64, uint64> map(4);
+    const auto initial = map.capacity();
+    for(uint64 i = 0; i < 10000; i++)
+        EXPECT_TRUE(map.insert(i, i * 3));
+    EXPECT_GT(map.capacity(), initial);
+    EXPECT_EQ(10000u, map.size());
+    for(uint64 i = 0; i < 10000; i++) {
+        uint64 value = 0;
+        ASSERT_TRUE(map.find(i, value));
+        EXPECT_EQ(i * 3, value);
+    }
+}
+
+TEST(ConcurrentHashMap, TombstonesCleared) {
+    TEST_DESCRIPTION("Churning through keys should rebuild the table instead of growing it without bound");
+    ConcurrentHashMap<uint64, int> map(16);
+    for(uint64 i = 0; i < 100000; i++) {
+        map.insert(i, 1);
+        map.erase(i);
+    }
+    EXPECT_EQ(0u, map.size());
+    EXPECT_LE(map.capacity(), 64u);
+}
+
+TEST(ConcurrentHashMap, PointerKeys) {
+    TEST_DESCRIPTION("Pointers should be usable as keys");
+    int a = 0;
+    int b = 0;
+    ConcurrentHashMap<int *, char> map;
+    map.insert(&a, 'a');
+    map.insert(&b, 'b');
+    char value = 0;
+    EXPECT_TRUE(map.find(&b, value));
+    EXPECT_EQ('b', value);
+}
+
+TEST(ConcurrentHashMap, ConcurrentInserts) {
+    TEST_DESCRIPTION("Threads inserting different keys through several resizes should lose none of them");
+    constexpr uint64 threadCount = 4;
+    constexpr uint64 perThread = 20000;
+    ConcurrentHashMap<uint64, uint64> map(16);
+    Thread threads[threadCount];
+    for(uint64 t = 0; t < threadCount; t++)
+        ASSERT_TRUE(threads[t].start(Function<void()>([&map, t]() {
+            for(uint64 i = 0; i < perThread; i++)
+                map.insert(t * perThread + i, i);
+        })));
+    for(auto &thread : threads)
+        thread.join();
+    EXPECT_EQ(threadCount * perThread, map.size());
+    for(uint64 key = 0; key < threadCount * perThread; key++) {
+        uint64 value = 0;
+        ASSERT_TRUE(map.find(key, value));
+        EXPECT_EQ(key % perThread, value);
+    }
+}
+
+TEST(ConcurrentHashMap, SameKeys) {
+    TEST_DESCRIPTION("Threads inserting the same keys should add each key once");
+    ConcurrentHashMap<uint64, uint64> map(16);
+    uint64 added[4] = {};
+    Thread threads[4];
+    for(int t = 0; t < 4; t++)
+        ASSERT_TRUE(threads[t].start(Function<void()>([&map, &added, t]() {
+            for(uint64 i = 0; i < 5000; i++)
+                if(map.insert(i, i))
+                    added[t]++;
+        })));
+    for(auto &thread : threads)
+        thread.join();
+    EXPECT_EQ(5000u, added[0] + added[1] + added[2] + added[3]);
+    EXPECT_EQ(5000u, map.size());
+}
+
+TEST(ConcurrentHashMap, ReadersDuringWrites) {
+    TEST_DESCRIPTION("Readers should always see stable keys while writers churn and resize the table");
+    constexpr uint64 stable = 1000;
+    ConcurrentHashMap<uint64, uint64> map(16);
+    for(uint64 i = 0; i < stable; i++)
+        map.insert(i, i + 1);
+    bool stop = false;
+    bool consistent = true;
+    Thread readers[3];
+    for(auto &reader : readers)
+        ASSERT_TRUE(reader.start(Function<void()>([&]() {
+            while(!__atomic_load_n(&stop, __ATOMIC_ACQUIRE)) {
+                for(uint64 i = 0; i < stable; i++) {
+                    uint64 value = 0;
+                    // Stable keys are only ever rewritten with the same value.
+                    if(!map.find(i, value) || value != i + 1)
+                        __atomic_store_n(&consistent, false, __ATOMIC_RELAXED);
+                }
+            }
+        })));
+    for(uint64 round = 0; round < 20; round++) {
+        for(uint64 i = 0; i < 5000; i++)
+            map.insert(stable + round * 5000 + i, i);
+        for(uint64 i = 0; i < stable; i += 7)
+            map.insert(i, i + 1);
+        for(uint64 i = 0; i < 5000; i++)
+            map.erase(stable + round * 5000 + i);
+    }
+    __atomic_store_n(&stop, true, __ATOMIC_RELEASE);
+    for(auto &reader : readers)
+        reader.join();
+    EXPECT_TRUE(consistent);
+    EXPECT_EQ(stable, map.size());
+}
@@ -0,0 +1,91 @@
+#include "common.h"
+#include "hyper/CountMinSketch.h"
+
+using namespace hyper;
+
+TEST(CountMinSketch, Empty) {
+    TEST_DESCRIPTION("An empty sketch should estimate zero for every key");
+    CountMinSketch sketch(256, 4);
+    for(uint64 i = 0; i < 100; i++)
+        EXPECT_EQ(0u, sketch.estimateHash(hash(i)));
+    EXPECT_EQ(0u, sketch.totalCount());
+}
+
+TEST(CountMinSketch, NeverUndercounts) {
+    TEST_DESCRIPTION("Estimates should never be less than the true count");
+    CountMinSketch sketch(512, 4);
+    for(uint64 i = 0; i < 2000; i++)
+        sketch.addHash(hash(i % 100), 1);
+    for(uint64 i = 0; i < 100; i++)
+        ASSERT_GE(sketch.estimateHash(hash(i)), 20u);
+    EXPECT_EQ(2000u, sketch.totalCount());
+}
+
+TEST(CountMinSketch, ErrorBound) {
+    TEST_DESCRIPTION("Heavy hitters should be estimated within e/width of the total count");
+    const size_t width = 2048;
+    CountMinSketch sketch(width, 5);
+    // Zipf-like stream: key k appears about 10000/k times.
+    uint64 total = 0;
+    for(uint64 key = 1; key <= 5000; key++) {
+        const auto count = static_cast<uint32>(10000 / key + 1);
+        sketch.addHash(hash(key), count);
+        total += count;
+    }
+    const auto bound = static_cast<uint32>(2.72 * static_cast<double>(total) / width);
+    for(uint64 key = 1; key <= 100; key++) {
+        const auto expected = static_cast<uint32>(10000 / key + 1);
+        const auto estimate = sketch.estimateHash(hash(key));
+        EXPECT_GE(estimate, expected);
+        EXPECT_LE(estimate, expected + bound);
+    }
+}
+
+TEST(CountMinSketch, ByteKeys) {
+    TEST_DESCRIPTION("Byte keys should be hashed so that their counts add up");
+    CountMinSketch sketch(64, 3);
+    const char key[] = "event/jump";
+    sketch.add(reinterpret_cast<const byte *>(key), sizeof(key), 3);
+    sketch.add(reinterpret_cast<const byte *>(key), sizeof(key));
+    EXPECT_EQ(4u, sketch.estimate(reinterpret_cast<const byte *>(key), sizeof(key)));
+}
+
+TEST(CountMinSketch, Saturates) {
+    TEST_DESCRIPTION("Counters should stop at the maximum instead of wrapping around");
+    CountMinSketch sketch(16, 2);
+    sketch.addHash(hash(uint64(1)), 0xFFFFFFF0u);
+    sketch.addHash(hash(uint64(1)), 0x100u);
+    EXPECT_EQ(0xFFFFFFFFu, sketch.estimateHash(hash(uint64(1))));
+}
+
+TEST(CountMinSketch, Merge) {
+    TEST_DESCRIPTION("Merged sketches should count both streams");
+    CountMinSketch first(256, 4), second(256, 4), wrong(128, 4);
+    for(uint64 i = 0; i < 10; i++) {
+        first.addHash(hash(i), 2);
+        second.addHash(hash(i), 3);
+    }
+    EXPECT_FALSE(first.merge(wrong));
+    ASSERT_TRUE(first.merge(second));
+    for(uint64 i = 0; i < 10; i++)
+        EXPECT_GE(first.estimateHash(hash(i)), 5u);
+    EXPECT_EQ(50u, first.totalCount());
+}
+
+TEST(CountMinSketch, SerializeRoundTrip) {
+    TEST_DESCRIPTION("A deserialized sketch should give the same estimates");
+    CountMinSketch sketch(100, 3), copy(1, 1);
+    for(uint64 i = 0; i < 500; i++)
+        sketch.addHash(hash(i % 37), static_cast<uint32>(i));
+    const auto size = sketch.serializedSize();
+    auto buffer = new byte[size];
+    ASSERT_EQ(size, sketch.serialize(buffer));
+    EXPECT_FALSE(copy.deserialize(buffer, size - 4));
+    ASSERT_TRUE(copy.deserialize(buffer, size));
+    EXPECT_EQ(100u, copy.width());
+    EXPECT_EQ(3u, copy.depth());
+    EXPECT_EQ(sketch.totalCount(), copy.totalCount());
+    for(uint64 i = 0; i < 37; i++)
+        EXPECT_EQ(sketch.estimateHash(hash(i)), copy.estimateHash(hash(i)));
+    delete[] buffer;
+}
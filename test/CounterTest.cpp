@@ -1,3 +1,4 @@
+#include <thread>
 #include "gtest/gtest.h"
 #include "hyper/Counter.h"
 #include "common.h"
@@ -94,4 +95,37 @@ TEST(Counter, Cast) {
     const size_t initial = 42;
     Counter counter(initial);
     EXPECT_EQ(initial, (size_t)counter);
-}
\ No newline at end of file
+}
+
+TEST(Counter, ConcurrentUpdates) {
+    TEST_DESCRIPTION("Increments and decrements from several threads should not be lost");
+    const size_t initial = 100000;
+    Counter counter(initial);
+    std::thread threads[4];
+    for(size_t t = 0; t < 4; t++)
+        threads[t] = std::thread([&counter, t]() {
+            for(size_t i = 0; i < 10000; i++) {
+                if(t % 2 == 0)
+                    counter.increment();
+                else
+                    counter.decrement();
+            }
+        });
+    for(auto &thread : threads)
+        thread.join();
+    EXPECT_EQ(initial, counter.value());
+}
+
+TEST(Counter, DecrementStopsAtZero) {
+    TEST_DESCRIPTION("Concurrent decrements should never take the counter below zero");
+    Counter counter(1000);
+    std::thread threads[4];
+    for(auto &thread : threads)
+        thread = std::thread([&counter]() {
+            for(size_t i = 0; i < 1000; i++)
+                counter.decrement();
+        });
+    for(auto &thread : threads)
+        thread.join();
+    EXPECT_EQ(0u, counter.value());
+}
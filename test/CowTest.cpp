@@ -0,0 +1,107 @@
+#include "common.h"
+#include "hyper/Cow.h"
+#include "hyper/Thread.h"
+
+using namespace hyper;
+
+namespace {
+    // Counts how many times it is copied, to tell sharing from cloning.
+    struct Table {
+        static int copies;
+        int values[64];
+
+        Table()
+                : values() {
+            // ...
+        }
+
+        Table(const Table &other)
+                : values() {
+            copies++;
+            for(int i = 0; i < 64; i++)
+                values[i] = other.values[i];
+        }
+    };
+
+    int Table::copies = 0;
+}
+
+TEST(Cow, CopiesShare) {
+    TEST_DESCRIPTION("Copying shares the value instead of cloning it");
+    Table::copies = 0;
+    Cow<Table> original;
+    Cow<Table> copy(original);
+    Cow<Table> another;
+    another = copy;
+    EXPECT_EQ(0, Table::copies);
+    EXPECT_EQ(3u, original.useCount());
+    EXPECT_EQ(&original.read(), &another.read());
+}
+
+TEST(Cow, WriteClonesShared) {
+    TEST_DESCRIPTION("Writing to a shared value clones it, leaving the other copies unchanged");
+    Table::copies = 0;
+    Cow<Table> original;
+    Cow<Table> copy(original);
+    copy.write().values[0] = 42;
+    EXPECT_EQ(1, Table::copies);
+    EXPECT_EQ(0, original->values[0]);
+    EXPECT_EQ(42, copy->values[0]);
+    EXPECT_FALSE(original.isShared());
+    EXPECT_FALSE(copy.isShared());
+}
+
+TEST(Cow, WriteUniqueInPlace) {
+    TEST_DESCRIPTION("Writing to a value that isn't shared changes it in place");
+    Table::copies = 0;
+    Cow<Table> value;
+    const Table *before = &value.read();
+    value.write().values[1] = 7;
+    value.write().values[2] = 8;
+    EXPECT_EQ(0, Table::copies);
+    EXPECT_EQ(before, &value.read());
+    EXPECT_EQ(7, (*value).values[1]);
+}
+
+TEST(Cow, MovedFromReassigned) {
+    TEST_DESCRIPTION("A moved-from instance holds no value until it is assigned another");
+    Cow<Table> original;
+    original.write().values[0] = 5;
+    Cow<Table> moved(move(original));
+    EXPECT_EQ(0u, original.useCount());
+    EXPECT_FALSE(original.isShared());
+    EXPECT_EQ(5, moved->values[0]);
+    original = moved;
+    original.write().values[0] = 6;
+    EXPECT_EQ(5, moved->values[0]);
+    EXPECT_EQ(6, original->values[0]);
+}
+
+#ifndef NDEBUG
+TEST(Cow, MovedFromWriteAsserts) {
+    TEST_DESCRIPTION("Writing to a moved-from instance should fail an assertion instead of cloning null");
+    Cow<Table> original;
+    Cow<Table> moved(move(original));
+    EXPECT_DEATH(original.write(), "moved-from Cow");
+}
+#endif
+
+TEST(Cow, SharedAcrossThreads) {
+    TEST_DESCRIPTION("Copies made and dropped on other threads leave the count consistent");
+    Cow<Table> original;
+    original.write().values[0] = 1;
+    Thread threads[4];
+    for(auto &thread : threads)
+        ASSERT_TRUE(thread.start(Function<void()>([&original]() {
+            for(int i = 0; i < 10000; i++) {
+                Cow<Table> copy(original);
+                EXPECT_EQ(1, copy->values[0]);
+            }
+        })));
+    for(auto &thread : threads)
+        thread.join();
+    EXPECT_EQ(1u, original.useCount());
+    Table::copies = 0;
+    original.write().values[0] = 2;
+    EXPECT_EQ(0, Table::copies);
+}
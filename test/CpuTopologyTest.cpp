@@ -0,0 +1,49 @@
+#include "common.h"
+#include "hyper/CpuTopology.h"
+
+using namespace hyper;
+
+TEST(CpuTopology, Counts) {
+    TEST_DESCRIPTION("There should be at least one of everything, and no more cores than logical CPUs");
+    CpuTopology topology;
+    EXPECT_GE(topology.logicalCount(), 1u);
+    EXPECT_GE(topology.coreCount(), 1u);
+    EXPECT_GE(topology.cacheCount(), 1u);
+    EXPECT_GE(topology.packageCount(), 1u);
+    EXPECT_LE(topology.coreCount(), topology.logicalCount());
+    EXPECT_LE(topology.cacheCount(), topology.logicalCount());
+    EXPECT_LE(topology.packageCount(), topology.cacheCount());
+}
+
+TEST(CpuTopology, DenseGroups) {
+    TEST_DESCRIPTION("Group indices should be in range and every group should be used");
+    CpuTopology topology;
+    bool coreUsed[1024] = {};
+    for(size_t i = 0; i < topology.logicalCount(); i++) {
+        const auto &cpu = topology.logical(i);
+        ASSERT_LT(cpu.core, topology.coreCount());
+        EXPECT_LT(cpu.cache, topology.cacheCount());
+        EXPECT_LT(cpu.package, topology.packageCount());
+        if(cpu.core < 1024)
+            coreUsed[cpu.core] = true;
+    }
+    for(size_t core = 0; core < topology.coreCount() && core < 1024; core++)
+        EXPECT_TRUE(coreUsed[core]);
+}
+
+TEST(CpuTopology, PrimaryCpu) {
+    TEST_DESCRIPTION("The primary CPU of a core should be a logical CPU on that core");
+    CpuTopology topology;
+    for(size_t core = 0; core < topology.coreCount(); core++) {
+        const auto primary = topology.primaryCpu(core);
+        bool found = false;
+        for(size_t i = 0; i < topology.logicalCount(); i++) {
+            const auto &cpu = topology.logical(i);
+            if(cpu.id == primary) {
+                EXPECT_EQ(core, cpu.core);
+                found = true;
+            }
+        }
+        EXPECT_TRUE(found);
+    }
+}
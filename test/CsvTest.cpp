@@ -0,0 +1,208 @@
+#include <cstdlib>
+#include <cstring>
+#include "common.h"
+#include "hyper/Csv.h"
+
+using namespace hyper;
+
+namespace {
+    const byte *bytes(const char *text) {
+        return reinterpret_cast<const byte *>(text);
+    }
+
+    /// @brief Appends each field of every record to a buffer, unescaped, ending fields with 0x1 and records with 0x2.
+    size_t flatten(CsvReader &reader, char *output) {
+        size_t length = 0;
+        while(reader.next()) {
+            for(size_t i = 0; i < reader.fieldCount(); i++) {
+                length += reader.field(i).unescape(output + length);
+                output[length++] = '\x01';
+            }
+            output[length++] = '\x02';
+        }
+        return length;
+    }
+
+    /// @brief Byte-at-a-time reader with the same rules, to check the vectorized one against.
+    size_t flattenNaive(const char *text, size_t size, char delimiter, char *output) {
+        size_t length = 0;
+        size_t start = 0;
+        size_t fields = 0;
+        bool inQuotes = false;
+        for(size_t i = 0; i <= size; i++) {
+            if(i < size && text[i] == '"')
+                inQuotes = !inQuotes;
+            const bool end = i == size;
+            if(!end && (inQuotes || (text[i] != delimiter && text[i] != '\n')))
+                continue;
+            const bool lineEnd = end || text[i] == '\n';
+            size_t stop = i;
+            if(lineEnd && stop > start && text[stop - 1] == '\r')
+                stop--;
+            if(lineEnd && fields == 0 && stop == start) {
+                start = i + 1;
+                continue;
+            }
+            if(stop > start && text[start] == '"') {
+                size_t close = stop;
+                while(close > start + 1 && text[close - 1] != '"')
+                    close--;
+                if(close == start + 1)
+                    close = stop + 1;
+                for(size_t k = start + 1; k < close - 1; k++) {
+                    output[length++] = text[k];
+                    if(text[k] == '"' && k + 1 < close - 1 && text[k + 1] == '"')
+                        k++;
+                }
+            } else {
+                for(size_t k = start; k < stop; k++)
+                    output[length++] = text[k];
+            }
+            output[length++] = '\x01';
+            fields++;
+            start = i + 1;
+            if(lineEnd) {
+                output[length++] = '\x02';
+                fields = 0;
+            }
+        }
+        return length;
+    }
+}
+
+TEST(Csv, Records) {
+    TEST_DESCRIPTION("Records should be split into fields, with quotes removed and empty lines skipped");
+    const char *text = "id,name,score\r\n1,\"Smith, J\",9.5\n\n2,\"say \"\"hi\"\"\",\n3,\"multi\nline\",-4";
+    CsvReader reader(bytes(text), strlen(text));
+    ASSERT_TRUE(reader.next());
+    ASSERT_EQ(3u, reader.fieldCount());
+    EXPECT_TRUE(reader.field(0) == "id");
+    EXPECT_TRUE(reader.field(2) == "score");
+
+    ASSERT_TRUE(reader.next());
+    ASSERT_EQ(3u, reader.fieldCount());
+    int64 id = 0;
+    EXPECT_TRUE(reader.field(0).toInt64(id));
+    EXPECT_EQ(1, id);
+    EXPECT_TRUE(reader.field(1) == "Smith, J");
+    EXPECT_TRUE(reader.field(1).quoted);
+    float64 score = 0;
+    EXPECT_TRUE(reader.field(2).toDouble(score));
+    EXPECT_EQ(9.5, score);
+
+    ASSERT_TRUE(reader.next());
+    ASSERT_EQ(3u, reader.fieldCount());
+    char buffer[32];
+    const size_t length = reader.field(1).unescape(buffer);
+    EXPECT_EQ(8u, length);
+    EXPECT_EQ(0, memcmp("say \"hi\"", buffer, length));
+    EXPECT_EQ(0u, reader.field(2).size);
+
+    ASSERT_TRUE(reader.next());
+    ASSERT_EQ(3u, reader.fieldCount());
+    EXPECT_TRUE(reader.field(1) == "multi\nline");
+    EXPECT_TRUE(reader.field(2).toInt64(id));
+    EXPECT_EQ(-4, id);
+    EXPECT_FALSE(reader.next());
+    EXPECT_FALSE(reader.next());
+}
+
+TEST(Csv, Tabs) {
+    TEST_DESCRIPTION("Tab-separated values should be read with a tab delimiter");
+    const char *text = "a\tb,c\t\n\t";
+    CsvReader reader(bytes(text), strlen(text), '\t');
+    ASSERT_TRUE(reader.next());
+    ASSERT_EQ(3u, reader.fieldCount());
+    EXPECT_TRUE(reader.field(1) == "b,c");
+    EXPECT_TRUE(reader.field(2) == "");
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(2u, reader.fieldCount());
+    EXPECT_FALSE(reader.next());
+}
+
+TEST(Csv, CompareNullByte) {
+    TEST_DESCRIPTION("A field with a null byte where the string ends should not match the string");
+    const char data[] = {'a', 'b', '\0', 'c'};
+    const CsvField field{data, sizeof(data), false};
+    EXPECT_FALSE(field == "ab");
+    EXPECT_FALSE(field == "");
+    EXPECT_TRUE((CsvField{data, 2, false} == "ab"));
+}
+
+TEST(Csv, Empty) {
+    TEST_DESCRIPTION("Input with only blank lines should have no records");
+    CsvReader empty(nullptr, 0);
+    EXPECT_FALSE(empty.next());
+    const char *text = "\n\r\n\n";
+    CsvReader blank(bytes(text), strlen(text));
+    EXPECT_FALSE(blank.next());
+}
+
+TEST(Csv, ManyFields) {
+    TEST_DESCRIPTION("Records wider than the initial field array should keep every field");
+    char text[1024];
+    size_t length = 0;
+    for(int i = 0; i < 100; i++)
+        length += static_cast<size_t>(snprintf(text + length, sizeof(text) - length, "%s%d", i == 0 ? "" : ",", i));
+    CsvReader reader(bytes(text), length);
+    ASSERT_TRUE(reader.next());
+    ASSERT_EQ(100u, reader.fieldCount());
+    for(size_t i = 0; i < 100; i++) {
+        uint64 value = 0;
+        EXPECT_TRUE(reader.field(i).toUInt64(value));
+        EXPECT_EQ(i, value);
+    }
+}
+
+TEST(Csv, RandomAgainstNaive) {
+    TEST_DESCRIPTION("Random text should be split the same as a byte-at-a-time reader");
+    srand(11);
+    const char alphabet[] = "ab,\"\n\r\t1";
+    static char text[4096], expected[8192], actual[8192];
+    for(int round = 0; round < 500; round++) {
+        const size_t size = static_cast<size_t>(rand()) % sizeof(text);
+        for(size_t i = 0; i < size; i++)
+            text[i] = alphabet[rand() % (sizeof(alphabet) - 1)];
+        const char delimiter = round % 2 == 0 ? ',' : '\t';
+        CsvReader reader(bytes(text), size, delimiter);
+        const size_t length = flatten(reader, actual);
+        ASSERT_EQ(flattenNaive(text, size, delimiter, expected), length);
+        ASSERT_EQ(0, memcmp(expected, actual, length));
+    }
+}
+
+TEST(Csv, Split) {
+    TEST_DESCRIPTION("Chunks from split() should read as the same records as the whole input");
+    srand(5);
+    static char text[1 << 16], expected[1 << 17], actual[1 << 17];
+    size_t size = 0;
+    while(size < sizeof(text) - 64) {
+        const int kind = rand() % 4;
+        if(kind == 0)
+            size += static_cast<size_t>(snprintf(text + size, 64, "%d,", rand()));
+        else if(kind == 1)
+            size += static_cast<size_t>(snprintf(text + size, 64, "\"q\n,\"\"%d\",", rand() % 100));
+        else if(kind == 2)
+            size += static_cast<size_t>(snprintf(text + size, 64, "x\n"));
+        else
+            size += static_cast<size_t>(snprintf(text + size, 64, "\"long quoted field spanning, many bytes\n\n\"\n"));
+    }
+    CsvReader whole(bytes(text), size);
+    const size_t length = flatten(whole, expected);
+
+    for(size_t workers = 1; workers <= 8; workers++) {
+        WorkerPool pool(workers);
+        size_t boundaries[9];
+        CsvReader::split(pool, bytes(text), size, boundaries);
+        EXPECT_EQ(0u, boundaries[0]);
+        EXPECT_EQ(size, boundaries[workers]);
+        size_t total = 0;
+        for(size_t i = 0; i < workers; i++) {
+            ASSERT_LE(boundaries[i], boundaries[i + 1]);
+            CsvReader reader(bytes(text) + boundaries[i], boundaries[i + 1] - boundaries[i]);
+            total += flatten(reader, actual + total);
+        }
+        ASSERT_EQ(length, total);
+        EXPECT_EQ(0, memcmp(expected, actual, length));
+    }
+}
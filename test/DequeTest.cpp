@@ -0,0 +1,139 @@
+#include "common.h"
+#include "hyper/Deque.h"
+
+using namespace hyper;
+
+namespace {
+    struct Tracked {
+        static int live;
+
+        int value;
+
+        explicit Tracked(int value) noexcept
+                : value(value) {
+            live++;
+        }
+
+        Tracked(const Tracked &other) noexcept
+                : value(other.value) {
+            live++;
+        }
+
+        Tracked(Tracked &&other) noexcept
+                : value(other.value) {
+            live++;
+        }
+
+        ~Tracked() noexcept {
+            live--;
+        }
+
+        Tracked &operator=(const Tracked &other) = delete;
+    };
+
+    int Tracked::live = 0;
+}
+
+TEST(Deque, Empty) {
+    TEST_DESCRIPTION("A new deque should be empty");
+    Deque<int> deque;
+    EXPECT_TRUE(deque.isEmpty());
+    EXPECT_EQ(0u, deque.size());
+}
+
+TEST(Deque, PushBackPopFront) {
+    TEST_DESCRIPTION("Used as a queue, elements should come out in the order they went in");
+    Deque<int> deque;
+    for(int i = 0; i < 1000; i++)
+        deque.pushBack(i);
+    EXPECT_EQ(1000u, deque.size());
+    EXPECT_EQ(0, deque.front());
+    EXPECT_EQ(999, deque.back());
+    for(int i = 0; i < 1000; i++)
+        EXPECT_EQ(i, deque.popFront());
+    EXPECT_TRUE(deque.isEmpty());
+}
+
+TEST(Deque, PushFrontPopFront) {
+    TEST_DESCRIPTION("Used as a stack at the front, elements should come out in reverse order");
+    Deque<int> deque;
+    for(int i = 0; i < 1000; i++)
+        deque.pushFront(i);
+    for(int i = 999; i >= 0; i--)
+        EXPECT_EQ(i, deque.popFront());
+    EXPECT_TRUE(deque.isEmpty());
+}
+
+TEST(Deque, BothEnds) {
+    TEST_DESCRIPTION("Pushing at both ends should keep elements in order");
+    Deque<int> deque;
+    for(int i = 0; i < 300; i++) {
+        deque.pushBack(i);
+        deque.pushFront(-i - 1);
+    }
+    ASSERT_EQ(600u, deque.size());
+    for(size_t i = 0; i < 600; i++)
+        EXPECT_EQ(static_cast<int>(i) - 300, deque[i]);
+    EXPECT_EQ(299, deque.popBack());
+    EXPECT_EQ(-300, deque.popFront());
+}
+
+TEST(Deque, StableAddresses) {
+    TEST_DESCRIPTION("Elements should not move as the deque grows at either end");
+    Deque<int> deque;
+    int *pointers[64];
+    for(int i = 0; i < 64; i++)
+        pointers[i] = &deque.pushBack(i);
+    for(int i = 0; i < 5000; i++) {
+        deque.pushBack(i);
+        deque.pushFront(i);
+    }
+    for(int i = 0; i < 64; i++)
+        EXPECT_EQ(i, *pointers[i]);
+}
+
+TEST(Deque, SlidingWindow) {
+    TEST_DESCRIPTION("A queue that keeps moving forward should reuse its blocks");
+    Deque<int> deque;
+    for(int i = 0; i < 10; i++)
+        deque.pushBack(i);
+    for(int i = 10; i < 100000; i++) {
+        deque.pushBack(i);
+        EXPECT_EQ(i - 10, deque.popFront());
+    }
+    EXPECT_EQ(10u, deque.size());
+}
+
+TEST(Deque, Iterate) {
+    TEST_DESCRIPTION("Iterating should visit elements from front to back");
+    Deque<int> deque;
+    for(int i = 0; i < 100; i++)
+        deque.pushBack(i);
+    int expected = 0;
+    for(auto value : deque)
+        EXPECT_EQ(expected++, value);
+    EXPECT_EQ(100, expected);
+    const auto &constant = deque;
+    int sum = 0;
+    for(auto &value : constant)
+        sum += value;
+    EXPECT_EQ(4950, sum);
+}
+
+TEST(Deque, DestroysElements) {
+    TEST_DESCRIPTION("Clearing and destroying the deque should destroy every element");
+    const auto before = Tracked::live;
+    {
+        Deque<Tracked> deque;
+        for(int i = 0; i < 100; i++)
+            deque.pushBack(Tracked(i));
+        deque.popFront();
+        deque.popBack();
+        EXPECT_EQ(before + 98, Tracked::live);
+        deque.clear();
+        EXPECT_EQ(before, Tracked::live);
+        for(int i = 0; i < 50; i++)
+            deque.pushFront(Tracked(i));
+    }
+    EXPECT_EQ(before, Tracked::live);
+}
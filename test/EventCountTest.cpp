@@ -0,0 +1,78 @@
+#include "common.h"
+#include "hyper/EventCount.h"
+#include "hyper/Thread.h"
+
+using namespace hyper;
+
+TEST(EventCount, NotifyWithoutWaiters) {
+    TEST_DESCRIPTION("Notifying with nobody waiting should do nothing");
+    EventCount events;
+    events.notify();
+    events.notifyAll();
+    const auto key = events.prepareWait();
+    events.cancelWait();
+    EXPECT_EQ(key, events.prepareWait());
+    events.cancelWait();
+}
+
+TEST(EventCount, NotifyBeforeWait) {
+    TEST_DESCRIPTION("A notification between preparing and waiting should not be lost");
+    EventCount events;
+    const auto key = events.prepareWait();
+    events.notify();
+    events.wait(key);
+}
+
+TEST(EventCount, Consumer) {
+    TEST_DESCRIPTION("A consumer should sleep until items are published and see every one");
+    constexpr uint32 count = 10000;
+    EventCount events;
+    uint32 published = 0;
+    uint32 consumed = 0;
+    Thread consumer;
+    ASSERT_TRUE(consumer.start(Function<void()>([&]() {
+        while(consumed < count) {
+            if(__atomic_load_n(&published, __ATOMIC_ACQUIRE) > consumed) {
+                consumed++;
+                continue;
+            }
+            const auto key = events.prepareWait();
+            if(__atomic_load_n(&published, __ATOMIC_ACQUIRE) > consumed) {
+                events.cancelWait();
+                continue;
+            }
+            events.wait(key);
+        }
+    })));
+    for(uint32 i = 0; i < count; i++) {
+        __atomic_add_fetch(&published, 1, __ATOMIC_RELEASE);
+        events.notify();
+    }
+    consumer.join();
+    EXPECT_EQ(count, consumed);
+}
+
+TEST(EventCount, NotifyAll) {
+    TEST_DESCRIPTION("Notifying all should wake every waiting thread");
+    EventCount events;
+    bool flag = false;
+    int woken = 0;
+    Thread threads[4];
+    for(auto &thread : threads)
+        ASSERT_TRUE(thread.start(Function<void()>([&]() {
+            while(!__atomic_load_n(&flag, __ATOMIC_ACQUIRE)) {
+                const auto key = events.prepareWait();
+                if(__atomic_load_n(&flag, __ATOMIC_ACQUIRE)) {
+                    events.cancelWait();
+                    break;
+                }
+                events.wait(key);
+            }
+            __atomic_add_fetch(&woken, 1, __ATOMIC_RELAXED);
+        })));
+    __atomic_store_n(&flag, true, __ATOMIC_RELEASE);
+    events.notifyAll();
+    for(auto &thread : threads)
+        thread.join();
+    EXPECT_EQ(4, woken);
+}
@@ -0,0 +1,116 @@
+#include <unistd.h>
+#include "common.h"
+#include "hyper/EventLoop.h"
+#include "util/DestructorSpy.h"
+
+using namespace hyper;
+
+TEST(EventLoop, Empty) {
+    TEST_DESCRIPTION("Running a loop with no tasks should return immediately");
+    EventLoop loop;
+    loop.run();
+    EXPECT_FALSE(loop.runOnce());
+}
+
+TEST(EventLoop, Yield) {
+    TEST_DESCRIPTION("Yielding tasks should take turns");
+    EventLoop loop;
+    char order[7] = {};
+    int position = 0;
+    auto worker = [&](char name) -> Task<> {
+        for(int i = 0; i < 3; i++) {
+            order[position++] = name;
+            co_await loop.yield();
+        }
+    };
+    loop.spawn(worker('a'));
+    loop.spawn(worker('b'));
+    loop.run();
+    EXPECT_STREQ("ababab", order);
+}
+
+TEST(EventLoop, Sleep) {
+    TEST_DESCRIPTION("Sleeping tasks should wake up in deadline order after their duration");
+    EventLoop loop;
+    int order[3] = {};
+    int position = 0;
+    auto sleeper = [&](int id, uint64 milliseconds) -> Task<> {
+        const auto start = EventLoop::now();
+        co_await loop.sleep(milliseconds * 1000000);
+        EXPECT_GE(EventLoop::now() - start, milliseconds * 1000000);
+        order[position++] = id;
+    };
+    loop.spawn(sleeper(1, 30));
+    loop.spawn(sleeper(2, 10));
+    loop.spawn(sleeper(3, 20));
+    loop.run();
+    EXPECT_EQ(2, order[0]);
+    EXPECT_EQ(3, order[1]);
+    EXPECT_EQ(1, order[2]);
+}
+
+TEST(EventLoop, Readable) {
+    TEST_DESCRIPTION("A task waiting on a pipe should resume once data is written to it");
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    EventLoop loop;
+    char received = 0;
+    auto reader = [&]() -> Task<> {
+        auto ready = co_await loop.readable(fds[0]);
+        EXPECT_TRUE(ready.isOk());
+        EXPECT_EQ(1, read(fds[0], &received, 1));
+    };
+    auto writer = [&]() -> Task<> {
+        co_await loop.sleep(1000000);
+        auto ready = co_await loop.writable(fds[1]);
+        EXPECT_TRUE(ready.isOk());
+        EXPECT_EQ(1, write(fds[1], "x", 1));
+    };
+    loop.spawn(reader());
+    loop.spawn(writer());
+    loop.run();
+    EXPECT_EQ('x', received);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(EventLoop, InvalidDescriptor) {
+    TEST_DESCRIPTION("Waiting on an invalid file descriptor should produce an error");
+    EventLoop loop;
+    bool failed = false;
+    auto task = [&]() -> Task<> {
+        auto ready = co_await loop.readable(-5 + 1000);
+        failed = !ready.isOk();
+    };
+    loop.spawn(task());
+    loop.run();
+    EXPECT_TRUE(failed);
+}
+
+TEST(EventLoop, DestroysPendingTasks) {
+    TEST_DESCRIPTION("Destroying a loop should destroy suspended tasks and the tasks they are awaiting");
+    int callCount = 0;
+    {
+        EventLoop loop;
+        auto inner = [&]() -> Task<int> {
+            DestructorSpy spy(&callCount);
+            co_await loop.sleep(1000000000000);
+            co_return 1;
+        };
+        auto outer = [&]() -> Task<> {
+            DestructorSpy spy(&callCount);
+            co_await inner();
+        };
+        auto yielder = [&]() -> Task<> {
+            DestructorSpy spy(&callCount);
+            for(;;)
+                co_await loop.yield();
+        };
+        loop.spawn(outer());
+        loop.spawn(yielder());
+        loop.spawn(outer());
+        EXPECT_TRUE(loop.runOnce());
+        EXPECT_EQ(0, callCount);
+    }
+    EXPECT_EQ(5, callCount);
+}
@@ -0,0 +1,63 @@
+#include "common.h"
+#include "hyper/Generator.h"
+#include "hyper/integer.h"
+
+using namespace hyper;
+
+namespace {
+    Generator<int> range(int count) {
+        for(int i = 0; i < count; i++)
+            co_yield i;
+    }
+
+    Generator<uint64> fibonacci() {
+        uint64 a = 0, b = 1;
+        while(true) {
+            co_yield a;
+            const auto next = a + b;
+            a = b;
+            b = next;
+        }
+    }
+}
+
+TEST(Generator, Next) {
+    TEST_DESCRIPTION("Each call to next should produce the next value until the coroutine finishes");
+    auto generator = range(3);
+    for(int i = 0; i < 3; i++) {
+        ASSERT_TRUE(generator.next());
+        EXPECT_EQ(i, generator.value());
+    }
+    EXPECT_FALSE(generator.next());
+    EXPECT_TRUE(generator.isDone());
+}
+
+TEST(Generator, RangeFor) {
+    TEST_DESCRIPTION("Generators should work in range-based for loops");
+    int total = 0, count = 0;
+    for(auto value : range(10)) {
+        total += value;
+        count++;
+    }
+    EXPECT_EQ(10, count);
+    EXPECT_EQ(45, total);
+}
+
+TEST(Generator, Empty) {
+    TEST_DESCRIPTION("A generator that yields nothing should end the loop immediately");
+    int count = 0;
+    for(auto value : range(0))
+        count += value + 1;
+    EXPECT_EQ(0, count);
+}
+
+TEST(Generator, Endless) {
+    TEST_DESCRIPTION("An endless generator should only compute the values that are consumed");
+    auto generator = fibonacci();
+    uint64 value = 0;
+    for(int i = 0; i <= 50; i++) {
+        ASSERT_TRUE(generator.next());
+        value = generator.value();
+    }
+    EXPECT_EQ(12586269025ull, value);
+}
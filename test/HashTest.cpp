@@ -0,0 +1,55 @@
+#include "common.h"
+#include "hyper/hash.h"
+
+using namespace hyper;
+
+TEST(hash, Deterministic) {
+    TEST_DESCRIPTION("Hashing the same bytes should always produce the same hash");
+    const char text[] = "the quick brown fox jumps over the lazy dog";
+    auto data = reinterpret_cast<const byte *>(text);
+    EXPECT_EQ(hash(data, sizeof(text)), hash(data, sizeof(text)));
+}
+
+TEST(hash, Seed) {
+    TEST_DESCRIPTION("Different seeds should produce different hashes");
+    const char text[] = "hyper";
+    auto data = reinterpret_cast<const byte *>(text);
+    EXPECT_NE(hash(data, 5, 1), hash(data, 5, 2));
+}
+
+TEST(hash, EveryLength) {
+    TEST_DESCRIPTION("Every byte of keys of every length should affect the hash");
+    byte data[100] = {};
+    for(size_t size = 1; size <= 100; size++) {
+        const auto original = hash(data, size);
+        for(size_t i = 0; i < size; i++) {
+            data[i] = byte(1);
+            EXPECT_NE(original, hash(data, size)) << "Length " << size << ", byte " << i;
+            data[i] = byte(0);
+        }
+    }
+}
+
+TEST(hash, Length) {
+    TEST_DESCRIPTION("Keys that differ only in length should have different hashes");
+    byte data[32] = {};
+    for(size_t size = 0; size < 32; size++)
+        EXPECT_NE(hash(data, size), hash(data, size + 1));
+}
+
+TEST(hash, Integer) {
+    TEST_DESCRIPTION("Consecutive integers should hash to well-spread values");
+    EXPECT_EQ(0u, hash(uint64(0)));
+    EXPECT_NE(hash(uint64(1)), hash(uint64(2)));
+    // Roughly half of the bits should flip between neighbors.
+    const auto flipped = __builtin_popcountll(hash(uint64(1)) ^ hash(uint64(2)));
+    EXPECT_GT(flipped, 16);
+    EXPECT_LT(flipped, 48);
+}
+
+TEST(hash, ReduceRange) {
+    TEST_DESCRIPTION("Reducing should map hashes evenly onto the range, keeping the lowest and highest values at its ends");
+    EXPECT_EQ(0u, reduceRange(0, 10));
+    EXPECT_EQ(9u, reduceRange(maxValue<uint64>(), 10));
+    EXPECT_EQ(5u, reduceRange(uint64(1) << 63, 10));
+}
@@ -0,0 +1,206 @@
+#include "common.h"
+#include "hyper/HazardPointer.h"
+#include "hyper/SpinLock.h"
+#include "hyper/Thread.h"
+
+using namespace hyper;
+
+namespace {
+    struct Node {
+        static int live;
+
+        int value;
+        Node *next;
+
+        explicit Node(int value) noexcept
+                : value(value), next(nullptr) {
+            __atomic_add_fetch(&live, 1, __ATOMIC_RELAXED);
+        }
+
+        Node(const Node &other) = delete;
+
+        ~Node() noexcept {
+            __atomic_sub_fetch(&live, 1, __ATOMIC_RELAXED);
+        }
+
+        Node &operator=(const Node &other) = delete;
+    };
+
+    int Node::live = 0;
+
+    // Lock-free stack, the classic case where a popped node can still be read by another thread.
+    struct Stack {
+        HazardDomain &domain;
+        Node *head;
+
+        explicit Stack(HazardDomain &domain) noexcept
+                : domain(domain), head(nullptr) {
+            // ...
+        }
+
+        void push(int value) noexcept {
+            auto node = new Node(value);
+            node->next = __atomic_load_n(&head, __ATOMIC_RELAXED);
+            while(!__atomic_compare_exchange_n(&head, &node->next, node, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+                continue;
+        }
+
+        bool pop(int &value) noexcept {
+            HazardPointer hazard(domain);
+            while(true) {
+                auto node = hazard.protect(head);
+                if(node == nullptr)
+                    return false;
+                // The node is protected, so reading its next pointer is safe even if another thread pops it.
+                auto expected = node;
+                if(__atomic_compare_exchange_n(&head, &expected, node->next, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                    value = node->value;
+                    hazard.clear();
+                    domain.retire(node);
+                    return true;
+                }
+            }
+        }
+    };
+}
+
+TEST(HazardPointer, ReclaimUnprotected) {
+    TEST_DESCRIPTION("Retired objects that nobody protects should be freed");
+    const auto before = Node::live;
+    HazardDomain domain;
+    for(int i = 0; i < 10; i++)
+        domain.retire(new Node(i));
+    EXPECT_EQ(10u, domain.retiredCount());
+    EXPECT_EQ(10u, domain.reclaim());
+    EXPECT_EQ(0u, domain.retiredCount());
+    EXPECT_EQ(before, Node::live);
+}
+
+TEST(HazardPointer, KeepsProtected) {
+    TEST_DESCRIPTION("A protected object should survive scans until its hazard is cleared");
+    const auto before = Node::live;
+    HazardDomain domain;
+    auto shared = new Node(1);
+    HazardPointer hazard(domain);
+    EXPECT_EQ(shared, hazard.protect(shared));
+    auto retired = shared;
+    shared = nullptr;
+    domain.retire(retired);
+    domain.retire(new Node(2));
+    EXPECT_EQ(1u, domain.reclaim());
+    EXPECT_EQ(before + 1, Node::live);
+    EXPECT_EQ(1, retired->value);
+    hazard.clear();
+    EXPECT_EQ(1u, domain.reclaim());
+    EXPECT_EQ(before, Node::live);
+}
+
+TEST(HazardPointer, ProtectedByOtherThread) {
+    TEST_DESCRIPTION("An object protected by another thread should not be freed");
+    const auto before = Node::live;
+    HazardDomain domain;
+    auto shared = new Node(5);
+    bool holding = false;
+    bool release = false;
+    Thread reader;
+    ASSERT_TRUE(reader.start(Function<void()>([&]() {
+        HazardPointer hazard(domain);
+        hazard.protect(shared);
+        __atomic_store_n(&holding, true, __ATOMIC_RELEASE);
+        while(!__atomic_load_n(&release, __ATOMIC_ACQUIRE))
+            yieldThread();
+    })));
+    while(!__atomic_load_n(&holding, __ATOMIC_ACQUIRE))
+        yieldThread();
+    auto retired = shared;
+    __atomic_store_n(&shared, nullptr, __ATOMIC_RELEASE);
+    domain.retire(retired);
+    EXPECT_EQ(0u, domain.reclaim());
+    EXPECT_EQ(before + 1, Node::live);
+    __atomic_store_n(&release, true, __ATOMIC_RELEASE);
+    reader.join();
+    EXPECT_EQ(1u, domain.reclaim());
+    EXPECT_EQ(before, Node::live);
+}
+
+TEST(HazardPointer, ReclaimRetiresMore) {
+    TEST_DESCRIPTION("Freeing an object that retires others should not free anything twice");
+    struct Parent {
+        HazardDomain &domain;
+        Node *child;
+
+        ~Parent() noexcept {
+            domain.retire(child);
+        }
+    };
+    const auto before = Node::live;
+    {
+        HazardDomain domain;
+        // Enough to cross the scan threshold from inside a scan.
+        for(int i = 0; i < 200; i++)
+            domain.retire(new Parent{domain, new Node(i)});
+        domain.reclaim();
+        domain.reclaim();
+        EXPECT_EQ(0u, domain.retiredCount());
+    }
+    EXPECT_EQ(before, Node::live);
+}
+
+TEST(HazardPointer, DestroyFreesRetired) {
+    TEST_DESCRIPTION("Destroying the domain should free everything still retired");
+    const auto before = Node::live;
+    {
+        HazardDomain domain;
+        HazardPointer hazard(domain);
+        auto node = new Node(0);
+        hazard.reset(node);
+        domain.retire(node);
+    }
+    EXPECT_EQ(before, Node::live);
+}
+
+TEST(HazardPointer, SlotsReused) {
+    TEST_DESCRIPTION("Hazard slots should be given back when a hazard pointer is destroyed");
+    HazardDomain domain;
+    for(int i = 0; i < 100; i++) {
+        HazardPointer first(domain);
+        HazardPointer second(domain);
+        first.clear();
+        second.clear();
+    }
+}
+
+TEST(HazardPointer, ConcurrentStack) {
+    TEST_DESCRIPTION("Threads pushing and popping a lock-free stack should see every value exactly once");
+    constexpr int threadCount = 4;
+    constexpr int perThread = 5000;
+    const auto before = Node::live;
+    {
+        HazardDomain domain;
+        Stack stack(domain);
+        long sums[threadCount] = {};
+        Thread threads[threadCount];
+        for(int t = 0; t < threadCount; t++)
+            ASSERT_TRUE(threads[t].start(Function<void()>([&stack, &sums, t]() {
+                for(int i = 0; i < perThread; i++) {
+                    stack.push(t * perThread + i);
+                    int value;
+                    if(stack.pop(value))
+                        sums[t] += value;
+                }
+            })));
+        for(auto &thread : threads)
+            thread.join();
+        long total = 0;
+        for(auto sum : sums)
+            total += sum;
+        int value;
+        while(stack.pop(value))
+            total += value;
+        const long count = threadCount * perThread;
+        EXPECT_EQ(count * (count - 1) / 2, total);
+        // Memory waiting to be freed stays bounded by the scan threshold rather than growing with the work done.
+        EXPECT_LT(domain.retiredCount(), 1000u);
+    }
+    EXPECT_EQ(before, Node::live);
+}
@@ -0,0 +1,106 @@
+#include "common.h"
+#include "hyper/hash.h"
+#include "hyper/Heap.h"
+
+using namespace hyper;
+
+TEST(Heap, Empty) {
+    TEST_DESCRIPTION("A new heap should be empty");
+    Heap<int32> heap;
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_EQ(0u, heap.size());
+}
+
+TEST(Heap, PopsInOrder) {
+    TEST_DESCRIPTION("Elements should come out smallest first");
+    const size_t count = 1000;
+    Heap<uint64> heap;
+    for(size_t i = 0; i < count; i++)
+        heap.push(hash(i) % 300);
+    EXPECT_EQ(count, heap.size());
+    uint64 previous = 0;
+    for(size_t i = 0; i < count; i++) {
+        const auto top = heap.top();
+        const auto value = heap.pop();
+        EXPECT_EQ(top, value);
+        ASSERT_LE(previous, value);
+        previous = value;
+    }
+    EXPECT_TRUE(heap.isEmpty());
+}
+
+TEST(Heap, CustomLess) {
+    TEST_DESCRIPTION("The comparison should decide which element is on top");
+    auto greater = [](int32 first, int32 second) { return first > second; };
+    Heap<int32, decltype(greater)> heap(greater);
+    for(int32 value : {4, 9, -3, 12, 0})
+        heap.push(value);
+    EXPECT_EQ(12, heap.pop());
+    EXPECT_EQ(9, heap.pop());
+    EXPECT_EQ(4, heap.pop());
+}
+
+TEST(Heap, Interleaved) {
+    TEST_DESCRIPTION("Pushing between pops should keep the smallest element on top");
+    Heap<int32> heap;
+    int32 expected[200] = {};
+    size_t count = 0;
+    for(int32 round = 0; round < 200; round++) {
+        const auto value = static_cast<int32>(hash(static_cast<uint64>(round)) % 1000);
+        heap.push(value);
+        expected[count++] = value;
+        if(round % 3 == 2) {
+            size_t smallest = 0;
+            for(size_t i = 1; i < count; i++)
+                if(expected[i] < expected[smallest])
+                    smallest = i;
+            ASSERT_EQ(expected[smallest], heap.pop());
+            expected[smallest] = expected[--count];
+        }
+    }
+    EXPECT_EQ(count, heap.size());
+}
+
+namespace {
+    // Counts how many instances are alive, so leaks and double destruction show up.
+    struct Tracked {
+        int *live;
+        int32 value;
+
+        Tracked(int *live, int32 value) : live(live), value(value) {
+            (*live)++;
+        }
+
+        Tracked(const Tracked &other) : live(other.live), value(other.value) {
+            (*live)++;
+        }
+
+        ~Tracked() {
+            (*live)--;
+        }
+
+        Tracked &operator=(const Tracked &other) = default;
+
+        bool operator<(const Tracked &other) const {
+            return value < other.value;
+        }
+    };
+}
+
+TEST(Heap, DestroysElements) {
+    TEST_DESCRIPTION("Every element should be destroyed once, including those left in the heap");
+    int live = 0;
+    {
+        Heap<Tracked> heap;
+        for(int32 i = 0; i < 40; i++)
+            heap.push(Tracked(&live, 40 - i));
+        EXPECT_EQ(40, live);
+        EXPECT_EQ(1, heap.pop().value);
+        EXPECT_EQ(39, live);
+        heap.clear();
+        EXPECT_EQ(0, live);
+        for(int32 i = 0; i < 3; i++)
+            heap.push(Tracked(&live, i));
+    }
+    EXPECT_EQ(0, live);
+}
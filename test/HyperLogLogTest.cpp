@@ -0,0 +1,144 @@
+#include "common.h"
+#include "hyper/HyperLogLog.h"
+
+using namespace hyper;
+
+namespace {
+    void expectWithin(uint64 actual, uint64 expected, double tolerance) {
+        const auto error = (static_cast<double>(actual) - static_cast<double>(expected)) / static_cast<double>(expected);
+        EXPECT_LT(error < 0 ? -error : error, tolerance) << "estimate " << actual << " for " << expected;
+    }
+}
+
+TEST(HyperLogLog, Empty) {
+    TEST_DESCRIPTION("An empty sketch should estimate zero");
+    HyperLogLog sketch;
+    EXPECT_EQ(0u, sketch.estimate());
+    EXPECT_TRUE(sketch.isSparse());
+}
+
+TEST(HyperLogLog, SmallCardinalities) {
+    TEST_DESCRIPTION("Small cardinalities should be counted almost exactly in the sparse representation");
+    HyperLogLog sketch;
+    for(uint64 i = 0; i < 1000; i++) {
+        sketch.insertHash(hash(i));
+        sketch.insertHash(hash(i));
+    }
+    EXPECT_TRUE(sketch.isSparse());
+    expectWithin(sketch.estimate(), 1000, 0.005);
+}
+
+TEST(HyperLogLog, LargeCardinalities) {
+    TEST_DESCRIPTION("Large cardinalities should be estimated within a few standard errors");
+    HyperLogLog sketch(14);
+    for(uint64 i = 0; i < 1000000; i++)
+        sketch.insertHash(hash(i));
+    EXPECT_FALSE(sketch.isSparse());
+    expectWithin(sketch.estimate(), 1000000, 0.03);
+}
+
+TEST(HyperLogLog, SparseToDenseTransition) {
+    TEST_DESCRIPTION("Estimates should stay accurate across the switch to the dense representation");
+    HyperLogLog sketch(10);
+    for(uint64 count = 1; count <= 20000; count++) {
+        sketch.insertHash(hash(count));
+        if(count % 500 == 0)
+            expectWithin(sketch.estimate(), count, 0.12);
+    }
+    EXPECT_FALSE(sketch.isSparse());
+}
+
+TEST(HyperLogLog, ByteKeys) {
+    TEST_DESCRIPTION("Inserting the same byte key twice should count it once");
+    HyperLogLog sketch;
+    const char key[] = "player-42";
+    sketch.insert(reinterpret_cast<const byte *>(key), sizeof(key));
+    sketch.insert(reinterpret_cast<const byte *>(key), sizeof(key));
+    EXPECT_EQ(1u, sketch.estimate());
+}
+
+TEST(HyperLogLog, Merge) {
+    TEST_DESCRIPTION("Merging should give the same estimate as one sketch that saw every key");
+    HyperLogLog combined, first, second, sparse;
+    for(uint64 i = 0; i < 200000; i++) {
+        combined.insertHash(hash(i));
+        (i % 2 == 0 ? first : second).insertHash(hash(i));
+    }
+    for(uint64 i = 200000; i < 200100; i++) {
+        combined.insertHash(hash(i));
+        sparse.insertHash(hash(i));
+    }
+    ASSERT_TRUE(first.merge(second));
+    ASSERT_TRUE(first.merge(sparse));
+    EXPECT_EQ(combined.estimate(), first.estimate());
+}
+
+TEST(HyperLogLog, MergeSparse) {
+    TEST_DESCRIPTION("Merging sparse sketches should combine overlapping keys");
+    HyperLogLog first, second;
+    for(uint64 i = 0; i < 300; i++)
+        first.insertHash(hash(i));
+    for(uint64 i = 200; i < 500; i++)
+        second.insertHash(hash(i));
+    ASSERT_TRUE(first.merge(second));
+    EXPECT_TRUE(first.isSparse());
+    expectWithin(first.estimate(), 500, 0.01);
+}
+
+TEST(HyperLogLog, MergeDifferentPrecision) {
+    TEST_DESCRIPTION("Sketches with different precisions should not be merged");
+    HyperLogLog first(12), second(14);
+    second.insertHash(hash(uint64(1)));
+    EXPECT_FALSE(first.merge(second));
+    EXPECT_EQ(0u, first.estimate());
+}
+
+TEST(HyperLogLog, Clear) {
+    TEST_DESCRIPTION("Clearing should return the sketch to an empty sparse state");
+    HyperLogLog sketch(8);
+    for(uint64 i = 0; i < 10000; i++)
+        sketch.insertHash(hash(i));
+    sketch.clear();
+    EXPECT_TRUE(sketch.isSparse());
+    EXPECT_EQ(0u, sketch.estimate());
+}
+
+TEST(HyperLogLog, SerializeRoundTrip) {
+    TEST_DESCRIPTION("A deserialized sketch should match the original in both representations");
+    for(uint64 count : {uint64(100), uint64(100000)}) {
+        HyperLogLog sketch(12), copy(4);
+        for(uint64 i = 0; i < count; i++)
+            sketch.insertHash(hash(i));
+        const auto size = sketch.serializedSize();
+        auto buffer = new byte[size];
+        ASSERT_EQ(size, sketch.serialize(buffer));
+        ASSERT_TRUE(copy.deserialize(buffer, size));
+        EXPECT_EQ(12, copy.precision());
+        EXPECT_EQ(sketch.isSparse(), copy.isSparse());
+        EXPECT_EQ(sketch.estimate(), copy.estimate());
+        delete[] buffer;
+    }
+}
+
+TEST(HyperLogLog, DeserializeInvalid) {
+    TEST_DESCRIPTION("Corrupt or truncated data should be rejected without changing the sketch");
+    HyperLogLog sketch(10);
+    for(uint64 i = 0; i < 50; i++)
+        sketch.insertHash(hash(i));
+    const auto size = sketch.serializedSize();
+    auto buffer = new byte[size];
+    sketch.serialize(buffer);
+
+    HyperLogLog target;
+    target.insertHash(hash(uint64(7)));
+    EXPECT_FALSE(target.deserialize(buffer, size - 1));
+    EXPECT_FALSE(target.deserialize(buffer, 2));
+    buffer[0] = byte(0);
+    EXPECT_FALSE(target.deserialize(buffer, size));
+    buffer[0] = byte(0x48);
+    buffer[2] = byte(30);
+    EXPECT_FALSE(target.deserialize(buffer, size));
+    EXPECT_EQ(14, target.precision());
+    EXPECT_EQ(1u, target.estimate());
+    delete[] buffer;
+}
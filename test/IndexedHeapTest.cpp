@@ -0,0 +1,133 @@
+#include "common.h"
+#include "hyper/hash.h"
+#include "hyper/IndexedHeap.h"
+
+using namespace hyper;
+
+TEST(IndexedHeap, PopsInOrder) {
+    TEST_DESCRIPTION("Items should come out in order of priority");
+    IndexedHeap<int32> heap(5);
+    heap.push(0, 50);
+    heap.push(1, 10);
+    heap.push(2, 30);
+    heap.push(3, 20);
+    EXPECT_EQ(4u, heap.size());
+    EXPECT_EQ(1u, heap.top());
+    EXPECT_EQ(10, heap.topPriority());
+    EXPECT_EQ(1u, heap.pop());
+    EXPECT_EQ(3u, heap.pop());
+    EXPECT_EQ(2u, heap.pop());
+    EXPECT_EQ(0u, heap.pop());
+    EXPECT_TRUE(heap.isEmpty());
+}
+
+TEST(IndexedHeap, Contains) {
+    TEST_DESCRIPTION("Only items that were pushed and not removed should be in the heap");
+    IndexedHeap<int32> heap(4);
+    heap.push(2, 7);
+    EXPECT_TRUE(heap.contains(2));
+    EXPECT_FALSE(heap.contains(1));
+    EXPECT_FALSE(heap.contains(100));
+    EXPECT_EQ(7, heap.priority(2));
+    heap.pop();
+    EXPECT_FALSE(heap.contains(2));
+}
+
+TEST(IndexedHeap, PushOrDecrease) {
+    TEST_DESCRIPTION("Relaxing an item should only ever lower its priority");
+    IndexedHeap<int32> heap(3);
+    EXPECT_TRUE(heap.pushOrDecrease(0, 10));
+    EXPECT_TRUE(heap.pushOrDecrease(1, 20));
+    EXPECT_FALSE(heap.pushOrDecrease(0, 15));
+    EXPECT_EQ(10, heap.priority(0));
+    EXPECT_TRUE(heap.pushOrDecrease(1, 5));
+    EXPECT_EQ(1u, heap.top());
+}
+
+TEST(IndexedHeap, Update) {
+    TEST_DESCRIPTION("Raising and lowering priorities should reorder the heap");
+    IndexedHeap<int32> heap(3);
+    heap.push(0, 1);
+    heap.push(1, 2);
+    heap.push(2, 3);
+    heap.update(0, 10);
+    EXPECT_EQ(1u, heap.top());
+    heap.update(2, 0);
+    EXPECT_EQ(2u, heap.pop());
+    EXPECT_EQ(1u, heap.pop());
+    EXPECT_EQ(0u, heap.pop());
+}
+
+TEST(IndexedHeap, Erase) {
+    TEST_DESCRIPTION("Erased items should be skipped and can be pushed again");
+    IndexedHeap<int32> heap(100);
+    for(size_t i = 0; i < 100; i++)
+        heap.push(i, static_cast<int32>(hash(i) % 1000));
+    for(size_t i = 0; i < 100; i += 2)
+        EXPECT_TRUE(heap.erase(i));
+    EXPECT_FALSE(heap.erase(0));
+    EXPECT_EQ(50u, heap.size());
+    int32 previous = -1;
+    while(!heap.isEmpty()) {
+        const auto priority = heap.topPriority();
+        const auto item = heap.pop();
+        EXPECT_EQ(1u, item % 2);
+        ASSERT_LE(previous, priority);
+        previous = priority;
+    }
+    heap.push(0, 3);
+    EXPECT_EQ(0u, heap.pop());
+}
+
+TEST(IndexedHeap, ShortestPaths) {
+    TEST_DESCRIPTION("Dijkstra's algorithm on a grid should find the same distances as repeated relaxation");
+    constexpr size_t width = 24;
+    constexpr size_t count = width * width;
+    uint32 cost[count];
+    for(size_t i = 0; i < count; i++)
+        cost[i] = 1 + static_cast<uint32>(hash(i) % 9);
+    auto neighbors = [](size_t node, size_t *out) {
+        size_t found = 0;
+        const size_t x = node % width, y = node / width;
+        if(x > 0) out[found++] = node - 1;
+        if(x + 1 < width) out[found++] = node + 1;
+        if(y > 0) out[found++] = node - width;
+        if(y + 1 < width) out[found++] = node + width;
+        return found;
+    };
+
+    uint32 distance[count];
+    bool settled[count] = {};
+    IndexedHeap<uint32> heap(count);
+    heap.push(0, 0);
+    while(!heap.isEmpty()) {
+        const auto current = heap.topPriority();
+        const auto node = heap.pop();
+        distance[node] = current;
+        settled[node] = true;
+        size_t next[4];
+        for(size_t i = neighbors(node, next); i-- > 0;)
+            if(!settled[next[i]])
+                heap.pushOrDecrease(next[i], current + cost[next[i]]);
+    }
+
+    // Bellman-Ford style relaxation until nothing changes.
+    uint32 expected[count];
+    for(auto &value : expected)
+        value = 0xFFFFFFFF;
+    expected[0] = 0;
+    for(bool changed = true; changed;) {
+        changed = false;
+        for(size_t node = 0; node < count; node++) {
+            size_t next[4];
+            for(size_t i = neighbors(node, next); i-- > 0;) {
+                if(expected[node] != 0xFFFFFFFF && expected[node] + cost[next[i]] < expected[next[i]]) {
+                    expected[next[i]] = expected[node] + cost[next[i]];
+                    changed = true;
+                }
+            }
+        }
+    }
+    for(size_t i = 0; i < count; i++)
+        ASSERT_EQ(expected[i], distance[i]) << "node " << i;
+}
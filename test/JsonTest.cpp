@@ -0,0 +1,221 @@
+#include <cstdio>
+#include <cstring>
+#include "common.h"
+#include "hyper/Json.h"
+
+using namespace hyper;
+
+namespace {
+    Result<void> parse(JsonDocument &document, const char *text) {
+        return document.parse(reinterpret_cast<const byte *>(text), strlen(text));
+    }
+
+    JsonErrorCode parseError(const char *text) {
+        JsonDocument document;
+        const auto result = parse(document, text);
+        if(result.isOk())
+            return JsonErrorCode::Empty;
+        return static_cast<const JsonError &>(*result.error()).code();
+    }
+
+    bool sameString(const JsonString &string, const char *text, size_t size) {
+        return string.size == size && memcmp(string.data, text, size) == 0;
+    }
+}
+
+TEST(Json, Scalars) {
+    TEST_DESCRIPTION("Top-level scalars should parse to their types and values");
+    JsonDocument document;
+    ASSERT_TRUE(parse(document, "null").isOk());
+    EXPECT_TRUE(document.root().isNull());
+    ASSERT_TRUE(parse(document, " true ").isOk());
+    EXPECT_TRUE(document.root().getBool().value());
+    ASSERT_TRUE(parse(document, "false").isOk());
+    EXPECT_FALSE(document.root().getBool().value());
+    ASSERT_TRUE(parse(document, "-42").isOk());
+    EXPECT_EQ(JsonType::Number, document.root().type());
+    EXPECT_EQ(-42, document.root().getInt64().value());
+    ASSERT_TRUE(parse(document, "\"hello\"").isOk());
+    EXPECT_TRUE(document.root().getString().value() == "hello");
+}
+
+TEST(Json, Nested) {
+    TEST_DESCRIPTION("Fields and elements of nested containers should be found lazily");
+    JsonDocument document;
+    const char *text = R"({"name": "hyper", "tags": ["fast", [], {}], "meta": {"count": 3, "ok": true}, "last": null})";
+    ASSERT_TRUE(parse(document, text).isOk());
+    const auto root = document.root();
+    EXPECT_EQ(JsonType::Object, root.type());
+    EXPECT_EQ(4u, root.size());
+    EXPECT_TRUE(root.field("name").value().getString().value() == "hyper");
+    const auto tags = root.field("tags").value();
+    EXPECT_EQ(3u, tags.size());
+    EXPECT_TRUE(tags.element(0).value().getString().value() == "fast");
+    EXPECT_EQ(JsonType::Array, tags.element(1).value().type());
+    EXPECT_EQ(0u, tags.element(1).value().size());
+    EXPECT_EQ(JsonType::Object, tags.element(2).value().type());
+    EXPECT_FALSE(tags.element(3).isOk());
+    EXPECT_EQ(3, root.field("meta").value().field("count").value().getInt64().value());
+    EXPECT_TRUE(root.field("meta").value().field("ok").value().getBool().value());
+    EXPECT_TRUE(root.field("last").value().isNull());
+    EXPECT_FALSE(root.field("missing").isOk());
+}
+
+TEST(Json, Iteration) {
+    TEST_DESCRIPTION("Iterating a container should visit each member in order, skipping nested contents");
+    JsonDocument document;
+    ASSERT_TRUE(parse(document, R"({"a": [1, [2, 3]], "b": {"c": 4}, "d": 5})").isOk());
+    const char *keys[] = {"a", "b", "d"};
+    size_t count = 0;
+    document.root().forEachField([&](const JsonString &key, const JsonValue &) {
+        EXPECT_TRUE(key == keys[count]);
+        count++;
+    });
+    EXPECT_EQ(3u, count);
+
+    int64 sum = 0;
+    document.root().field("a").value().forEachElement([&](const JsonValue &value) {
+        if(value.type() == JsonType::Number)
+            sum += value.getInt64().value();
+        else
+            sum += value.size();
+    });
+    EXPECT_EQ(3, sum);
+}
+
+TEST(Json, Escapes) {
+    TEST_DESCRIPTION("Escape sequences, including surrogate pairs, should be decoded");
+    JsonDocument document;
+    ASSERT_TRUE(parse(document, R"(["a\"b\\c\/d\n", "é€", "😀", "plain"])").isOk());
+    const auto root = document.root();
+    EXPECT_TRUE(sameString(root.element(0).value().getString().value(), "a\"b\\c/d\n", 8));
+    EXPECT_TRUE(root.element(1).value().getString().value() == "\xC3\xA9\xE2\x82\xAC");
+    EXPECT_TRUE(root.element(2).value().getString().value() == "\xF0\x9F\x98\x80");
+    EXPECT_TRUE(root.element(3).value().getString().value() == "plain");
+}
+
+TEST(Json, StringsAcrossBlocks) {
+    TEST_DESCRIPTION("Strings with escapes and structural characters should be indexed across 64-byte blocks");
+    char text[1024];
+    for(size_t padding = 50; padding < 80; padding++) {
+        size_t length = 0;
+        text[length++] = '[';
+        for(size_t i = 0; i < padding; i++)
+            text[length++] = ' ';
+        const char *value = R"("x\\\"{[,:]}\\", 12)";
+        for(size_t i = 0; value[i] != '\0'; i++)
+            text[length++] = value[i];
+        text[length++] = ']';
+        JsonDocument document;
+        ASSERT_TRUE(document.parse(reinterpret_cast<const byte *>(text), length).isOk());
+        EXPECT_EQ(2u, document.root().size());
+        EXPECT_TRUE(document.root().element(0).value().getString().value() == "x\\\"{[,:]}\\");
+        EXPECT_EQ(12, document.root().element(1).value().getInt64().value());
+    }
+}
+
+TEST(Json, Numbers) {
+    TEST_DESCRIPTION("Numbers should convert exactly, reporting values that don't fit");
+    JsonDocument document;
+    ASSERT_TRUE(parse(document, "[0, -0, 9223372036854775807, -9223372036854775808, 18446744073709551615, "
+            "18446744073709551616, 1.5, -2.5e-3, 1e400, 0.1, 123456789012345678901234567890, 2.2250738585072014e-308]").isOk());
+    const auto root = document.root();
+    EXPECT_EQ(0, root.element(0).value().getInt64().value());
+    EXPECT_EQ(0u, root.element(1).value().getUInt64().value());
+    EXPECT_EQ(maxValue<int64>(), root.element(2).value().getInt64().value());
+    EXPECT_EQ(minValue<int64>(), root.element(3).value().getInt64().value());
+    EXPECT_FALSE(root.element(3).value().getUInt64().isOk());
+    EXPECT_EQ(maxValue<uint64>(), root.element(4).value().getUInt64().value());
+    EXPECT_FALSE(root.element(4).value().getInt64().isOk());
+    EXPECT_FALSE(root.element(5).value().getUInt64().isOk());
+    EXPECT_EQ(1.5, root.element(6).value().getDouble().value());
+    EXPECT_FALSE(root.element(6).value().getInt64().isOk());
+    EXPECT_EQ(-2.5e-3, root.element(7).value().getDouble().value());
+    EXPECT_FALSE(root.element(8).value().getDouble().isOk());
+    EXPECT_EQ(0.1, root.element(9).value().getDouble().value());
+    EXPECT_EQ(123456789012345678901234567890.0, root.element(10).value().getDouble().value());
+    EXPECT_EQ(2.2250738585072014e-308, root.element(11).value().getDouble().value());
+}
+
+TEST(Json, RandomDoubles) {
+    TEST_DESCRIPTION("Printed doubles should read back as the same value");
+    srand(42);
+    char text[64];
+    JsonDocument document;
+    for(int i = 0; i < 2000; i++) {
+        const float64 value = (rand() - RAND_MAX / 2) * 1e-3 * static_cast<float64>(rand() % 100000);
+        snprintf(text, sizeof(text), i % 2 == 0 ? "%.17g" : "%.6g", value);
+        ASSERT_TRUE(parse(document, text).isOk()) << text;
+        EXPECT_EQ(strtod(text, nullptr), document.root().getDouble().value()) << text;
+    }
+}
+
+TEST(Json, Errors) {
+    TEST_DESCRIPTION("Invalid documents should be rejected with the reason");
+    EXPECT_EQ(JsonErrorCode::Empty, parseError("  "));
+    EXPECT_EQ(JsonErrorCode::UnexpectedCharacter, parseError("[1, x]"));
+    EXPECT_EQ(JsonErrorCode::UnclosedString, parseError("[\"abc"));
+    EXPECT_EQ(JsonErrorCode::InvalidEscape, parseError(R"("\q")"));
+    EXPECT_EQ(JsonErrorCode::InvalidEscape, parseError(R"("\ud83d")"));
+    EXPECT_EQ(JsonErrorCode::ControlCharacter, parseError("\"a\tb\""));
+    EXPECT_EQ(JsonErrorCode::InvalidUtf8, parseError("\"\xC0\x80\""));
+    EXPECT_EQ(JsonErrorCode::InvalidUtf8, parseError("\"\xED\xA0\x80\""));
+    EXPECT_EQ(JsonErrorCode::InvalidNumber, parseError("01"));
+    EXPECT_EQ(JsonErrorCode::InvalidNumber, parseError("1."));
+    EXPECT_EQ(JsonErrorCode::InvalidNumber, parseError("-"));
+    EXPECT_EQ(JsonErrorCode::InvalidNumber, parseError("1e+"));
+    EXPECT_EQ(JsonErrorCode::InvalidLiteral, parseError("tru"));
+    EXPECT_EQ(JsonErrorCode::InvalidLiteral, parseError("nullx"));
+    EXPECT_EQ(JsonErrorCode::UnexpectedEnd, parseError("[1,"));
+    EXPECT_EQ(JsonErrorCode::UnexpectedEnd, parseError("{\"a\":"));
+    EXPECT_EQ(JsonErrorCode::ExpectedKey, parseError("{1: 2}"));
+    EXPECT_EQ(JsonErrorCode::ExpectedColon, parseError("{\"a\" 2}"));
+    EXPECT_EQ(JsonErrorCode::ExpectedCommaOrEnd, parseError("[1 2]"));
+    EXPECT_EQ(JsonErrorCode::ExpectedCommaOrEnd, parseError("[1}"));
+    EXPECT_EQ(JsonErrorCode::ExpectedCommaOrEnd, parseError("[\"a\"b]"));
+    EXPECT_EQ(JsonErrorCode::TrailingContent, parseError("1 2"));
+    EXPECT_EQ(JsonErrorCode::TrailingContent, parseError("[] ]"));
+
+    char deep[2 * JsonDocument::maxDepth + 3];
+    for(size_t i = 0; i <= JsonDocument::maxDepth; i++) {
+        deep[i] = '[';
+        deep[2 * JsonDocument::maxDepth + 1 - i] = ']';
+    }
+    deep[2 * JsonDocument::maxDepth + 2] = '\0';
+    EXPECT_EQ(JsonErrorCode::DepthExceeded, parseError(deep));
+}
+
+TEST(Json, ErrorMessage) {
+    TEST_DESCRIPTION("Errors should say what went wrong and where");
+    JsonDocument document;
+    const auto result = parse(document, "[1, 2,, 3]");
+    ASSERT_FALSE(result.isOk());
+    EXPECT_STREQ("Unexpected character at byte 6", result.error()->message());
+    EXPECT_EQ(6u, static_cast<const JsonError &>(*result.error()).offset());
+
+    ASSERT_TRUE(parse(document, "[1]").isOk());
+    const auto missing = document.root().field("a");
+    ASSERT_FALSE(missing.isOk());
+    EXPECT_STREQ("Value has a different type", missing.error()->message());
+}
+
+TEST(Json, Reuse) {
+    TEST_DESCRIPTION("A document should parse many inputs of different sizes, including after a failure");
+    JsonDocument document;
+    char text[4096];
+    for(size_t count = 0; count < 200; count += 7) {
+        size_t length = 0;
+        text[length++] = '[';
+        for(size_t i = 0; i < count; i++)
+            length += static_cast<size_t>(snprintf(text + length, sizeof(text) - length, "%s{\"k\\n\":%zu}", i == 0 ? "" : ",", i));
+        text[length++] = ']';
+        ASSERT_TRUE(document.parse(reinterpret_cast<const byte *>(text), length).isOk());
+        ASSERT_EQ(count, document.root().size());
+        int64 sum = 0;
+        document.root().forEachElement([&sum](const JsonValue &value) {
+            sum += value.field("k\n").value().getInt64().value();
+        });
+        EXPECT_EQ(static_cast<int64>(count * (count - (count > 0 ? 1 : 0)) / 2), sum);
+        EXPECT_FALSE(parse(document, "[").isOk());
+    }
+}
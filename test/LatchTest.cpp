@@ -0,0 +1,67 @@
+#include "common.h"
+#include "hyper/Latch.h"
+#include "hyper/Thread.h"
+
+using namespace hyper;
+
+TEST(Latch, ZeroIsReady) {
+    TEST_DESCRIPTION("A latch starting at zero should not block");
+    Latch latch(0);
+    EXPECT_TRUE(latch.isReady());
+    latch.wait();
+}
+
+TEST(Latch, CountDown) {
+    TEST_DESCRIPTION("A latch should become ready once counted down to zero");
+    Latch latch(3);
+    latch.countDown();
+    EXPECT_FALSE(latch.isReady());
+    latch.countDown(2);
+    EXPECT_TRUE(latch.isReady());
+    latch.wait();
+}
+
+TEST(Latch, CountDownZero) {
+    TEST_DESCRIPTION("Counting down by zero should leave the latch unchanged");
+    Latch latch(1);
+    latch.countDown(0);
+    EXPECT_FALSE(latch.isReady());
+    latch.countDown();
+    latch.countDown(0);
+    EXPECT_TRUE(latch.isReady());
+}
+
+TEST(Latch, WaitsForWorkers) {
+    TEST_DESCRIPTION("Waiting should see the work of every thread that counted down");
+    constexpr int count = 8;
+    Latch latch(count);
+    int results[count] = {};
+    Thread threads[count];
+    for(int i = 0; i < count; i++)
+        ASSERT_TRUE(threads[i].start(Function<void()>([&latch, &results, i]() {
+            results[i] = i * i;
+            latch.countDown();
+        })));
+    latch.wait();
+    for(int i = 0; i < count; i++)
+        EXPECT_EQ(i * i, results[i]);
+    for(auto &thread : threads)
+        thread.join();
+}
+
+TEST(Latch, ReleasesAllWaiters) {
+    TEST_DESCRIPTION("Every waiting thread should be released together");
+    Latch start(1);
+    Latch done(4);
+    Thread threads[4];
+    for(auto &thread : threads)
+        ASSERT_TRUE(thread.start(Function<void()>([&]() {
+            start.wait();
+            done.countDown();
+        })));
+    start.countDown();
+    done.wait();
+    EXPECT_TRUE(done.isReady());
+    for(auto &thread : threads)
+        thread.join();
+}
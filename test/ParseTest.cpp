@@ -0,0 +1,127 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "common.h"
+#include "hyper/parse.h"
+
+using namespace hyper;
+
+namespace {
+    bool toInt64(const char *text, int64 &value) {
+        return parseInt64(text, strlen(text), value);
+    }
+
+    bool toFloat64(const char *text, float64 &value) {
+        return parseFloat64(text, strlen(text), value);
+    }
+}
+
+TEST(Parse, Integers) {
+    TEST_DESCRIPTION("Integers should convert with an optional sign, rejecting other text and overflow");
+    int64 value = 0;
+    EXPECT_TRUE(toInt64("0", value));
+    EXPECT_EQ(0, value);
+    EXPECT_TRUE(toInt64("+17", value));
+    EXPECT_EQ(17, value);
+    EXPECT_TRUE(toInt64("-0042", value));
+    EXPECT_EQ(-42, value);
+    EXPECT_TRUE(toInt64("9223372036854775807", value));
+    EXPECT_EQ(maxValue<int64>(), value);
+    EXPECT_TRUE(toInt64("-9223372036854775808", value));
+    EXPECT_EQ(minValue<int64>(), value);
+    EXPECT_FALSE(toInt64("9223372036854775808", value));
+    EXPECT_FALSE(toInt64("", value));
+    EXPECT_FALSE(toInt64("-", value));
+    EXPECT_FALSE(toInt64("1.0", value));
+    EXPECT_FALSE(toInt64("12a", value));
+    EXPECT_EQ(minValue<int64>(), value);
+
+    uint64 unsignedValue = 0;
+    EXPECT_TRUE(parseUInt64("18446744073709551615", 20, unsignedValue));
+    EXPECT_EQ(maxValue<uint64>(), unsignedValue);
+    EXPECT_FALSE(parseUInt64("18446744073709551616", 20, unsignedValue));
+    EXPECT_FALSE(parseUInt64("-1", 2, unsignedValue));
+    EXPECT_TRUE(parseUInt64("-0", 2, unsignedValue));
+    EXPECT_EQ(0u, unsignedValue);
+}
+
+TEST(Parse, Unterminated) {
+    TEST_DESCRIPTION("Conversion should stop at the given size, without needing a null terminator");
+    int64 integer = 0;
+    EXPECT_TRUE(parseInt64("123456", 3, integer));
+    EXPECT_EQ(123, integer);
+    float64 value = 0;
+    EXPECT_TRUE(parseFloat64("2.5e3xyz", 5, value));
+    EXPECT_EQ(2.5e3, value);
+}
+
+TEST(Parse, Floats) {
+    TEST_DESCRIPTION("Floats should convert exactly in common forms, and reject malformed text and overflow");
+    float64 value = 0;
+    EXPECT_TRUE(toFloat64("1.5", value));
+    EXPECT_EQ(1.5, value);
+    EXPECT_TRUE(toFloat64("-.25", value));
+    EXPECT_EQ(-0.25, value);
+    EXPECT_TRUE(toFloat64("3.", value));
+    EXPECT_EQ(3.0, value);
+    EXPECT_TRUE(toFloat64("+6.02E23", value));
+    EXPECT_EQ(6.02e23, value);
+    EXPECT_TRUE(toFloat64("1e-400", value));
+    EXPECT_EQ(0.0, value);
+    EXPECT_TRUE(toFloat64("-0.0", value));
+    EXPECT_TRUE(std::signbit(value));
+    EXPECT_TRUE(toFloat64("0.1", value));
+    EXPECT_EQ(0.1, value);
+    EXPECT_TRUE(toFloat64("2.2250738585072014e-308", value));
+    EXPECT_EQ(2.2250738585072014e-308, value);
+    char largest[320] = "17976931348623157";
+    for(size_t i = 17; i < 309; i++)
+        largest[i] = '0';
+    largest[309] = '\0';
+    EXPECT_TRUE(toFloat64(largest, value));
+    EXPECT_EQ(1.7976931348623157e308, value);
+    value = 7;
+    EXPECT_FALSE(toFloat64("1e309", value));
+    EXPECT_FALSE(toFloat64("", value));
+    EXPECT_FALSE(toFloat64(".", value));
+    EXPECT_FALSE(toFloat64("-e5", value));
+    EXPECT_FALSE(toFloat64("1e", value));
+    EXPECT_FALSE(toFloat64("1.2.3", value));
+    EXPECT_FALSE(toFloat64("nan", value));
+    EXPECT_EQ(7.0, value);
+}
+
+TEST(Parse, LongMantissa) {
+    TEST_DESCRIPTION("Numbers with hundreds of digits should still round correctly");
+    // Halfway between 1 and the next double, plus a tiny bit far past the 200th digit.
+    char text[512] = "1.00000000000000011102230246251565404236316680908203125";
+    const size_t length = strlen(text);
+    for(size_t i = length; i < 400; i++)
+        text[i] = '0';
+    text[400] = '1';
+    text[401] = '\0';
+    float64 value = 0;
+    ASSERT_TRUE(toFloat64(text, value));
+    EXPECT_EQ(strtod(text, nullptr), value);
+    text[400] = '0';
+    ASSERT_TRUE(toFloat64(text, value));
+    EXPECT_EQ(1.0, value);
+}
+
+TEST(Parse, RandomFloats) {
+    TEST_DESCRIPTION("Printed doubles should convert to the same value as strtod()");
+    srand(7);
+    char text[64];
+    for(int i = 0; i < 10000; i++) {
+        uint64 bits = static_cast<uint64>(rand()) << 33 ^ static_cast<uint64>(rand()) << 11 ^ static_cast<uint64>(rand());
+        float64 original;
+        memcpy(&original, &bits, sizeof(original));
+        if(original != original || original == infinity<float64>() || original == negativeInfinity<float64>())
+            continue;
+        snprintf(text, sizeof(text), i % 3 == 0 ? "%.17g" : i % 3 == 1 ? "%.8e" : "%.3f", original);
+        float64 value = 0;
+        ASSERT_TRUE(toFloat64(text, value)) << text;
+        EXPECT_EQ(strtod(text, nullptr), value) << text;
+    }
+}
@@ -0,0 +1,149 @@
+#include "common.h"
+#include "hyper/PersistentHashMap.h"
+#include "hyper/Thread.h"
+
+using namespace hyper;
+
+namespace {
+    // Puts every key into one of four hashes, so keys collide all the way down the trie.
+    struct CollidingHasher {
+        uint64 operator()(int key) const noexcept {
+            return static_cast<uint64>(key % 4) * 0x9E3779B97F4A7C15ull;
+        }
+    };
+}
+
+TEST(PersistentHashMap, Empty) {
+    TEST_DESCRIPTION("A new map is empty and finds nothing");
+    PersistentHashMap<int, int> map;
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_EQ(nullptr, map.find(1));
+    EXPECT_FALSE(map.erase(1));
+}
+
+TEST(PersistentHashMap, InsertFindErase) {
+    TEST_DESCRIPTION("Keys can be added, replaced and removed");
+    PersistentHashMap<int, int> map;
+    for(int i = 0; i < 10000; i++)
+        EXPECT_TRUE(map.insert(i, i * 2));
+    EXPECT_EQ(10000u, map.size());
+    EXPECT_FALSE(map.insert(5, 50));
+    EXPECT_EQ(50, *map.find(5));
+    for(int i = 0; i < 10000; i += 2)
+        EXPECT_TRUE(map.erase(i));
+    EXPECT_EQ(5000u, map.size());
+    for(int i = 0; i < 10000; i++) {
+        if(i % 2 == 0)
+            EXPECT_FALSE(map.contains(i));
+        else
+            EXPECT_EQ(i == 5 ? 50 : i * 2, *map.find(i));
+    }
+    for(int i = 1; i < 10000; i += 2)
+        EXPECT_TRUE(map.erase(i));
+    EXPECT_TRUE(map.isEmpty());
+}
+
+TEST(PersistentHashMap, SnapshotsAreIndependent) {
+    TEST_DESCRIPTION("Updating a map leaves earlier copies unchanged");
+    PersistentHashMap<int, int> map;
+    for(int i = 0; i < 1000; i++)
+        map.insert(i, i);
+    const auto snapshot = map;
+    for(int i = 0; i < 1000; i += 3)
+        map.erase(i);
+    for(int i = 1; i < 1000; i += 3)
+        map.insert(i, -i);
+    map.insert(5000, 1);
+
+    EXPECT_EQ(1000u, snapshot.size());
+    for(int i = 0; i < 1000; i++)
+        EXPECT_EQ(i, *snapshot.find(i));
+    EXPECT_FALSE(snapshot.contains(5000));
+    for(int i = 0; i < 1000; i++) {
+        if(i % 3 == 0)
+            EXPECT_FALSE(map.contains(i));
+        else
+            EXPECT_EQ(i % 3 == 1 ? -i : i, *map.find(i));
+    }
+}
+
+TEST(PersistentHashMap, UnsharedUpdatesInPlace) {
+    TEST_DESCRIPTION("Without a snapshot, replacing a value doesn't copy its node");
+    PersistentHashMap<int, int> map;
+    for(int i = 0; i < 100; i++)
+        map.insert(i, i);
+    const int *value = map.find(42);
+    map.insert(42, 7);
+    EXPECT_EQ(value, map.find(42));
+
+    const auto snapshot = map;
+    map.insert(42, 8);
+    EXPECT_NE(value, map.find(42));
+    EXPECT_EQ(value, snapshot.find(42));
+    EXPECT_EQ(7, *snapshot.find(42));
+}
+
+TEST(PersistentHashMap, FullHashCollisions) {
+    TEST_DESCRIPTION("Keys with equal hashes are kept apart and can all be removed");
+    PersistentHashMap<int, int, CollidingHasher> map;
+    for(int i = 0; i < 100; i++)
+        map.insert(i, i);
+    const auto snapshot = map;
+    for(int i = 0; i < 100; i++)
+        EXPECT_EQ(i, *map.find(i));
+    for(int i = 0; i < 100; i++)
+        EXPECT_TRUE(map.erase(i));
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_EQ(100u, snapshot.size());
+    EXPECT_EQ(99, *snapshot.find(99));
+}
+
+TEST(PersistentHashMap, ForEach) {
+    TEST_DESCRIPTION("Each entry is visited once");
+    PersistentHashMap<int, int> map;
+    for(int i = 1; i <= 100; i++)
+        map.insert(i, i);
+    int sum = 0, count = 0;
+    map.forEach([&](int key, int value) {
+        sum += value;
+        count += key > 0;
+    });
+    EXPECT_EQ(5050, sum);
+    EXPECT_EQ(100, count);
+}
+
+TEST(PersistentHashMap, DestroysValues) {
+    TEST_DESCRIPTION("Values are released once no map refers to them");
+    SharedPointer<int> shared(new int(1));
+    {
+        PersistentHashMap<int, SharedPointer<int>> map;
+        for(int i = 0; i < 100; i++)
+            map.insert(i, shared);
+        auto snapshot = map;
+        map.erase(3);
+        map.insert(4, SharedPointer<int>());
+        EXPECT_EQ(1, **snapshot.find(3));
+        EXPECT_FALSE((bool) *map.find(4));
+    }
+    EXPECT_EQ(1u, shared.useCount());
+}
+
+TEST(PersistentHashMap, SnapshotsAcrossThreads) {
+    TEST_DESCRIPTION("Snapshots can be read on other threads while the original is updated");
+    PersistentHashMap<int, int> map;
+    for(int i = 0; i < 1000; i++)
+        map.insert(i, i);
+    const auto snapshot = map;
+    Thread readers[2];
+    for(auto &reader : readers)
+        ASSERT_TRUE(reader.start(Function<void()>([&snapshot]() {
+            for(int round = 0; round < 20; round++)
+                for(int i = 0; i < 1000; i++)
+                    ASSERT_EQ(i, *snapshot.find(i));
+        })));
+    for(int i = 0; i < 1000; i++)
+        map.insert(i, -i);
+    for(auto &reader : readers)
+        reader.join();
+    EXPECT_EQ(-999, *map.find(999));
+}
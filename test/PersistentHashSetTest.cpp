@@ -0,0 +1,30 @@
+#include "common.h"
+#include "hyper/PersistentHashSet.h"
+
+using namespace hyper;
+
+TEST(PersistentHashSet, InsertErase) {
+    TEST_DESCRIPTION("Keys can be added once and removed");
+    PersistentHashSet<int> set;
+    EXPECT_TRUE(set.insert(3));
+    EXPECT_FALSE(set.insert(3));
+    EXPECT_TRUE(set.contains(3));
+    EXPECT_TRUE(set.erase(3));
+    EXPECT_FALSE(set.contains(3));
+    EXPECT_TRUE(set.isEmpty());
+}
+
+TEST(PersistentHashSet, Snapshot) {
+    TEST_DESCRIPTION("Copies keep their keys when the original changes");
+    PersistentHashSet<int> set;
+    for(int i = 0; i < 500; i++)
+        set.insert(i);
+    const auto snapshot = set;
+    set.clear();
+    EXPECT_EQ(500u, snapshot.size());
+    int sum = 0;
+    snapshot.forEach([&sum](int key) {
+        sum += key;
+    });
+    EXPECT_EQ(499 * 500 / 2, sum);
+}
@@ -0,0 +1,79 @@
+#include "common.h"
+#include "hyper/hash.h"
+#include "hyper/RadixHeap.h"
+
+using namespace hyper;
+
+TEST(RadixHeap, Empty) {
+    TEST_DESCRIPTION("A new heap should be empty");
+    RadixHeap<int32> heap;
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_EQ(0u, heap.size());
+}
+
+TEST(RadixHeap, PopsInOrder) {
+    TEST_DESCRIPTION("Values should come out in order of their keys");
+    RadixHeap<uint64> heap;
+    const size_t count = 2000;
+    for(size_t i = 0; i < count; i++) {
+        const auto key = hash(i) >> (i % 64);
+        heap.push(key, key);
+    }
+    uint64 previous = 0;
+    for(size_t i = 0; i < count; i++) {
+        const auto key = heap.topKey();
+        ASSERT_LE(previous, key);
+        EXPECT_EQ(key, heap.top());
+        EXPECT_EQ(key, heap.pop());
+        previous = key;
+    }
+    EXPECT_TRUE(heap.isEmpty());
+}
+
+TEST(RadixHeap, MonotonePushes) {
+    TEST_DESCRIPTION("Keys pushed at or after the last key taken should come out in order");
+    RadixHeap<uint64> heap;
+    heap.push(0, 0);
+    uint64 previous = 0;
+    size_t popped = 0;
+    while(!heap.isEmpty()) {
+        const auto key = heap.topKey();
+        ASSERT_LE(previous, key);
+        previous = key;
+        heap.pop();
+        popped++;
+        // Each pop schedules a couple of later events, like relaxing edges in a shortest-path search.
+        if(popped < 5000) {
+            heap.push(key + hash(popped) % 100, key);
+            heap.push(key, key);
+            if(popped % 2 == 0)
+                heap.pop();
+        }
+    }
+    EXPECT_GE(popped, 5000u);
+}
+
+TEST(RadixHeap, EqualKeys) {
+    TEST_DESCRIPTION("Every value with the same key should be returned");
+    RadixHeap<int32> heap;
+    for(int32 i = 0; i < 10; i++)
+        heap.push(7, i);
+    int32 sum = 0;
+    while(!heap.isEmpty()) {
+        EXPECT_EQ(7u, heap.topKey());
+        sum += heap.pop();
+    }
+    EXPECT_EQ(45, sum);
+}
+
+TEST(RadixHeap, Clear) {
+    TEST_DESCRIPTION("Clearing should empty the heap and let keys start over");
+    RadixHeap<int32> heap;
+    heap.push(1000, 1);
+    EXPECT_EQ(1000u, heap.topKey());
+    heap.clear();
+    EXPECT_TRUE(heap.isEmpty());
+    heap.push(3, 2);
+    EXPECT_EQ(3u, heap.topKey());
+    EXPECT_EQ(2, heap.pop());
+}
@@ -0,0 +1,69 @@
+#include "common.h"
+#include "hyper/Result.h"
+#include "util/DestructorSpy.h"
+
+using namespace hyper;
+
+namespace {
+    class TestError : public Error {
+    public:
+        const char *message() const noexcept override {
+            return "test error";
+        }
+    };
+
+    SharedPointer<Error> makeError() {
+        return SharedPointer<Error>(new TestError());
+    }
+
+    Result<int> half(int value) {
+        if(value % 2 != 0)
+            return makeError();
+        return value / 2;
+    }
+}
+
+TEST(Result, Value) {
+    TEST_DESCRIPTION("A result created from a value should be successful and hold the value");
+    Result<int> result = half(42);
+    ASSERT_TRUE(result.isOk());
+    EXPECT_TRUE((bool)result);
+    EXPECT_EQ(21, result.value());
+}
+
+TEST(Result, Error) {
+    TEST_DESCRIPTION("A result created from an error should have failed and hold the error");
+    auto result = half(3);
+    ASSERT_FALSE(result.isOk());
+    EXPECT_STREQ("test error", result.error()->message());
+}
+
+TEST(Result, Void) {
+    TEST_DESCRIPTION("A void result should report success, or failure with its error");
+    Result<void> success;
+    EXPECT_TRUE(success.isOk());
+    Result<void> failure(makeError());
+    EXPECT_FALSE(failure.isOk());
+    EXPECT_STREQ("test error", failure.error()->message());
+}
+
+TEST(Result, CopyAndAssign) {
+    TEST_DESCRIPTION("Copies and assignments should replace the value or error");
+    auto result = half(8);
+    auto copy = result;
+    EXPECT_EQ(4, copy.value());
+    copy = half(1);
+    EXPECT_FALSE(copy.isOk());
+    copy = result;
+    EXPECT_EQ(4, copy.value());
+}
+
+TEST(Result, DestroysValue) {
+    TEST_DESCRIPTION("The value should be destroyed with the result");
+    int count = 0;
+    {
+        Result<DestructorSpy> result{DestructorSpy(&count)};
+        count = 0;
+    }
+    EXPECT_EQ(1, count);
+}
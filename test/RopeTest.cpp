@@ -0,0 +1,170 @@
+#include "common.h"
+#include "hyper/Rope.h"
+
+using namespace hyper;
+
+namespace {
+    // Plain array that the rope is checked against.
+    struct Reference {
+        byte data[1 << 20];
+        size_t size = 0;
+
+        void insert(size_t position, const byte *bytes, size_t count) {
+            __builtin_memmove(data + position + count, data + position, size - position);
+            __builtin_memcpy(data + position, bytes, count);
+            size += count;
+        }
+
+        void erase(size_t position, size_t count) {
+            __builtin_memmove(data + position, data + position + count, size - position - count);
+            size -= count;
+        }
+    };
+
+    uint64 nextRandom(uint64 &state) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    void fillText(byte *bytes, size_t count, uint64 &state) {
+        for(size_t i = 0; i < count; i++)
+            bytes[i] = nextRandom(state) % 16 == 0 ? byte('\n') : byte('a' + nextRandom(state) % 26);
+    }
+
+    void expectContents(const Rope &rope, const byte *expected, size_t size) {
+        ASSERT_EQ(size, rope.size());
+        static byte buffer[1 << 20];
+        ASSERT_EQ(size, rope.read(0, buffer, size));
+        ASSERT_EQ(0, __builtin_memcmp(buffer, expected, size));
+    }
+
+    const byte *text(const char *string) {
+        return reinterpret_cast<const byte *>(string);
+    }
+}
+
+TEST(Rope, Empty) {
+    TEST_DESCRIPTION("A new rope is empty and has one empty line");
+    Rope rope;
+    EXPECT_TRUE(rope.isEmpty());
+    EXPECT_EQ(0u, rope.size());
+    EXPECT_EQ(1u, rope.lineCount());
+    EXPECT_EQ(0u, rope.lineStart(0));
+    EXPECT_EQ(0u, rope.lineOf(0));
+}
+
+TEST(Rope, InsertErase) {
+    TEST_DESCRIPTION("Small edits change the contents as expected");
+    Rope rope;
+    rope.append(text("hello world"), 11);
+    rope.insert(5, text(","), 1);
+    rope.insert(0, text(">> "), 3);
+    expectContents(rope, text(">> hello, world"), 15);
+    rope.erase(3, 7);
+    expectContents(rope, text(">> world"), 8);
+    EXPECT_EQ(byte('w'), rope[3]);
+    rope.erase(0, 8);
+    EXPECT_TRUE(rope.isEmpty());
+}
+
+TEST(Rope, RandomEdits) {
+    TEST_DESCRIPTION("Random inserts and erases across many chunks match a plain buffer");
+    static Reference reference;
+    static byte bytes[20000];
+    reference.size = 0;
+    static byte saved[1 << 20];
+    size_t savedSize = 0;
+    uint64 state = 0x12345;
+    Rope rope, snapshot;
+    for(int round = 0; round < 2000; round++) {
+        if(round == 1000) {
+            snapshot = rope;
+            __builtin_memcpy(saved, reference.data, reference.size);
+            savedSize = reference.size;
+        }
+        const auto position = reference.size == 0 ? 0 : nextRandom(state) % (reference.size + 1);
+        if(reference.size < 200000 && nextRandom(state) % 3 != 0) {
+            const auto count = nextRandom(state) % (round % 50 == 0 ? sizeof(bytes) : 300) + 1;
+            fillText(bytes, count, state);
+            rope.insert(position, bytes, count);
+            reference.insert(position, bytes, count);
+        } else if(position < reference.size) {
+            const auto available = reference.size - position;
+            const auto count = nextRandom(state) % (available < 5000 ? available : 5000) + 1;
+            rope.erase(position, count);
+            reference.erase(position, count);
+        }
+    }
+    expectContents(rope, reference.data, reference.size);
+    expectContents(snapshot, saved, savedSize);
+}
+
+TEST(Rope, BulkConstruction) {
+    TEST_DESCRIPTION("A rope built from a large buffer holds the same bytes and lines");
+    static byte bytes[1 << 20];
+    uint64 state = 99;
+    fillText(bytes, sizeof(bytes), state);
+    Rope rope(bytes, sizeof(bytes));
+    expectContents(rope, bytes, sizeof(bytes));
+    size_t newlines = 0;
+    for(auto value : bytes)
+        newlines += value == byte('\n');
+    EXPECT_EQ(newlines + 1, rope.lineCount());
+}
+
+TEST(Rope, Lines) {
+    TEST_DESCRIPTION("Lines can be found by index and by position");
+    static byte bytes[200000];
+    uint64 state = 7;
+    fillText(bytes, sizeof(bytes), state);
+    Rope rope(bytes, sizeof(bytes));
+    rope.insert(5000, text("\n\n"), 2);
+    rope.erase(100000, 3000);
+
+    static byte contents[200000];
+    const auto size = rope.read(0, contents, sizeof(contents));
+    size_t line = 0;
+    for(size_t i = 0; i < size; i++) {
+        ASSERT_EQ(line, rope.lineOf(i));
+        if(i == 0 || contents[i - 1] == byte('\n')) {
+            ASSERT_EQ(i, rope.lineStart(line));
+        }
+        if(contents[i] == byte('\n'))
+            line++;
+    }
+    EXPECT_EQ(line + 1, rope.lineCount());
+    EXPECT_EQ(line, rope.lineOf(size));
+}
+
+TEST(Rope, Snapshots) {
+    TEST_DESCRIPTION("Editing a rope leaves earlier copies unchanged");
+    static byte bytes[100000];
+    static byte original[100000];
+    uint64 state = 3;
+    fillText(bytes, sizeof(bytes), state);
+    __builtin_memcpy(original, bytes, sizeof(bytes));
+    Rope rope(bytes, sizeof(bytes));
+    const Rope snapshot(rope);
+    rope.erase(10, 50000);
+    rope.insert(20, text("changed"), 7);
+    expectContents(snapshot, original, sizeof(original));
+    EXPECT_EQ(100000u - 50000u + 7u, rope.size());
+    EXPECT_EQ(byte('c'), rope[20]);
+}
+
+TEST(Rope, Chunks) {
+    TEST_DESCRIPTION("Walking chunks visits every byte in order");
+    static byte bytes[50000];
+    uint64 state = 11;
+    fillText(bytes, sizeof(bytes), state);
+    Rope rope(bytes, sizeof(bytes));
+    size_t position = 0;
+    for(size_t length; position < rope.size(); position += length) {
+        const auto data = rope.chunk(position, length);
+        ASSERT_GT(length, 0u);
+        ASSERT_EQ(0, __builtin_memcmp(data, bytes + position, length));
+    }
+    EXPECT_EQ(sizeof(bytes), position);
+}
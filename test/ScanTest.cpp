@@ -0,0 +1,272 @@
+#include "common.h"
+#include "hyper/limits.h"
+#include "hyper/scan.h"
+#include "hyper/WorkerPool.h"
+
+using namespace hyper;
+
+// Lengths that exercise both the vector loops and the scalar remainder.
+static const size_t lengths[] = {0, 1, 3, 4, 7, 8, 9, 16, 31, 33, 100};
+
+TEST(scan, InclusiveScan) {
+    TEST_DESCRIPTION("Each element should be the sum of all elements up to and including it");
+    int32 input[100], output[100];
+    for(auto length : lengths) {
+        for(size_t i = 0; i < length; i++)
+            input[i] = static_cast<int32>(i * 7 % 13) - 6;
+        auto total = inclusiveScan(input, output, length);
+        int32 expected = 0;
+        for(size_t i = 0; i < length; i++) {
+            expected += input[i];
+            EXPECT_EQ(expected, output[i]);
+        }
+        EXPECT_EQ(expected, total);
+    }
+}
+
+TEST(scan, InclusiveScanInitial) {
+    TEST_DESCRIPTION("Initial value should be added to every element");
+    uint32 input[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    uint32 output[9];
+    EXPECT_EQ(145u, inclusiveScan(input, output, 9, 100u));
+    EXPECT_EQ(101u, output[0]);
+    EXPECT_EQ(145u, output[8]);
+}
+
+TEST(scan, InclusiveScanInPlace) {
+    TEST_DESCRIPTION("Scanning should work when the input and output are the same array");
+    int64 values[10] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+    inclusiveScan(values, values, 10);
+    for(size_t i = 0; i < 10; i++)
+        EXPECT_EQ(static_cast<int64>(i + 1), values[i]);
+}
+
+TEST(scan, InclusiveScanChunked) {
+    TEST_DESCRIPTION("Scanning in chunks with the returned carry should match a single scan");
+    float32 input[40], whole[40], chunked[40];
+    for(size_t i = 0; i < 40; i++)
+        input[i] = static_cast<float32>(i % 5);
+    inclusiveScan(input, whole, 40);
+    auto carry = inclusiveScan(input, chunked, 13);
+    carry = inclusiveScan(input + 13, chunked + 13, 20, carry);
+    inclusiveScan(input + 33, chunked + 33, 7, carry);
+    for(size_t i = 0; i < 40; i++)
+        EXPECT_EQ(whole[i], chunked[i]);
+}
+
+TEST(scan, ExclusiveScan) {
+    TEST_DESCRIPTION("Each element should be the sum of all elements before it");
+    float32 input[100], output[100];
+    for(auto length : lengths) {
+        for(size_t i = 0; i < length; i++)
+            input[i] = static_cast<float32>(i % 4);
+        auto total = exclusiveScan(input, output, length, 10.0f);
+        float32 expected = 10.0f;
+        for(size_t i = 0; i < length; i++) {
+            EXPECT_EQ(expected, output[i]);
+            expected += input[i];
+        }
+        EXPECT_EQ(expected, total);
+    }
+}
+
+TEST(scan, ExclusiveScanInPlace) {
+    TEST_DESCRIPTION("Scanning should work when the input and output are the same array");
+    int32 values[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    EXPECT_EQ(78, exclusiveScan(values, values, 12));
+    EXPECT_EQ(0, values[0]);
+    EXPECT_EQ(1, values[1]);
+    EXPECT_EQ(66, values[11]);
+}
+
+TEST(scan, Sum) {
+    TEST_DESCRIPTION("Sum should add every element");
+    uint64 values[37];
+    for(size_t i = 0; i < 37; i++)
+        values[i] = i;
+    EXPECT_EQ(666u, sum(values, 37));
+}
+
+TEST(scan, SumEmpty) {
+    TEST_DESCRIPTION("Sum of nothing should be zero");
+    EXPECT_EQ(0, sum<int32>(nullptr, 0));
+}
+
+TEST(scan, SumWraps) {
+    TEST_DESCRIPTION("Signed sums should wrap around on overflow");
+    int32 values[11];
+    for(size_t i = 0; i < 11; i++)
+        values[i] = maxValue<int32>();
+    EXPECT_EQ(static_cast<int32>(11u * static_cast<uint32>(maxValue<int32>())), sum(values, 11));
+    int32 scanned[11];
+    EXPECT_EQ(static_cast<int32>(11u * static_cast<uint32>(maxValue<int32>())), inclusiveScan(values, scanned, 11));
+}
+
+TEST(scan, SumFloat) {
+    TEST_DESCRIPTION("Floating-point sum should add every element");
+    float64 values[21];
+    for(size_t i = 0; i < 21; i++)
+        values[i] = 0.5;
+    EXPECT_DOUBLE_EQ(10.5, sum(values, 21));
+}
+
+TEST(scan, Minimum) {
+    TEST_DESCRIPTION("Minimum should find the smallest element");
+    int32 values[100];
+    for(auto length : lengths) {
+        if(length == 0)
+            continue;
+        for(size_t i = 0; i < length; i++)
+            values[i] = static_cast<int32>(length - i);
+        values[length / 2] = -5;
+        EXPECT_EQ(-5, minimum(values, length));
+    }
+}
+
+TEST(scan, MinimumUnsigned) {
+    TEST_DESCRIPTION("Unsigned values with the high bit set should compare as large");
+    uint32 values[9] = {0x80000000u, 0xFFFFFFFFu, 7, 0x90000000u, 8, 9, 10, 11, 12};
+    EXPECT_EQ(7u, minimum(values, 9));
+    EXPECT_EQ(0xFFFFFFFFu, maximum(values, 9));
+}
+
+TEST(scan, MinimumEmpty) {
+    TEST_DESCRIPTION("Minimum of nothing should be the largest value");
+    EXPECT_EQ(maxValue<int32>(), minimum<int32>(nullptr, 0));
+    EXPECT_EQ(infinity<float32>(), minimum<float32>(nullptr, 0));
+}
+
+TEST(scan, Maximum) {
+    TEST_DESCRIPTION("Maximum should find the largest element");
+    float32 values[100];
+    for(auto length : lengths) {
+        if(length == 0)
+            continue;
+        for(size_t i = 0; i < length; i++)
+            values[i] = -static_cast<float32>(i);
+        values[length - 1] = 42.0f;
+        EXPECT_EQ(42.0f, maximum(values, length));
+    }
+}
+
+TEST(scan, MaximumEmpty) {
+    TEST_DESCRIPTION("Maximum of nothing should be the smallest value");
+    EXPECT_EQ(minValue<int64>(), maximum<int64>(nullptr, 0));
+    EXPECT_EQ(negativeInfinity<float64>(), maximum<float64>(nullptr, 0));
+}
+
+TEST(scan, CompactFlags) {
+    TEST_DESCRIPTION("Only flagged elements should be kept, in their original order");
+    int32 input[100], output[100];
+    bool keep[100];
+    for(auto length : lengths) {
+        for(size_t i = 0; i < length; i++) {
+            input[i] = static_cast<int32>(i);
+            keep[i]  = (i * 5 % 7) < 3;
+        }
+        auto written = compact(input, keep, output, length);
+        size_t expected = 0;
+        for(size_t i = 0; i < length; i++) {
+            if(keep[i]) {
+                ASSERT_LT(expected, written);
+                EXPECT_EQ(input[i], output[expected++]);
+            }
+        }
+        EXPECT_EQ(expected, written);
+    }
+}
+
+TEST(scan, CompactFlagsInPlace) {
+    TEST_DESCRIPTION("Compaction should work when the input and output are the same array");
+    float32 values[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    bool keep[10] = {false, true, false, true, false, true, false, true, false, true};
+    ASSERT_EQ(5u, compact(values, keep, values, 10));
+    for(size_t i = 0; i < 5; i++)
+        EXPECT_EQ(static_cast<float32>(i * 2 + 1), values[i]);
+}
+
+TEST(scan, CompactPredicate) {
+    TEST_DESCRIPTION("Only elements that satisfy the predicate should be kept");
+    uint64 input[20], output[20];
+    for(size_t i = 0; i < 20; i++)
+        input[i] = i;
+    auto written = compact(input, output, 20, [](uint64 value) { return value % 3 == 0; });
+    ASSERT_EQ(7u, written);
+    for(size_t i = 0; i < written; i++)
+        EXPECT_EQ(i * 3, output[i]);
+}
+
+// Lengths for the pool kernels, including ones shorter than the number of workers.
+static const size_t poolLengths[] = {0, 1, 3, 4, 7, 33, 100, 1000, 4099};
+
+TEST(scan, PoolInclusiveScan) {
+    TEST_DESCRIPTION("Scanning with a pool should match the serial scan");
+    WorkerPool pool(4);
+    static int64 input[4099], expected[4099], output[4099];
+    for(auto length : poolLengths) {
+        for(size_t i = 0; i < length; i++)
+            input[i] = static_cast<int64>(i * 7 % 13) - 6;
+        const auto expectedTotal = inclusiveScan(input, expected, length, int64(5));
+        EXPECT_EQ(expectedTotal, inclusiveScan(pool, input, output, length, int64(5)));
+        for(size_t i = 0; i < length; i++)
+            EXPECT_EQ(expected[i], output[i]);
+    }
+}
+
+TEST(scan, PoolExclusiveScanInPlace) {
+    TEST_DESCRIPTION("Exclusive scanning in place with a pool should match the serial scan");
+    WorkerPool pool(3);
+    static float32 values[4099], expected[4099];
+    for(auto length : poolLengths) {
+        for(size_t i = 0; i < length; i++)
+            values[i] = static_cast<float32>(i % 4);
+        const auto expectedTotal = exclusiveScan(values, expected, length);
+        EXPECT_EQ(expectedTotal, exclusiveScan(pool, values, values, length));
+        for(size_t i = 0; i < length; i++)
+            EXPECT_EQ(expected[i], values[i]);
+    }
+}
+
+TEST(scan, PoolReductions) {
+    TEST_DESCRIPTION("Reducing with a pool should match the serial reductions");
+    WorkerPool pool(4);
+    static int32 input[4099];
+    for(auto length : poolLengths) {
+        for(size_t i = 0; i < length; i++)
+            input[i] = static_cast<int32>(i * 37 % 101) - 50;
+        EXPECT_EQ(sum(input, length), sum(pool, input, length));
+        EXPECT_EQ(minimum(input, length), minimum(pool, input, length));
+        EXPECT_EQ(maximum(input, length), maximum(pool, input, length));
+    }
+}
+
+TEST(scan, PoolCompact) {
+    TEST_DESCRIPTION("Compacting with a pool should match the serial compaction");
+    WorkerPool pool(4);
+    static uint32 input[4099], expected[4099], output[4099];
+    static bool keep[4099];
+    for(auto length : poolLengths) {
+        for(size_t i = 0; i < length; i++) {
+            input[i] = static_cast<uint32>(i);
+            keep[i]  = (i * 5 % 7) < 3;
+        }
+        const auto expectedCount = compact(input, keep, expected, length);
+        ASSERT_EQ(expectedCount, compact(pool, input, keep, output, length));
+        for(size_t i = 0; i < expectedCount; i++)
+            EXPECT_EQ(expected[i], output[i]);
+    }
+}
+
+TEST(scan, PoolCompactInPlace) {
+    TEST_DESCRIPTION("Compacting in place with a pool should keep every flagged element in order");
+    WorkerPool pool(4);
+    static float64 values[1000];
+    static bool keep[1000];
+    for(size_t i = 0; i < 1000; i++) {
+        values[i] = static_cast<float64>(i);
+        keep[i]   = i % 3 == 1;
+    }
+    ASSERT_EQ(333u, compact(pool, values, keep, values, 1000));
+    for(size_t i = 0; i < 333; i++)
+        EXPECT_EQ(static_cast<float64>(i * 3 + 1), values[i]);
+}
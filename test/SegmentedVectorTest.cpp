@@ -0,0 +1,86 @@
+#include "common.h"
+#include "hyper/SegmentedVector.h"
+#include "hyper/Thread.h"
+
+using namespace hyper;
+
+TEST(SegmentedVector, Append) {
+    TEST_DESCRIPTION("Appended elements should be found at their index");
+    SegmentedVector<int> vector;
+    EXPECT_TRUE(vector.isEmpty());
+    for(int i = 0; i < 10000; i++)
+        vector.pushBack(i * 2);
+    EXPECT_EQ(10000u, vector.size());
+    for(int i = 0; i < 10000; i++)
+        EXPECT_EQ(i * 2, vector[i]);
+}
+
+TEST(SegmentedVector, StableAddresses) {
+    TEST_DESCRIPTION("Elements should not move as the array grows");
+    SegmentedVector<int> vector;
+    int *pointers[100];
+    for(int i = 0; i < 100; i++)
+        pointers[i] = &vector.pushBack(i);
+    for(int i = 0; i < 100000; i++)
+        vector.pushBack(i);
+    for(int i = 0; i < 100; i++) {
+        EXPECT_EQ(i, *pointers[i]);
+        EXPECT_EQ(pointers[i], &vector[i]);
+    }
+}
+
+TEST(SegmentedVector, ForEach) {
+    TEST_DESCRIPTION("Visiting should reach every element in order");
+    SegmentedVector<int> vector;
+    for(int i = 0; i < 1000; i++)
+        vector.pushBack(i);
+    int expected = 0;
+    vector.forEach([&](int &value) { EXPECT_EQ(expected++, value); });
+    EXPECT_EQ(1000, expected);
+}
+
+TEST(SegmentedVector, Clear) {
+    TEST_DESCRIPTION("Clearing should empty the array and keep it usable");
+    SegmentedVector<int> vector;
+    for(int i = 0; i < 100; i++)
+        vector.pushBack(i);
+    vector.clear();
+    EXPECT_TRUE(vector.isEmpty());
+    vector.pushBack(5);
+    EXPECT_EQ(5, vector[0]);
+}
+
+TEST(SegmentedVector, IsConstructed) {
+    TEST_DESCRIPTION("Only appended slots should be reported as constructed");
+    SegmentedVector<int> vector;
+    EXPECT_FALSE(vector.isConstructed(0));
+    for(int i = 0; i < 20; i++)
+        vector.pushBack(i);
+    EXPECT_TRUE(vector.isConstructed(0));
+    EXPECT_TRUE(vector.isConstructed(19));
+    EXPECT_FALSE(vector.isConstructed(20));
+    vector.clear();
+    EXPECT_FALSE(vector.isConstructed(0));
+}
+
+TEST(SegmentedVector, ConcurrentAppend) {
+    TEST_DESCRIPTION("Threads appending at once should each get their own slot");
+    constexpr int threadCount = 4;
+    constexpr int perThread = 20000;
+    SegmentedVector<int> vector;
+    Thread threads[threadCount];
+    for(int t = 0; t < threadCount; t++)
+        ASSERT_TRUE(threads[t].start(Function<void()>([&vector, t]() {
+            for(int i = 0; i < perThread; i++)
+                vector.pushBack(t * perThread + i);
+        })));
+    for(auto &thread : threads)
+        thread.join();
+    ASSERT_EQ(static_cast<size_t>(threadCount * perThread), vector.size());
+    auto seen = new bool[threadCount * perThread]();
+    vector.forEach([&](int &value) {
+        EXPECT_FALSE(seen[value]);
+        seen[value] = true;
+    });
+    delete[] seen;
+}
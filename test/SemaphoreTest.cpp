@@ -0,0 +1,84 @@
+#include "common.h"
+#include "hyper/Semaphore.h"
+#include "hyper/Thread.h"
+
+using namespace hyper;
+
+TEST(Semaphore, TryAcquire) {
+    TEST_DESCRIPTION("Permits should be taken until none are left");
+    Semaphore semaphore(2);
+    EXPECT_TRUE(semaphore.tryAcquire());
+    EXPECT_TRUE(semaphore.tryAcquire());
+    EXPECT_FALSE(semaphore.tryAcquire());
+    semaphore.release();
+    EXPECT_EQ(1u, semaphore.value());
+    EXPECT_TRUE(semaphore.tryAcquire());
+}
+
+TEST(Semaphore, TimesOut) {
+    TEST_DESCRIPTION("Waiting for a permit that never comes should give up");
+    Semaphore semaphore;
+    EXPECT_FALSE(semaphore.tryAcquireFor(1000000));
+    semaphore.release();
+    EXPECT_TRUE(semaphore.tryAcquireFor(1000000));
+}
+
+TEST(Semaphore, WakesWaiter) {
+    TEST_DESCRIPTION("Releasing should wake a thread waiting for a permit");
+    Semaphore semaphore;
+    bool acquired = false;
+    Thread thread;
+    ASSERT_TRUE(thread.start(Function<void()>([&]() {
+        semaphore.acquire();
+        acquired = true;
+    })));
+    semaphore.release();
+    thread.join();
+    EXPECT_TRUE(acquired);
+    EXPECT_EQ(0u, semaphore.value());
+}
+
+TEST(Semaphore, PingPong) {
+    TEST_DESCRIPTION("Two semaphores should pass control back and forth between threads");
+    Semaphore ping;
+    Semaphore pong;
+    int value = 0;
+    Thread thread;
+    ASSERT_TRUE(thread.start(Function<void()>([&]() {
+        for(int i = 0; i < 1000; i++) {
+            ping.acquire();
+            value++;
+            pong.release();
+        }
+    })));
+    for(int i = 0; i < 1000; i++) {
+        ping.release();
+        pong.acquire();
+        EXPECT_EQ(i + 1, value);
+    }
+    thread.join();
+}
+
+TEST(Semaphore, LimitsConcurrency) {
+    TEST_DESCRIPTION("No more threads than there are permits should hold one at once");
+    Semaphore semaphore(2);
+    int holding = 0;
+    int most = 0;
+    Thread threads[6];
+    for(auto &thread : threads)
+        ASSERT_TRUE(thread.start(Function<void()>([&]() {
+            for(int i = 0; i < 200; i++) {
+                semaphore.acquire();
+                const auto now = __atomic_add_fetch(&holding, 1, __ATOMIC_RELAXED);
+                auto seen = __atomic_load_n(&most, __ATOMIC_RELAXED);
+                while(now > seen && !__atomic_compare_exchange_n(&most, &seen, now, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                    continue;
+                __atomic_sub_fetch(&holding, 1, __ATOMIC_RELAXED);
+                semaphore.release();
+            }
+        })));
+    for(auto &thread : threads)
+        thread.join();
+    EXPECT_LE(most, 2);
+    EXPECT_EQ(2u, semaphore.value());
+}
@@ -107,4 +107,19 @@ TEST(SharedPointer, ArraySpecializationBoolCastFalse) {
     TEST_DESCRIPTION("Cast to bool should return false for null pointers");
     SharedPointer<int[]> sharedPointer(nullptr);
     EXPECT_FALSE((bool) sharedPointer);
-}
\ No newline at end of file
+}
+
+TEST(SharedPointer, UseCount) {
+    TEST_DESCRIPTION("Use count tracks copies and drops to zero when moved from");
+    SharedPointer<int> first(new int(1));
+    EXPECT_EQ(1u, first.useCount());
+    {
+        SharedPointer<int> second(first);
+        EXPECT_EQ(2u, first.useCount());
+        EXPECT_EQ(2u, second.useCount());
+    }
+    EXPECT_EQ(1u, first.useCount());
+    SharedPointer<int> moved(move(first));
+    EXPECT_EQ(0u, first.useCount());
+    EXPECT_EQ(1u, moved.useCount());
+}
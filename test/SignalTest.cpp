@@ -0,0 +1,208 @@
+#include "common.h"
+#include "hyper/Function.h"
+#include "hyper/Signal.h"
+#include "util/DestructorSpy.h"
+
+using namespace hyper;
+
+TEST(Signal, EmitWithoutListeners) {
+    TEST_DESCRIPTION("Emitting a signal with no listeners should do nothing");
+    Signal<void(int)> signal;
+    signal.emit(1);
+    EXPECT_EQ(0u, signal.listenerCount());
+}
+
+TEST(Signal, CallsEveryListener) {
+    TEST_DESCRIPTION("Every connected listener should be called with the arguments");
+    Signal<void(int, int)> signal;
+    int total = 0;
+    for(int i = 0; i < 100; i++)
+        signal.connect([&total, i](int a, int b) { total += a * b + i; });
+    signal.emit(2, 3);
+    EXPECT_EQ(100 * 6 + 4950, total);
+    EXPECT_EQ(100u, signal.listenerCount());
+}
+
+TEST(Signal, FunctionListener) {
+    TEST_DESCRIPTION("Function instances should be accepted as listeners");
+    Signal<void(int)> signal;
+    int value = 0;
+    Function<void(int)> function([&value](int x) { value = x; });
+    signal.connect(function);
+    signal(7);
+    EXPECT_EQ(7, value);
+}
+
+TEST(Signal, LargeListener) {
+    TEST_DESCRIPTION("Listeners too large to store inline should still be called and destroyed");
+    int calls = 0;
+    int destroyed = 0;
+    struct Large {
+        int *calls;
+        DestructorSpy spy;
+        char padding[128];
+
+        void operator()() const {
+            (*calls)++;
+        }
+    };
+    {
+        Signal<void()> scoped;
+        scoped.connect(Large{&calls, DestructorSpy(&destroyed), {}});
+        scoped.emit();
+        EXPECT_EQ(1, calls);
+        destroyed = 0;
+    }
+    EXPECT_EQ(1, destroyed);
+}
+
+TEST(Signal, Disconnect) {
+    TEST_DESCRIPTION("A disconnected listener should not be called");
+    Signal<void()> signal;
+    int first = 0, second = 0;
+    auto connection = signal.connect([&first]() { first++; });
+    signal.connect([&second]() { second++; });
+    EXPECT_TRUE(signal.isConnected(connection));
+    EXPECT_TRUE(signal.disconnect(connection));
+    EXPECT_FALSE(signal.isConnected(connection));
+    EXPECT_FALSE(signal.disconnect(connection));
+    signal.emit();
+    EXPECT_EQ(0, first);
+    EXPECT_EQ(1, second);
+}
+
+TEST(Signal, StaleConnection) {
+    TEST_DESCRIPTION("A handle to a disconnected listener should not affect a listener reusing its slot");
+    Signal<void()> signal;
+    int calls = 0;
+    auto stale = signal.connect([]() {});
+    signal.disconnect(stale);
+    auto fresh = signal.connect([&calls]() { calls++; });
+    EXPECT_FALSE(signal.disconnect(stale));
+    EXPECT_TRUE(signal.isConnected(fresh));
+    signal.emit();
+    EXPECT_EQ(1, calls);
+    EXPECT_FALSE(signal.isConnected(Signal<void()>::Connection()));
+}
+
+TEST(Signal, DisconnectSelfWhileEmitting) {
+    TEST_DESCRIPTION("A listener should be able to disconnect itself while it is being called");
+    Signal<void()> signal;
+    Signal<void()>::Connection connection;
+    int calls = 0;
+    connection = signal.connect([&]() {
+        calls++;
+        signal.disconnect(connection);
+    });
+    signal.emit();
+    signal.emit();
+    EXPECT_EQ(1, calls);
+    EXPECT_EQ(0u, signal.listenerCount());
+}
+
+TEST(Signal, DisconnectOtherWhileEmitting) {
+    TEST_DESCRIPTION("A listener disconnected during an emit should not be called later in that emit");
+    Signal<void()> signal;
+    Signal<void()>::Connection second;
+    int calls = 0;
+    signal.connect([&]() { signal.disconnect(second); });
+    second = signal.connect([&calls]() { calls++; });
+    signal.emit();
+    EXPECT_EQ(0, calls);
+}
+
+TEST(Signal, ConnectWhileEmitting) {
+    TEST_DESCRIPTION("A listener connected during an emit should first be called by the next emit");
+    Signal<void()> signal;
+    int added = 0;
+    bool connected = false;
+    for(int i = 0; i < 20; i++)
+        signal.connect([]() {});
+    signal.connect([&]() {
+        if(!connected) {
+            connected = true;
+            for(int i = 0; i < 40; i++)
+                signal.connect([&added]() { added++; });
+        }
+    });
+    signal.emit();
+    EXPECT_EQ(0, added);
+    signal.emit();
+    EXPECT_EQ(40, added);
+}
+
+TEST(Signal, ReentrantEmit) {
+    TEST_DESCRIPTION("A listener should be able to emit the signal again");
+    Signal<void(int)> signal;
+    int total = 0;
+    signal.connect([&](int depth) {
+        total++;
+        if(depth > 0)
+            signal.emit(depth - 1);
+    });
+    signal.emit(3);
+    EXPECT_EQ(4, total);
+}
+
+TEST(Signal, DisconnectAll) {
+    TEST_DESCRIPTION("Disconnecting all listeners should stop every one of them being called");
+    Signal<void()> signal;
+    int calls = 0;
+    for(int i = 0; i < 5; i++)
+        signal.connect([&calls]() { calls++; });
+    signal.disconnectAll();
+    signal.emit();
+    EXPECT_EQ(0, calls);
+    EXPECT_EQ(0u, signal.listenerCount());
+}
+
+TEST(Signal, QueuedCalls) {
+    TEST_DESCRIPTION("Queued calls should be delivered in order when flushed");
+    Signal<void(const int &)> signal;
+    int values[4] = {};
+    int count = 0;
+    signal.connect([&](const int &value) { values[count++] = value; });
+    for(int i = 1; i <= 3; i++)
+        signal.enqueue(i * 10);
+    EXPECT_EQ(0, count);
+    EXPECT_EQ(3u, signal.queuedCount());
+    signal.flush();
+    ASSERT_EQ(3, count);
+    EXPECT_EQ(10, values[0]);
+    EXPECT_EQ(20, values[1]);
+    EXPECT_EQ(30, values[2]);
+    EXPECT_EQ(0u, signal.queuedCount());
+}
+
+TEST(Signal, EnqueueWhileFlushing) {
+    TEST_DESCRIPTION("Calls queued while flushing should wait for the next flush");
+    Signal<void(int)> signal;
+    int calls = 0;
+    signal.connect([&](int value) {
+        calls++;
+        if(value > 0)
+            signal.enqueue(value - 1);
+    });
+    signal.enqueue(2);
+    signal.flush();
+    EXPECT_EQ(1, calls);
+    EXPECT_EQ(1u, signal.queuedCount());
+    signal.flush();
+    signal.flush();
+    EXPECT_EQ(3, calls);
+    EXPECT_EQ(0u, signal.queuedCount());
+}
+
+TEST(Signal, DestroysListeners) {
+    TEST_DESCRIPTION("Listeners should be destroyed when disconnected and when the signal is destroyed");
+    int destroyed = 0;
+    {
+        Signal<void()> signal;
+        auto connection = signal.connect([spy = DestructorSpy(&destroyed)]() {});
+        signal.connect([spy = DestructorSpy(&destroyed)]() {});
+        destroyed = 0;
+        signal.disconnect(connection);
+        EXPECT_EQ(1, destroyed);
+    }
+    EXPECT_EQ(2, destroyed);
+}
@@ -0,0 +1,62 @@
+#include "common.h"
+#include "hyper/sort.h"
+#include "hyper/hash.h"
+
+using namespace hyper;
+
+TEST(Sort, Empty) {
+    TEST_DESCRIPTION("Sorting nothing should do nothing");
+    int32 values[1] = {5};
+    sort(values, 0);
+    EXPECT_EQ(5, values[0]);
+}
+
+TEST(Sort, Ascending) {
+    TEST_DESCRIPTION("Values should be in ascending order after sorting");
+    const size_t count = 1000;
+    uint64 values[count];
+    for(size_t i = 0; i < count; i++)
+        values[i] = hash(i) % 500;
+    sort(values, count);
+    for(size_t i = 1; i < count; i++)
+        ASSERT_LE(values[i - 1], values[i]);
+}
+
+TEST(Sort, Descending) {
+    TEST_DESCRIPTION("The comparison should decide the order");
+    int32 values[] = {3, 9, -1, 4, 4, 0, 12, 7};
+    const size_t count = sizeof(values) / sizeof(values[0]);
+    sort(values, count, [](int32 first, int32 second) { return first > second; });
+    for(size_t i = 1; i < count; i++)
+        EXPECT_GE(values[i - 1], values[i]);
+}
+
+TEST(Sort, AdversarialInputs) {
+    TEST_DESCRIPTION("Sorted, reversed and constant inputs should still be sorted correctly");
+    const size_t count = 5000;
+    auto values = new int32[count];
+    for(size_t i = 0; i < count; i++)
+        values[i] = static_cast<int32>(count - i);
+    sort(values, count);
+    for(size_t i = 0; i < count; i++)
+        ASSERT_EQ(static_cast<int32>(i + 1), values[i]);
+    sort(values, count);
+    for(size_t i = 0; i < count; i++)
+        ASSERT_EQ(static_cast<int32>(i + 1), values[i]);
+    for(size_t i = 0; i < count; i++)
+        values[i] = 7;
+    sort(values, count);
+    for(size_t i = 0; i < count; i++)
+        ASSERT_EQ(7, values[i]);
+    delete[] values;
+}
+
+TEST(Sort, Unique) {
+    TEST_DESCRIPTION("Adjacent duplicates should be removed");
+    int32 values[] = {1, 1, 2, 3, 3, 3, 4, 1};
+    const auto kept = unique(values, 8);
+    ASSERT_EQ(5u, kept);
+    const int32 expected[] = {1, 2, 3, 4, 1};
+    for(size_t i = 0; i < kept; i++)
+        EXPECT_EQ(expected[i], values[i]);
+}
@@ -0,0 +1,44 @@
+#include <thread>
+#include "common.h"
+#include "hyper/ScopedLock.h"
+#include "hyper/SpinLock.h"
+
+using namespace hyper;
+
+TEST(SpinLock, TryLock) {
+    TEST_DESCRIPTION("A held lock should not be acquired again until it is released");
+    SpinLock lock;
+    EXPECT_TRUE(lock.tryLock());
+    EXPECT_FALSE(lock.tryLock());
+    lock.unlock();
+    EXPECT_TRUE(lock.tryLock());
+    lock.unlock();
+}
+
+TEST(SpinLock, ScopedLock) {
+    TEST_DESCRIPTION("A scoped lock should hold the lock until the end of its scope");
+    SpinLock lock;
+    {
+        ScopedLock<SpinLock> guard(lock);
+        EXPECT_FALSE(lock.tryLock());
+    }
+    EXPECT_TRUE(lock.tryLock());
+    lock.unlock();
+}
+
+TEST(SpinLock, MutualExclusion) {
+    TEST_DESCRIPTION("Updates made while holding the lock should not be lost");
+    SpinLock lock;
+    size_t total = 0;
+    std::thread threads[4];
+    for(auto &thread : threads)
+        thread = std::thread([&lock, &total]() {
+            for(size_t i = 0; i < 20000; i++) {
+                ScopedLock<SpinLock> guard(lock);
+                total++;
+            }
+        });
+    for(auto &thread : threads)
+        thread.join();
+    EXPECT_EQ(80000u, total);
+}
@@ -0,0 +1,153 @@
+#include <cstring>
+#include <thread>
+#include "common.h"
+#include "hyper/TaskGraph.h"
+
+using namespace hyper;
+
+TEST(TaskGraph, Empty) {
+    TEST_DESCRIPTION("An empty graph should compile and finish immediately");
+    TaskGraph graph;
+    ASSERT_TRUE(graph.compile());
+    graph.run();
+    EXPECT_TRUE(graph.isDone());
+}
+
+TEST(TaskGraph, DependencyOrder) {
+    TEST_DESCRIPTION("Nodes should not run until their predecessors have finished");
+    TaskGraph graph;
+    int order[4] = {};
+    int next = 0;
+    auto a = graph.addNode(Function<void()>([&]() { order[0] = next++; }));
+    auto b = graph.addNode(Function<void()>([&]() { order[1] = next++; }));
+    auto c = graph.addNode(Function<void()>([&]() { order[2] = next++; }));
+    auto d = graph.addNode(Function<void()>([&]() { order[3] = next++; }));
+    // Diamond, added in reverse so index order doesn't happen to match dependency order.
+    graph.addEdge(c, a);
+    graph.addEdge(b, a);
+    graph.addEdge(d, b);
+    graph.addEdge(d, c);
+    ASSERT_TRUE(graph.compile());
+    graph.run();
+    EXPECT_EQ(0, order[3]);
+    EXPECT_LT(order[1], order[0]);
+    EXPECT_LT(order[2], order[0]);
+    EXPECT_EQ(3, order[0]);
+}
+
+TEST(TaskGraph, Cycle) {
+    TEST_DESCRIPTION("A graph with a cycle should fail to compile");
+    TaskGraph graph;
+    auto a = graph.addNode(Function<void()>([]() {}));
+    auto b = graph.addNode(Function<void()>([]() {}));
+    auto c = graph.addNode(Function<void()>([]() {}));
+    graph.addEdge(a, b);
+    graph.addEdge(b, c);
+    graph.addEdge(c, b);
+    EXPECT_FALSE(graph.compile());
+}
+
+TEST(TaskGraph, CriticalPathFirst) {
+    TEST_DESCRIPTION("When several nodes are ready, the one with the longest chain behind it should run first");
+    TaskGraph graph;
+    int order[4] = {};
+    int next = 0;
+    graph.addNode(Function<void()>([&]() { order[0] = next++; }));
+    auto head = graph.addNode(Function<void()>([&]() { order[1] = next++; }));
+    auto middle = graph.addNode(Function<void()>([&]() { order[2] = next++; }));
+    auto tail = graph.addNode(Function<void()>([&]() { order[3] = next++; }));
+    graph.addEdge(head, middle);
+    graph.addEdge(middle, tail);
+    ASSERT_TRUE(graph.compile());
+    graph.run();
+    EXPECT_EQ(0, order[1]);
+    EXPECT_LT(order[1], order[0]);
+}
+
+TEST(TaskGraph, Rerun) {
+    TEST_DESCRIPTION("A compiled graph should run every node once each time it is run");
+    TaskGraph graph;
+    int counts[8] = {};
+    for(size_t i = 0; i < 8; i++) {
+        auto count = &counts[i];
+        graph.addNode(Function<void()>([count]() { (*count)++; }));
+        if(i > 0)
+            graph.addEdge(i - 1, i);
+    }
+    ASSERT_TRUE(graph.compile());
+    for(int frame = 0; frame < 5; frame++)
+        graph.run();
+    for(auto count : counts)
+        EXPECT_EQ(5, count);
+}
+
+TEST(TaskGraph, Parallel) {
+    TEST_DESCRIPTION("Threads sharing a run should run every node exactly once, after its predecessors");
+    constexpr size_t layers = 20;
+    constexpr size_t width = 50;
+    TaskGraph graph;
+    static int runs[layers * width];
+    static int finishedLayers[layers * width];
+    memset(runs, 0, sizeof(runs));
+    for(size_t layer = 0; layer < layers; layer++) {
+        for(size_t i = 0; i < width; i++) {
+            const size_t index = layer * width + i;
+            graph.addNode(Function<void()>([index]() {
+                // Every node in the previous layer is a predecessor, so all of them must be done.
+                if(index >= width) {
+                    const size_t start = (index / width - 1) * width;
+                    for(size_t j = start; j < start + width; j++)
+                        if(__atomic_load_n(&runs[j], __ATOMIC_ACQUIRE) == 0)
+                            finishedLayers[index] = -1;
+                }
+                __atomic_fetch_add(&runs[index], 1, __ATOMIC_RELEASE);
+            }));
+            if(layer > 0)
+                for(size_t j = 0; j < width; j++)
+                    graph.addEdge((layer - 1) * width + j, index);
+        }
+    }
+    ASSERT_TRUE(graph.compile());
+    for(int frame = 0; frame < 3; frame++) {
+        graph.start();
+        std::thread threads[3];
+        for(auto &thread : threads)
+            thread = std::thread([&graph]() { graph.work(); });
+        graph.work();
+        for(auto &thread : threads)
+            thread.join();
+        EXPECT_TRUE(graph.isDone());
+    }
+    for(size_t i = 0; i < layers * width; i++) {
+        EXPECT_EQ(3, runs[i]);
+        EXPECT_EQ(0, finishedLayers[i]);
+    }
+}
+
+TEST(TaskGraph, Graphviz) {
+    TEST_DESCRIPTION("The Graphviz description should list the nodes and edges");
+    TaskGraph graph;
+    auto a = graph.addNode(Function<void()>([]() {}), "input");
+    auto b = graph.addNode(Function<void()>([]() {}), "say \"hi\"");
+    graph.addEdge(a, b);
+    char buffer[256];
+    auto length = graph.toGraphviz(buffer, sizeof(buffer));
+    ASSERT_LT(length, sizeof(buffer));
+    EXPECT_EQ(strlen(buffer), length);
+    EXPECT_NE(nullptr, strstr(buffer, "digraph"));
+    EXPECT_NE(nullptr, strstr(buffer, "n0 [label=\"input\"]"));
+    EXPECT_NE(nullptr, strstr(buffer, "n1 [label=\"say \\\"hi\\\"\"]"));
+    EXPECT_NE(nullptr, strstr(buffer, "n0 -> n1;"));
+}
+
+TEST(TaskGraph, GraphvizTruncated) {
+    TEST_DESCRIPTION("A description that doesn't fit should be truncated and report its full length");
+    TaskGraph graph;
+    graph.addNode(Function<void()>([]() {}), "node");
+    char full[128];
+    auto length = graph.toGraphviz(full, sizeof(full));
+    char small[16];
+    EXPECT_EQ(length, graph.toGraphviz(small, sizeof(small)));
+    EXPECT_EQ(sizeof(small) - 1, strlen(small));
+    EXPECT_EQ(0, strncmp(full, small, sizeof(small) - 1));
+}
@@ -0,0 +1,85 @@
+#include "common.h"
+#include "hyper/EventLoop.h"
+#include "hyper/Task.h"
+
+using namespace hyper;
+
+namespace {
+    class TestError : public Error {
+    public:
+        const char *message() const noexcept override {
+            return "task failed";
+        }
+    };
+
+    Task<int> answer() {
+        co_return 42;
+    }
+
+    Task<int> fail() {
+        co_return SharedPointer<Error>(new TestError());
+    }
+
+    Task<int> add(int depth) {
+        if(depth == 0)
+            co_return 0;
+        auto rest = co_await add(depth - 1);
+        co_return rest.value() + 1;
+    }
+
+    Task<> record(Task<int> task, Result<int> *result) {
+        *result = co_await task;
+    }
+}
+
+TEST(Task, Lazy) {
+    TEST_DESCRIPTION("A task should not run until it is awaited");
+    bool started = false;
+    auto task = [&started]() -> Task<> {
+        started = true;
+        co_return;
+    }();
+    EXPECT_FALSE(started);
+    EXPECT_FALSE(task.isDone());
+}
+
+TEST(Task, Value) {
+    TEST_DESCRIPTION("Awaiting a task should produce its value");
+    EventLoop loop;
+    Result<int> result(0);
+    loop.spawn(record(answer(), &result));
+    loop.run();
+    ASSERT_TRUE(result.isOk());
+    EXPECT_EQ(42, result.value());
+}
+
+TEST(Task, Error) {
+    TEST_DESCRIPTION("Awaiting a failed task should produce its error");
+    EventLoop loop;
+    Result<int> result(0);
+    loop.spawn(record(fail(), &result));
+    loop.run();
+    ASSERT_FALSE(result.isOk());
+    EXPECT_STREQ("task failed", result.error()->message());
+}
+
+TEST(Task, NestedAwaits) {
+    TEST_DESCRIPTION("Each awaiting task should resume with the result of the task it awaited");
+    EventLoop loop;
+    Result<int> result(0);
+    loop.spawn(record(add(1000), &result));
+    loop.run();
+    ASSERT_TRUE(result.isOk());
+    EXPECT_EQ(1000, result.value());
+}
+
+TEST(Task, FrameReuse) {
+    TEST_DESCRIPTION("Frames should be recycled between tasks of the same size");
+    EventLoop loop;
+    Result<int> result(0);
+    for(int i = 0; i < 1000; i++) {
+        loop.spawn(record(answer(), &result));
+        loop.run();
+    }
+    EXPECT_EQ(42, result.value());
+}
@@ -0,0 +1,173 @@
+#include <cstdio>
+#include <cstdlib>
+#include "common.h"
+#include "hyper/SpinLock.h"
+#include "hyper/Thread.h"
+#include "hyper/ThreadLocal.h"
+
+using namespace hyper;
+
+namespace {
+    struct Tracked {
+        static int live;
+
+        int value;
+
+        Tracked() noexcept
+                : value(0) {
+            live++;
+        }
+
+        Tracked(const Tracked &other) noexcept
+                : value(other.value) {
+            live++;
+        }
+
+        ~Tracked() noexcept {
+            live--;
+        }
+
+        Tracked &operator=(const Tracked &other) = delete;
+    };
+
+    int Tracked::live = 0;
+}
+
+TEST(ThreadLocal, SameThread) {
+    TEST_DESCRIPTION("A thread should see the same value each time");
+    ThreadLocal<int> local;
+    EXPECT_EQ(nullptr, local.tryGet());
+    local.get() = 5;
+    EXPECT_EQ(5, *local);
+    EXPECT_EQ(&local.get(), local.tryGet());
+}
+
+TEST(ThreadLocal, InitialValue) {
+    TEST_DESCRIPTION("Each thread should start with a copy of the initial value");
+    ThreadLocal<int> local(12);
+    EXPECT_EQ(12, local.get());
+    local.get() = 1;
+    int seen = 0;
+    Thread thread;
+    ASSERT_TRUE(thread.start(Function<void()>([&]() { seen = local.get(); })));
+    thread.join();
+    EXPECT_EQ(12, seen);
+    EXPECT_EQ(1, local.get());
+}
+
+TEST(ThreadLocal, SeparateThreads) {
+    TEST_DESCRIPTION("Each thread should have its own value");
+    ThreadLocal<int> local;
+    local.get() = -1;
+    int seen[4] = {};
+    Thread threads[4];
+    for(int i = 0; i < 4; i++)
+        ASSERT_TRUE(threads[i].start(Function<void()>([&local, &seen, i]() {
+            for(int j = 0; j < 1000; j++)
+                local.get() += i + 1;
+            seen[i] = local.get();
+        })));
+    for(auto &thread : threads)
+        thread.join();
+    for(int i = 0; i < 4; i++)
+        EXPECT_EQ(1000 * (i + 1), seen[i]);
+    EXPECT_EQ(-1, local.get());
+}
+
+TEST(ThreadLocal, DestroyedAtThreadExit) {
+    TEST_DESCRIPTION("A thread's value should be destroyed when the thread exits");
+    ThreadLocal<Tracked> local;
+    const auto before = Tracked::live;
+    int during = 0;
+    Thread thread;
+    ASSERT_TRUE(thread.start(Function<void()>([&]() {
+        local.get();
+        during = Tracked::live;
+    })));
+    thread.join();
+    EXPECT_EQ(before + 1, during);
+    EXPECT_EQ(before, Tracked::live);
+}
+
+TEST(ThreadLocal, DestroyedWithObject) {
+    TEST_DESCRIPTION("Destroying the object should destroy the values of running threads");
+    const auto before = Tracked::live;
+    {
+        ThreadLocal<Tracked> local;
+        local.get().value = 3;
+        EXPECT_EQ(before + 1, Tracked::live);
+    }
+    EXPECT_EQ(before, Tracked::live);
+}
+
+TEST(ThreadLocal, ReusedSlot) {
+    TEST_DESCRIPTION("A new object reusing a slot should not see the old object's value");
+    {
+        ThreadLocal<int> first;
+        first.get() = 99;
+    }
+    ThreadLocal<int> second;
+    EXPECT_EQ(nullptr, second.tryGet());
+    EXPECT_EQ(0, second.get());
+}
+
+TEST(ThreadLocal, ManyInstances) {
+    TEST_DESCRIPTION("Slots should grow to hold many objects");
+    constexpr int count = 100;
+    auto locals = new ThreadLocal<int>[count];
+    for(int i = 0; i < count; i++)
+        locals[i].get() = i;
+    for(int i = 0; i < count; i++)
+        EXPECT_EQ(i, locals[i].get());
+    delete[] locals;
+}
+
+TEST(ThreadLocal, ForEach) {
+    TEST_DESCRIPTION("Visiting should reach the value of every live thread");
+    ThreadLocal<int> local;
+    local.get() = 1;
+    bool ready[3] = {};
+    bool release = false;
+    Thread threads[3];
+    for(int i = 0; i < 3; i++)
+        ASSERT_TRUE(threads[i].start(Function<void()>([&local, &ready, &release, i]() {
+            local.get() = 10 * (i + 1);
+            __atomic_store_n(&ready[i], true, __ATOMIC_RELEASE);
+            while(!__atomic_load_n(&release, __ATOMIC_ACQUIRE))
+                yieldThread();
+        })));
+    for(auto &flag : ready)
+        while(!__atomic_load_n(&flag, __ATOMIC_ACQUIRE))
+            yieldThread();
+    int total = 0;
+    int visited = 0;
+    local.forEach([&](int &value) {
+        total += value;
+        visited++;
+    });
+    __atomic_store_n(&release, true, __ATOMIC_RELEASE);
+    for(auto &thread : threads)
+        thread.join();
+    EXPECT_EQ(4, visited);
+    EXPECT_EQ(61, total);
+}
+
+namespace {
+    struct ReportsExit {
+        ~ReportsExit() noexcept {
+            fprintf(stderr, "value destroyed\n");
+        }
+    };
+
+    // Leaves a value on the calling thread and exits without destroying the ThreadLocal that owns it.
+    void exitWithValue() {
+        auto local = new ThreadLocal<ReportsExit>;
+        local->get();
+        exit(0);
+    }
+}
+
+TEST(ThreadLocal, DestroyedAtProcessExit) {
+    TEST_DESCRIPTION("Values of the thread that exits the process should be destroyed");
+    EXPECT_EXIT(exitWithValue(), ::testing::ExitedWithCode(0), "value destroyed");
+}
@@ -0,0 +1,98 @@
+#include <cstring>
+#include <pthread.h>
+#include "common.h"
+#include "hyper/Thread.h"
+
+using namespace hyper;
+
+TEST(Thread, RunsEntry) {
+    TEST_DESCRIPTION("The entry point should have run by the time join() returns");
+    int value = 0;
+    Thread thread;
+    ASSERT_TRUE(thread.start(Function<void()>([&]() { value = 42; })));
+    EXPECT_TRUE(thread.isJoinable());
+    thread.join();
+    EXPECT_FALSE(thread.isJoinable());
+    EXPECT_EQ(42, value);
+}
+
+TEST(Thread, DestructorJoins) {
+    TEST_DESCRIPTION("Destroying a running thread should wait for it to finish");
+    int value = 0;
+    {
+        Thread thread;
+        ASSERT_TRUE(thread.start(Function<void()>([&]() { value = 7; })));
+    }
+    EXPECT_EQ(7, value);
+}
+
+TEST(Thread, Move) {
+    TEST_DESCRIPTION("Moving a thread should transfer ownership of it");
+    int value = 0;
+    Thread first;
+    ASSERT_TRUE(first.start(Function<void()>([&]() { value = 3; })));
+    Thread second(static_cast<Thread &&>(first));
+    EXPECT_FALSE(first.isJoinable());
+    EXPECT_TRUE(second.isJoinable());
+    Thread third;
+    third = static_cast<Thread &&>(second);
+    EXPECT_FALSE(second.isJoinable());
+    third.join();
+    EXPECT_EQ(3, value);
+}
+
+TEST(Thread, Name) {
+    TEST_DESCRIPTION("Threads should be given their name, truncated to what the system allows");
+    char name[32] = {};
+    Thread thread;
+    ASSERT_TRUE(thread.start(Function<void()>([&]() {
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+    }), "a rather long thread name"));
+    thread.join();
+    EXPECT_STREQ("a rather long t", name);
+}
+
+TEST(Thread, CurrentId) {
+    TEST_DESCRIPTION("Each thread should have its own identifier");
+    const auto mainId = Thread::currentId();
+    uint64 otherId = mainId;
+    Thread thread;
+    ASSERT_TRUE(thread.start(Function<void()>([&]() { otherId = Thread::currentId(); })));
+    thread.join();
+    EXPECT_NE(mainId, otherId);
+    EXPECT_EQ(mainId, Thread::currentId());
+}
+
+TEST(Thread, Affinity) {
+    TEST_DESCRIPTION("A thread should run on the CPU it is pinned to");
+    cpu_set_t original;
+    ASSERT_EQ(0, pthread_getaffinity_np(pthread_self(), sizeof(original), &original));
+    uint32 cpu = 0;
+    while(!CPU_ISSET(cpu, &original))
+        cpu++;
+    int observed = -1;
+    Thread thread;
+    ASSERT_TRUE(thread.start(Function<void()>([&]() {
+        ASSERT_TRUE(Thread::setCurrentAffinity(&cpu, 1));
+        observed = sched_getcpu();
+    })));
+    thread.join();
+    EXPECT_EQ(static_cast<int>(cpu), observed);
+}
+
+TEST(Thread, InvalidAffinity) {
+    TEST_DESCRIPTION("Pinning to a CPU that can't exist should fail");
+    const uint32 cpu = CPU_SETSIZE;
+    EXPECT_FALSE(Thread::setCurrentAffinity(&cpu, 1));
+}
+
+TEST(Thread, LowerPriority) {
+    TEST_DESCRIPTION("Any thread should be allowed to lower its own priority");
+    bool lowered = false;
+    Thread thread;
+    ASSERT_TRUE(thread.start(Function<void()>([&]() {
+        lowered = static_cast<bool>(Thread::setCurrentPriority(ThreadPriority::Low));
+    })));
+    thread.join();
+    EXPECT_TRUE(lowered);
+}
@@ -0,0 +1,190 @@
+#include "common.h"
+#include "hyper/TimerWheel.h"
+
+using namespace hyper;
+
+TEST(TimerWheel, FiresWhenDue) {
+    TEST_DESCRIPTION("A timer should fire once its delay has passed, and not before");
+    TimerWheel wheel;
+    int fired = 0;
+    TimerWheel::Timer timer(Function<void()>([&fired]() { fired++; }));
+    wheel.schedule(timer, 10);
+    EXPECT_TRUE(timer.isScheduled());
+    EXPECT_EQ(10u, timer.expiry());
+    EXPECT_EQ(0u, wheel.advance(9));
+    EXPECT_EQ(0, fired);
+    EXPECT_EQ(1u, wheel.advance());
+    EXPECT_EQ(1, fired);
+    EXPECT_FALSE(timer.isScheduled());
+    EXPECT_EQ(0u, wheel.size());
+}
+
+TEST(TimerWheel, ZeroDelay) {
+    TEST_DESCRIPTION("A timer with no delay should fire on the next tick");
+    TimerWheel wheel(100);
+    int fired = 0;
+    TimerWheel::Timer timer(Function<void()>([&fired]() { fired++; }));
+    wheel.schedule(timer, 0);
+    EXPECT_EQ(0u, wheel.advance(0));
+    EXPECT_EQ(1u, wheel.advance());
+    EXPECT_EQ(1, fired);
+}
+
+TEST(TimerWheel, Cancel) {
+    TEST_DESCRIPTION("A cancelled timer should not fire");
+    TimerWheel wheel;
+    int fired = 0;
+    TimerWheel::Timer timer(Function<void()>([&fired]() { fired++; }));
+    wheel.schedule(timer, 5);
+    EXPECT_TRUE(wheel.cancel(timer));
+    EXPECT_FALSE(wheel.cancel(timer));
+    EXPECT_FALSE(timer.isScheduled());
+    EXPECT_EQ(0u, wheel.advance(10));
+    EXPECT_EQ(0, fired);
+}
+
+TEST(TimerWheel, DestroyedTimerCancels) {
+    TEST_DESCRIPTION("Destroying a scheduled timer should remove it from the wheel");
+    TimerWheel wheel;
+    int fired = 0;
+    {
+        TimerWheel::Timer timer(Function<void()>([&fired]() { fired++; }));
+        wheel.schedule(timer, 5);
+        EXPECT_EQ(1u, wheel.size());
+    }
+    EXPECT_EQ(0u, wheel.size());
+    EXPECT_EQ(0u, wheel.advance(10));
+    EXPECT_EQ(0, fired);
+}
+
+TEST(TimerWheel, Reschedule) {
+    TEST_DESCRIPTION("Scheduling a timer again should move it to the new time");
+    TimerWheel wheel;
+    int fired = 0;
+    TimerWheel::Timer timer(Function<void()>([&fired]() { fired++; }));
+    wheel.schedule(timer, 5);
+    wheel.schedule(timer, 500);
+    EXPECT_EQ(1u, wheel.size());
+    EXPECT_EQ(0u, wheel.advance(499));
+    EXPECT_EQ(1u, wheel.advance());
+    EXPECT_EQ(1, fired);
+}
+
+TEST(TimerWheel, DistantTimers) {
+    TEST_DESCRIPTION("Timers across every ring should fire exactly on their expiry tick");
+    TimerWheel wheel(12345);
+    constexpr size_t count = 40;
+    uint64 firedAt[count] = {};
+    uint64 delays[count] = {};
+    TimerWheel::Timer *timers[count] = {};
+    for(size_t i = 0; i < count; i++) {
+        delays[i] = (uint64(1) << i) + i * 7;
+        auto slot = &firedAt[i];
+        timers[i] = new TimerWheel::Timer(Function<void()>([slot, &wheel]() { *slot = wheel.now(); }));
+        wheel.schedule(*timers[i], delays[i]);
+    }
+    // Advance in uneven steps, ending exactly at the last expiry.
+    const uint64 end = 12345 + delays[count - 1];
+    uint64 step = 1;
+    while(wheel.now() < end) {
+        wheel.advance(step);
+        step = step * 3 + 1;
+    }
+    for(size_t i = 0; i < count; i++) {
+        EXPECT_FALSE(timers[i]->isScheduled()) << "timer " << i;
+        EXPECT_GE(firedAt[i], 12345 + delays[i]) << "timer " << i;
+        delete timers[i];
+    }
+    // Each step is checked separately, since timers fire in a batch at the end of an advance.
+    for(size_t i = 0; i < count; i++) {
+        TimerWheel exact(12345);
+        TimerWheel::Timer timer(Function<void()>([]() {}));
+        exact.schedule(timer, delays[i]);
+        uint64 tick = 0;
+        ASSERT_TRUE(exact.nextTick(tick));
+        EXPECT_LE(tick, 12345 + delays[i]);
+        EXPECT_EQ(0u, exact.advanceTo(12345 + delays[i] - 1)) << "timer " << i;
+        EXPECT_EQ(1u, exact.advance()) << "timer " << i;
+    }
+}
+
+TEST(TimerWheel, ExpiryOrder) {
+    TEST_DESCRIPTION("Timers that expire in the same advance should fire in expiry order");
+    TimerWheel wheel;
+    int order[3] = {};
+    int next = 0;
+    TimerWheel::Timer late(Function<void()>([&]() { order[0] = next++; }));
+    TimerWheel::Timer early(Function<void()>([&]() { order[1] = next++; }));
+    TimerWheel::Timer middle(Function<void()>([&]() { order[2] = next++; }));
+    wheel.schedule(late, 300);
+    wheel.schedule(early, 3);
+    wheel.schedule(middle, 70);
+    EXPECT_EQ(3u, wheel.advance(1000));
+    EXPECT_EQ(0, order[1]);
+    EXPECT_EQ(1, order[2]);
+    EXPECT_EQ(2, order[0]);
+}
+
+TEST(TimerWheel, CallbackReschedules) {
+    TEST_DESCRIPTION("A callback should be able to schedule its own timer again");
+    TimerWheel wheel;
+    int fired = 0;
+    TimerWheel::Timer *self = nullptr;
+    TimerWheel::Timer timer(Function<void()>([&]() {
+        fired++;
+        wheel.schedule(*self, 10);
+    }));
+    self = &timer;
+    wheel.schedule(timer, 10);
+    for(int i = 0; i < 100; i++)
+        wheel.advance();
+    EXPECT_EQ(10, fired);
+    EXPECT_TRUE(timer.isScheduled());
+}
+
+TEST(TimerWheel, CallbackCancelsExpired) {
+    TEST_DESCRIPTION("A callback should be able to cancel a timer that expired in the same batch");
+    TimerWheel wheel;
+    int fired = 0;
+    TimerWheel::Timer second(Function<void()>([&fired]() { fired++; }));
+    TimerWheel::Timer first(Function<void()>([&]() {
+        fired++;
+        EXPECT_TRUE(wheel.cancel(second));
+    }));
+    wheel.schedule(first, 1);
+    wheel.schedule(second, 2);
+    EXPECT_EQ(1u, wheel.advance(5));
+    EXPECT_EQ(1, fired);
+}
+
+TEST(TimerWheel, NextTick) {
+    TEST_DESCRIPTION("The next tick should be empty without timers and never after the earliest expiry");
+    TimerWheel wheel;
+    uint64 tick = 0;
+    EXPECT_FALSE(wheel.nextTick(tick));
+    TimerWheel::Timer timer(Function<void()>([]() {}));
+    wheel.schedule(timer, 42);
+    ASSERT_TRUE(wheel.nextTick(tick));
+    EXPECT_EQ(42u, tick);
+}
+
+TEST(TimerWheel, ManyTimers) {
+    TEST_DESCRIPTION("Every one of many timers should fire exactly once");
+    constexpr size_t count = 20000;
+    TimerWheel wheel;
+    size_t fired = 0;
+    auto timers = static_cast<TimerWheel::Timer *>(operator new(sizeof(TimerWheel::Timer) * count));
+    for(size_t i = 0; i < count; i++) {
+        new(&timers[i]) TimerWheel::Timer(Function<void()>([&fired]() { fired++; }));
+        wheel.schedule(timers[i], (i * 7919) % 100000);
+    }
+    EXPECT_EQ(count, wheel.size());
+    size_t total = 0;
+    while(wheel.size() > 0)
+        total += wheel.advance(997);
+    EXPECT_EQ(count, total);
+    EXPECT_EQ(count, fired);
+    for(size_t i = 0; i < count; i++)
+        timers[i].~Timer();
+    operator delete(timers);
+}
@@ -0,0 +1,118 @@
+#include "common.h"
+#include "hyper/Heap.h"
+#include "hyper/Pair.h"
+#include "hyper/SharedPointer.h"
+#include "hyper/traits.h"
+
+using namespace hyper;
+
+namespace {
+    enum class Color {
+        Red, Green
+    };
+
+    struct Empty {
+    };
+
+    struct Owning {
+        int *value;
+
+        Owning()
+                : value(nullptr) {
+            // ...
+        }
+
+        Owning(const Owning &) = delete;
+        Owning &operator=(const Owning &) = delete;
+
+        ~Owning() {
+            delete value;
+        }
+    };
+
+    // Counts destructor calls, to check that containers still destroy non-trivial elements.
+    struct Undestructible {
+        ~Undestructible() = delete;
+    };
+
+    struct Counted {
+        static int destroyed;
+        int value;
+
+        explicit Counted(int value)
+                : value(value) {
+            // ...
+        }
+
+        Counted(const Counted &other) = default;
+
+        ~Counted() {
+            destroyed++;
+        }
+
+        bool operator<(const Counted &other) const {
+            return value < other.value;
+        }
+    };
+
+    int Counted::destroyed = 0;
+
+    static_assert(IsSame<RemoveCvRef<const volatile int &>::type, int>::value);
+    static_assert(IsSame<RemoveCv<const int *>::type, const int *>::value);
+    static_assert(IsSame<Decay<const int &>::type, int>::value);
+    static_assert(IsSame<Decay<int[4]>::type, int *>::value);
+    static_assert(IsSame<Decay<int(char)>::type, int (*)(char)>::value);
+    static_assert(IsSame<Conditional<true, int, char>::type, int>::value);
+    static_assert(IsSame<Conditional<false, int, char>::type, char>::value);
+    static_assert(IsEnum<Color>::value && !IsEnum<int>::value);
+    static_assert(IsEmpty<Empty>::value && !IsEmpty<Owning>::value);
+
+    static_assert(IsTriviallyCopyable<int>::value);
+    static_assert(IsTriviallyCopyable<Pair<int, double>>::value);
+    static_assert(!IsTriviallyCopyable<Owning>::value);
+    static_assert(!IsTriviallyCopyable<SharedPointer<int>>::value);
+    static_assert(IsTriviallyDestructible<Pair<int, Empty>>::value);
+    static_assert(!IsTriviallyDestructible<Owning>::value);
+    static_assert(!IsTriviallyDestructible<Undestructible>::value);
+    static_assert(IsTriviallyRelocatable<Pair<int, int>>::value);
+
+    static_assert(TriviallyCopyable<Pair<int, int>>);
+    static_assert(!TriviallyDestructible<Counted>);
+    static_assert(EqualityComparable<int> && !EqualityComparable<Empty>);
+    static_assert(LessThanComparable<Counted>);
+
+    template<typename T, typename = typename EnableIf<IsTriviallyCopyable<T>::value>::type>
+    constexpr bool copyableBytes(int) {
+        return true;
+    }
+
+    template<typename T>
+    constexpr bool copyableBytes(...) {
+        return false;
+    }
+
+    static_assert(copyableBytes<int>(0));
+    static_assert(!copyableBytes<Owning>(0));
+}
+
+TEST(Traits, TriviallyCopyableGrowth) {
+    TEST_DESCRIPTION("Trivially copyable elements survive growth copied as bytes");
+    Heap<Pair<int, int>> heap;
+    for(int i = 0; i < 1000; i++)
+        heap.push(createPair((i * 7919) % 1000, i));
+    for(int i = 0; i < 1000; i++)
+        EXPECT_EQ(i, heap.pop().first);
+}
+
+TEST(Traits, NonTrivialClear) {
+    TEST_DESCRIPTION("Elements with destructors are still destroyed when cleared");
+    Counted::destroyed = 0;
+    {
+        Heap<Counted> heap;
+        for(int i = 0; i < 10; i++)
+            heap.push(Counted(i));
+        Counted::destroyed = 0;
+        heap.clear();
+        EXPECT_EQ(10, Counted::destroyed);
+    }
+}
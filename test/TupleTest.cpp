@@ -0,0 +1,137 @@
+#include <tuple>   // Declares the same std::tuple_size that Tuple.h specializes.
+#include "common.h"
+#include "hyper/Function.h"
+#include "hyper/Tuple.h"
+
+using namespace hyper;
+
+namespace {
+    struct Empty {
+        bool operator==(const Empty &) const {
+            return true;
+        }
+    };
+
+    struct OtherEmpty {
+        int operator()(int value) const {
+            return value * 2;
+        }
+    };
+
+    // Empty elements take no space.
+    static_assert(sizeof(Tuple<Empty, int>) == sizeof(int));
+    static_assert(sizeof(Tuple<int, Empty, OtherEmpty>) == sizeof(int));
+    static_assert(sizeof(Tuple<Empty, OtherEmpty>) == 1);
+    static_assert(sizeof(Tuple<int, double>) == sizeof(double) * 2);
+    static_assert(Tuple<int, char, float>::size == 3);
+    static_assert(__is_same(TupleElement<1, Tuple<int, char, float>>, char));
+
+    // Large tuples compile, and reaching the last element costs no more than the first.
+    typedef Tuple<int, int, int, int, int, int, int, int, int, int,
+                  int, int, int, int, int, int, int, int, int, int,
+                  int, int, int, int, int, int, int, int, int, int,
+                  int, int, int, int, int, int, int, int, int, int,
+                  int, int, int, int, int, int, int, int, int, char> Wide;
+    static_assert(Wide::size == 50);
+    static_assert(__is_same(TupleElement<49, Wide>, char));
+    static_assert(sizeof(Wide) == sizeof(int) * 50);
+
+    constexpr Tuple<int, char> constant(3, 'x');
+    static_assert(get<0>(constant) == 3);
+    static_assert(get<char>(constant) == 'x');
+}
+
+TEST(Tuple, DefaultConstruct) {
+    TEST_DESCRIPTION("Elements of a default tuple should be value-initialized");
+    Tuple<int, float, bool> tuple;
+    EXPECT_EQ(0, get<0>(tuple));
+    EXPECT_EQ(0.0f, get<1>(tuple));
+    EXPECT_FALSE(get<2>(tuple));
+}
+
+TEST(Tuple, GetByIndex) {
+    TEST_DESCRIPTION("Elements should be reachable and writable by index");
+    Tuple<int, char, double> tuple(1, 'a', 2.5);
+    EXPECT_EQ(1, get<0>(tuple));
+    EXPECT_EQ('a', get<1>(tuple));
+    EXPECT_EQ(2.5, get<2>(tuple));
+    get<0>(tuple) = 7;
+    EXPECT_EQ(7, get<0>(tuple));
+}
+
+TEST(Tuple, GetByType) {
+    TEST_DESCRIPTION("Elements of a unique type should be reachable by type");
+    Tuple<int, char, double> tuple(1, 'a', 2.5);
+    EXPECT_EQ('a', get<char>(tuple));
+    get<double>(tuple) = 4.0;
+    EXPECT_EQ(4.0, get<2>(tuple));
+}
+
+TEST(Tuple, SameTypes) {
+    TEST_DESCRIPTION("Elements of the same type should be kept apart");
+    Tuple<int, int, int> tuple(1, 2, 3);
+    EXPECT_EQ(1, get<0>(tuple));
+    EXPECT_EQ(2, get<1>(tuple));
+    EXPECT_EQ(3, get<2>(tuple));
+}
+
+TEST(Tuple, StructuredBinding) {
+    TEST_DESCRIPTION("Tuples should unpack with structured bindings");
+    Tuple<int, char> tuple(5, 'z');
+    auto [number, letter] = tuple;
+    EXPECT_EQ(5, number);
+    EXPECT_EQ('z', letter);
+    auto &[numberRef, letterRef] = tuple;
+    numberRef = 6;
+    EXPECT_EQ(6, get<0>(tuple));
+    (void)letterRef;
+}
+
+TEST(Tuple, CopyAndCompare) {
+    TEST_DESCRIPTION("Copies should compare equal until changed");
+    Tuple<int, Empty, char> first(1, Empty(), 'c');
+    Tuple<int, Empty, char> second(first);
+    EXPECT_TRUE(first == second);
+    get<0>(second) = 2;
+    EXPECT_TRUE(first != second);
+    second = first;
+    EXPECT_TRUE(first == second);
+}
+
+TEST(Tuple, Deduction) {
+    TEST_DESCRIPTION("Element types should be deduced from the constructor arguments");
+    Tuple tuple(1, 2.0, 'c');
+    static_assert(__is_same(decltype(tuple), Tuple<int, double, char>));
+    EXPECT_EQ('c', get<2>(tuple));
+}
+
+TEST(Tuple, Apply) {
+    TEST_DESCRIPTION("Applying should call a function with the elements as arguments");
+    Tuple<int, int> arguments(3, 4);
+    EXPECT_EQ(7, apply([](int a, int b) { return a + b; }, arguments));
+    Function<int(int, int)> multiply([](int a, int b) { return a * b; });
+    EXPECT_EQ(12, apply(multiply, arguments));
+    Tuple<OtherEmpty, int> packed(OtherEmpty(), 5);
+    EXPECT_EQ(10, get<0>(packed)(get<1>(packed)));
+}
+
+TEST(Tuple, ApplyByReference) {
+    TEST_DESCRIPTION("Applying to a tuple should pass elements by reference");
+    Tuple<int, int> values(1, 2);
+    apply([](int &a, int &b) {
+        a *= 10;
+        b *= 10;
+    }, values);
+    EXPECT_EQ(10, get<0>(values));
+    EXPECT_EQ(20, get<1>(values));
+}
+
+TEST(Tuple, Wide) {
+    TEST_DESCRIPTION("Large tuples should work like small ones");
+    Wide wide;
+    get<49>(wide) = 'w';
+    get<0>(wide) = 1;
+    EXPECT_EQ('w', get<49>(wide));
+    EXPECT_EQ(1, get<0>(wide));
+    EXPECT_EQ(0, get<25>(wide));
+}
@@ -0,0 +1,121 @@
+#include "common.h"
+#include "hyper/Function.h"
+#include "hyper/Pair.h"
+#include "hyper/SharedPointer.h"
+#include "hyper/sort.h"
+#include "hyper/UniquePointer.h"
+#include "hyper/utility.h"
+#include "util/DestructorSpy.h"
+
+using namespace hyper;
+
+namespace {
+    // Keeps a pointer to itself, so copying its bytes would leave the copy pointing at the original.
+    struct SelfReferencing {
+        int value;
+        int *self;
+
+        explicit SelfReferencing(int value)
+                : value(value), self(&this->value) {
+            // ...
+        }
+
+        SelfReferencing(SelfReferencing &&other) noexcept
+                : value(other.value), self(&value) {
+            // ...
+        }
+
+        SelfReferencing &operator=(SelfReferencing &&other) noexcept {
+            value = other.value;
+            return *this;
+        }
+    };
+
+    static_assert(IsTriviallyRelocatable<SharedPointer<int>>::value);
+    static_assert(IsTriviallyRelocatable<SharedPointer<int[]>>::value);
+    static_assert(IsTriviallyRelocatable<UniquePointer<int>>::value);
+    static_assert(IsTriviallyRelocatable<Function<int(int)>>::value);
+    static_assert(IsTriviallyRelocatable<Pair<int, SharedPointer<int>>>::value);
+    static_assert(!IsTriviallyRelocatable<Pair<int, SelfReferencing>>::value);
+    static_assert(!IsTriviallyRelocatable<SelfReferencing>::value);
+}
+
+TEST(Utility, SwapRelocatable) {
+    TEST_DESCRIPTION("Swapping trivially relocatable values exchanges them without touching reference counts");
+    int callCount = 0;
+    {
+        Function<int(int)> twice([](int value) { return value * 2; });
+        Function<int(int)> negate([](int value) { return -value; });
+        swap(twice, negate);
+        EXPECT_EQ(-3, twice(3));
+        EXPECT_EQ(6, negate(3));
+
+        SharedPointer<DestructorSpy> first(new DestructorSpy(&callCount));
+        SharedPointer<DestructorSpy> second;
+        swap(first, second);
+        EXPECT_FALSE((bool) first);
+        EXPECT_TRUE((bool) second);
+    }
+    EXPECT_EQ(1, callCount);
+}
+
+TEST(Utility, SwapNonRelocatable) {
+    TEST_DESCRIPTION("Swapping other values goes through their move operations");
+    SelfReferencing first(1), second(2);
+    swap(first, second);
+    EXPECT_EQ(2, first.value);
+    EXPECT_EQ(1, second.value);
+    EXPECT_EQ(&first.value, first.self);
+    EXPECT_EQ(&second.value, second.self);
+}
+
+TEST(Utility, RelocateRelocatable) {
+    TEST_DESCRIPTION("Relocated pointers keep ownership, and nothing is freed until the new copies are destroyed");
+    int callCount = 0;
+    const size_t count = 8;
+    auto source = static_cast<UniquePointer<DestructorSpy> *>(::operator new(count * sizeof(UniquePointer<DestructorSpy>)));
+    auto destination = static_cast<UniquePointer<DestructorSpy> *>(::operator new(count * sizeof(UniquePointer<DestructorSpy>)));
+    for(size_t i = 0; i < count; i++)
+        new(&source[i]) UniquePointer<DestructorSpy>(new DestructorSpy(&callCount));
+    relocate(destination, source, count);
+    EXPECT_EQ(0, callCount);
+    for(size_t i = 0; i < count; i++)
+        destination[i].~UniquePointer<DestructorSpy>();
+    EXPECT_EQ(8, callCount);
+    ::operator delete(source);
+    ::operator delete(destination);
+}
+
+TEST(Utility, RelocateNonRelocatable) {
+    TEST_DESCRIPTION("Relocating other values move-constructs them");
+    auto source = static_cast<SelfReferencing *>(::operator new(4 * sizeof(SelfReferencing)));
+    auto destination = static_cast<SelfReferencing *>(::operator new(4 * sizeof(SelfReferencing)));
+    for(int i = 0; i < 4; i++)
+        new(&source[i]) SelfReferencing(i);
+    relocate(destination, source, 4);
+    for(int i = 0; i < 4; i++) {
+        EXPECT_EQ(i, destination[i].value);
+        EXPECT_EQ(&destination[i].value, destination[i].self);
+    }
+    ::operator delete(source);
+    ::operator delete(destination);
+}
+
+TEST(Utility, SortSharedPointers) {
+    TEST_DESCRIPTION("Sorting shared pointers swaps them without leaking or freeing early");
+    int callCount = 0;
+    {
+        const int count = 1000;
+        auto pointers = new SharedPointer<int>[count];
+        for(int i = 0; i < count; i++)
+            pointers[i] = SharedPointer<int>(new int((i * 7919) % count));
+        sort(pointers, count, [](const SharedPointer<int> &first, const SharedPointer<int> &second) {
+            return *first < *second;
+        });
+        for(int i = 0; i < count; i++)
+            EXPECT_EQ(i, *pointers[i]);
+        delete[] pointers;
+        SharedPointer<DestructorSpy> spy(new DestructorSpy(&callCount));
+    }
+    EXPECT_EQ(1, callCount);
+}
@@ -0,0 +1,73 @@
+#include <sys/resource.h>
+#include <unistd.h>
+#include "common.h"
+#include "hyper/TaskGraph.h"
+#include "hyper/WorkerPool.h"
+
+using namespace hyper;
+
+TEST(WorkerPool, DefaultSize) {
+    TEST_DESCRIPTION("A default pool should have at least one worker");
+    WorkerPool pool;
+    EXPECT_GE(pool.size(), 1u);
+}
+
+TEST(WorkerPool, EachWorkerRunsOnce) {
+    TEST_DESCRIPTION("Every worker should run each job exactly once");
+    WorkerPool pool(4);
+    ASSERT_EQ(4u, pool.size());
+    int counts[4] = {};
+    for(int round = 0; round < 50; round++)
+        pool.run(Function<void(size_t)>([&](size_t index) { __atomic_add_fetch(&counts[index], 1, __ATOMIC_RELAXED); }));
+    for(auto count : counts)
+        EXPECT_EQ(50, count);
+}
+
+TEST(WorkerPool, MoreWorkersThanCores) {
+    TEST_DESCRIPTION("Workers beyond the number of cores should still run");
+    WorkerPool pool(16);
+    int total = 0;
+    pool.run(Function<void(size_t)>([&](size_t) { __atomic_add_fetch(&total, 1, __ATOMIC_RELAXED); }));
+    EXPECT_EQ(static_cast<int>(pool.size()), total);
+}
+
+TEST(WorkerPool, SharesTaskGraph) {
+    TEST_DESCRIPTION("Workers should be able to share the work of a task graph");
+    WorkerPool pool(3);
+    TaskGraph graph;
+    int values[64] = {};
+    for(int i = 0; i < 64; i++)
+        graph.addNode(Function<void()>([&values, i]() { values[i] = i * 2; }));
+    ASSERT_TRUE(graph.compile());
+    graph.start();
+    pool.run(Function<void(size_t)>([&](size_t) { graph.work(); }));
+    EXPECT_TRUE(graph.isDone());
+    for(int i = 0; i < 64; i++)
+        EXPECT_EQ(i * 2, values[i]);
+}
+
+// Starts a pool in a process that can't create threads and runs a job on it.
+// The process drops to an unprivileged user without any process allowance, so thread creation fails.
+static void runWithoutThreads() {
+    if(geteuid() == 0 && setuid(65534) != 0)
+        _exit(2);
+    const rlimit limit = {0, 0};
+    if(setrlimit(RLIMIT_NPROC, &limit) != 0)
+        _exit(3);
+    WorkerPool pool(4);
+    if(pool.size() != 0)
+        _exit(4);
+    const auto caller = pthread_self();
+    size_t calls = 0;
+    bool onCaller = false;
+    pool.run(Function<void(size_t)>([&](size_t index) {
+        calls++;
+        onCaller = index == 0 && pthread_equal(pthread_self(), caller);
+    }));
+    _exit(calls == 1 && onCaller ? 0 : 5);
+}
+
+TEST(WorkerPool, EmptyRunsInline) {
+    TEST_DESCRIPTION("A pool whose workers can't start should run jobs on the calling thread");
+    EXPECT_EXIT(runWithoutThreads(), ::testing::ExitedWithCode(0), "");
+}